@@ -13,6 +13,12 @@ Description:
   is calculated. This value is printed for each delay value if delayL <= delayU.
   The cross-file statistics for the delay which maximizes the SNR are returned.
 
+  For a large range of delays, the gain optimized SNR values are calculated
+  for all delays in one pass through the data using FFT-based correlation
+  (CAxcorr). The statistics for the delays with the largest of these SNR values
+  are then recalculated exactly (CAcorr). The best delay is chosen from these
+  delays.
+
 Parameters:
   <- struct Stats_X CAcomp
       Structure containing the cross-file statistics corresponding to the delay
@@ -32,10 +38,11 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.32 $  $Date: 2020/11/27 02:06:32 $
+  $Revision: 1.33 $  $Date: 2020/12/08 10:20:00 $
 
 -----------------------------------------------------------------------*/
 
+#include <assert.h>
 #include <float.h>  /* DBL_MAX */
 #include <math.h> /* log10 */
 
@@ -48,6 +55,8 @@ Author / revision:
 
 static double
 CA_Nsseg(double SfreqA, double SfreqB);
+static void
+CA_best(const struct Stats_X StatsXD[], long int Nd, int Ibest[], int Nbest);
 
 
 struct Stats_X
@@ -56,9 +65,16 @@ CAcomp(AFILE *AFp[2], const long int Start[2], long int Nsamp,
 
 {
   struct Stats_X StatsXD, StatsX;
+  struct Stats_X *StatsXA;
   struct SNR_X SNRX;
-  long int Nsseg, delay;
+  long int Nsseg, delay, Nd;
   double SNRGmax;
+  int Ibest[CA_NBEST];
+  int *Exact;
+  int i;
+
+  StatsXA = NULL;
+  Exact = NULL;
 
 /* Check Sfreq, find the segment length for segmental SNR */
   Nsseg = AFp[0]->Nchan * CA_Nsseg(AFp[0]->Sfreq, AFp[1]->Sfreq);
@@ -77,11 +93,31 @@ CAcomp(AFILE *AFp[2], const long int Start[2], long int Nsamp,
 */
 
 /* Loop over the delays */
+  Nd = Delay[1] - Delay[0] + 1;
+  if (Nd >= CA_NDFFT) {
+
+    /* Find the SNR values for all delays, recalculate the best few exactly */
+    StatsXA = (struct Stats_X *) UTmalloc(Nd * sizeof(struct Stats_X));
+    Exact = (int *) UTmalloc(Nd * sizeof(int));
+    CAxcorr(AFp, Start, Nsamp, Delay, Nsseg, StatsXA);
+    CA_best(StatsXA, Nd, Ibest, CA_NBEST);
+    for (i = 0; i < Nd; ++i)
+      Exact[i] = 0;
+    for (i = 0; i < CA_NBEST && Ibest[i] >= 0; ++i) {
+      StatsXA[Ibest[i]] = CAcorr(AFp, Start, Nsamp, Delay[0] + Ibest[i],
+                                 Nsseg);
+      Exact[Ibest[i]] = 1;
+    }
+  }
+
   SNRGmax = -DBL_MAX;
   for (delay = Delay[0]; delay <= Delay[1]; ++delay) {
 
     /* Cross product terms */
-    StatsXD = CAcorr(AFp, Start, Nsamp, delay, Nsseg);
+    if (StatsXA != NULL)
+      StatsXD = StatsXA[delay - Delay[0]];
+    else
+      StatsXD = CAcorr(AFp, Start, Nsamp, delay, Nsseg);
 
     if (Delay[0] != Delay[1]) {
 
@@ -94,6 +130,10 @@ CAcomp(AFILE *AFp[2], const long int Start[2], long int Nsamp,
       else
         printf(CAMF_DelayAxB, delay, SNRX.SF);
 
+      /* Only exactly calculated statistics are candidates */
+      if (StatsXA != NULL && ! Exact[delay - Delay[0]])
+        continue;
+
       /* Save the best match statistics - if the best match occurs at several
          delays, use the delay with the smallest absolute value */
       if (SNRX.SNRG > SNRGmax ||
@@ -106,9 +146,51 @@ CAcomp(AFILE *AFp[2], const long int Start[2], long int Nsamp,
       StatsX = StatsXD;
     }
   }
+
+  UTfree(StatsXA);
+  UTfree(Exact);
+
   return StatsX;
 }
-
+
+/* Find the indices of the Nbest largest gain optimized SNR values; ties are
+   resolved in favour of the delay with the smallest absolute value. Unused
+   entries are set to -1. */
+
+
+static void
+CA_best(const struct Stats_X StatsXD[], long int Nd, int Ibest[], int Nbest)
+
+{
+  int i, j, k;
+  double SNRG[CA_NBEST];
+  struct SNR_X SNRX;
+
+  assert(Nbest <= CA_NBEST);
+  for (j = 0; j < Nbest; ++j)
+    Ibest[j] = -1;
+
+  for (i = 0; i < Nd; ++i) {
+    SNRX = CASNR(&StatsXD[i]);
+
+    /* Insertion into the list in decreasing order */
+    for (j = 0; j < Nbest; ++j) {
+      if (Ibest[j] < 0 || SNRX.SNRG > SNRG[j] ||
+          (SNRX.SNRG == SNRG[j] &&
+           ABSV(StatsXD[i].Delay) < ABSV(StatsXD[Ibest[j]].Delay)))
+        break;
+    }
+    if (j < Nbest) {
+      for (k = Nbest-1; k > j; --k) {
+        Ibest[k] = Ibest[k-1];
+        SNRG[k] = SNRG[k-1];
+      }
+      Ibest[j] = i;
+      SNRG[j] = SNRX.SNRG;
+    }
+  }
+}
+
 /* Resolve the sampling frequency, choose the segment length in frames */
 
 
@@ -0,0 +1,275 @@
+/*------------- Telecommunications & Signal Processing Lab --------------
+                          McGill University
+Routine:
+  void CAxcorr(AFILE *AFp[2], const long int Start[2], long int Nsamp,
+               const long int Delay[2], long int Nsseg, struct Stats_X StatsX[])
+
+Purpose:
+  Gather correlation statistics for two audio files for a range of delays
+
+Description:
+  This routine calculates the sums of squares and the sum of cross-products for
+  two audio files for each delay in a range of delays. The data alignment and
+  the data included in the sums are the same as for CAcorr. The cross-products
+  for all delays are calculated together using FFT-based correlation, reading
+  the data in blocks. The sums of squares are obtained from the sums over the
+  common part of the data and cumulative sums over the end regions.
+
+  Only the values Sxx, Syy, Sxy and See are calculated, with the sum of
+  squared differences obtained as See = Sxx + Syy - 2 Sxy. The other sample
+  difference statistics and the segmental SNR values are not calculated. The
+  number of differences is set to zero if See is zero (the data is the same
+  for that delay, as for instance for files of zeros) and to one otherwise,
+  so that CASNR reports equal data or calculates the SNR values from the sums
+  as for CAcorr. The cross-products are subject to round-off error in the FFT
+  calculations. The exact values for a given delay can be calculated with
+  CAcorr.
+
+Parameters:
+   -> AFILE *AFp[2]
+      Audio file pointers
+   -> long int Start[2]
+      Start samples
+   -> long int Nsamp
+      Number of samples
+   -> const long int Delay[2]
+      Start/end delay value, Delay[0] <= Delay[1]
+   -> long int Nsseg
+      Segment length in samples for segmental SNR computations
+  <-  struct Stats_X StatsX[]
+      Array of Delay[1]-Delay[0]+1 structures containing the file statistics
+      for each delay
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/26 10:00:00 $
+
+-----------------------------------------------------------------------*/
+
+#include <assert.h>
+
+#include "CompAudio.h"
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+#define MAXV(a, b)  (((a) > (b)) ? (a) : (b))
+#define SQRV(x)     ((x) * (x))
+
+#define NBUF      2560
+#define NFFT_MIN  4096
+
+static const struct Stats_X Stats_X_Init = {
+  0.0L, 0.0L, 0.0L, 0.0L, 0L, 0L, 0.0, 0L, 0, 0L, 0L, 0.0 };
+
+
+static long int
+CA_lag(long int delay, long int Nchan, long int Nsamp);
+static long double
+CA_sumsq(AFILE *AFp, long int offs, long int N, long double S[]);
+static void
+CA_xlag(AFILE *AFp[2], const long int Start[2], long int jl, long int ju,
+        long int kl, long int ku, long int Ll, long int Lu, long double Sxy[]);
+
+
+void
+CAxcorr(AFILE *AFp[2], const long int Start[2], long int Nsamp,
+        const long int Delay[2], long int Nsseg, struct Stats_X StatsX[])
+
+{
+  long int Nchan, Nd, Ll, Lu, L, Np, Nn, i;
+  long double Exx, Eyy;
+  long double *Sxy, *Sp, *Sn;
+
+  assert(AFp[0]->Nchan == AFp[1]->Nchan);
+  assert(Delay[0] <= Delay[1]);
+  Nchan = AFp[0]->Nchan;
+  Nd = Delay[1] - Delay[0] + 1;
+
+/*
+  The delays are expressed as lags in samples, L = Nchan*delay, limited to the
+  range -Nsamp to +Nsamp (see CAcorr). With the data in files A and B denoted
+  as a(j) and b(k), relative to the start samples, the cross-product sum for
+  lag L pairs a(j) with b(k), k = j - L, over the range
+    L >= 0:  0 <= j < Nsamp+L,  -L <= k < Nsamp,
+    L < 0:   L <= j < Nsamp,     0 <= k < Nsamp-L.
+  For L >= 0, the limits are j >= 0 and k < Nsamp; for L < 0, the limits are
+  k >= 0 and j < Nsamp. The non-negative and negative lags are handled
+  separately, each with data windows that implement the corresponding limits.
+*/
+  Ll = CA_lag(Delay[0], Nchan, Nsamp);
+  Lu = CA_lag(Delay[1], Nchan, Nsamp);
+  Sxy = (long double *) UTmalloc((Lu - Ll + 1) * sizeof(long double));
+  for (L = Ll; L <= Lu; ++L)
+    Sxy[L-Ll] = 0.0L;
+
+  if (Lu >= 0)
+    CA_xlag(AFp, Start, 0L, Nsamp + Lu, -Lu, Nsamp, MAXV(Ll, 0L), Lu,
+            &Sxy[MAXV(Ll, 0L) - Ll]);
+  if (Ll < 0)
+    CA_xlag(AFp, Start, Ll, Nsamp, 0L, Nsamp - Ll, Ll, MINV(Lu, -1L), Sxy);
+
+/*
+  Sums of squares
+  - Exx and Eyy are the sums over 0 <= j,k < Nsamp
+  - Sp[i] is the cumulative sum of squares for a(Nsamp), ..., a(Nsamp+i-1)
+    (file A) or for b(-Np), ..., b(-Np+i-1) (file B) for non-negative lags
+  - Sn[i] is the cumulative sum of squares for a(-Nn), ..., a(-Nn+i-1) (file
+    A) or for b(Nsamp), ..., b(Nsamp+i-1) (file B) for negative lags
+*/
+  Np = MAXV(Lu, 0L);
+  Nn = MAXV(-Ll, 0L);
+  Sp = (long double *) UTmalloc(2 * (Np + 1) * sizeof(long double));
+  Sn = (long double *) UTmalloc(2 * (Nn + 1) * sizeof(long double));
+  Exx = CA_sumsq(AFp[0], Start[0], Nsamp, NULL);
+  Eyy = CA_sumsq(AFp[1], Start[1], Nsamp, NULL);
+  CA_sumsq(AFp[0], Start[0] + Nsamp, Np, Sp);
+  CA_sumsq(AFp[1], Start[1] - Np, Np, &Sp[Np+1]);
+  CA_sumsq(AFp[0], Start[0] - Nn, Nn, Sn);
+  CA_sumsq(AFp[1], Start[1] + Nsamp, Nn, &Sn[Nn+1]);
+
+  for (i = 0; i < Nd; ++i) {
+    StatsX[i] = Stats_X_Init;
+    StatsX[i].Nsseg = Nsseg;
+    StatsX[i].Delay = Delay[0] + i;
+
+    /* For |L| = Nsamp, the data does not overlap */
+    L = CA_lag(Delay[0] + i, Nchan, Nsamp);
+    if (L > -Nsamp && L < Nsamp)
+      StatsX[i].Sxy = Sxy[L-Ll];
+    if (L >= 0) {
+      StatsX[i].Sxx = Exx + Sp[L];
+      StatsX[i].Syy = Eyy + (Sp[Np+1+Np] - Sp[Np+1+Np-L]);
+    }
+    else {
+      StatsX[i].Sxx = Exx + (Sn[Nn] - Sn[Nn+L]);
+      StatsX[i].Syy = Eyy + Sn[Nn+1-L];
+    }
+
+    /* Sum of squared differences, exactly zero for equal data (e.g. zeros);
+       a negative value can only arise from round-off */
+    StatsX[i].See = StatsX[i].Sxx + StatsX[i].Syy - 2.0L * StatsX[i].Sxy;
+    StatsX[i].Ndiff = (StatsX[i].See == 0.0L) ? 0 : 1;
+    if (StatsX[i].See < 0.0L)
+      StatsX[i].See = 0.0L;
+  }
+
+  UTfree(Sxy);
+  UTfree(Sp);
+  UTfree(Sn);
+}
+
+/* Lag in samples for a delay in frames */
+
+
+static long int
+CA_lag(long int delay, long int Nchan, long int Nsamp)
+
+{
+  long int L;
+
+  L = delay * Nchan;
+  return MAXV(-Nsamp, MINV(Nsamp, L));
+}
+
+/* Sum of squares of N samples starting at sample offs; if S is not NULL,
+   S[i] is set to the cumulative sum of the first i values, 0 <= i <= N */
+
+
+static long double
+CA_sumsq(AFILE *AFp, long int offs, long int N, long double S[])
+
+{
+  double x[NBUF];
+  int Nv, i;
+  long int k;
+  long double Sum;
+
+  Sum = 0.0L;
+  if (S != NULL)
+    S[0] = Sum;
+  for (k = 0; k < N; k += Nv) {
+    Nv = (int) MINV(N - k, NBUF);
+    AFdReadData(AFp, offs + k, x, Nv);
+    for (i = 0; i < Nv; ++i) {
+      Sum += SQRV((long double) x[i]);
+      if (S != NULL)
+        S[k+i+1] = Sum;
+    }
+  }
+
+  return Sum;
+}
+
+/*
+  Cross-products for a range of lags
+    Sxy[L-Ll] = SUM a(j) b(j-L),  Ll <= L <= Lu,
+  where a(j) is taken as zero outside jl <= j < ju and b(k) is taken as zero
+  outside kl <= k < ku.
+
+  The data from file A is processed in blocks of B samples. For a block
+  starting at jb, the data from file B needed for all lags is b(jb-Lu), ...,
+  b(jb+B-1-Ll). With u(i) = a(jb+i) and v(m) = b(jb-Lu+m), the contribution
+  of the block to lag L is
+    r(Lu-L) = SUM u(i) v(i+Lu-L) .
+  The correlation r(M) for 0 <= M <= Lu-Ll is calculated as the inverse DFT
+  of conj(U(k)) V(k), where U(k) and V(k) are DFT's of size Nfft. With
+  Nfft >= B + Lu - Ll, the circular correlation has no wrap-around for these
+  values of M.
+*/
+
+
+static void
+CA_xlag(AFILE *AFp[2], const long int Start[2], long int jl, long int ju,
+        long int kl, long int ku, long int Ll, long int Lu, long double Sxy[])
+
+{
+  int Nfft, B, Bj, Nm, M, i, k, m;
+  long int jb, kb, NL;
+  double *u, *v;
+  double t;
+
+  NL = Lu - Ll;
+  Nfft = NFFT_MIN;
+  while (Nfft < 2 * (NL + 1))
+    Nfft = 2 * Nfft;
+  B = (int) (Nfft - NL);
+  M = Nfft / 2;
+
+  u = (double *) UTmalloc(2 * Nfft * sizeof(double));
+  v = &u[Nfft];
+
+  for (jb = jl; jb < ju; jb += Bj) {
+    Bj = (int) MINV(B, ju - jb);
+    Nm = (int) (Bj + NL);
+
+    /* Data windows, zero padded */
+    AFdReadData(AFp[0], Start[0] + jb, u, Bj);
+    for (i = Bj; i < Nfft; ++i)
+      u[i] = 0.0;
+
+    kb = jb - Lu;
+    AFdReadData(AFp[1], Start[1] + kb, v, Nm);
+    for (m = 0; m < Nm; ++m) {
+      if (kb + m < kl || kb + m >= ku)
+        v[m] = 0.0;
+    }
+    for (m = Nm; m < Nfft; ++m)
+      v[m] = 0.0;
+
+    /* Correlation: conj(U) V, in the format used by SPdRFFT */
+    SPdRFFT(u, Nfft, 1);
+    SPdRFFT(v, Nfft, 1);
+    v[0] = u[0] * v[0];
+    v[M] = u[M] * v[M];
+    for (k = 1; k < M; ++k) {
+      t = u[k] * v[k] + u[M+k] * v[M+k];
+      v[M+k] = u[k] * v[M+k] - u[M+k] * v[k];
+      v[k] = t;
+    }
+    SPdRFFT(v, Nfft, -1);
+
+    for (m = 0; m <= NL; ++m)
+      Sxy[NL-m] += v[m];
+  }
+
+  UTfree(u);
+}
@@ -144,9 +144,11 @@ Options:
   Input file(s), AFileA [AFileB]:
       The environment variable AUDIOPATH specifies a list of directories to be
       searched for the input audio file(s). One or two input files can be
-      specified. For a single input file, specifying "-" as the input file
-      indicates that input is from standard input (use the "-t" option to
-      specify the format of the input data).
+      specified. Specifying "-" as an input file indicates that input is from
+      standard input (use the "-t" option to specify the format of the input
+      data). With two input files, the data of each file is read twice. Data
+      from standard input is kept in a window for moving back (see AFoptions,
+      1 MB by default); a longer input from standard input gives an error.
   -d DL:DU, --delay=DL:DU
       Specify a delay range (in samples). Each delay in the delay range
       represents a delay of file B relative to file A. A single delay value can
@@ -161,6 +163,20 @@ Options:
       Sample limits for the input files (numbered from zero). Each invocation
       applies to the input files that follow the option. The specification "L:"
       means from sample L to the end; "N" means from sample 0 to sample N-1.
+  --stats
+      Print data transfer statistics for the audio files when they are closed
+      (requests, bytes, read/write calls, seeks and times).
+  --mmap
+      Map the data of random access input files into memory, instead of
+      reading it with stdio calls. Files which cannot be mapped are read as
+      usual.
+  --async=N
+      Transfer the audio file data in a separate thread for each file, using
+      N buffer blocks. This lets the file reads and writes overlap the
+      processing. The default (0) transfers the data in the program thread.
+  --lazy-info
+      Defer decoding the information records (LIST/INFO, bext and DISP
+      chunks) of random access WAVE input files until they are used.
   -h, --help
       Print a list of options and exit.
   -v, --version
@@ -214,11 +230,9 @@ main(int argc, const char *argv[])
 
 /* Input file access options */
   NsampND = 0;
-  RAccess = 0;
+  RAccess = 0;    /* Moving back in a stream uses the retained data window */
   if (Nfiles == 1)
     NsampND = 1;  /* Number of samples can be unknown */
-  else
-    RAccess = 1;  /* Must be random access (need to rewind) */
 
 /* Open the input files */
   for (i = 0; i < Nfiles; ++i) {
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.84 $  $Date: 2020/11/30 12:31:25 $
+  $Revision: 1.88 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -33,6 +33,10 @@ Author / revision:
                                  corresponding to 128 samples  at 8 kHz*/
 #define SN_NSEG_MIN 64        /* Segmental SNR, min segment length */
 #define SN_NSEG_MAX 768       /* Segmental SNR, max segment length */
+#define CA_NDFFT    16        /* Delay range, min number of delays for the
+                                 FFT-based correlation */
+#define CA_NBEST    5         /* Delay range, number of delays with exact
+                                 statistics */
 
 struct Stats_F {
   long int N;       /* Number of samples */
@@ -132,6 +136,10 @@ Options:\n\
                               \"SPPACK\", \"SPW\", \"NSP\".\n\
   -P PARMS, --parameters=PARMS  Parameters for input files,\n\
                               \"Format,Start,Sfreq,Swapb,Nchan,FullScale\".\n\
+  --stats                     Print data transfer statistics.\n\
+  --mmap                      Map the input file data into memory.\n\
+  --async=N                   Transfer the file data in the background.\n\
+  --lazy-info                 Decode WAVE information records on use.\n\
   -h, --help                  Print this message and exit.\n\
   -v, --version               Print the version number and exit."
 
@@ -149,6 +157,9 @@ struct Stats_X
 CAcorr(AFILE *AFp[2], const long int Start[2], long int Nsamp, long int delay,
        long int Nsseg);
 void
+CAxcorr(AFILE *AFp[2], const long int Start[2], long int Nsamp,
+        const long int Delay[2], long int Nsseg, struct Stats_X StatsX[]);
+void
 CAoptions(int argc, const char *argv[], long int Delay[2],
           struct AO_FIpar FI[2]);
 void
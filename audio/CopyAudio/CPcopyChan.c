@@ -20,6 +20,14 @@ Description:
     Nframe   specified    min(Nframe, MaxNframe)  Nframe
            unspecified    min(MaxNframe, EoF)     EoF
 
+  For a single input file with the same data format and byte order as the
+  output file and no gain applied, the data is copied as bytes (AFcopyData)
+  rather than being converted to double values and back. Mu-law data, which
+  has two codes for zero, is always converted (see AFcopyCheck). For a single
+  input file with 16-bit integer data, a 16-bit integer output file and no
+  gain applied (e.g. a change of byte order), the data is transferred as
+  16-bit integers (AFsReadData and AFsWriteData).
+
 Parameters:
   <-  long int CPcopyChan
       Number of sample frames written
@@ -38,7 +46,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.28 $  $Date: 2020/11/23 18:30:55 $
+  $Revision: 1.31 $  $Date: 2020/12/26 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -52,6 +60,7 @@ Author / revision:
 #define ICEILV(n, m)  (((n) + ((m) - 1)) / (m)) /* int n,m >= 0 */
 
 #define BFSIZE  5120
+#define RAWSIZE 262144  /* Samples per transfer for raw copies */
 
 static long int
 CP_copy1(AFILE *AFpI, long int StartF, long int Nframe, int eof, AFILE *AFpO);
@@ -127,8 +136,9 @@ CP_copy1(AFILE *AFpI, long int StartF, long int Nframe, int eof, AFILE *AFpO)
 
 {
   double Dbuff[BFSIZE];
-  long int offr, ioffs, Nrem, Nj;
-  int Nr, Nv;
+  short int Sbuff[BFSIZE];
+  long int offr, offs, ioffs, Nrem, Nj;
+  int Nr, Nv, Raw, Sint;
 
 /* There are 3 cases here:
    eof indicates that reading should stop at end-of-file (EOF)
@@ -147,18 +157,39 @@ CP_copy1(AFILE *AFpI, long int StartF, long int Nframe, int eof, AFILE *AFpO)
   else
     Nrem = Nj * Nframe;
 
+/* Raw copy: the number of samples in the input file must be known to resolve
+   EOF before writing */
+  Raw = (AFcopyCheck(AFpI, AFpO) && AFpI->Nsamp != AF_NSAMP_UNDEF);
+
+/* 16-bit integer transfer: the values are not changed (unit gain, standard
+   full scale) */
+  Sint = (! Raw && AFpI->Format == FD_INT16 && AFpO->Format == FD_INT16 &&
+          AFpI->FullScale == AF_FULLSCALE[FD_INT16] &&
+          AFpI->ScaleF * AFpO->ScaleF == 1.0);
+
   offr = 0L;
   while (Nrem > 0L) {
-    Nv = (int) MINV(Nrem, BFSIZE);
-    Nr = AFdReadData(AFpI, offr + Nj * StartF, Dbuff, Nv);
+    offs = offr + Nj * StartF;
+    if (Raw) {
+      Nv = (int) MINV(Nrem, RAWSIZE);
+      Nr = (int) MINV(Nv, MAXV(AFpI->Nsamp - offs, 0L));
+    }
+    else if (Sint) {
+      Nv = (int) MINV(Nrem, BFSIZE);
+      Nr = AFsReadData(AFpI, offs, Sbuff, Nv);
+    }
+    else {
+      Nv = (int) MINV(Nrem, BFSIZE);
+      Nr = AFdReadData(AFpI, offs, Dbuff, Nv);
+    }
 
     /* There is a potential problem when we encounter EOF since the number of
        samples may not be a multiple of the number of channels. Here we round up
        to the next multiple of channels, resetting Nrem to the value it should
        have had before the read if we had known the number of samples in the
        file.
-       Note: AFdReadData returns Nv samples, Nr of which are real samples and
-             the rest are zeros.
+       Note: AFdReadData (AFsReadData) returns Nv samples, Nr of which are
+             real samples and the rest are zeros.
     */
     if (eof && Nr < Nv) {
       ioffs = Nj * ICEILV(offr + Nr, Nj);
@@ -171,7 +202,12 @@ CP_copy1(AFILE *AFpI, long int StartF, long int Nframe, int eof, AFILE *AFpO)
     Nrem -= Nv;
     offr += Nv;
 
-    AFdWriteData(AFpO, Dbuff, Nv);
+    if (Raw)
+      AFcopyData(AFpI, offs, AFpO, Nv);
+    else if (Sint)
+      AFsWriteData(AFpO, Sbuff, Nv);
+    else
+      AFdWriteData(AFpO, Dbuff, Nv);
   }
   assert(Nj * (offr/Nj) == offr);
 
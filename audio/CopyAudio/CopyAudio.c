@@ -140,6 +140,7 @@ Options:
                                    format.
         "WAVE-NOEX" or "wave-noex" - WAVE file; do not use the WAVE file
                                    extensible format
+        "Wave64" or "wave64"     - Wave64 file (64-bit sizes)
         "AIFF-C" or "aiff-c"     - AIFF-C sound file
         "AIFF-C/sowt" or "aiff-c/sowt" - AIFF-C (byte-swapped data)
         "AIFF" or "aiff"         - AIFF sound file
@@ -235,6 +236,20 @@ Options:
       identifier followed by text. The text from an information record of the
       form "title: TITLE" will appear as part of the printout of the file
       information as a file is opened.
+  --stats
+      Print data transfer statistics for the audio files when they are closed
+      (requests, bytes, read/write calls, seeks and times).
+  --mmap
+      Map the data of random access input files into memory, instead of
+      reading it with stdio calls. Files which cannot be mapped are read as
+      usual.
+  --async=N
+      Transfer the audio file data in a separate thread for each file, using
+      N buffer blocks. This lets the file reads and writes overlap the
+      processing. The default (0) transfers the data in the program thread.
+  --lazy-info
+      Defer decoding the information records (LIST/INFO, bext and DISP
+      chunks) of random access WAVE input files until they are used.
   -h, --help
       Print a list of options and exit.
   -v, --version
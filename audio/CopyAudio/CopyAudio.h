@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.101 $  $Date: 2020/11/30 12:32:00 $
+  $Revision: 1.105 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -89,8 +89,8 @@ Options:\n\
   -cL CGAINS, --chanL=CGAINS  Scaling factors for output channel L.\n\
   -F FTYPE, --file-type=FTYPE  Output file type,\n\
                               \"AU\", \"WAVE\", \"WAVE-NOEX\", \"AIFF\",\n\
-                              \"AIFF-C\", \"AIFF-C/sowt\", \"noheader\",\n\
-                              \"noheader-swap\", \"text-audio\".\n\
+                              \"AIFF-C\", \"AIFF-C/sowt\", \"Wave64\",\n\
+                              \"noheader\", \"noheader-swap\", \"text-audio\".\n\
   -D DFORMAT, --data-format=DFORMAT  Data format for the output file,\n\
                               \"mu-law8\", \"mu-lawR8\", \"A-law8\", \"unsigned8\",\n\
                               \"integer8\", \"integer16\", \"integer24\",\n\
@@ -98,6 +98,10 @@ Options:\n\
   -S SPEAKERS, --speakers=SPEAKERS  Loudspeaker positions,\n\
                               \"FL\", \"FR\", ... \n\
   -I INFO, --info=INFO        Add a header information record.\n\
+  --stats                     Print data transfer statistics.\n\
+  --mmap                      Map the input file data into memory.\n\
+  --async=N                   Transfer the file data in the background.\n\
+  --lazy-info                 Decode WAVE information records on use.\n\
   -h, --help                  Print a list of options and exit.\n\
   -v, --version               Print the version number and exit."
 
@@ -0,0 +1,151 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void FAnewCbuf(struct FA_cbuf *B, int Nchan)
+  void FAfreeCbuf(struct FA_cbuf *B)
+  void FAreadCbuf(AFILE *AFpI, long int n, struct FA_cbuf *B, int ist, int Nx)
+  void FAwriteCbuf(AFILE *AFpO, const struct FA_cbuf *B, int ist, int Ny,
+                   int Nstep)
+
+Purpose:
+  Allocate a multichannel data buffer
+  Deallocate a multichannel data buffer
+  Read data from an audio file into the channel buffers
+  Write data from the channel buffers to an audio file
+
+Description:
+  A multichannel buffer has a separate buffer of NBUF values for each channel
+  (FA_CHAN(B, i) points to the buffer for channel i) and an NBUF frame buffer
+  for the channel-interleaved data to and from the audio files. The filtering
+  routines operate on the channel buffers, each channel with its own filter
+  memory.
+
+  FAreadCbuf reads Nx frames starting at frame n of the input file. The data
+  for each channel is placed in the channel buffer starting at element ist.
+
+  FAwriteCbuf writes Ny frames to the output file. The values for each channel
+  are taken from the channel buffer starting at element ist, taking every
+  Nstep'th element.
+
+  For single channel files, the data is transferred directly to and from the
+  channel buffer where possible.
+
+Parameters:
+  <-  void FAnewCbuf
+  <-  struct FA_cbuf *B
+      Multichannel buffer structure
+   -> int Nchan
+      Number of channels
+
+  <-  void FAfreeCbuf
+  <-> struct FA_cbuf *B
+      Multichannel buffer structure
+
+  <-  void FAreadCbuf
+   -> AFILE *AFpI
+      Audio file pointer for the input audio file
+   -> long int n
+      Frame offset of the first frame to be read
+  <-> struct FA_cbuf *B
+      Multichannel buffer structure
+   -> int ist
+      Offset into the channel buffers for the first value
+   -> int Nx
+      Number of frames to be read (ist + Nx <= NBUF)
+
+  <-  void FAwriteCbuf
+   -> AFILE *AFpO
+      Audio file pointer for the output audio file
+   -> const struct FA_cbuf *B
+      Multichannel buffer structure
+   -> int ist
+      Offset into the channel buffers for the first value
+   -> int Ny
+      Number of frames to be written (Ny <= NBUF)
+   -> int Nstep
+      Step between values in the channel buffers
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/02 10:15:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <assert.h>
+
+#include <libtsp.h>
+#include "FiltAudio.h"
+
+
+void
+FAnewCbuf(struct FA_cbuf *B, int Nchan)
+
+{
+  B->Nchan = Nchan;
+  B->x = (double *) UTmalloc(Nchan * NBUF * sizeof (double));
+  B->xi = (double *) UTmalloc(Nchan * NBUF * sizeof (double));
+}
+
+
+void
+FAfreeCbuf(struct FA_cbuf *B)
+
+{
+  UTfree(B->x);
+  UTfree(B->xi);
+  B->x = NULL;
+  B->xi = NULL;
+}
+
+
+void
+FAreadCbuf(AFILE *AFpI, long int n, struct FA_cbuf *B, int ist, int Nx)
+
+{
+  int i, j, Nchan;
+  const double *xi;
+  double *x;
+
+  assert(ist >= 0 && ist + Nx <= NBUF);
+
+  Nchan = B->Nchan;
+  if (Nchan == 1) {
+    AFdReadData(AFpI, n, &B->x[ist], Nx);
+    return;
+  }
+
+  AFdReadData(AFpI, n * Nchan, B->xi, Nx * Nchan);
+  for (i = 0; i < Nchan; ++i) {
+    x = &FA_CHAN(B, i)[ist];
+    xi = &B->xi[i];
+    for (j = 0; j < Nx; ++j)
+      x[j] = xi[j*Nchan];
+  }
+}
+
+
+void
+FAwriteCbuf(AFILE *AFpO, const struct FA_cbuf *B, int ist, int Ny, int Nstep)
+
+{
+  int i, j, Nchan;
+  const double *x;
+  double *xi;
+
+  assert(Ny <= NBUF);
+
+  Nchan = B->Nchan;
+  if (Nchan == 1 && Nstep == 1) {
+    AFdWriteData(AFpO, &B->x[ist], Ny);
+    return;
+  }
+
+  xi = B->xi;
+  for (i = 0; i < Nchan; ++i) {
+    x = &FA_CHAN(B, i)[ist];
+    for (j = 0; j < Ny; ++j)
+      xi[j*Nchan + i] = x[j*Nstep];
+  }
+  AFdWriteData(AFpO, xi, Ny * Nchan);
+}
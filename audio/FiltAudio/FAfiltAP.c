@@ -3,14 +3,16 @@
 
 Routine:
   void FAfiltAP(AFILE *AFpI, AFILE *AFpO, long int NsampO, double h[], int Ncof,
-                int Nsub, long int noffs)
+                int Nsub, long int noffs, int Nthread)
 
 Purpose:
   Filter an audio file with an all-pole filter
 
 Description:
   This routine convolves the data from the input audio file with an all-pole
-  filter response.
+  filter response. For multichannel data, each channel is filtered separately
+  with its own filter memory. The channels can be filtered in parallel threads,
+  using a pool of threads that is created once for the file (see AOnewPool).
 
 Parameters:
    -> AFILE *AFpI
@@ -18,17 +20,19 @@ Parameters:
    -> AFILE *AFpO
       Audio file pointer for the output audio file
    -> long int NsampO
-      Number of output samples to be calculated
+      Number of output samples (per channel) to be calculated
    -> double h[]
       Array of Ncof all-pole filter coefficients
    -> int Nsub
       Subsampling factor
    -> long int noffs
       Data offset into the input data for the first output point
+   -> int Nthread
+      Maximum number of threads used to filter the channels
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.19 $  $Date: 2020/11/23 18:31:10 $
+  $Revision: 1.20 $  $Date: 2020/12/24 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -39,17 +43,30 @@ Author / revision:
 #define MAXV(a, b)  (((a) > (b)) ? (a) : (b))
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
 
+/* Arguments for filtering one channel */
+struct FA_AParg {
+  struct FA_cbuf *B;
+  const double *h;
+  int Ncof;
+  int Nx;
+};
+
+static void
+FA_filtChan(int ich, void *Arg);
 static void
-FA_writeSubData(AFILE *AFp0, long int k, int Nsub, const double x[], int Nx);
+FA_writeSubData(AFILE *AFp0, long int k, int Nsub, const struct FA_cbuf *B,
+                int ist, int Nx);
 
 
 void
 FAfiltAP(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[], int Ncof,
-         int Nsub, long int noffs)
+         int Nsub, long int noffs, int Nthread)
 
 {
-  double x[NBUF];
-  int lmem, Nxmax, Nx;
+  struct FA_cbuf B;
+  struct AO_pool *Pool;
+  struct FA_AParg A;
+  int lmem, Nxmax, Nx, i;
   long int n, k, NyO;
 
 /*
@@ -86,9 +103,16 @@ Buffer allocation:
   Nxmax = NBUF - lmem;
   NyO = (NsampO - 1) * Nsub + 1;
 
+  FAnewCbuf(&B, (int) AFpI->Nchan);
+  Pool = AOnewPool(MINV(Nthread, B.Nchan));
+  A.B = &B;
+  A.h = h;
+  A.Ncof = Ncof;
+
 /* Main processing loop */
   /* if (n < noffs), processing warm-up points, no output */
-  VRdZero(x, lmem);
+  for (i = 0; i < B.Nchan; ++i)
+    VRdZero(FA_CHAN(&B, i), lmem);
   n = MINV(noffs, MAXV(0, noffs - MAXWUP));
 
   k = 0;
@@ -99,35 +123,51 @@ Buffer allocation:
       Nx = (int) MINV(Nxmax, noffs - n);
     else
       Nx = (int) MINV(Nxmax, NyO - k);
-    AFdReadData(AFpI, n, &x[lmem], Nx);
+    FAreadCbuf(AFpI, n, &B, lmem, Nx);
 
 /* Convolve the input samples with the filter response */
-    FIdFiltAP(&x[lmem], x, Nx, h, Ncof);
+    A.Nx = Nx;
+    AOrunPool(Pool, FA_filtChan, &A, B.Nchan);
 
 /* Write the output data to the output audio file */
     if (n >= noffs) {
       if (Nsub == 1)
-        AFdWriteData(AFpO, &x[2], Nx);
+        FAwriteCbuf(AFpO, &B, lmem, Nx, 1);
       else
-        FA_writeSubData(AFpO, k, Nsub, &x[2], Nx);
+        FA_writeSubData(AFpO, k, Nsub, &B, lmem, Nx);
       k = k + Nx;
     }
     n = n + Nx;
 
 /* Update the filter memory */
-    VRdShift(x, lmem, Nx);
+    for (i = 0; i < B.Nchan; ++i)
+      VRdShift(FA_CHAN(&B, i), lmem, Nx);
   }
+
+  AOfreePool(Pool);
+  FAfreeCbuf(&B);
+}
+
+static void
+FA_filtChan(int ich, void *Arg)
+
+{
+  const struct FA_AParg *A;
+  double *x;
+
+  A = (const struct FA_AParg *) Arg;
+  x = FA_CHAN(A->B, ich);
+  FIdFiltAP(&x[A->Ncof-1], x, A->Nx, A->h, A->Ncof);
 }
 
 static void
-FA_writeSubData(AFILE *AFp0, long int k, int Nsub, const double x[], int Nx)
+FA_writeSubData(AFILE *AFp0, long int k, int Nsub, const struct FA_cbuf *B,
+                int ist, int Nx)
 
 {
-  double xs[(NBUF+1)/2];   /* Only used for sub-sampling, i.e. when Nsub > 1 */
-  int i, ist, m;
+  int is, m;
 
-  ist = ICEILV(k, Nsub)*Nsub - k;
-  for (m = 0, i = ist; i < Nx; ++m, i += Nsub)
-    xs[m] = x[i];
-  AFdWriteData(AFp0, xs, m);
+  is = ICEILV(k, Nsub)*Nsub - k;
+  m = (is < Nx) ? ICEILV(Nx - is, Nsub) : 0;
+  FAwriteCbuf(AFp0, B, ist + is, m, Nsub);
 }
@@ -3,14 +3,20 @@
 
 Routine:
   void FAfiltFIR(AFILE *AFpI, AFILE *AFpO, long int NsampO, double h[],
-                 int Ncof, long int noffs)
+                 int Ncof, long int noffs, int Nthread)
 
 Purpose:
   Filter an audio file with an FIR filter
 
 Description:
   This routine convolves the data from the input audio file with an FIR filter
-  response.
+  response. For multichannel data, each channel is filtered separately with
+  its own filter memory. The channels can be filtered in parallel threads,
+  using a pool of threads that is created once for the file (see AOnewPool).
+
+  Filters with NCOF_FFT or more coefficients use FFT-based convolution
+  (FIdConvFFT), otherwise direct convolution (FIdConvol) is used. The two
+  methods give the same results to within round-off error.
 
 Parameters:
    -> AFILE *AFpI
@@ -18,17 +24,19 @@ Parameters:
    -> AFILE *AFpO
       Audio file pointer for the output audio file
    -> long int NsampO
-      Number of output samples to be calculated
+      Number of output samples (per channel) to be calculated
    -> double h[]
       Array of Ncof FIR filter coefficients
    -> int Ncof
       Number of filter coefficients
    -> long int noffs
       Data offset into the input data for the first output point
+   -> int Nthread
+      Maximum number of threads used to filter the channels
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.18 $  $Date: 2020/11/23 18:31:10 $
+  $Revision: 1.20 $  $Date: 2020/12/24 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -37,14 +45,30 @@ Author / revision:
 
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
 
+/* Arguments for filtering one channel */
+struct FA_FIRarg {
+  struct FA_cbuf *B;
+  const double *h;
+  int Ncof;
+  struct FI_convFFT **Conv;   /* FFT convolution, one per channel, or NULL */
+  int Nx;
+};
+
+static void
+FA_filtChan(int ich, void *Arg);
+static int
+FA_blkFFT(int Ncof);
+
 
 void
 FAfiltFIR(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[],
-          int Ncof, long int noffs)
+          int Ncof, long int noffs, int Nthread)
 
 {
-  double x[NBUF];
-  int lmem, Nxmax, Nx;
+  struct FA_cbuf B;
+  struct AO_pool *Pool;
+  struct FA_FIRarg A;
+  int lmem, ist, Nxmax, Nx, Nblk, i;
   long int n, k;
 
 /*
@@ -74,16 +98,41 @@ Batch processing:
     range by subtracting Nx from it and incrementing the batch number.
 
 Buffer allocation:
-  The buffer holds the filter memory (lmem) and the input data (Nx). The output
-  data overlay the input data.
+  For direct convolution, the buffer for each channel holds the filter memory
+  (lmem) and the input data (Nx). The output data overlay the input data.
+  For FFT convolution, the filter memory is kept by the convolution routine.
+  The buffer holds only the input data (Nx, a multiple of the block size).
 */
 
   lmem = Ncof - 1;
-  Nxmax = NBUF - lmem;
 
-/* Prime the array */
+  FAnewCbuf(&B, (int) AFpI->Nchan);
+  Pool = AOnewPool(MINV(Nthread, B.Nchan));
+  A.B = &B;
+  A.h = h;
+  A.Ncof = Ncof;
+  A.Conv = NULL;
+  if (Ncof >= NCOF_FFT) {
+    Nblk = FA_blkFFT(Ncof);
+    A.Conv = (struct FI_convFFT **)
+             UTmalloc(B.Nchan * sizeof(struct FI_convFFT *));
+    for (i = 0; i < B.Nchan; ++i)
+      A.Conv[i] = FIdAllocConvFFT(h, Ncof, Nblk);
+    ist = 0;
+    Nxmax = (NBUF / Nblk) * Nblk;
+  }
+  else {
+    ist = lmem;
+    Nxmax = NBUF - lmem;
+  }
+
+/* Prime the array (for FFT convolution, prime the filter memory) */
   n = noffs;
-  AFdReadData(AFpI, n - lmem, &x[0], lmem);
+  FAreadCbuf(AFpI, n - lmem, &B, 0, lmem);
+  if (A.Conv != NULL) {
+    A.Nx = lmem;
+    AOrunPool(Pool, FA_filtChan, &A, B.Nchan);
+  }
 
 /* Main processing loop */
   k = 0;
@@ -91,17 +140,59 @@ Buffer allocation:
 
 /* Read the input data into the input buffer */
     Nx = (int) MINV(Nxmax, NsampO - k);
-    AFdReadData(AFpI, n, &x[lmem], Nx);
+    FAreadCbuf(AFpI, n, &B, ist, Nx);
     n = n + Nx;
 
 /* Convolve the input samples with the filter response */
-    FIdConvol(x, x, Nx, h, Ncof);
+    A.Nx = Nx;
+    AOrunPool(Pool, FA_filtChan, &A, B.Nchan);
 
 /* Write the output data to the output audio file */
-    AFdWriteData(AFpO, x, Nx);
+    FAwriteCbuf(AFpO, &B, 0, Nx, 1);
     k = k + Nx;
 
 /* Update the filter memory */
-    VRdShift(x, lmem, Nx);
+    if (A.Conv == NULL) {
+      for (i = 0; i < B.Nchan; ++i)
+        VRdShift(FA_CHAN(&B, i), lmem, Nx);
+    }
   }
+
+  if (A.Conv != NULL) {
+    for (i = 0; i < B.Nchan; ++i)
+      FIdFreeConvFFT(A.Conv[i]);
+    UTfree(A.Conv);
+  }
+  AOfreePool(Pool);
+  FAfreeCbuf(&B);
+}
+
+static void
+FA_filtChan(int ich, void *Arg)
+
+{
+  const struct FA_FIRarg *A;
+  double *x;
+
+  A = (const struct FA_FIRarg *) Arg;
+  x = FA_CHAN(A->B, ich);
+  if (A->Conv != NULL)
+    FIdConvFFT(A->Conv[ich], x, x, A->Nx);
+  else
+    FIdConvol(x, x, A->Nx, A->h, A->Ncof);
+}
+
+/* FFT block size: filter length rounded up to a power of 2, within limits */
+
+static int
+FA_blkFFT(int Ncof)
+
+{
+  int Nblk;
+
+  Nblk = NBLK_FFTMIN;
+  while (Nblk < Ncof && Nblk < NBLK_FFTMAX)
+    Nblk = 2 * Nblk;
+
+  return Nblk;
 }
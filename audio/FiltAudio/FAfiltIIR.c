@@ -9,8 +9,11 @@ Purpose:
   Filter an audio file with an IIR filter
 
 Description:
-  This routine convolves the data from the input audio file with an IIR filter
-  response.
+  This routine filters the data from the input audio file with an IIR filter
+  (cascade of biquadratic sections). For multichannel data, each channel is
+  filtered separately with its own filter memory. The channels are processed
+  together, with the interleaved data from the file filtered directly by
+  FIdCascIIR (the calculations are vectorized across the channels).
 
 Parameters:
    -> AFILE *AFpI
@@ -18,7 +21,7 @@ Parameters:
    -> AFILE *AFpO
       Audio file pointer for the output audio file
    -> long int NsampO
-      Number of output samples to be calculated
+      Number of output samples (per channel) to be calculated
    -> const double h[][5]
       Array of Nsec IIR filter sections
    -> int Nsec
@@ -30,7 +33,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.20 $  $Date: 2020/11/23 18:31:10 $
+  $Revision: 1.21 $  $Date: 2020/12/12 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -42,7 +45,8 @@ Author / revision:
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
 
 static void
-FA_writeSubData(AFILE *AFp0, long int k, int Nsub, const double x[], int Nx);
+FA_writeSubData(AFILE *AFp0, long int k, int Nsub, double x[], int Nchan,
+                int Nx);
 
 
 void
@@ -50,8 +54,9 @@ FAfiltIIR(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[][5],
           int Nsec, int Nsub, long int noffs)
 
 {
-  double x[NBUF];
-  int lmem, Nxmax, Nx;
+  struct FI_cascIIR *Filt;
+  double *x;
+  int Nchan, Nx;
   long int n, k, NyO;
 
 /*
@@ -67,69 +72,71 @@ Batch processing:
       x(j,n') = d(noffs+j*Nx+n'), for 0 <= n' < Nx,
   - The k'th output point y(k) is calculated at position d(noffs+k) - the start
     of the impulse response, h(0), is aligned with d(noffs+k).
-      y(k) --> h[0] <==> d(n),    where l=loffs+k
-               h[0] <==> x(j,n').
   - For batch j=0,
       n = noffs  - pointer to d(noffs),
       n' = 0     - pointer to x(0,0) = d(noffs),
       k = 0      - pointer to y(0).
-  - For each batch, k and n' advance by Nx,
-      k <- k + Nx,
-      n' <- n' + Nx.
-  - When the index n' for x(j,n') advances beyond Nx, we bring n' back into
-    range by subtracting Nx from it and incrementing the batch number,
+  - For each batch, k and n' advance by Nx.
 
 Buffer allocation:
-  The buffer holds the filter memory (lmem) and the input data (Nx). The output
-  output data overlay the input data.
+  The buffer holds NBUF frames of interleaved data. The filter memory is kept
+  in the filter structure. The output data overlay the input data.
 */
 
-  lmem = 2 * (Nsec + 1);
-  Nxmax = NBUF - lmem;
+  Nchan = (int) AFpI->Nchan;
   NyO = (NsampO - 1) * Nsub + 1;
+  Filt = FIdAllocCascIIR(h, Nsec, Nchan);
+  x = (double *) UTmalloc(Nchan * NBUF * sizeof (double));
 
 /* Main processing loop */
   /* if (n < noffs), processing warm-up points, no output */
-  VRdZero(x, lmem);
   n = MINV(noffs, MAXV(0, noffs - MAXWUP));
   k = 0;
   while (k < NyO) {
 
 /* Read the input data into the input buffer */
     if (n < noffs)
-      Nx = (int) MINV(Nxmax, noffs - n);
+      Nx = (int) MINV(NBUF, noffs - n);
     else
-      Nx = (int) MINV(Nxmax, NyO - k);
-    AFdReadData(AFpI, n, &x[lmem], Nx);
+      Nx = (int) MINV(NBUF, NyO - k);
+    AFdReadData(AFpI, n * Nchan, x, Nx * Nchan);
 
-/* Convolve the input samples with the filter response */
-    FIdFiltIIR(&x[lmem-2], x, Nx, h, Nsec);
+/* Filter the input samples, all channels together */
+    FIdCascIIR(Filt, x, x, Nx);
 
 /* Write the output data to the output audio file */
     if (n >= noffs) {
       if (Nsub == 1)
-        AFdWriteData(AFpO, &x[2], Nx);
+        AFdWriteData(AFpO, x, Nx * Nchan);
       else
-        FA_writeSubData(AFpO, k, Nsub, &x[2], Nx);
+        FA_writeSubData(AFpO, k, Nsub, x, Nchan, Nx);
       k = k + Nx;
     }
     n = n + Nx;
-
-/* Update the filter memory */
-    VRdShift(x, lmem, Nx);
   }
+
+  UTfree(x);
+  FIdFreeCascIIR(Filt);
 }
-
+
+/* Write every Nsub'th frame, starting at the first output sample position
+   that is a multiple of Nsub */
+
+
 static void
-FA_writeSubData(AFILE *AFp0, long int k, int Nsub, const double x[], int Nx)
+FA_writeSubData(AFILE *AFp0, long int k, int Nsub, double x[], int Nchan,
+                int Nx)
 
 {
-  double xs[(NBUF+1)/2];  /* Only used for sub-sampling, i.e. when Nsub > 1 */
-  int i, ist, m;
+  int is, m, i, j;
+
+  is = (int) (ICEILV(k, Nsub)*Nsub - k);
+  m = (is < Nx) ? ICEILV(Nx - is, Nsub) : 0;
 
-  ist = ICEILV(k, Nsub)*Nsub - k;
-  for (m = 0, i = ist; i < Nx; ++m, i += Nsub) {
-    xs[m] = x[i];
+  /* Move the frames together (in place) */
+  for (j = 0; j < m; ++j) {
+    for (i = 0; i < Nchan; ++i)
+      x[j*Nchan + i] = x[(is + j*Nsub)*Nchan + i];
   }
-  AFdWriteData(AFp0, xs, m);
+  AFdWriteData(AFp0, x, m * Nchan);
 }
@@ -3,7 +3,7 @@
 
 Routine:
   void FAfiltSI(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[],
-                int Ncof, int Nsub, int Ir, long int moffs)
+                int Ncof, int Nsub, int Ir, long int moffs, int Nthread)
 
 Purpose:
   Filter an audio file with an FIR filter (sample rate change)
@@ -13,7 +13,10 @@ Description:
   Conceptually Ir-1 zeros are inserted between each sample from the input audio
   file to form this rate-increased data sequence. The filtered output is
   subsampled by a factor Nsub - only every Nsub'th output sample is calculated
-  and stored into the output audio file.
+  and stored into the output audio file. For multichannel data, each channel is
+  filtered separately with its own filter memory. The channels can be filtered
+  in parallel threads, using a pool of threads that is created once for the
+  file (see AOnewPool).
 
 Parameters:
    -> AFILE *AFpI
@@ -21,7 +24,7 @@ Parameters:
    -> AFILE *AFpO
       Audio file pointer for the output audio file
    -> long int NsampO
-      Number of output samples to be calculated
+      Number of output samples (per channel) to be calculated
    -> const double h[]
       Array of Ncof FIR filter coefficients
    -> int Ncof
@@ -32,10 +35,12 @@ Parameters:
       Interpolation factor
    -> long int moffs
       Data offset into the rate-increased data for the first output point
+   -> int Nthread
+      Maximum number of threads used to filter the channels
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.24 $  $Date: 2020/11/23 18:31:11 $
+  $Revision: 1.25 $  $Date: 2020/12/24 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -46,14 +51,32 @@ Author / revision:
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
 #define ICEILV(n, m)  (((n) + ((m) - 1)) / (m)) /* int n>=0, int m>0 */
 
+/* Arguments for filtering one channel */
+struct FA_SIarg {
+  struct FA_cbuf *B;
+  const double *h;
+  int Ncof;
+  int Nsub;
+  int Ir;
+  int np;       /* Offset of the filter memory for the first output */
+  int mrn;      /* Filter phase for the first output */
+  int Ny;       /* Number of output values */
+  int ioffs;    /* Offset of the output values */
+};
+
+static void
+FA_filtChan(int ich, void *Arg);
+
 
 void
 FAfiltSI(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[],
-         int Ncof, int Nsub, int Ir, long int moffs)
+         int Ncof, int Nsub, int Ir, long int moffs, int Nthread)
 
 {
-  double Fbuf[NBUF];
-  double *xmem, *x, *y;
+  struct FA_cbuf B;
+  struct AO_pool *Pool;
+  struct FA_SIarg A;
+  int i;
   long int lmem, Nb;
   long int Nxmax, Nymax, Nx, Ny;
   long int noffs;
@@ -137,7 +160,7 @@ Last frame:
     Nx = ceil(((Ny-1)*Nsub+m'+1) / Ir)
 
 Buffer Allocation:
-  The allocated buffer will contain the filter memory (length lmem), and has
+  The allocated buffer for each channel will contain the filter memory (length lmem), and has
   room for Nxmax input samples and Nymax output samples. Let the buffer size be
   Nb,
     Nxmax + Nymax <= Nb
@@ -192,10 +215,15 @@ Buffer Allocation:
   Nymax = ICEILV(Nxmax*IR, NSUB);
   assert(Nxmax + Nymax <= Nb);
 
-  /* Set up the buffer pointers */
-  xmem = Fbuf;
-  x = xmem + lmem;
-  y = x + Nxmax;
+  /* Set up the buffers, xmem at offset 0, x at lmem, y at lmem+Nxmax */
+  FAnewCbuf(&B, (int) AFpI->Nchan);
+  Pool = AOnewPool(MINV(Nthread, B.Nchan));
+  A.B = &B;
+  A.h = h;
+  A.Ncof = Ncof;
+  A.Nsub = Nsub;
+  A.Ir = Ir;
+  A.ioffs = (int) (lmem + Nxmax);
 
 /* Initialization */
   noffs = moffs / IR;       /* calculate noffs, mro => moffs = noffs*IR + m */
@@ -207,7 +235,7 @@ Buffer Allocation:
 
 /* Prime the input data array with the filter memory */
   n = noffs;
-  AFdReadData(AFpI, n - lmem, xmem, (int) lmem);
+  FAreadCbuf(AFpI, n - lmem, &B, 0, (int) lmem);
 
 /* Main processing loop */
   k = 0;
@@ -224,7 +252,7 @@ Buffer Allocation:
    assert( Ny >= 0 && Ny <= Nymax);
 
 /* Read the input data into the input buffer */
-    AFdReadData(AFpI, n, x, (int) Nx);
+    FAreadCbuf(AFpI, n, &B, (int) lmem, (int) Nx);
     n = n + Nx;
 
 /* Set up the filter offset */
@@ -232,20 +260,41 @@ Buffer Allocation:
     mrn = mp - np*IR;
 
 /* Convolve the input samples with the filter response */
-/* &xmem[np] = &x[np-lmem] */
-    FIdConvSI(&xmem[np], y, (int) Ny, h, Ncof, (int) mrn, Nsub, Ir);
+    A.np = (int) np;
+    A.mrn = (int) mrn;
+    A.Ny = (int) Ny;
+    AOrunPool(Pool, FA_filtChan, &A, B.Nchan);
 
 /* Write the output buffer to the output audio file */
-    AFdWriteData(AFpO, y, (int) Ny);
+    FAwriteCbuf(AFpO, &B, A.ioffs, (int) Ny, 1);
     k = k + Ny;
     if (k == NsampO)
       break;
 
 /* Update the filter memory */
-    VRdShift(xmem, (int) lmem, (int) Nxmax);
+    for (i = 0; i < B.Nchan; ++i)
+      VRdShift(FA_CHAN(&B, i), (int) lmem, (int) Nxmax);
 
 /* Update the pointer mp */
     mp = mp + Ny*NSUB - Nxmax*IR;
     assert(mp >= 0 && mp < NSUB);
   }
+
+  AOfreePool(Pool);
+  FAfreeCbuf(&B);
+}
+
+static void
+FA_filtChan(int ich, void *Arg)
+
+{
+  const struct FA_SIarg *A;
+  double *xmem;
+
+  A = (const struct FA_SIarg *) Arg;
+  xmem = FA_CHAN(A->B, ich);
+
+/* &xmem[np] = &x[np-lmem] */
+  FIdConvSI(&xmem[A->np], &xmem[A->ioffs], A->Ny, A->h, A->Ncof, A->mrn,
+            A->Nsub, A->Ir);
 }
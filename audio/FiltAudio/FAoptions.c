@@ -42,6 +42,7 @@ static const char *OptTable[] = {
   "-f#", "--f*ilter_file=",
   "-i#", "--int*erpolate=",
   "-a#", "--a*lignment=",
+  "-j#", "--th*reads=",
   NULL
 };
 
@@ -124,6 +125,12 @@ FAoptions(int argc, const char *argv[], struct FA_FIpar *FI,
       if (STdec1long(OptArg, &FF->Doffs))
         ERRSTOP(FAM_BadAlign, OptArg);
       break;
+    case 7:
+    case 8:
+      /* Number of threads */
+      if (STdec1int(OptArg, &FF->Nthread) || FF->Nthread <= 0)
+        ERRSTOP(FAM_BadNthread, OptArg);
+      break;
     default:
       assert(0);
       break;
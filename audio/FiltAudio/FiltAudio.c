@@ -5,7 +5,7 @@ Routine:
   FiltAudio [options] -f FilterFile AFileI AFileO
 
 Purpose:
-  Filter data from a single channel audio file
+  Filter data from an audio file
 
 Description:
   This program takes an audio file and a filter coefficient file as input and
@@ -13,6 +13,10 @@ Description:
   can be optionally specified. This program supports three types of filters,
   FIR, all-pole, and general IIR. Filters are specified in filter files.
 
+  For multichannel input files, the same filter is applied to each channel
+  separately. The channels are processed in a single pass over the input file.
+  Optionally, the channels can be filtered in parallel threads.
+
   Filter Files:
   The first record of a filter file indicates the type of filter.
     !FIR  - FIR filter, direct form
@@ -29,6 +33,9 @@ Description:
            N-1       -i
     H(z) = SUM h[i] z    .
            i=0
+  Long FIR filters (64 or more coefficients) without a sample rate change are
+  implemented using FFT-based convolution. The results are the same as for
+  direct convolution, to within round-off error.
 
   IIR filters are implemented as the cascade of biquadratic filter sections,
   where each section has a z-transform,
@@ -95,8 +102,7 @@ Options:
       The environment variable AUDIOPATH specifies a list of directories to be
       searched for the input audio file. Specifying "-" as the input file
       indicates that input is from standard input (use the "-t" option to
-      specify the format of the input data). The input file must have a single
-      channel.
+      specify the format of the input data).
   Output file name, AFileO:
       The second file name is the output file. Specifying "-" as the output file
       name indicates that output is to be written to standard output. If the
@@ -124,6 +130,11 @@ Options:
   -n NSAMPLE, --number_samples=NSAMPLE
       Number of samples (per channel) for the output file. If not specified, the
       number of samples is set as described above.
+  -j NTHREAD, --threads=NTHREAD
+      Number of threads used to filter the channels of a multichannel file,
+      default 1. Each channel is filtered by one thread; there is no benefit in
+      specifying more threads than channels. IIR filters process all of the
+      channels together (vectorized across channels) and do not use threads.
   -F FTYPE, --file-type=FTYPE
       Output file type. If this option is not specified, the file type is
       determined by the output file name extension.
@@ -135,6 +146,7 @@ Options:
                                    format.
         "WAVE-NOEX" or "wave-noex" - WAVE file; do not use the WAVE file
                                    extensible format
+        "Wave64" or "wave64"     - Wave64 file (64-bit sizes)
         "AIFF-C" or "aiff-c"     - AIFF-C sound file
         "AIFF-C/sowt" or "aiff-c/sowt" - AIFF-C (byte-swapped data)
         "AIFF" or "aiff"         - AIFF sound file
@@ -143,6 +155,21 @@ Options:
         "noheader-big-endian"    - Headerless file (big-endian byte order)
         "noheader-little-endian" - Headerless file (little-endian byte order)
         "text-audio"             - Text audio file (with header)
+  --stats
+      Print data transfer statistics for the audio files when they are closed
+      (requests, bytes, read/write calls, seeks and times), and the time for
+      the filtering stage.
+  --mmap
+      Map the data of random access input files into memory, instead of
+      reading it with stdio calls. Files which cannot be mapped are read as
+      usual.
+  --async=N
+      Transfer the audio file data in a separate thread for each file, using
+      N buffer blocks. This lets the file reads and writes overlap the
+      processing. The default (0) transfers the data in the program thread.
+  --lazy-info
+      Defer decoding the information records (LIST/INFO, bext and DISP
+      chunks) of random access WAVE input files until they are used.
   -h, --help
       Print a list of options and exit.
   -v, --version
@@ -197,7 +224,8 @@ main(int argc, const char *argv[])
   FILE *fpinfo;
   int FiltType, Ncof, Nsec, DoffsFlag;
   long int Nsamp, Nchan, NframeI;
-  double SfreqI;
+  double SfreqI, T;
+  AFILE *AFpS[2];
   double h[MAXCOF];
 
 /* Get the input parameters */
@@ -213,8 +241,6 @@ main(int argc, const char *argv[])
   AOsetFIopt(&FI, 0, 0);       /* Nsamp must be known */
   FLpathList(FI.Fname, AFPATH_ENV, FI.Fname);
   AFpI = AFopnRead(FI.Fname, &Nsamp, &Nchan, &SfreqI, fpinfo);
-  if (Nchan != 1)
-    UThalt("%s: %s", PROGRAM, FAM_XNchan);
   AFpI->ScaleF *= FI.Gain;  /* Gain absorbed into scaling factor */
 
 /* Default number of output samples */
@@ -269,16 +295,18 @@ main(int argc, const char *argv[])
 /* Open the output audio file */
   if (strcmp(FO.Fname, "-") != 0)
     FLbackup(FO.Fname);
-  AFpO = AFopnWrite(FO.Fname, FO.FtypeW, FO.DFormat.Format, 1L, FO.Sfreq,
+  AFpO = AFopnWrite(FO.Fname, FO.FtypeW, FO.DFormat.Format, Nchan, FO.Sfreq,
                     fpinfo);
 
 /* Filtering */
+  T = UTclock();
   switch (FiltType) {
     case FI_FIR:
       if (FF.Nsub == 1 && FF.Ir == 1)
-        FAfiltFIR(AFpI, AFpO, FO.Nframe, h, Ncof, FF.Doffs);
+        FAfiltFIR(AFpI, AFpO, FO.Nframe, h, Ncof, FF.Doffs, FF.Nthread);
       else
-        FAfiltSI(AFpI, AFpO, FO.Nframe, h, Ncof, FF.Nsub, FF.Ir, FF.Doffs);
+        FAfiltSI(AFpI, AFpO, FO.Nframe, h, Ncof, FF.Nsub, FF.Ir, FF.Doffs,
+                 FF.Nthread);
       break;
     case FI_IIR:
       Nsec = Ncof / 5;
@@ -286,12 +314,16 @@ main(int argc, const char *argv[])
                 FF.Nsub, FF.Doffs);
       break;
     case FI_ALL:
-      FAfiltAP(AFpI, AFpO, FO.Nframe, h, Ncof, FF.Nsub, FF.Doffs);
+      FAfiltAP(AFpI, AFpO, FO.Nframe, h, Ncof, FF.Nsub, FF.Doffs,
+               FF.Nthread);
       break;
     default:
       UThalt("%s: %s", PROGRAM, FAM_BadFiltType);
      break;
   }
+  AFpS[0] = AFpI;
+  AFpS[1] = AFpO;
+  AOprStage(FAM_StageFilt, UTclock() - T, AFpS, 2);
 
 /* Close the audio files */
   AFclose(AFpI);
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.80 $  $Date: 2020/11/30 12:32:12 $
+  $Revision: 1.85 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -31,6 +31,12 @@ Author / revision:
 #define NBUF        5120            /* Buffer size for filter memory, data */
 #define DOFFS_UNDEF LONG_MIN        /* Undefined data offset */
 
+/* FIR filters with at least NCOF_FFT coefficients use FFT convolution. The
+   crossover and the block size limits are from timing measurements. */
+#define NCOF_FFT    64
+#define NBLK_FFTMIN 256
+#define NBLK_FFTMAX 2048
+
 #define FA_LIM_UNDEF  AO_LIM_UNDEF  /* Undefined Limits */
 #define FA_FIpar      AO_FIpar      /* Input file structure */
 #define FA_FOpar      AO_FOpar      /* Output file structure */
@@ -40,30 +46,41 @@ struct FA_FFpar {
   int Ir;
   int Nsub;
   long int Doffs;
+  int Nthread;
 };
 
 #define FFpar_INIT(p) { \
   (p)->Fname[0] = '\0'; \
   (p)->Ir = 1; \
   (p)->Nsub = 1; \
-  (p)->Doffs = DOFFS_UNDEF; }
+  (p)->Doffs = DOFFS_UNDEF; \
+  (p)->Nthread = 1; }
+
+/* Multichannel data buffer, NBUF values for each channel */
+struct FA_cbuf {
+  int Nchan;
+  double *x;      /* Channel buffers, channel i at x[i*NBUF] */
+  double *xi;     /* Interleaved data, NBUF frames */
+};
+#define FA_CHAN(B, i)   (&(B)->x[(i)*NBUF])
 
 /* Error messages */
 #define FAM_APNoInt     "Interpolation not supported for all-pole filters"
 #define FAM_BadAlign    "Invalid alignment offset"
 #define FAM_BadFiltType "Invalid filter type"
 #define FAM_BadRatio    "Invalid interpolation ratio"
+#define FAM_BadNthread  "Invalid number of threads"
 #define FAM_BadSFreqRatio \
   "Incompatible sampling frequency and interpolation ratio"
 #define FAM_IIRNoInt    "Interpolation not supported for IIR filters"
 #define FAM_MFName      "Too few filenames specified"
 #define FAM_NoCoef      "No coeffients specified"
 #define FAM_NoFFile     "No filter file specified"
+#define FAM_StageFilt   "Filtering"
 #define FAM_XFName      "Too many filenames specified"
 #define FAM_XIIRSect    "Too many filter sections"
 #define FAM_XNcof       "Too many filter coefficients"
 #define FAM_XNcofIr     "No. coefficients and/or interpolation ratio too large"
-#define FAM_XNchan      "Multiple input channels not supported"
 
 /* Usage */
 #define FAMF_Usage "\
@@ -73,16 +90,21 @@ Options:\n\
   -i IR/NSUB, --interpolate=IR/NSUB  Interpolation ratio.\n\
   -a OFFS, --alignment=OFFS   Offset for first output.\n\
   -n NSAMPLE, --number_samples=NSAMPLE  Number of output samples.\n\
+  -j NTHREAD, --threads=NTHREAD  Number of threads for filtering channels.\n\
   -g GAIN, --gain=GAIN        Gain factor for the input file.\n\
   -F FTYPE, --file-type=FTYPE  Output file type,\n\
                               \"AU\", \"WAVE\", \"WAVE-NOEX\", \"AIFF\",\n\
-                              \"AIFF-C\", \"AIFF-C/sowt\", \"noheader\",\n\
-                              \"noheader-swap\", \"text-audio\".\n\
+                              \"AIFF-C\", \"AIFF-C/sowt\", \"Wave64\",\n\
+                              \"noheader\", \"noheader-swap\", \"text-audio\".\n\
   -D DFORMAT, --data-format=DFORMAT  Data format for the output file,\n\
                               \"mu-law8\", \"mu-lawR8\", \"A-law8\", \"unsigned8\",\n\
                               \"integer8\", \"integer16\", \"integer24\",\n\
                               \"float32\", \"float64\", \"text16\", \"text\".\n\
   -I INFO, --info=INFO        Add a header information record.\n\
+  --stats                     Print data transfer statistics.\n\
+  --mmap                      Map the input file data into memory.\n\
+  --async=N                   Transfer the file data in the background.\n\
+  --lazy-info                 Decode WAVE information records on use.\n\
   -h, --help                  Print a list of options and exit.\n\
   -v, --version               Print the version number and exit.\n\
    Additional options [-t -P -S], see CopyAudio."
@@ -94,16 +116,24 @@ extern "C" {
 /* Prototypes */
 void
 FAfiltAP(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[],
-         int Ncof, int Nsub, long int noffs);
+         int Ncof, int Nsub, long int noffs, int Nthread);
 void
 FAfiltFIR(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[],
-          int Ncof, long int noffs);
+          int Ncof, long int noffs, int Nthread);
 void
 FAfiltIIR(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[][5],
           int Nsec, int Nsub, long int noffs);
 void
 FAfiltSI(AFILE *AFpI, AFILE *AFpO, long int NsampO, const double h[],
-         int Ncof, int Nsub, int Ir, long int moffs);
+         int Ncof, int Nsub, int Ir, long int moffs, int Nthread);
+void
+FAfreeCbuf(struct FA_cbuf *B);
+void
+FAnewCbuf(struct FA_cbuf *B, int Nchan);
+void
+FAreadCbuf(AFILE *AFpI, long int n, struct FA_cbuf *B, int ist, int Nx);
+void
+FAwriteCbuf(AFILE *AFpO, const struct FA_cbuf *B, int ist, int Ny, int Nstep);
 void
 FAoptions(int argc, const char *argv[], struct FA_FIpar *FI,
           struct FA_FFpar *FF, struct FA_FOpar *FO);
@@ -3,7 +3,7 @@
 
 Routine:
   void GNoptions(int argc, const char *argv[], double *rms, int *seed,
-                 struct GN_FOpar *FO)
+                 int *Nchan, int *Nthread, struct GN_FOpar *FO)
 
 Purpose:
   Decode options for GenNoise
@@ -20,12 +20,16 @@ Parameters:
       Standard deviation for the noise samples, default 0.03
   <-  int *seed
       Seed for the random number generator, default 0
+  <-  int *Nchan
+      Number of output channels, default 1
+  <-  int *Nthread
+      Number of threads, default 1
   <-  struct GN_FOpar *FO
       Output file parameters
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.38 $  $Date: 2020/11/23 18:31:18 $
+  $Revision: 1.39 $  $Date: 2020/12/14 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -42,19 +46,21 @@ Author / revision:
 static const char *OptTable[] = {
   "-d#", "--st*d_deviation=",
   "-x#", "--se*ed=",
+  "-c#", "--ch*annels=",
+  "-j#", "--th*reads=",
   NULL
 };
 
 
 void
-GNoptions(int argc, const char *argv[], double *rms, int *seed,
-          struct GN_FOpar *FO)
+GNoptions(int argc, const char *argv[], double *rms, int *seed, int *Nchan,
+          int *Nthread, struct GN_FOpar *FO)
 
 {
   const char *OptArg;
   int nF, n;
   double rmsx, Nv, Dv;
-  int seedx;
+  int seedx, Nchanx, Nthreadx;
 
 /* Output file defaults */
   FOpar_INIT(FO);
@@ -63,6 +69,8 @@ GNoptions(int argc, const char *argv[], double *rms, int *seed,
 /* Defaults */
   rmsx = RMS_DEFAULT;
   seedx = 0;
+  Nchanx = 1;
+  Nthreadx = 1;
 
 /* Initialization */
   UTsetProg(PROGRAM);
@@ -111,6 +119,18 @@ GNoptions(int argc, const char *argv[], double *rms, int *seed,
       if (STdec1int(OptArg, &seedx) || seedx < 0)
         ERRSTOP(GNM_BadSeed, OptArg);
       break;
+    case 5:
+    case 6:
+      /* Number of channels */
+      if (STdec1int(OptArg, &Nchanx) || Nchanx <= 0)
+        ERRSTOP(GNM_BadNchan, OptArg);
+      break;
+    case 7:
+    case 8:
+      /* Number of threads */
+      if (STdec1int(OptArg, &Nthreadx) || Nthreadx <= 0)
+        ERRSTOP(GNM_BadNthread, OptArg);
+      break;
     default:
       assert(0);
       break;
@@ -126,4 +146,6 @@ GNoptions(int argc, const char *argv[], double *rms, int *seed,
 /* Set return values */
   *rms = rmsx;
   *seed = seedx;
+  *Nchan = Nchanx;
+  *Nthread = Nthreadx;
 }
@@ -12,7 +12,12 @@ Description:
   These white noise samples are written to an audio file. Each invocation of
   this program generates a different random sequence unless the random number
   generator seed is specified. Options are available to specify the number of
-  samples, the sampling frequency and the data format of the output file.
+  samples, the number of channels, the sampling frequency and the data format
+  of the output file.
+
+  Each channel uses its own stream of pseudo-random values (see MSallocRandGen).
+  The noise in different channels is uncorrelated. For a given seed, the output
+  file is the same regardless of the number of threads used.
 
 Options:
   Output file name, AFile:
@@ -34,7 +39,16 @@ Options:
       Integer-valued seed for the random number generator, default from the
       current time.
   -n NSAMPLE, --number_samples=NSAMPLE
-      Number of output samples to be generated.
+      Number of output samples (per channel) to be generated.
+  -c NCHAN, --channels=NCHAN
+      Number of output channels, default 1.
+  -j NTHREAD, --threads=NTHREAD
+      Number of threads used to generate the noise for the channels, default 1.
+      The threads are started once. For each block of samples, each thread
+      takes the next channel not yet generated. There is no benefit in
+      specifying more threads than channels. Threads are not available for
+      all systems (e.g. builds with MSVC); the channels are then generated in
+      turn.
   -s SFREQ, --srate=SFREQ
       Sampling frequency for the output audio file, default 8000.
   -F FTYPE, --file-type=FTYPE
@@ -48,6 +62,7 @@ Options:
                                    format.
         "WAVE-NOEX" or "wave-noex" - WAVE file; do not use the WAVE file
                                    extensible format
+        "Wave64" or "wave64"     - Wave64 file (64-bit sizes)
         "AIFF-C" or "aiff-c"     - AIFF-C sound file
         "AIFF-C/sowt" or "aiff-c/sowt" - AIFF-C (byte-swapped data)
         "AIFF" or "aiff"         - AIFF sound file
@@ -72,6 +87,13 @@ Options:
         "text"      - text data, scaled the same as float/double data
   -I INFO, --info=INFO
       Add an information record to the output audio file.
+  --stats
+      Print data transfer statistics for the audio files when they are closed
+      (requests, bytes, read/write calls, seeks and times).
+  --async=N
+      Transfer the audio file data in a separate thread for each file, using
+      N buffer blocks. This lets the file reads and writes overlap the
+      processing. The default (0) transfers the data in the program thread.
   -h, --help
       Print a list of options and exit.
   -v, --version
@@ -98,7 +120,18 @@ Author / version:
 #include "GenNoise.h"
 
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
-#define MAXBUF  5120
+#define NBUF  5120
+
+/* Per-channel generation: channel ich is generated into y[ich*NBUF] */
+struct GN_noiseArg {
+  struct MS_randGen *Gen;
+  double *y;
+  int n;
+  double rms;
+};
+
+static void
+GN_genChan(int ich, void *Arg);
 
 
 int
@@ -106,15 +139,17 @@ main(int argc, const char *argv[])
 
 {
   struct GN_FOpar FO;
+  struct GN_noiseArg A;
+  struct AO_pool *Pool;
   AFILE *AFp;
   FILE *fpinfo;
-  int i, n, seed;
+  int i, j, n, seed, Nchan, Nthread;
   long int k;
   double rms;
-  double x[MAXBUF];
+  double *x;
 
 /* Get the input parameters */
-  GNoptions(argc, argv, &rms, &seed, &FO);
+  GNoptions(argc, argv, &rms, &seed, &Nchan, &Nthread, &FO);
 
 /* If output is to stdout, use stderr for informational messages */
   if (strcmp(FO.Fname, "-") == 0)
@@ -127,22 +162,52 @@ main(int argc, const char *argv[])
   AOsetFOopt(&FO);
   if (strcmp(FO.Fname, "-") != 0)
     FLbackup(FO.Fname);
-  AFp = AFopnWrite(FO.Fname, FO.FtypeW, FO.DFormat.Format, 1L, FO.Sfreq,
-                   fpinfo);
-
-/* Generate the noise samples */
-  MSrandSeed(seed);
+  AFp = AFopnWrite(FO.Fname, FO.FtypeW, FO.DFormat.Format, (long int) Nchan,
+                   FO.Sfreq, fpinfo);
+
+/* Generate the noise samples, one stream per channel */
+  A.Gen = MSallocRandGen(seed, Nchan);
+  A.rms = rms;
+  x = (double *) UTmalloc(Nchan * NBUF * sizeof(double));
+  A.y = (Nchan > 1) ? (double *) UTmalloc(Nchan * NBUF * sizeof(double)) : x;
+  Pool = AOnewPool(MINV(Nthread, Nchan));
   k = 0;
   while (k < FO.Nframe) {
-    n = (int) MINV(FO.Nframe - k, MAXBUF);
-    for (i = 0; i < n; ++i)
-      x[i] = MSfGaussRand(rms);
+    n = (int) MINV(FO.Nframe - k, NBUF);
+    A.n = n;
+    AOrunPool(Pool, GN_genChan, &A, Nchan);
+
+    /* Interleave the channels */
+    if (Nchan > 1) {
+      for (j = 0; j < Nchan; ++j) {
+        for (i = 0; i < n; ++i)
+          x[i*Nchan+j] = A.y[j*NBUF+i];
+      }
+    }
     k += n;
-    AFdWriteData(AFp, x, n);
+    AFdWriteData(AFp, x, n * Nchan);
   }
 
 /* Close the audio file */
   AFclose(AFp);
+  AOfreePool(Pool);
+  if (A.y != x)
+    UTfree(A.y);
+  UTfree(x);
+  MSfreeRandGen(A.Gen);
 
   return EXIT_SUCCESS;
 }
+
+/* Generate the noise samples for one channel */
+
+
+static void
+GN_genChan(int ich, void *Arg)
+
+{
+  const struct GN_noiseArg *A;
+
+  A = (const struct GN_noiseArg *) Arg;
+  MSdRandGauss(A->Gen, ich, &A->y[ich*NBUF], A->n, A->rms);
+}
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.48 $  $Date: 2020/11/30 12:32:20 $
+  $Revision: 1.51 $  $Date: 2020/12/23 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -27,6 +27,8 @@ Author / revision:
 #define GN_FOpar  AO_FOpar  /* Output file structure */
 
 /* Error messages */
+#define GNM_BadNchan "Invalid number of channels"
+#define GNM_BadNthread "Invalid number of threads"
 #define GNM_BadSeed "Invalid seed value"
 #define GNM_BadStdDev "Invalid standard deviation"
 #define GNM_XFName  "Too many filenames specified"
@@ -40,16 +42,20 @@ Options:\n\
   -n NSAMPLE, --number_samples=NSAMPLE  Number of output samples.\n\
   -d SDEV, --std_deviation=SDEV  Standard deviation of the noise samples.\n\
   -x SEED, --seed=SEED        Seed for the random number generator.\n\
+  -c NCHAN, --channels=NCHAN  Number of output channels.\n\
+  -j NTHREAD, --threads=NTHREAD  Number of threads for generating channels.\n\
   -s SFREQ, --srate=SFREQ     Sampling frequency for the output file.\n\
   -F FTYPE, --file-type=FTYPE  Output file type,\n\
                               \"AU\", \"WAVE\", \"WAVE-NOEX\", \"AIFF\",\n\
-                              \"AIFF-C\", \"AIFF-C/sowt\", \"noheader\",\n\
-                              \"noheader-swap\", \"text-audio\".\n\
+                              \"AIFF-C\", \"AIFF-C/sowt\", \"Wave64\",\n\
+                              \"noheader\", \"noheader-swap\", \"text-audio\".\n\
   -D DFORMAT, --data-format=DFORMAT  Data format for the output file,\n\
                               \"mu-law8\", \"mu-lawR8\", \"A-law8\", \"unsigned8\",\n\
                               \"integer8\", \"integer16\", \"integer24\",\n\
                               \"float32\", \"float64\", \"text16\", \"text\".\n\
   -I INFO, --info=INFO        Add a header information record.\n\
+  --stats                     Print data transfer statistics.\n\
+  --async=N                   Transfer the file data in the background.\n\
   -h, --help                  Print a list of options and exit.\n\
   -v, --version               Print the version number and exit."
 
@@ -59,8 +65,8 @@ extern "C" {
 
 /* Prototypes */
 void
-GNoptions(int argc, const char *argv[], double *rms, int *seed,
-          struct GN_FOpar *FO);
+GNoptions(int argc, const char *argv[], double *rms, int *seed, int *Nchan,
+          int *Nthread, struct GN_FOpar *FO);
 
 #ifdef __cplusplus
 }
@@ -2,33 +2,37 @@
                            McGill University
 
 Routine:
-  void GToptions(int argc, const char *argv[], struct FT_Sine *Sine,
+  void GToptions(int argc, const char *argv[], struct GT_Spec *Spec,
                  struct GT_FOpar *FO)
 
 Purpose:
   Decode options for GenTone
 
 Description:
-  This routine decodes options for GenTone.
+  This routine decodes options for GenTone. The sine waves given by the
+  frequency, amplitude and phase options apply to all channels. These are
+  followed by the sine waves from the sine wave specification file.
 
 Parameters:
    -> int argc
       Number of command line arguments
    -> const char *argv[]
       Array of pointers to argument strings
-  <-  struct GT_Sine *Sine
-      Sine wave parameters
+  <-  struct GT_Spec *Spec
+      Sine wave specifications. The array of sine wave parameters is allocated
+      by this routine.
   <-  struct GT_FOpar *FO
       Output file parameters
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.14 $  $Date: 2020/11/23 18:31:26 $
+  $Revision: 1.15 $  $Date: 2020/12/15 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 #include <libtsp.h>
 #include <AFpar.h>
@@ -38,6 +42,8 @@ Author / revision:
 #define PI  3.14159265358979323846
 #define DEG_RAD   (PI / 180.0)
 
+#define WS_STRIP  1
+
 #define ERRSTOP(text,par) UThalt("%s: %s: \"%s\"", PROGRAM, text, par)
 
 /* Option table */
@@ -46,27 +52,38 @@ static const char *OptTable[] = {
   "-r#", "--rms=",
   "-a#", "--amp*litude=",
   "-p#", "--phase=",
+  "-t#", "--sine*-file=",
+  "-c#", "--ch*annels=",
   NULL
 };
 
+static int
+GT_decList(const char String[], double Val[], int MaxN, int NegOK);
+
 
 void
-GToptions(int argc, const char *argv[], struct GT_Sine *Sine,
+GToptions(int argc, const char *argv[], struct GT_Spec *Spec,
           struct GT_FOpar *FO)
 
 {
   const char *OptArg;
-  int nF, n;
-  double Nv, Dv;
+  int nF, n, i, Nf, Na, Np, Nchan, Ns;
+  double Freq[MAXSINE], Ampl[MAXSINE], Phase[MAXSINE];
+  char SFname[FILENAME_MAX];
+  struct GT_Sine *Sine;
 
 /* Output file defaults */
   FOpar_INIT(FO);
   FO->Sfreq = AF_SFREQ_DEFAULT;
 
 /* Defaults */
-  Sine->Freq = AF_SFREQ_DEFAULT / 8.0;
-  Sine->Ampl = AMPL_DEF;
-  Sine->Phase = 0;
+  Nf = 0;
+  Ampl[0] = AMPL_DEF;
+  Na = 1;
+  Phase[0] = 0;
+  Np = 1;
+  Nchan = 0;
+  SFname[0] = '\0';
 
 /* Initialization */
   UTsetProg(PROGRAM);
@@ -105,30 +122,43 @@ GToptions(int argc, const char *argv[], struct GT_Sine *Sine,
     case 1:
     case 2:
       /* frequency */
-      if (STdecDfrac(OptArg, &Nv, &Dv) || Nv / Dv < 0.0)
+      Nf = GT_decList(OptArg, Freq, MAXSINE, 0);
+      if (Nf <= 0)
         ERRSTOP(GTM_BadFreq, OptArg);
-      Sine->Freq = Nv / Dv;
       break;
     case 3:
     case 4:
       /* rms value */
-      if (STdecDfrac(OptArg, &Nv, &Dv) || Nv / Dv < 0.0)
+      Na = GT_decList(OptArg, Ampl, MAXSINE, 0);
+      if (Na <= 0)
         ERRSTOP(GTM_BadRMS, OptArg);
-      Sine->Ampl = SQRT2 * Nv / Dv;
+      for (i = 0; i < Na; ++i)
+        Ampl[i] = SQRT2 * Ampl[i];
       break;
     case 5:
     case 6:
       /* amplitude */
-      if (STdecDfrac(OptArg, &Nv, &Dv) || Nv / Dv < 0.0)
+      Na = GT_decList(OptArg, Ampl, MAXSINE, 0);
+      if (Na <= 0)
         ERRSTOP(GTM_BadAmpl, OptArg);
-      Sine->Ampl = Nv / Dv;
       break;
     case 7:
     case 8:
       /* phase */
-      if (STdecDfrac(OptArg, &Nv, &Dv))
+      Np = GT_decList(OptArg, Phase, MAXSINE, 1);
+      if (Np <= 0)
         ERRSTOP(GTM_BadPhase, OptArg);
-      Sine->Phase =  DEG_RAD * Nv / Dv; /* Radians */
+      break;
+    case 9:
+    case 10:
+      /* sine wave file */
+      STcopyMax(OptArg, SFname, FILENAME_MAX-1);
+      break;
+    case 11:
+    case 12:
+      /* number of channels */
+      if (STdec1int(OptArg, &Nchan) || Nchan <= 0)
+        ERRSTOP(GTM_BadNchan, OptArg);
       break;
     default:
       assert(0);
@@ -141,4 +171,77 @@ GToptions(int argc, const char *argv[], struct GT_Sine *Sine,
     UThalt("%s: %s", PROGRAM, GTM_NoFName);
   if (FO->Nframe == AF_NFRAME_UNDEF)
     UThalt("%s: %s", PROGRAM, GTM_NoNsamp);
+
+/* Default frequency, unless a sine wave file is given */
+  if (Nf == 0 && SFname[0] == '\0') {
+    Freq[0] = AF_SFREQ_DEFAULT / 8.0;
+    Nf = 1;
+  }
+  if ((Na != 1 && Na != Nf) || (Np != 1 && Np != Nf))
+    UThalt("%s: %s", PROGRAM, GTM_BadNval);
+
+/* Sine waves for all channels */
+  Sine = (struct GT_Sine *) UTmalloc(MAXSINE * sizeof(struct GT_Sine));
+  for (i = 0; i < Nf; ++i) {
+    Sine[i].Chan = 0;
+    Sine[i].Freq = Freq[i];
+    Sine[i].Ampl = (Na == 1) ? Ampl[0] : Ampl[i];
+    Sine[i].Phase = DEG_RAD * ((Np == 1) ? Phase[0] : Phase[i]);  /* Radians */
+  }
+
+/* Sine waves from the file */
+  Ns = 0;
+  if (SFname[0] != '\0')
+    Ns = GTreadSine(SFname, &Sine[Nf], MAXSINE - Nf);
+
+/* Number of channels, default from the channel numbers in the file */
+  for (i = Nf; i < Nf + Ns; ++i) {
+    if (Nchan > 0 && Sine[i].Chan > Nchan)
+      UThalt("%s: %s: %d", PROGRAM, GTM_BadSine, i-Nf+1);
+  }
+  if (Nchan == 0) {
+    Nchan = 1;
+    for (i = Nf; i < Nf + Ns; ++i)
+      Nchan = (Sine[i].Chan > Nchan) ? Sine[i].Chan : Nchan;
+  }
+
+/* Set return values */
+  Spec->Nchan = Nchan;
+  Spec->Nsine = Nf + Ns;
+  Spec->Sine = Sine;
+}
+
+/* Decode a list of values separated by commas, each a real number or a ratio.
+   Returns the number of values, or -1 on error (including negative values if
+   NegOK is zero).
+*/
+
+
+static int
+GT_decList(const char String[], double Val[], int MaxN, int NegOK)
+
+{
+  int N, nt;
+  const char *p;
+  char *token;
+  double Nv, Dv;
+
+  nt = (int) strlen(String);
+  token = (char *) UTmalloc(nt + 1);
+
+  N = 0;
+  p = String;
+  while (p != NULL) {
+    p = STfindToken(p, ",", "", token, WS_STRIP, nt);
+    if (N >= MaxN || STdecDfrac(token, &Nv, &Dv)
+        || (!NegOK && Nv / Dv < 0.0)) {
+      N = -1;
+      break;
+    }
+    Val[N] = Nv / Dv;
+    ++N;
+  }
+  UTfree(token);
+
+  return N;
 }
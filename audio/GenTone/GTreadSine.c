@@ -0,0 +1,94 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int GTreadSine(const char Fname[], struct GT_Sine Sine[], int MaxSine)
+
+Purpose:
+  Read sine wave specifications from a file
+
+Description:
+  This routine reads the specifications for a set of sine waves from a text
+  file. Each sine wave is specified by 4 values,
+    CHAN FREQ AMPL PHASE
+  where CHAN is the channel number (1, 2, ...) or 0 for all channels, FREQ is
+  the frequency in Hertz, AMPL is the maximum amplitude in normalized units and
+  PHASE is the initial phase in degrees. The values are separated by white
+  space or commas. Normally, each sine wave is specified on a separate line.
+  Comments start with a "!" character and extend to the end of the line.
+
+  This routine prints an error message and halts execution on detection of an
+  error.
+
+Parameters:
+  <-  int GTreadSine
+      Number of sine waves
+   -> const char Fname[]
+      Sine wave specification file name
+  <-  struct GT_Sine Sine[]
+      Array of MaxSine sine wave specifications
+   -> int MaxSine
+      Maximum number of sine waves
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/15 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_SECURE_NO_WARNINGS     /* Allow fopen */
+#endif
+
+#include <limits.h>
+#include <math.h>
+
+#include <libtsp.h>
+#include <libtsp/nucleus.h>
+#include "GenTone.h"
+
+#define PI  3.14159265358979323846
+#define DEG_RAD   (PI / 180.0)
+
+#define COMMENT_CHAR  '!'
+#define NVAL  4
+
+
+int
+GTreadSine(const char Fname[], struct GT_Sine Sine[], int MaxSine)
+
+{
+  FILE *fp;
+  int i, N, Nsine;
+  double *v;
+
+/* Read the values */
+  fp = fopen(Fname, "r");
+  if (fp == NULL)
+    UThalt("%s: %s: \"%s\"", PROGRAM, GTM_OpenSFile, Fname);
+  v = (double *) UTmalloc((NVAL * MaxSine + 1) * sizeof(double));
+  N = FLdReadTF(fp, NVAL * MaxSine + 1, COMMENT_CHAR, v);
+  fclose(fp);
+
+  if (N > NVAL * MaxSine)
+    UThalt("%s: %s", PROGRAM, GTM_XSine);
+  if (N % NVAL != 0)
+    UThalt("%s: %s", PROGRAM, GTM_BadSFile);
+
+/* Check and store the specifications */
+  Nsine = N / NVAL;
+  for (i = 0; i < Nsine; ++i) {
+    if (v[NVAL*i] < 0.0 || v[NVAL*i] > INT_MAX
+        || v[NVAL*i] != floor(v[NVAL*i])
+        || v[NVAL*i+1] < 0.0 || v[NVAL*i+2] < 0.0)
+      UThalt("%s: %s: %d", PROGRAM, GTM_BadSine, i+1);
+    Sine[i].Chan = (int) v[NVAL*i];
+    Sine[i].Freq = v[NVAL*i+1];
+    Sine[i].Ampl = v[NVAL*i+2];
+    Sine[i].Phase = DEG_RAD * v[NVAL*i+3];  /* Radians */
+  }
+  UTfree(v);
+
+  return Nsine;
+}
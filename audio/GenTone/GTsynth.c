@@ -0,0 +1,251 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void GTnewSynth(struct GT_synth *S, const struct GT_Spec *Spec, double Sfreq,
+                  FILE *fpinfo)
+  void GTfreeSynth(struct GT_synth *S)
+  void GTsynth(struct GT_synth *S, double x[], int Nframe)
+
+Purpose:
+  Set up a bank of sine wave oscillators
+  Deallocate a bank of sine wave oscillators
+  Generate multichannel sine wave samples
+
+Description:
+  The oscillator bank generates a sum of sine waves for each channel. Each sine
+  wave has its own frequency, amplitude and phase. A sine wave is either added
+  to all of the channels or to a single channel.
+
+  The normalized frequency of each sine wave is resolved as a ratio of
+  integers, N/D. The phase at sample k, 2 pi ((k N) mod D) / D, is then known
+  exactly, with no accumulation of phase error. Within segments of NSEG
+  samples, the sine waves are generated with a recursive oscillator, a complex
+  value rotated by exp(j 2 pi N/D) for each sample. This needs no calls to
+  sin() or cos() for each sample. At the start of each segment, the oscillator
+  is set from the exact phase. The round-off error in the recursion is then
+  limited to that of NSEG steps. The calculations for the sine waves of a
+  channel are done together in an inner loop over the oscillators.
+
+  GTnewSynth sets up the oscillators. An informational message is printed if
+  the frequency of a sine wave cannot be represented exactly. GTsynth generates
+  Nframe frames of channel-interleaved samples, continuing from where the
+  previous call left off.
+
+Parameters:
+  <-  void GTnewSynth
+  <-  struct GT_synth *S
+      Oscillator bank structure
+   -> const struct GT_Spec *Spec
+      Sine wave specifications
+   -> double Sfreq
+      Sampling frequency
+   -> FILE *fpinfo
+      File pointer for informational messages
+
+  <-  void GTfreeSynth
+  <-> struct GT_synth *S
+      Oscillator bank structure
+
+  <-  void GTsynth
+  <-> struct GT_synth *S
+      Oscillator bank structure
+  <-  double x[]
+      Output array of Nframe*Nchan channel-interleaved samples
+   -> int Nframe
+      Number of frames to be generated
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/15 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <float.h>  /* DBL_EPSILON */
+#include <limits.h>
+#include <math.h>
+
+#include <libtsp.h>
+#include "GenTone.h"
+
+#define ABSV(x)   (((x) < 0) ? -(x) : (x))
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+#define PIx2    6.28318530717958647693
+
+#define NSEG  512
+
+static long int
+GT_addMod(long int a, long int b, long int D);
+static long int
+GT_mulMod(long int n, long int N, long int D);
+static void
+GT_oscGroup(struct GT_synth *S, int ig, double y[], int n);
+
+
+void
+GTnewSynth(struct GT_synth *S, const struct GT_Spec *Spec, double Sfreq,
+           FILE *fpinfo)
+
+{
+  int i, k, ig, Ng;
+  long int N, D;
+  double Sratio, Xratio;
+  const struct GT_Sine *Sine;
+
+  S->Nchan = Spec->Nchan;
+  S->Nosc = Spec->Nsine;
+  Ng = S->Nchan + 1;
+  S->Ist = (int *) UTmalloc((Ng + 1) * sizeof(int));
+  S->N = (long int *) UTmalloc(3 * S->Nosc * sizeof(long int));
+  S->D = &S->N[S->Nosc];
+  S->P = &S->D[S->Nosc];
+  S->Ampl = (double *) UTmalloc(6 * S->Nosc * sizeof(double));
+  S->Phase = &S->Ampl[S->Nosc];
+  S->wr = &S->Phase[S->Nosc];
+  S->wi = &S->wr[S->Nosc];
+  S->zr = &S->wi[S->Nosc];
+  S->zi = &S->zr[S->Nosc];
+  S->y = (double *) UTmalloc(NSEG * sizeof(double));
+
+/* Oscillators in groups: group 0 for all channels, group ig for channel ig */
+  k = 0;
+  for (ig = 0; ig < Ng; ++ig) {
+    S->Ist[ig] = k;
+    for (i = 0; i < Spec->Nsine; ++i) {
+      Sine = &Spec->Sine[i];
+      if (Sine->Chan != ig)
+        continue;
+
+/* Resolve the normalized sine wave frequency as a ratio of integers.
+   The phase advance can then be calculated as a ratio of integers, with no
+   accumulation of phase error.
+*/
+      Sratio = Sine->Freq / Sfreq;
+      MSratio(Sratio, &N, &D, 0.0, LONG_MAX / 2, LONG_MAX);
+      Xratio = (double) N / D;
+      if (ABSV(Sratio - Xratio) >= ABSV (Sratio) * DBL_EPSILON)
+        fprintf(fpinfo, GTMF_SineFreq, Xratio * Sfreq);
+      S->N[k] = (N % D);  /* Alias frequency */
+      S->D[k] = D;
+      S->P[k] = 0;
+      S->Ampl[k] = Sine->Ampl;
+      S->Phase[k] = Sine->Phase;
+      S->wr[k] = cos((PIx2 / D) * S->N[k]);
+      S->wi[k] = sin((PIx2 / D) * S->N[k]);
+      ++k;
+    }
+  }
+  S->Ist[Ng] = k;
+}
+
+
+void
+GTfreeSynth(struct GT_synth *S)
+
+{
+  UTfree(S->Ist);
+  UTfree(S->N);
+  UTfree(S->Ampl);
+  UTfree(S->y);
+}
+
+
+void
+GTsynth(struct GT_synth *S, double x[], int Nframe)
+
+{
+  int i, ic, k, n, Nchan;
+  double *y;
+
+  Nchan = S->Nchan;
+  y = S->y;
+  for (k = 0; k < Nframe; k += n) {
+    n = MINV(Nframe - k, NSEG);
+
+    /* Sine waves common to all channels */
+    GT_oscGroup(S, 0, y, n);
+    for (i = 0; i < n; ++i) {
+      for (ic = 0; ic < Nchan; ++ic)
+        x[(k+i)*Nchan+ic] = y[i];
+    }
+
+    /* Sine waves for individual channels */
+    for (ic = 0; ic < Nchan; ++ic) {
+      if (S->Ist[ic+1] == S->Ist[ic+2])
+        continue;
+      GT_oscGroup(S, ic + 1, y, n);
+      for (i = 0; i < n; ++i)
+        x[(k+i)*Nchan+ic] += y[i];
+    }
+  }
+}
+
+/* Generate n samples of the sum of the sine waves in oscillator group ig */
+
+
+static void
+GT_oscGroup(struct GT_synth *S, int ig, double y[], int n)
+
+{
+  int i, j, jl, ju;
+  double sum, t;
+  double *zr, *zi;
+  const double *wr, *wi;
+
+  jl = S->Ist[ig];
+  ju = S->Ist[ig+1];
+
+/* Set the oscillators from the exact phase, advance the phase for the next
+   segment */
+  for (j = jl; j < ju; ++j) {
+    t = (PIx2 / S->D[j]) * S->P[j] + S->Phase[j];
+    S->zr[j] = S->Ampl[j] * cos(t);
+    S->zi[j] = S->Ampl[j] * sin(t);
+    S->P[j] = GT_addMod(S->P[j], GT_mulMod(n, S->N[j], S->D[j]), S->D[j]);
+  }
+
+/* Recursive oscillators, z(i+1) = w z(i), output Im[z(i)] */
+  zr = S->zr;
+  zi = S->zi;
+  wr = S->wr;
+  wi = S->wi;
+  for (i = 0; i < n; ++i) {
+    sum = 0.0;
+    for (j = jl; j < ju; ++j) {
+      sum += zi[j];
+      t = zr[j] * wr[j] - zi[j] * wi[j];
+      zi[j] = zr[j] * wi[j] + zi[j] * wr[j];
+      zr[j] = t;
+    }
+    y[i] = sum;
+  }
+}
+
+/* (a + b) mod D for 0 <= a, b < D, without overflow */
+
+
+static long int
+GT_addMod(long int a, long int b, long int D)
+
+{
+  return (a >= D - b) ? a - (D - b) : a + b;
+}
+
+/* (n N) mod D for 0 <= N < D, n >= 0, without overflow */
+
+
+static long int
+GT_mulMod(long int n, long int N, long int D)
+
+{
+  long int r;
+
+  r = 0;
+  for (; n > 0; n >>= 1) {
+    if (n & 1)
+      r = GT_addMod(r, N, D);
+    N = GT_addMod(N, N, D);
+  }
+
+  return r;
+}
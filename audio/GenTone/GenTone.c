@@ -5,7 +5,7 @@ Routine:
   GenTone [options] AFile
 
 Purpose:
-  Generate an audio file containing a sine wave
+  Generate an audio file containing sine waves
 
 Description:
   This program generates a sine wave of a given amplitude and phase. The samples
@@ -13,6 +13,16 @@ Description:
   specify the number of samples, the sampling frequency and the data format of
   the output file.
 
+  More generally, each channel of the output file can contain a sum of sine
+  waves. Sine waves specified with the frequency, amplitude and phase options
+  are added to all channels. Sine waves for individual channels can be given
+  in a sine wave specification file.
+
+  The frequency of each sine wave is resolved as a ratio of integers relative
+  to the sampling frequency. The phase at the start of each segment of 512
+  samples is calculated exactly from this ratio. Within a segment, the sine
+  wave is generated with a recursive oscillator (see GTsynth).
+
 Options:
   Output file name, AFile:
       Specifying "-" as the output file indicates that output is to be written
@@ -26,22 +36,36 @@ Options:
         ".raw"  - Headerless file (native byte order)
         ".txt"  - Text audio file (with header)
   -f FREQ, --frequency=FREQ
-      Frequency of the sine wave in Hertz, default 1000.
+      Frequency of the sine wave in Hertz, default 1000. A list of frequencies
+      separated by commas (e.g., "1000, 1500, 2250") specifies several sine
+      waves. The default frequency is not used if a sine wave file is given.
   -r SDEV, --rms=SDEV
       Root-mean-square value of the sinusoid in normalized units, default 0.03.
       The rms value can be given as a real number (e.g., "0.03") or as a ratio
-      (e.g., "983.04/32768").
+      (e.g., "983.04/32768"). For several sine waves, either one value (used
+      for all of the sine waves) or one value for each sine wave can be given.
   -a AMPL, --amplitude=AMPL
       Maximum amplitude of the sine wave in normalized units. The amplitude of
       the sine wave is specified by either the rms value or the maximum
       amplitude. The amplitude can be given as a real number (e.g., "0.0424")
       or as a ratio (e.g., "1390.2/32768"). The default amplitude corresponds
-      to an RMS value of 0.03.
+      to an RMS value of 0.03. For several sine waves, either one value or one
+      value for each sine wave can be given.
   -p PHASE, --phase PHASE
       Initial phase of the sinusoid (sine) in degrees, default 0. Zero phase
-      gives a sine, -90 degrees gives a cosine.
+      gives a sine, -90 degrees gives a cosine. For several sine waves, either
+      one value or one value for each sine wave can be given.
+  -t SFILE, --sine-file=SFILE
+      Sine wave specification file. Each sine wave is specified by 4 values,
+      "CHAN FREQ AMPL PHASE": the channel number (1, 2, ...), or 0 for all
+      channels, the frequency in Hertz, the maximum amplitude in normalized
+      units and the initial phase in degrees. Normally each sine wave is given
+      on a separate line. Comments start with a "!" character.
+  -c NCHAN, --channels=NCHAN
+      Number of output channels. The default is the largest channel number in
+      the sine wave file, or one if there is no sine wave file.
   -n NSAMPLE, --number-samples=NSAMPLE
-      Number of output samples to be generated.
+      Number of output samples (per channel) to be generated.
   -s SFREQ, --srate=SFREQ
       Sampling frequency for the output audio file, default 8000.
   -F FTYPE, --file-type=FTYPE
@@ -55,6 +79,7 @@ Options:
                                    format.
         "WAVE-NOEX" or "wave-noex" - WAVE file; do not use the WAVE file
                                    extensible format
+        "Wave64" or "wave64"     - Wave64 file (64-bit sizes)
         "AIFF-C" or "aiff-c"     - AIFF-C sound file
         "AIFF-C/sowt" or "aiff-c/sowt" - AIFF-C (byte-swapped data)
         "AIFF" or "aiff"         - AIFF sound file
@@ -79,6 +104,13 @@ Options:
         "text"      - text data, scaled the same as float/double data
   -I INFO, --info=INFO
       Audio file information string for the output file.
+  --stats
+      Print data transfer statistics for the audio files when they are closed
+      (requests, bytes, read/write calls, seeks and times).
+  --async=N
+      Transfer the audio file data in a separate thread for each file, using
+      N buffer blocks. This lets the file reads and writes overlap the
+      processing. The default (0) transfers the data in the program thread.
   -h, --help
       Print a list of options and exit.
   -v, --version
@@ -97,9 +129,6 @@ Author / version:
 
 -------------------------------------------------------------------------*/
 
-#include <float.h>  /* DBL_EPSILON */
-#include <limits.h>
-#include <math.h>
 #include <stdlib.h> /* EXIT_SUCCESS */
 #include <string.h>
 
@@ -108,11 +137,9 @@ Author / version:
 #include <AO.h>
 #include "GenTone.h"
 
-#define ABSV(x)   (((x) < 0) ? -(x) : (x))
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
-#define PIx2    6.28318530717958647693
 
-#define MAXBUF  5120
+#define NBUF  5120
 
 
 int
@@ -120,17 +147,16 @@ main(int argc, const char *argv[])
 
 {
   struct GT_FOpar FO;
+  struct GT_Spec Spec;
+  struct GT_synth S;
   AFILE *AFp;
   FILE *fpinfo;
-  long int N, D, PND;
-  int i, n;
+  int n;
   long int k;
-  double Sratio, Xratio;
-  double x[MAXBUF];
-  struct GT_Sine Sine;
+  double *x;
 
 /* Get the input parameters */
-  GToptions(argc, argv, &Sine, &FO);
+  GToptions(argc, argv, &Spec, &FO);
 
 /* If output is to stdout, use stderr for informational messages */
   if (strcmp(FO.Fname, "-") == 0)
@@ -143,37 +169,27 @@ main(int argc, const char *argv[])
   AOsetFOopt(&FO);
   if (strcmp(FO.Fname, "-") != 0)
     FLbackup(FO.Fname);
-  AFp = AFopnWrite(FO.Fname, FO.FtypeW, FO.DFormat.Format, 1L, FO.Sfreq,
-                   fpinfo);
-
-/* Resolve the normalized sine wave frequency as a ratio of integers.
-   The phase advance can then be calculated as a ratio of integers, with no
-   accumulation of phase error.
-*/
-  Sratio = Sine.Freq / FO.Sfreq;
-  MSratio(Sratio, &N, &D, 0.0, LONG_MAX / 2, LONG_MAX);
-  Xratio = (double) N / D;
-  if (ABSV(Sratio - Xratio) >= ABSV (Sratio) * DBL_EPSILON)
-    fprintf(fpinfo, GTMF_SineFreq, Xratio * FO.Sfreq);
-  N = (N % D);  /* Alias frequency */
+  AFp = AFopnWrite(FO.Fname, FO.FtypeW, FO.DFormat.Format,
+                   (long int) Spec.Nchan, FO.Sfreq, fpinfo);
+
+/* Set up the oscillators */
+  GTnewSynth(&S, &Spec, FO.Sfreq, fpinfo);
 
 /* Generate the sine wave samples */
+  x = (double *) UTmalloc(Spec.Nchan * NBUF * sizeof(double));
   k = 0;
-  PND = 0;
   while (k < FO.Nframe) {
-    n = (int) MINV(FO.Nframe - k, MAXBUF);
-    for (i = 0; i < n; ++i) {
-      x[i] = Sine.Ampl * sin((PIx2 / D) * PND + Sine.Phase);
-      PND += N;
-      if (PND > D)
-        PND -= D;
-    }
+    n = (int) MINV(FO.Nframe - k, NBUF);
+    GTsynth(&S, x, n);
     k += n;
-    AFdWriteData(AFp, x, n);
+    AFdWriteData(AFp, x, n * Spec.Nchan);
   }
 
 /* Close the audio file */
   AFclose(AFp);
+  GTfreeSynth(&S);
+  UTfree(x);
+  UTfree(Spec.Sine);
 
   return EXIT_SUCCESS;
 }
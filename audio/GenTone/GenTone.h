@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.33 $  $Date: 2020/11/30 12:32:28 $
+  $Revision: 1.36 $  $Date: 2020/12/23 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -21,6 +21,7 @@ Author / revision:
 
 #define SQRT2 (1.41421356237309504880)
 #define AMPL_DEF  (0.03 * SQRT2)
+#define MAXSINE   1024
 
 
 #include <libtsp.h>
@@ -29,11 +30,31 @@ Author / revision:
 #define GT_FOpar  AO_FOpar  /* Output file structure */
 
 struct GT_Sine {
+  int Chan;       /* Channel number (1, 2, ...), 0 for all channels */
   double Freq;    /* Frequency Hz */
   double Ampl;    /* Amplitude */
   double Phase;   /* Phase in Radians */
 };
 
+struct GT_Spec {
+  int Nchan;              /* Number of channels */
+  int Nsine;              /* Number of sine waves */
+  struct GT_Sine *Sine;   /* Sine wave parameters */
+};
+
+/* Oscillator bank, oscillators for group ig (ig = 0 for all channels, ig = i
+   for channel i) are Ist[ig], ..., Ist[ig+1]-1 */
+struct GT_synth {
+  int Nchan;
+  int Nosc;
+  int *Ist;
+  long int *N, *D, *P;    /* Frequency N/D, current phase P/D */
+  double *Ampl, *Phase;
+  double *wr, *wi;        /* Phase rotation per sample */
+  double *zr, *zi;        /* Oscillator state */
+  double *y;              /* Output buffer for a group */
+};
+
 /* Informational message */
 #define GTMF_SineFreq " Sine wave frequency: %g\n"
 
@@ -42,6 +63,12 @@ struct GT_Sine {
 #define GTM_BadFreq   "Invalid sine wave frequency"
 #define GTM_BadRMS    "Invalid rms value"
 #define GTM_BadPhase  "Invalid sine wave phase"
+#define GTM_BadNchan  "Invalid number of channels"
+#define GTM_BadNval   "Number of values does not match the number of frequencies"
+#define GTM_BadSine   "Invalid sine wave specification"
+#define GTM_BadSFile  "Number of values in the sine wave file not a multiple of 4"
+#define GTM_OpenSFile "Cannot open sine wave file"
+#define GTM_XSine     "Too many sine waves"
 #define GTM_XFName    "Too many filenames specified"
 #define GTM_NoFName   "No filename specified"
 #define GTM_NoNsamp   "Number of samples not specified"
@@ -51,20 +78,24 @@ struct GT_Sine {
 Usage: %s [options] AFileO\n\
 Options:\n\
   -n NSAMPLE, --number-samples=NSAMPLE  Number of output samples.\n\
-  -f FREQ, --frequency=FREQ   Frequency of the sine wave.\n\
-  -r RMS, --rms=RMS           Root-mean-square value of the sine wave.\n\
-  -a AMPL, --amplitude=AMPL   Maximum amplitude of the sine wave.\n\
-  -p PHASE, --phase=PHASE     Initial phase of the sine wave.\n\
+  -f FREQ, --frequency=FREQ   Frequencies of the sine waves.\n\
+  -r RMS, --rms=RMS           Root-mean-square values of the sine waves.\n\
+  -a AMPL, --amplitude=AMPL   Maximum amplitudes of the sine waves.\n\
+  -p PHASE, --phase=PHASE     Initial phases of the sine waves.\n\
+  -t SFILE, --sine-file=SFILE  Sine wave specification file.\n\
+  -c NCHAN, --channels=NCHAN  Number of output channels.\n\
   -s SFREQ, --srate=SFREQ     Sampling frequency for the output file.\n\
   -F FTYPE, --file-type=FTYPE  Output file type,\n\
                               \"AU\", \"WAVE\", \"WAVE-NOEX\", \"AIFF\",\n\
-                              \"AIFF-C\", \"AIFF-C/sowt\", \"noheader\",\n\
-                              \"noheader-swap\", \"text-audio\".\n\
+                              \"AIFF-C\", \"AIFF-C/sowt\", \"Wave64\",\n\
+                              \"noheader\", \"noheader-swap\", \"text-audio\".\n\
   -D DFORMAT, --data-format=DFORMAT  Data format for the output file,\n\
                               \"mu-law8\", \"mu-lawR8\", \"A-law8\", \"unsigned8\",\n\
                               \"integer8\", \"integer16\", \"integer24\",\n\
                               \"float32\", \"float64\", \"text16\", \"text\".\n\
   -I INFO, --info=INFO        Add a header information record.\n\
+  --stats                     Print data transfer statistics.\n\
+  --async=N                   Transfer the file data in the background.\n\
   -h, --help                  Print a list of options and exit.\n\
   -v, --version               Print the version number and exit."
 
@@ -74,8 +105,17 @@ extern "C" {
 
 /* Prototypes */
 void
-GToptions(int argc, const char *argv[], struct GT_Sine *Sine,
+GTfreeSynth(struct GT_synth *S);
+void
+GTnewSynth(struct GT_synth *S, const struct GT_Spec *Spec, double Sfreq,
+           FILE *fpinfo);
+void
+GToptions(int argc, const char *argv[], struct GT_Spec *Spec,
           struct GT_FOpar *FO);
+int
+GTreadSine(const char Fname[], struct GT_Sine Sine[], int MaxSine);
+void
+GTsynth(struct GT_synth *S, double x[], int Nframe);
 
 #ifdef __cplusplus
 }
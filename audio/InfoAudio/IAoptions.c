@@ -2,14 +2,17 @@
                            McGill University
 
 Routine:
-  void IAoptions(int argc, const char *argv[], int *Icode,
-                 struct IA_FIpar FI[MAXFILE], int *Nfiles)
+  void IAoptions(int argc, const char *argv[], int *Icode, int *Form,
+                 int *Nthread, struct IA_FIpar **FI, int *Nfiles)
 
 Purpose:
   Decode options for InfoAudio
 
 Description:
-  This routine decodes options for InfoAudio.
+  This routine decodes options for InfoAudio. The array of input file
+  parameters is allocated by this routine and grows as needed; there is no
+  limit on the number of input files. The array should be deallocated using
+  UTfree.
 
 Parameters:
   <-  void IAoptions
@@ -18,15 +21,19 @@ Parameters:
    -> const char *argv[]
       Array of pointers to argument strings
   <-  int *Icode
-      Flag to select the amount of output, default 7
-  <-  struct IA_FIpar FI[MAXFILE]
-      Input file parameters
+      Flag to select the amount of output, default 15
+  <-  int *Form
+      Output format, IA_TEXT, IA_CSV or IA_JSON
+  <-  int *Nthread
+      Number of threads for scanning files (IA_CSV and IA_JSON output)
+  <-  struct IA_FIpar **FI
+      Pointer to an allocated array of input file parameters
   <-  int *Nfiles
       Number of input file names
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.34 $  $Date: 2020/11/23 18:31:41 $
+  $Revision: 1.35 $  $Date: 2020/12/18 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -41,17 +48,25 @@ Author / revision:
 /* Option table  */
 static const char *OptTable[] = {
   "-i#", "--info_code=",
+  "-f#", "--form*at=",
+  "-j#", "--th*reads=",
   NULL
 };
 
+/* Output format keywords */
+static const char *FormTab[] = {
+  "text", "csv", "json", NULL
+};
+
 
 void
-IAoptions(int argc, const char *argv[], int *Icode,
-          struct IA_FIpar FI[MAXFILE], int *Nfiles)
+IAoptions(int argc, const char *argv[], int *Icode, int *Form, int *Nthread,
+          struct IA_FIpar **FI, int *Nfiles)
 
 {
   struct IA_FIpar FIx;
-  int n, nF, icode, FIParSet;
+  struct IA_FIpar *FIa;
+  int n, nF, NFmax, icode, form, nthread, FIParSet;
   const char *OptArg;
 
 /* Default values */
@@ -59,10 +74,14 @@ IAoptions(int argc, const char *argv[], int *Icode,
   FIpar_INIT(&FIx);
 
   icode = 15;
+  form = IA_TEXT;
+  nthread = NTHREAD_DEFAULT;
 
 /* Initialization */
   UTsetProg(PROGRAM);
   nF = 0;
+  NFmax = 0;
+  FIa = NULL;
 
 /* Decode options */
   AOinitOpt(argc, argv);
@@ -92,10 +111,13 @@ IAoptions(int argc, const char *argv[], int *Icode,
     case 0:
       /* Filename argument */
       ++nF;
-      if (nF > MAXFILE)
-        UThalt("%s: %s", PROGRAM, IAM_XFName);
+      if (nF > NFmax) {
+        NFmax += NFILE_INC;
+        FIa = (struct IA_FIpar *)
+          UTrealloc(FIa, (int) (NFmax * sizeof(struct IA_FIpar)));
+      }
       STcopyMax(OptArg, FIx.Fname, FILENAME_MAX-1);
-      FI[nF-1] = FIx;
+      FIa[nF-1] = FIx;
       break;
     case 1:
     case 2:
@@ -103,6 +125,19 @@ IAoptions(int argc, const char *argv[], int *Icode,
       if (STdec1int(OptArg, &icode) || icode < 0 || icode > 15)
         ERRSTOP(IAM_BadInfoCode, OptArg);
       break;
+    case 3:
+    case 4:
+      /* Output format */
+      form = STkeyMatch(OptArg, FormTab);
+      if (form < 0)
+        ERRSTOP(IAM_BadForm, OptArg);
+      break;
+    case 5:
+    case 6:
+      /* Number of threads */
+      if (STdec1int(OptArg, &nthread) || nthread <= 0)
+        ERRSTOP(IAM_BadNthread, OptArg);
+      break;
     default:
       assert(0);
       break;
@@ -115,10 +150,15 @@ IAoptions(int argc, const char *argv[], int *Icode,
   if (FIParSet >= nF)
     UThalt("%s: %s", PROGRAM, IAM_LateFPar);
 
-  /* Check for too many stdin specs */
-  AOstdin(FI, nF);
+  /* Check for too many stdin specs (for the csv and json formats, "-" is a
+     list of file names) */
+  if (form == IA_TEXT)
+    AOstdin(FIa, nF);
 
-/* Return parameter */
+/* Return parameters */
   *Icode = icode;
+  *Form = form;
+  *Nthread = nthread;
+  *FI = FIa;
   *Nfiles = nF;
 }
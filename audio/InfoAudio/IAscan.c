@@ -0,0 +1,631 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void IAscan(const struct IA_FIpar FI[], int Nfiles, int Form, int Nthread)
+
+Purpose:
+  Print one record of audio file information per file for a list of files
+
+Description:
+  This routine prints one line of information for each audio file, in comma
+  separated value (csv) or JSON format. The input names can be audio files,
+  directories or "-". The files in a directory tree are processed in the order
+  of their names. Symbolic links to directories within a directory tree are
+  skipped. For "-", a list of file names, one per line, is read from standard
+  input.
+
+  The files are handled in batches of up to 512 files. The files of a batch
+  are opened concurrently by a pool of Nthread threads (see AOnewPool) which
+  is kept for all of the batches. Each thread takes the next unopened file of
+  the batch when it is done with a file. The worker threads have the audio
+  file options of the calling thread (e.g. --stats). The files are opened
+  with header-only opens (see AFoptions) with error halts disabled. When all
+  of the files of a batch have been opened, the records for the batch are
+  written to standard output in the order of the file names and the next
+  batch is started. A file that cannot be opened gives a record with status
+  "error". The number of files is not limited.
+
+  Text fields are written as is, except for quoting and escapes. Characters
+  with codes 0x80 and above, for instance UTF-8 encoded characters, are not
+  changed. For json output, control characters are written as escapes. For
+  csv output, a field with a control character (e.g. a newline) is quoted and
+  the control character is written as is.
+
+Parameters:
+  <-  void IAscan
+   -> const struct IA_FIpar FI[]
+      Input file parameters (names and input file options)
+   -> int Nfiles
+      Number of input names
+   -> int Form
+      Output format, IA_CSV or IA_JSON
+   -> int Nthread
+      Number of threads
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.3 $  $Date: 2020/12/26 12:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_SECURE_NO_WARNINGS     /* Allow sprintf */
+#endif
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>   /* qsort */
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if (SY_POSIX)
+#  include <dirent.h>
+#else
+#  include <io.h>     /* _findfirst */
+#endif
+
+#include <libtsp.h>
+#include <libtsp/nucleus.h>
+#include "InfoAudio.h"
+
+#ifndef S_ISDIR   /* Defined by POSIX */
+#  define S_ISDIR(m)  (((m) & S_IFMT) == S_IFDIR)
+#endif
+
+#define NBATCH    512     /* Number of files in a batch */
+#define NNAME_INC 256     /* Increment for the directory list allocation */
+#define NSTR_INC  512     /* Increment for the record string allocation */
+#define LNUM      40      /* Length of a formatted number */
+
+#define NELEM(array)  ((int) ((sizeof array) / (sizeof array[0])))
+#define IA_CNTRL(c)   ((c) < 0x20 || (c) == 0x7F)   /* ASCII control char */
+
+/* File type keywords, indexed by file type */
+static const char *FtypeKey[] = {
+  "unknown",
+  "noheader",
+  "AU",
+  "WAVE",
+  "WAVE-EX",
+  "WAVE-BWF",
+  "WAVE-EX-BWF",
+  "AIFF",
+  "AIFF-C",
+  "SPHERE",
+  "ESPS",
+  "IRCAM",
+  "SPPACK",
+  "INRS",
+  "SPW",
+  "NSP",
+  "text-audio"
+};
+
+/* Data format keywords, indexed by data format */
+static const char *FormatKey[] = {
+  "undefined",
+  "A-law8",
+  "mu-law8",
+  "mu-lawR8",
+  "unsigned8",
+  "integer8",
+  "integer16",
+  "integer24",
+  "integer32",
+  "float32",
+  "float64",
+  "text16",
+  "text"
+};
+static const char *DataSwap[] = {
+  "big-endian",
+  "little-endian",
+  "native",
+  "swap"
+};
+
+#define CSV_HEADER "name,status,type,format,byte_order,sfreq,nchan,nframe," \
+                   "data_offset,chunks,info\n"
+
+/* Growing string */
+struct IA_str {
+  char *s;      /* String (null terminated) */
+  int n;        /* Number of characters */
+  int nmax;     /* Allocated size */
+};
+
+/* File in a batch: name, input file options and formatted record */
+struct IA_item {
+  char *Fname;
+  const struct IA_FIpar *FI;
+  char *Rec;
+};
+
+/* Batch of files */
+struct IA_batch {
+  struct IA_item Item[NBATCH];
+  int N;
+  int Form;
+  struct AO_pool *Pool;
+};
+
+static void
+IA_addDir(struct IA_batch *B, const char Dname[], const struct IA_FIpar *FI);
+static void
+IA_addFile(struct IA_batch *B, const char Fname[], const struct IA_FIpar *FI);
+static void
+IA_addPath(struct IA_batch *B, const char Fname[], const struct IA_FIpar *FI,
+           int Top);
+static void
+IA_cat(struct IA_str *S, const char Str[], int n);
+static void
+IA_catText(struct IA_str *S, const char Str[], int n, int Form);
+static int
+IA_cmpName(const void *a, const void *b);
+static void
+IA_field(struct IA_str *S, const char Key[], const char Value[], int Form);
+static void
+IA_flush(struct IA_batch *B);
+static int
+IA_listDir(const char Dname[], char ***Names);
+static char *
+IA_record(const AFILE *AFp, const char Fname[], int Form);
+static void
+IA_scanFile(int i, void *Arg);
+
+
+void
+IAscan(const struct IA_FIpar FI[], int Nfiles, int Form, int Nthread)
+
+{
+  struct IA_batch *B;
+  int i;
+  char *Line;
+  char Fname[FILENAME_MAX];
+
+  assert(NELEM(FtypeKey) == AF_NFT);
+  assert(NELEM(FormatKey) == AF_NFD);
+
+  B = (struct IA_batch *) UTmalloc(sizeof(struct IA_batch));
+  B->N = 0;
+  B->Form = Form;
+  B->Pool = AOnewPool(Nthread);
+
+  if (Form == IA_CSV)
+    fputs(CSV_HEADER, stdout);
+
+/* Loop over the input names */
+  for (i = 0; i < Nfiles; ++i) {
+    if (strcmp(FI[i].Fname, "-") == 0) {
+      while ((Line = FLgetLine(stdin)) != NULL) {
+        if (Line[0] != '\0')
+          IA_addPath(B, Line, &FI[i], 1);
+      }
+    }
+    else {
+      FLpathList(FI[i].Fname, AFPATH_ENV, Fname);
+      IA_addPath(B, Fname, &FI[i], 1);
+    }
+  }
+  IA_flush(B);
+
+  AOfreePool(B->Pool);
+  UTfree(B);
+}
+
+/* Add a file or the files in a directory tree to the batch */
+
+
+static void
+IA_addPath(struct IA_batch *B, const char Fname[], const struct IA_FIpar *FI,
+           int Top)
+
+{
+  struct stat Fstat;
+  int status;
+
+/* Below the top level, symbolic links to directories are skipped */
+#if (SY_POSIX)
+  if (! Top && lstat(Fname, &Fstat) == 0 && S_ISLNK(Fstat.st_mode)
+      && stat(Fname, &Fstat) == 0 && S_ISDIR(Fstat.st_mode))
+    return;
+#endif
+  status = stat(Fname, &Fstat);
+
+  if (status == 0 && S_ISDIR(Fstat.st_mode))
+    IA_addDir(B, Fname, FI);
+  else
+    IA_addFile(B, Fname, FI);
+}
+
+/* Add the files in a directory tree to the batch, in order of the names */
+
+
+static void
+IA_addDir(struct IA_batch *B, const char Dname[], const struct IA_FIpar *FI)
+
+{
+  int i, N;
+  char **Names;
+  char Fname[FILENAME_MAX];
+
+  N = IA_listDir(Dname, &Names);
+  if (N < 0) {
+    UTwarn("%s - %s: \"%s\"", PROGRAM, IAM_OpenDir, Dname);
+    return;
+  }
+
+  qsort(Names, (size_t) N, sizeof(char *), IA_cmpName);
+  for (i = 0; i < N; ++i) {
+    FLjoinNames(Dname, Names[i], Fname);
+    IA_addPath(B, Fname, FI, 0);
+    UTfree(Names[i]);
+  }
+  UTfree(Names);
+}
+
+/* Add a file to the batch, process the batch when it is full */
+
+
+static void
+IA_addFile(struct IA_batch *B, const char Fname[], const struct IA_FIpar *FI)
+
+{
+  struct IA_item *It;
+
+  It = &B->Item[B->N];
+  It->Fname = (char *) UTmalloc((int) strlen(Fname) + 1);
+  strcpy(It->Fname, Fname);
+  It->FI = FI;
+  It->Rec = NULL;
+
+  ++B->N;
+  if (B->N >= NBATCH)
+    IA_flush(B);
+}
+
+/* Open the files in the batch using the pool, print the records in order */
+
+
+static void
+IA_flush(struct IA_batch *B)
+
+{
+  int i;
+
+  AOrunPool(B->Pool, IA_scanFile, B, B->N);
+
+  for (i = 0; i < B->N; ++i) {
+    fputs(B->Item[i].Rec, stdout);
+    UTfree(B->Item[i].Rec);
+    UTfree(B->Item[i].Fname);
+  }
+  fflush(stdout);
+  B->N = 0;
+}
+
+/* Open one file (called from a worker thread), format its record */
+
+
+static void
+IA_scanFile(int i, void *Arg)
+
+{
+  struct IA_batch *B;
+  struct IA_item *It;
+  struct AF_opt Opt;
+  AFILE *AFp;
+  long int Nsamp, Nchan;
+  double Sfreq;
+
+  B = (struct IA_batch *) Arg;
+  It = &B->Item[i];
+
+  /* Options for this file: header-only open, continue on errors (the options
+     of the thread, a copy of those of the main thread, are unchanged) */
+  Opt = AFopt;
+  Opt.ErrorHalt = 0;
+  Opt.NsampND = 1;
+  Opt.RAccess = 0;
+  Opt.MMap = 0;
+  Opt.Lback = 0L;
+  Opt.HeadOnly = 1;
+  Opt.FtypeI = It->FI->Ftype;
+  Opt.InputPar = It->FI->InputPar;
+
+  AFp = AFopnReadCtx(It->Fname, &Nsamp, &Nchan, &Sfreq, NULL, &Opt);
+  It->Rec = IA_record(AFp, It->Fname, B->Form);
+  if (AFp != NULL)
+    AFclose(AFp);
+}
+
+/* Format the record for a file, returns an allocated string */
+
+
+static char *
+IA_record(const AFILE *AFp, const char Fname[], int Form)
+
+{
+  struct IA_str S, T;
+  int i, n, Lrec, Dbo;
+  long int FLsize, End;
+  const struct AF_chunkLim *Lim;
+  char ID[5];
+  char Num[LNUM];
+
+  S.s = NULL;
+  S.n = 0;
+  S.nmax = 0;
+  T = S;
+
+  if (Form == IA_JSON)
+    IA_cat(&S, "{\"name\":", 8);
+  IA_catText(&S, Fname, (int) strlen(Fname), Form);
+
+  if (AFp == NULL) {
+    if (Form == IA_JSON)
+      IA_cat(&S, ",\"status\":\"error\"}\n", 19);
+    else
+      IA_cat(&S, ",error,,,,,,,,,\n", 16);
+    return S.s;
+  }
+
+/* File parameters */
+  IA_field(&S, "status", "\"ok\"", Form);
+  IA_field(&S, "type", FtypeKey[AFp->Ftype], Form);
+  IA_field(&S, "format", FormatKey[AFp->Format], Form);
+  if (AF_DL[AFp->Format] <= 1)
+    IA_field(&S, "byte_order", "byte-stream", Form);
+  else {
+    Dbo = UTbyteCode(AFp->Swapb);
+    IA_field(&S, "byte_order", DataSwap[Dbo], Form);
+  }
+  sprintf(Num, "%.10g", AFp->Sfreq);
+  IA_field(&S, "sfreq", Num, Form);
+  sprintf(Num, "%ld", AFp->Nchan);
+  IA_field(&S, "nchan", Num, Form);
+  if (AFp->Nsamp == AF_NSAMP_UNDEF)
+    IA_field(&S, "nframe", NULL, Form);
+  else {
+    sprintf(Num, "%ld", AFp->Nsamp / AFp->Nchan);
+    IA_field(&S, "nframe", Num, Form);
+  }
+  sprintf(Num, "%ld", AFp->Start);
+  IA_field(&S, "data_offset", Num, Form);
+
+/* Chunk layout */
+  FLsize = AF_EoF;
+  if (FLseekable(AFp->fp))
+    FLsize = FLfileSize(AFp->fp);
+  if (Form == IA_JSON)
+    IA_cat(&S, ",\"chunks\":[", 11);
+  for (i = 0; i < AFp->ChunkInfo.N; ++i) {
+    Lim = &AFp->ChunkInfo.ChunkLim[i];
+    for (n = 0; n < 4; ++n)
+      ID[n] = isprint((unsigned char) Lim->ID[n]) ? Lim->ID[n] : '?';
+    ID[4] = '\0';
+    End = Lim->End;
+    if (End == AF_EoF && FLsize != AF_EoF)
+      End = FLsize - 1;
+    if (Form == IA_JSON) {
+      IA_cat(&S, (i == 0) ? "{\"id\":" : ",{\"id\":", (i == 0) ? 6 : 7);
+      IA_catText(&S, ID, 4, Form);
+      n = sprintf(Num, ",\"start\":%ld", Lim->Start);
+      IA_cat(&S, Num, n);
+      n = sprintf(Num, ",\"end\":%ld}", End);
+      IA_cat(&S, Num, n);
+    }
+    else {
+      if (i > 0)
+        IA_cat(&T, ";", 1);
+      IA_cat(&T, ID, 4);
+      n = sprintf(Num, ":%ld-%ld", Lim->Start, End);
+      IA_cat(&T, Num, n);
+    }
+  }
+  if (Form == IA_JSON)
+    IA_cat(&S, "]", 1);
+  else {
+    IA_cat(&S, ",", 1);
+    IA_catText(&S, T.s, T.n, Form);
+    T.n = 0;
+  }
+
+/* Information records (null terminated strings) */
+  if (Form == IA_JSON)
+    IA_cat(&S, ",\"info\":[", 9);
+  for (i = 0; i < AFp->AFInfo.N; i += Lrec + 1) {
+    Lrec = (int) strlen(&AFp->AFInfo.Info[i]);
+    if (Form == IA_JSON) {
+      if (i > 0)
+        IA_cat(&S, ",", 1);
+      IA_catText(&S, &AFp->AFInfo.Info[i], Lrec, Form);
+    }
+    else {
+      if (i > 0)
+        IA_cat(&T, " | ", 3);
+      IA_cat(&T, &AFp->AFInfo.Info[i], Lrec);
+    }
+  }
+  if (Form == IA_JSON)
+    IA_cat(&S, "]}\n", 3);
+  else {
+    IA_cat(&S, ",", 1);
+    IA_catText(&S, T.s, T.n, Form);
+    IA_cat(&S, "\n", 1);
+  }
+  UTfree(T.s);
+
+  return S.s;
+}
+
+/* Append a field. The value is written as is; NULL means no value. For csv,
+   only the value appears. */
+
+
+static void
+IA_field(struct IA_str *S, const char Key[], const char Value[], int Form)
+
+{
+  if (Form == IA_JSON) {
+    IA_cat(S, ",\"", 2);
+    IA_cat(S, Key, (int) strlen(Key));
+    IA_cat(S, "\":", 2);
+    if (Value == NULL)
+      IA_cat(S, "null", 4);
+    else if (Value[0] == '"' || isdigit((unsigned char) Value[0])
+             || Value[0] == '-')
+      IA_cat(S, Value, (int) strlen(Value));
+    else {
+      IA_cat(S, "\"", 1);
+      IA_cat(S, Value, (int) strlen(Value));
+      IA_cat(S, "\"", 1);
+    }
+  }
+  else {
+    IA_cat(S, ",", 1);
+    if (Value != NULL) {
+      if (Value[0] == '"')
+        IA_cat(S, &Value[1], (int) strlen(Value) - 2);
+      else
+        IA_cat(S, Value, (int) strlen(Value));
+    }
+  }
+}
+
+/* Append n characters of text as a string value
+   - Characters with codes 0x80 and above (e.g. UTF-8 sequences) are copied
+     unchanged
+   - json: the string is quoted, with escapes for '"', '\' and the control
+     characters (\n, \r, \t or \u00XX)
+   - csv: the string is quoted (with '"' doubled) if it contains a comma, a
+     quote or a control character; control characters are copied unchanged
+*/
+
+
+static void
+IA_catText(struct IA_str *S, const char Str[], int n, int Form)
+
+{
+  int i, Quote;
+  unsigned char c;
+  char Esc[7];
+
+  Quote = (Form == IA_JSON);
+  for (i = 0; i < n && !Quote; ++i) {
+    c = (unsigned char) Str[i];
+    Quote = (c == ',' || c == '"' || IA_CNTRL(c));
+  }
+
+  if (Quote)
+    IA_cat(S, "\"", 1);
+  for (i = 0; i < n; ++i) {
+    c = (unsigned char) Str[i];
+    if (c == '"')
+      IA_cat(S, (Form == IA_JSON) ? "\\\"" : "\"\"", 2);
+    else if (Form == IA_JSON && c == '\\')
+      IA_cat(S, "\\\\", 2);
+    else if (Form == IA_JSON && IA_CNTRL(c)) {
+      if (c == '\n' || c == '\r' || c == '\t')
+        IA_cat(S, (c == '\n') ? "\\n" : ((c == '\r') ? "\\r" : "\\t"), 2);
+      else {
+        sprintf(Esc, "\\u%04X", (unsigned int) c);
+        IA_cat(S, Esc, 6);
+      }
+    }
+    else
+      IA_cat(S, &Str[i], 1);
+  }
+  if (Quote)
+    IA_cat(S, "\"", 1);
+}
+
+/* Append n characters to a growing string */
+
+
+static void
+IA_cat(struct IA_str *S, const char Str[], int n)
+
+{
+  if (S->n + n + 1 > S->nmax) {
+    S->nmax = S->n + n + 1 + NSTR_INC;
+    S->s = (char *) UTrealloc(S->s, S->nmax);
+  }
+  memcpy(&S->s[S->n], Str, (size_t) n);
+  S->n += n;
+  S->s[S->n] = '\0';
+}
+
+/* List the entries in a directory (except "." and ".."), returns the number
+   of entries or -1 if the directory cannot be read */
+
+
+static int
+IA_listDir(const char Dname[], char ***Names)
+
+{
+  int N, Nmax;
+  const char *Ename;
+  char **List;
+#if (SY_POSIX)
+  DIR *dp;
+  struct dirent *de;
+#else
+  struct _finddata_t fd;
+  intptr_t h;
+  char Pattern[FILENAME_MAX];
+#endif
+
+  N = 0;
+  Nmax = 0;
+  List = NULL;
+
+#if (SY_POSIX)
+  dp = opendir(Dname);
+  if (dp == NULL)
+    return -1;
+  while ((de = readdir(dp)) != NULL) {
+    Ename = de->d_name;
+#else
+  FLjoinNames(Dname, "*", Pattern);
+  h = _findfirst(Pattern, &fd);
+  if (h == -1)
+    return -1;
+  do {
+    Ename = fd.name;
+#endif
+
+    if (strcmp(Ename, ".") == 0 || strcmp(Ename, "..") == 0)
+      continue;
+    if (N >= Nmax) {
+      Nmax += NNAME_INC;
+      List = (char **) UTrealloc(List, (int) (Nmax * sizeof(char *)));
+    }
+    List[N] = (char *) UTmalloc((int) strlen(Ename) + 1);
+    strcpy(List[N], Ename);
+    ++N;
+
+#if (SY_POSIX)
+  }
+  closedir(dp);
+#else
+  } while (_findnext(h, &fd) == 0);
+  _findclose(h);
+#endif
+
+  *Names = List;
+  return N;
+}
+
+/* Compare names for qsort */
+
+
+static int
+IA_cmpName(const void *a, const void *b)
+
+{
+  return strcmp(*(char * const *) a, *(char * const *) b);
+}
@@ -48,6 +48,39 @@ Description:
   Non-printing characters (as defined by the routine isprint) in the information
   records are replaced by question marks.
 
+  Scan mode:
+  With the csv or json output formats, the program writes one record (normally
+  one line) per audio file. This mode is intended for listing the properties of
+  large collections of audio files. An input name can be a directory, in which
+  case all files in the directory tree are listed (symbolic links to
+  directories within the tree are skipped). An input name "-" means that a list
+  of file names, one per line, is read from standard input. There is no limit
+  on the number of files. The files are opened concurrently by a number of
+  threads (option -j), in batches of 512 files. Only the file headers are read
+  (header-only open, see AFoptions). The records are written in the order of
+  the file names; for a directory, the entries are sorted by name.
+
+  Each record gives the file name, a status ("ok" or "error"), the file type,
+  the data format, the data byte order, the sampling frequency, the number of
+  channels, the number of frames (empty or null if not known from the header),
+  the offset to the data, the chunk layout (chunk ID, first and last byte) and
+  the information records. Files that cannot be opened as audio files are
+  listed with status "error" and no other values. For csv output, the first
+  line names the fields,
+    name,status,type,format,byte_order,sfreq,nchan,nframe,data_offset,chunks,
+    info
+  (a single line). The chunk layout is a list of ID:first-last separated by
+  semicolons and the information records are separated by " | ". Fields are
+  quoted if necessary. For json output, each line is a JSON object, with the
+  chunk layout as an array of objects {"id":, "start":, "end":} and the
+  information records as an array of strings. Characters with codes 0x80 and
+  above (e.g. UTF-8 characters) in the file name and information records are
+  written unchanged. Control characters (e.g. newlines) are escaped for json
+  (\n or \u00XX). For csv, a field with a control character is quoted and the
+  control character is written unchanged, so that such a record can span
+  lines. Non-printing characters in chunk ID's are replaced by question
+  marks.
+
 Options:
   Input file names, AFile1 [AFile2 ... ]:
       The environment variable AUDIOPATH specifies a list of directories to be
@@ -62,7 +95,19 @@ Options:
         8:  Print the chunk configuration (only for AIFF/WAVE/NSP files)
       The default is to print all of the information (ICODE=15). For ICODE=0,
       no information is printed, but the program return code indicates if all
-      files were opened successfully.
+      files were opened successfully. This option applies to the text output
+      format.
+  -f FORM, --format=FORM
+      Output format, "text", "csv" or "json". The default is "text". The csv
+      and json formats select scan mode (see above).
+  -j NTHREAD, --threads=NTHREAD
+      Number of threads used to open the files in scan mode, default 4.
+  --stats
+      Print data transfer statistics for the audio files when they are closed
+      (requests, bytes, read/write calls, seeks and times).
+  --lazy-info
+      Defer decoding the information records (LIST/INFO, bext and DISP
+      chunks) of random access WAVE input files until they are used.
   -h, --help
       Print a list of options and exit.
   -v, --version
@@ -96,15 +141,22 @@ int
 main(int argc, const char *argv[])
 
 {
-  struct IA_FIpar FI[MAXFILE];
+  struct IA_FIpar *FI;
   AFILE *AFp;
   FILE *fpinfo;
-  int i, Icode, Nfiles;
+  int i, Icode, Form, Nthread, Nfiles;
   long int Nsamp, Nchan;
   double Sfreq;
 
 /* Option handling */
-  IAoptions(argc, argv, &Icode, FI, &Nfiles);
+  IAoptions(argc, argv, &Icode, &Form, &Nthread, &FI, &Nfiles);
+
+/* Scan mode, one record per file */
+  if (Form != IA_TEXT) {
+    IAscan(FI, Nfiles, Form, Nthread);
+    UTfree(FI);
+    return EXIT_SUCCESS;
+  }
 
 /* Loop over the input files */
   for (i = 0; i < Nfiles; ++i) {
@@ -143,5 +195,7 @@ main(int argc, const char *argv[])
       fprintf(fpinfo, "\n");
 
   }
+  UTfree(FI);
+
   return EXIT_SUCCESS;
 }
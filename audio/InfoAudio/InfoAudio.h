@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.61 $  $Date: 2020/11/30 12:32:35 $
+  $Revision: 1.64 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -25,15 +25,23 @@ Author / revision:
 
 #define AFPATH_ENV  "$AUDIOPATH"
 
-#define MAXFILE   100
+#define NFILE_INC   64    /* Increment for the file list allocation */
+#define NTHREAD_DEFAULT 4   /* Threads for scanning files */
+
+/* Output formats */
+#define IA_TEXT   0     /* Text, several lines per file */
+#define IA_CSV    1     /* Comma separated values, one line per file */
+#define IA_JSON   2     /* JSON object, one line per file */
 
 #define IA_FIpar  AO_FIpar  /* Input file structure */
 
 /* Error messages */
+#define IAM_BadForm     "Invalid output format"
 #define IAM_BadInfoCode "Invalid info code parameter"
+#define IAM_BadNthread  "Invalid number of threads"
 #define IAM_LateFPar    "Input file parameter specified after input files"
 #define IAM_NoFName     "No filenames specified"
-#define IAM_XFName      "Too many filenames specified"
+#define IAM_OpenDir     "Cannot open directory"
 
 /* Printout formats */
 #define IAM_ByteStream  "File byte order: byte-stream\n"
@@ -53,15 +61,19 @@ Author / revision:
 
 /* Usage */
 #define IAMF_Usage "\
-Usage: %s [options] AFile\n\
+Usage: %s [options] AFile1 [AFile2 ... ]\n\
 Options:\n\
   -i ICODE, --info_code=ICODE Information to be printed (ICODE: 1+2+4).\n\
+  -f FORM, --format=FORM      Output format, \"text\", \"csv\", \"json\".\n\
+  -j NTHREAD, --threads=NTHREAD  Number of threads for csv/json output.\n\
   -t FTYPE, --type=FTYPE      Input file type,\n\
                               \"auto\", \"AIFF\", \"AU\", \"WAVE\", \"text-audio\"\n\
                               \"noheader\", \"IRCAM\", \"SPHERE\", \"ESPS\", \"INRS\",\n\
                               \"SPPACK\", \"SPW\", \"NSP\".\n\
   -P PARMS, --parameters=PARMS  Parameters for input files,\n\
                               \"Format,Start,Sfreq,Swapb,Nchan,FullScale\".\n\
+  --stats                     Print data transfer statistics.\n\
+  --lazy-info                 Decode WAVE information records on use.\n\
   -h, --help                  Print a list of options and exit.\n\
   -v, --version               Print the version number and exit."
 
@@ -71,11 +83,13 @@ extern "C" {
 
 /* Prototypes */
 
-void
-IAoptions(int argc, const char *argv[], int *Icode,
-          struct IA_FIpar FI[MAXFILE], int *Nfiles);
 void
 IAfileInfo(const AFILE *AFp, const char Fname[], FILE *fpinfo);
+void
+IAoptions(int argc, const char *argv[], int *Icode, int *Form, int *Nthread,
+          struct IA_FIpar **FI, int *Nfiles);
+void
+IAscan(const struct IA_FIpar FI[], int Nfiles, int Form, int Nthread);
 
 #ifdef __cplusplus
 }
@@ -43,6 +43,7 @@ Author / revision:
 #include "ResampAudio.h"
 
 #define MAXV(a, b)  (((a) > (b)) ? (a) : (b))
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
 #define CHECKSYM(x,N) ((int) (1.00001 * VRdCorSym(x,N)))
 
 static void
@@ -53,6 +54,8 @@ RS_readFilt(const char Fname[], const struct Fspec_T *Fspec, double h[],
             int *Ncof, int *Ir, double *Del, FILE *fpinfo);
 static void
 RS_polyphase(const double h[], int Ncof, int Ir, struct Fpoly_T *PF);
+static int
+RS_pairWin(const struct Fpoly_T *PF, int i, int *Woffs);
 
 
 void
@@ -251,8 +254,10 @@ static void
 RS_polyphase(const double h[], int Ncof, int Ir, struct Fpoly_T *PF)
 
 {
-  int i, j, m, mst, nc;
-  int Ncmax;
+  int i, j, k, m, mst, nc, ip;
+  int Ncmax, L, Lr, Lp, Woffs;
+  double *g;
+  struct Fpair_T *P;
 
   /* Allocate storage for the polyphase filter parameters */
   /* Include room for pointers to an extra subfilter */
@@ -307,4 +312,61 @@ RS_polyphase(const double h[], int Ncof, int Ir, struct Fpoly_T *PF)
   PF->hs[Ir] = PF->hs[0]; /* Same coefficients */
   PF->Nc[Ir] = PF->Nc[0]; /* Same number of coefficients */
   PF->offs[Ir] = PF->offs[0]-1; /* Adjust the offset */
+
+  /*
+    Set up the bracketing subfilter pairs (mr, mr+1) for the interpolation.
+    Subfilter i uses the data values x[n-offs[i]-m], 0 <= m < Nc[i]. The pair
+    uses a common data window covering the data values for both subfilters,
+      x[n-Woffs+k], 0 <= k < L, where Woffs = max(offs[i]+Nc[i]) - 1.
+    The coefficients are stored in reversed order with zero padding,
+      g[i][k] = hs[i][m],  k = Woffs - offs[i] - m.
+    The coefficients for each pair are in contiguous storage, with the length
+    rounded up to a multiple of 4.
+  */
+  PF->Pair = (struct Fpair_T *) UTmalloc(Ir * sizeof(struct Fpair_T));
+  Lp = 0;
+  for (i = 0; i < Ir; ++i) {
+    L = RS_pairWin(PF, i, &Woffs);
+    Lp += 2 * (((L + 3) / 4) * 4);
+  }
+  PF->gp = (double *) UTmalloc(MAXV(Lp, 1) * sizeof(double));
+
+  g = PF->gp;
+  for (i = 0; i < Ir; ++i) {
+    P = &PF->Pair[i];
+    L = RS_pairWin(PF, i, &Woffs);
+    Lr = ((L + 3) / 4) * 4;
+    P->Woffs = Woffs;
+    P->L = L;
+    for (k = 0; k < 2; ++k) {
+      ip = i + k;
+      for (m = 0; m < Lr; ++m)
+        g[m] = 0.0;
+      for (m = 0; m < PF->Nc[ip]; ++m)
+        g[Woffs - PF->offs[ip] - m] = PF->hs[ip][m];
+      P->g[k] = g;
+      P->ks[k] = Woffs - PF->offs[ip] - PF->Nc[ip] + 1;
+      P->kn[k] = PF->Nc[ip];
+      g += Lr;
+    }
+  }
+}
+
+/* Common data window for subfilters i and i+1 */
+
+
+static int
+RS_pairWin(const struct Fpoly_T *PF, int i, int *Woffs)
+
+{
+  int ist, iend;
+
+  /* Window from x[n-iend] to x[n-ist] */
+  ist = MINV(PF->offs[i], PF->offs[i+1]);
+  iend = MAXV(PF->offs[i] + PF->Nc[i], PF->offs[i+1] + PF->Nc[i+1]) - 1;
+  if (iend < ist)
+    iend = ist - 1;     /* Empty window */
+
+  *Woffs = iend;
+  return iend - ist + 1;
 }
@@ -2,8 +2,8 @@
                              McGill University
 
 Routine:
-  void RSinterp(const double x[], int Nxm, double y[], int Ny, double Ds,
-                const struct Tval_T *T, const struct Fpoly_T *PF)
+  void RSinterp(const double x[], int Nxm, int Nchan, double y[], int Ny,
+                double Ds, const struct Tval_T *T, const struct Fpoly_T *PF)
 
 Purpose:
   Interpolate data values in an array using an interpolation filter
@@ -18,15 +18,30 @@ Description:
   is used between the bracketing points to generate the output value
   corresponding to one time value.
 
+  The two bracketing subfilters are evaluated together in a single pass over a
+  common data window, using the reversed and zero-padded coefficient layout
+  set up in PF->Pair. When compiled with AVX2 and FMA instructions enabled
+  (e.g. -mavx2 -mfma), vectorized versions of the inner products are used.
+
+  Multichannel data is processed frame by frame. The data is channel
+  interleaved, both for the input and the output. The time position, the
+  subfilter index and the interpolation fraction are calculated once for each
+  output frame and applied to all channels. The inner products are calculated
+  for groups of four channels at a time, with the channel being the innermost
+  (vector) dimension. The results differ from those for single channel data
+  only by round-off error.
+
 Parameters:
    -> const double x[]
-      Input data array of size Nx+lmem
+      Input data array of size (Nx+lmem)*Nchan (channel interleaved)
    -> int Nxm
-      Number of data samples
+      Number of data frames
+   -> int Nchan
+      Number of channels
   <-  double y[]
-      Output data array of size Ny
+      Output data array of size Ny*Nchan (channel interleaved)
    -> int Ny
-      Number of output values to be generated
+      Number of output frames to be generated
    -> double Ds
       Normalizing value for the time increment specification
    -> const struct Tval_T *T
@@ -36,41 +51,62 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.14 $  $Date: 2020/11/23 18:31:59 $
+  $Revision: 1.15 $  $Date: 2020/12/05 10:40:00 $
 
 -------------------------------------------------------------------------*/
 
 #include <assert.h>
+#include <math.h>
+
+#if (defined(__AVX2__) && defined(__FMA__))
+#  include <immintrin.h>
+#  define RS_AVX2
+#endif
 
 #include "ResampAudio.h"
 
 #define EPS 1E-10
 
 static double
-RS_conv(const double *xp, const double h[], int Nc);
+RS_dot(const double x[], const double g[], int N);
+static void
+RS_dot2(const double x[], const double g0[], const double g1[], int N,
+        double *y0, double *y1);
+static void
+RS_dotMC(const double x[], const double g[], int N, int Nchan, double y[]);
+static void
+RS_dot2MC(const double x[], const double g0[], const double g1[], int N,
+          int Nchan, double p, double y[]);
 
 
 void
-RSinterp(const double x[], int Nxm, double y[], int Ny, double Ds,
+RSinterp(const double x[], int Nxm, int Nchan, double y[], int Ny, double Ds,
          const struct Tval_T *T, const struct Fpoly_T *PF)
 
 {
   double yl, yh;
-  int lmem, i, n, mr;
+  int i, n, mr, Dint;
   int Ir;
-  const double **hs;
-  const int *offs, *Nc;
+  long int Dq, Dr;
+  const struct Fpair_T *P;
+  const double *xw;
+  double *yf;
   double tir, p;
   struct Tval_T To;
 
-  hs = (const double **) PF->hs;
-  offs = PF->offs;
-  Nc = PF->Nc;
   Ir = PF->Ir;
-  lmem = PF->Ncmax - 1;
 
   To = *T;
-  To.n = lmem;
+  To.n = PF->Ncmax - 1;
+
+  /* For an integer time increment, precompute the quotient and remainder */
+  Dint = (Ds == floor(Ds) && Ds <= LONG_MAX);
+  Dq = 0;
+  Dr = 0;
+  if (Dint) {
+    Dq = (long int) Ds / To.M;
+    Dr = (long int) Ds - Dq * To.M;
+  }
 
   for (i = 0; i < Ny; ++i) {
 
@@ -90,24 +126,51 @@ RSinterp(const double x[], int Nxm, double y[], int Ny, double Ds,
   position. Here we avoid this arithmetic by creating an extra subfilter, which
   is the same as subfilter 0. The offset for this extra filter is that for
   subfilter 0 less one.
+
+  Pair mr holds subfilters mr and mr+1 aligned to the data window starting at
+  x[n-Woffs]. For the end points of the bracketed range, only the non-zero span
+  of one of the subfilters is used.
 */
+    P = &PF->Pair[mr];
+    xw = &x[(n - P->Woffs) * Nchan];
+
+    /* Multichannel data, all channels for the frame */
+    if (Nchan > 1) {
+      yf = &y[i*Nchan];
+      if (p <= EPS)
+        RS_dotMC(&xw[P->ks[0]*Nchan], &P->g[0][P->ks[0]], P->kn[0], Nchan, yf);
+      else if (p >= 1.0-EPS)
+        RS_dotMC(&xw[P->ks[1]*Nchan], &P->g[1][P->ks[1]], P->kn[1], Nchan, yf);
+      else
+        RS_dot2MC(xw, P->g[0], P->g[1], P->L, Nchan, p, yf);
+    }
+
     /* Sample point at the lower end of the bracketed range */
-    if (p <= EPS)
-      y[i] = RS_conv(&x[n-offs[mr]], hs[mr], Nc[mr]);
+    else if (p <= EPS)
+      y[i] = RS_dot(&xw[P->ks[0]], &P->g[0][P->ks[0]], P->kn[0]);
 
     /* Sample point at the upper end of the bracketed range */
     else if (p >= 1.0-EPS)
-      y[i] = RS_conv(&x[n-offs[mr+1]], hs[mr+1], Nc[mr+1]);
+      y[i] = RS_dot(&xw[P->ks[1]], &P->g[1][P->ks[1]], P->kn[1]);
 
     /* Sample point in the middle of the bracketed range */
     else {
-      yl = RS_conv(&x[n-offs[mr]], hs[mr], Nc[mr]);
-      yh = RS_conv(&x[n-offs[mr+1]], hs[mr+1], Nc[mr+1]);
+      RS_dot2(xw, P->g[0], P->g[1], P->L, &yl, &yh);
       y[i] = (1.0 - p) * yl + p * yh;
     }
 
     /* Update the sample pointer (n, ds, dsr) - dsr remains unchanged */
-    RSincTime(&To, Ds);
+    if (Dint) {
+      /* Same as RSincTime, without the division */
+      To.n += Dq;
+      To.dm += Dr;
+      if (To.dm >= To.M) {
+        To.dm -= To.M;
+        ++To.n;
+      }
+    }
+    else
+      RSincTime(&To, Ds);
   }
 }
 
@@ -115,54 +178,400 @@ RSinterp(const double x[], int Nxm, double y[], int Ny, double Ds,
                              McGill University
 
 Routine:
-  static double RS_conv(const double *xp, const double h[], int Nc)
+  static double RS_dot(const double x[], const double g[], int N)
+  static void RS_dot2(const double x[], const double g0[], const double g1[],
+                      int N, double *y0, double *y1)
 
 Purpose:
   Generate one filtered value
+  Generate filtered values for two filters with the same data
 
 Description:
-  The procedure convolves a set of filter coefficients with an array of data.
-  The input array is x[.]. The first N-1 samples of x[.] are past inputs.
+  These procedures form the inner product of a set of (reversed) filter
+  coefficients with an array of data,
         N-1
-    y = SUM h[j] x[N-1-j]
-        j=0
+    y = SUM g[k] x[k] .
+        k=0
+  RS_dot2 forms the inner products of the same data with two sets of
+  coefficients, loading each data value once.
+
+  The sums are accumulated in four interleaved partial sums. This breaks the
+  dependency between successive additions and allows the compiler (or the
+  AVX2 code) to process four terms at a time.
 
 Parameters:
-  <-  static double RS_conv
+  <-  static double RS_dot
       Output value
-   -> const double *xp
-      Pointer to the last element to be processed, x[Nc-1]
-   -> const double h[]
-      Array of Nc filter coefficients
-   -> int Nc
-      Number of filter coefficients
+   -> const double x[]
+      Array of N data values
+   -> const double g[]
+      Array of N filter coefficients
+   -> int N
+      Number of terms
+
+  <-  static void RS_dot2
+   -> const double x[]
+      Array of N data values
+   -> const double g0[]
+      Array of N filter coefficients for the first filter
+   -> const double g1[]
+      Array of N filter coefficients for the second filter
+   -> int N
+      Number of terms
+  <-  double *y0
+      Output value for the first filter
+  <-  double *y1
+      Output value for the second filter
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.14 $  $Date: 2020/11/23 18:31:59 $
+  $Revision: 1.15 $  $Date: 2020/12/05 10:40:00 $
 
 -------------------------------------------------------------------------*/
-
+
+#ifdef RS_AVX2
+
 static double
-RS_conv(const double *xp, const double h[], int Nc)
+RS_dot(const double x[], const double g[], int N)
 
 {
-  int l, j;
+  int k;
   double y;
-  const double *x;
+  __m256d a, b, h;
+  __m128d s;
+
+  a = _mm256_setzero_pd();
+  b = _mm256_setzero_pd();
+  for (k = 0; k + 8 <= N; k += 8) {
+    a = _mm256_fmadd_pd(_mm256_loadu_pd(&g[k]), _mm256_loadu_pd(&x[k]), a);
+    b = _mm256_fmadd_pd(_mm256_loadu_pd(&g[k+4]), _mm256_loadu_pd(&x[k+4]), b);
+  }
+  if (k + 4 <= N) {
+    a = _mm256_fmadd_pd(_mm256_loadu_pd(&g[k]), _mm256_loadu_pd(&x[k]), a);
+    k += 4;
+  }
+  h = _mm256_add_pd(a, b);
+  s = _mm_add_pd(_mm256_castpd256_pd128(h), _mm256_extractf128_pd(h, 1));
+  y = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+  for (; k < N; ++k)
+    y += g[k] * x[k];
 
-/*
-  There are many different ways to write this tight loop, including using
-  indices (as here) or using pointers with decrement and increment. Tests have
-  shown that for all compilers tested, these different idioms result in equally
-  fast execution.
-*/
+  return y;
+}
 
-  /* Convolution with filter */
-  x = xp - (Nc-1);
-  y = 0.0;
-  for (j = 0, l = Nc-1; j < Nc; ++j, --l)
-    y += h[j] * x[l];
+static void
+RS_dot2(const double x[], const double g0[], const double g1[], int N,
+        double *y0, double *y1)
 
-  return y;
+{
+  int k;
+  double s0, s1;
+  __m256d a0, a1, b0, b1, xv;
+  __m128d s;
+
+  a0 = _mm256_setzero_pd();
+  a1 = _mm256_setzero_pd();
+  b0 = _mm256_setzero_pd();
+  b1 = _mm256_setzero_pd();
+  for (k = 0; k + 8 <= N; k += 8) {
+    xv = _mm256_loadu_pd(&x[k]);
+    a0 = _mm256_fmadd_pd(_mm256_loadu_pd(&g0[k]), xv, a0);
+    b0 = _mm256_fmadd_pd(_mm256_loadu_pd(&g1[k]), xv, b0);
+    xv = _mm256_loadu_pd(&x[k+4]);
+    a1 = _mm256_fmadd_pd(_mm256_loadu_pd(&g0[k+4]), xv, a1);
+    b1 = _mm256_fmadd_pd(_mm256_loadu_pd(&g1[k+4]), xv, b1);
+  }
+  if (k + 4 <= N) {
+    xv = _mm256_loadu_pd(&x[k]);
+    a0 = _mm256_fmadd_pd(_mm256_loadu_pd(&g0[k]), xv, a0);
+    b0 = _mm256_fmadd_pd(_mm256_loadu_pd(&g1[k]), xv, b0);
+    k += 4;
+  }
+
+  /* Horizontal sums */
+  a0 = _mm256_add_pd(a0, a1);
+  b0 = _mm256_add_pd(b0, b1);
+  s = _mm_add_pd(_mm256_castpd256_pd128(a0), _mm256_extractf128_pd(a0, 1));
+  s0 = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+  s = _mm_add_pd(_mm256_castpd256_pd128(b0), _mm256_extractf128_pd(b0, 1));
+  s1 = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+  for (; k < N; ++k) {
+    s0 += g0[k] * x[k];
+    s1 += g1[k] * x[k];
+  }
+
+  *y0 = s0;
+  *y1 = s1;
+}
+
+#else
+
+static double
+RS_dot(const double x[], const double g[], int N)
+
+{
+  int k;
+  double a0, a1, a2, a3;
+
+  a0 = 0.0;
+  a1 = 0.0;
+  a2 = 0.0;
+  a3 = 0.0;
+  for (k = 0; k + 4 <= N; k += 4) {
+    a0 += g[k] * x[k];
+    a1 += g[k+1] * x[k+1];
+    a2 += g[k+2] * x[k+2];
+    a3 += g[k+3] * x[k+3];
+  }
+  for (; k < N; ++k)
+    a0 += g[k] * x[k];
+
+  return (a0 + a1) + (a2 + a3);
+}
+
+static void
+RS_dot2(const double x[], const double g0[], const double g1[], int N,
+        double *y0, double *y1)
+
+{
+  int k;
+  double a0, a1, a2, a3, b0, b1, b2, b3;
+
+  a0 = 0.0;
+  a1 = 0.0;
+  a2 = 0.0;
+  a3 = 0.0;
+  b0 = 0.0;
+  b1 = 0.0;
+  b2 = 0.0;
+  b3 = 0.0;
+  for (k = 0; k + 4 <= N; k += 4) {
+    a0 += g0[k] * x[k];
+    b0 += g1[k] * x[k];
+    a1 += g0[k+1] * x[k+1];
+    b1 += g1[k+1] * x[k+1];
+    a2 += g0[k+2] * x[k+2];
+    b2 += g1[k+2] * x[k+2];
+    a3 += g0[k+3] * x[k+3];
+    b3 += g1[k+3] * x[k+3];
+  }
+  for (; k < N; ++k) {
+    a0 += g0[k] * x[k];
+    b0 += g1[k] * x[k];
+  }
+
+  *y0 = (a0 + a1) + (a2 + a3);
+  *y1 = (b0 + b1) + (b2 + b3);
+}
+
+#endif
+
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  static void RS_dotMC(const double x[], const double g[], int N, int Nchan,
+                       double y[])
+  static void RS_dot2MC(const double x[], const double g0[],
+                        const double g1[], int N, int Nchan, double p,
+                        double y[])
+
+Purpose:
+  Generate one filtered frame of multichannel data
+  Generate one interpolated frame of multichannel data from two filters
+
+Description:
+  These procedures form the inner products of a set of (reversed) filter
+  coefficients with channel-interleaved data. For channel c,
+           N-1
+    y[c] = SUM g[k] x[k*Nchan+c] .
+           k=0
+  RS_dot2MC forms the inner products of the same data with two sets of
+  coefficients and combines them by linear interpolation,
+    y[c] = (1-p) y0[c] + p y1[c] .
+
+  The channels are processed in groups of four, with one partial sum for each
+  channel. Each filter coefficient is loaded once for the group. The remaining
+  channels are processed one at a time, with four interleaved partial sums.
+
+Parameters:
+  <-  static void RS_dotMC
+   -> const double x[]
+      Array of N*Nchan data values
+   -> const double g[]
+      Array of N filter coefficients
+   -> int N
+      Number of terms
+   -> int Nchan
+      Number of channels
+  <-  double y[]
+      Output values, Nchan values
+
+  <-  static void RS_dot2MC
+   -> const double x[]
+      Array of N*Nchan data values
+   -> const double g0[]
+      Array of N filter coefficients for the first filter
+   -> const double g1[]
+      Array of N filter coefficients for the second filter
+   -> int N
+      Number of terms
+   -> int Nchan
+      Number of channels
+   -> double p
+      Interpolation fraction
+  <-  double y[]
+      Output values, Nchan values
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.16 $  $Date: 2020/12/07 09:30:00 $
+
+-------------------------------------------------------------------------*/
+
+
+static void
+RS_dotMC(const double x[], const double g[], int N, int Nchan, double y[])
+
+{
+  int c, k;
+  const double *xc;
+  double a0, a1, a2, a3;
+#ifdef RS_AVX2
+  __m256d a;
+#endif
+
+  c = 0;
+
+#ifdef RS_AVX2
+  for (; c + 4 <= Nchan; c += 4) {
+    a = _mm256_setzero_pd();
+    xc = &x[c];
+    for (k = 0; k < N; ++k, xc += Nchan)
+      a = _mm256_fmadd_pd(_mm256_broadcast_sd(&g[k]), _mm256_loadu_pd(xc), a);
+    _mm256_storeu_pd(&y[c], a);
+  }
+#endif
+
+  /* Groups of four channels */
+  for (; c + 4 <= Nchan; c += 4) {
+    a0 = 0.0;
+    a1 = 0.0;
+    a2 = 0.0;
+    a3 = 0.0;
+    xc = &x[c];
+    for (k = 0; k < N; ++k, xc += Nchan) {
+      a0 += g[k] * xc[0];
+      a1 += g[k] * xc[1];
+      a2 += g[k] * xc[2];
+      a3 += g[k] * xc[3];
+    }
+    y[c] = a0;
+    y[c+1] = a1;
+    y[c+2] = a2;
+    y[c+3] = a3;
+  }
+
+  /* Remaining channels */
+  for (; c < Nchan; ++c) {
+    a0 = 0.0;
+    a1 = 0.0;
+    a2 = 0.0;
+    a3 = 0.0;
+    xc = &x[c];
+    for (k = 0; k + 4 <= N; k += 4, xc += 4*Nchan) {
+      a0 += g[k] * xc[0];
+      a1 += g[k+1] * xc[Nchan];
+      a2 += g[k+2] * xc[2*Nchan];
+      a3 += g[k+3] * xc[3*Nchan];
+    }
+    for (; k < N; ++k, xc += Nchan)
+      a0 += g[k] * xc[0];
+    y[c] = (a0 + a1) + (a2 + a3);
+  }
+}
+
+static void
+RS_dot2MC(const double x[], const double g0[], const double g1[], int N,
+          int Nchan, double p, double y[])
+
+{
+  int c, k;
+  const double *xc;
+  double a0, a1, a2, a3, b0, b1, b2, b3;
+#ifdef RS_AVX2
+  __m256d a, b, xv;
+#endif
+
+  c = 0;
+
+#ifdef RS_AVX2
+  for (; c + 4 <= Nchan; c += 4) {
+    a = _mm256_setzero_pd();
+    b = _mm256_setzero_pd();
+    xc = &x[c];
+    for (k = 0; k < N; ++k, xc += Nchan) {
+      xv = _mm256_loadu_pd(xc);
+      a = _mm256_fmadd_pd(_mm256_broadcast_sd(&g0[k]), xv, a);
+      b = _mm256_fmadd_pd(_mm256_broadcast_sd(&g1[k]), xv, b);
+    }
+    a = _mm256_mul_pd(_mm256_set1_pd(1.0 - p), a);
+    _mm256_storeu_pd(&y[c], _mm256_fmadd_pd(_mm256_set1_pd(p), b, a));
+  }
+#endif
+
+  /* Groups of four channels */
+  for (; c + 4 <= Nchan; c += 4) {
+    a0 = 0.0;
+    a1 = 0.0;
+    a2 = 0.0;
+    a3 = 0.0;
+    b0 = 0.0;
+    b1 = 0.0;
+    b2 = 0.0;
+    b3 = 0.0;
+    xc = &x[c];
+    for (k = 0; k < N; ++k, xc += Nchan) {
+      a0 += g0[k] * xc[0];
+      b0 += g1[k] * xc[0];
+      a1 += g0[k] * xc[1];
+      b1 += g1[k] * xc[1];
+      a2 += g0[k] * xc[2];
+      b2 += g1[k] * xc[2];
+      a3 += g0[k] * xc[3];
+      b3 += g1[k] * xc[3];
+    }
+    y[c] = (1.0 - p) * a0 + p * b0;
+    y[c+1] = (1.0 - p) * a1 + p * b1;
+    y[c+2] = (1.0 - p) * a2 + p * b2;
+    y[c+3] = (1.0 - p) * a3 + p * b3;
+  }
+
+  /* Remaining channels */
+  for (; c < Nchan; ++c) {
+    a0 = 0.0;
+    a1 = 0.0;
+    a2 = 0.0;
+    a3 = 0.0;
+    b0 = 0.0;
+    b1 = 0.0;
+    b2 = 0.0;
+    b3 = 0.0;
+    xc = &x[c];
+    for (k = 0; k + 4 <= N; k += 4, xc += 4*Nchan) {
+      a0 += g0[k] * xc[0];
+      b0 += g1[k] * xc[0];
+      a1 += g0[k+1] * xc[Nchan];
+      b1 += g1[k+1] * xc[Nchan];
+      a2 += g0[k+2] * xc[2*Nchan];
+      b2 += g1[k+2] * xc[2*Nchan];
+      a3 += g0[k+3] * xc[3*Nchan];
+      b3 += g1[k+3] * xc[3*Nchan];
+    }
+    for (; k < N; ++k, xc += Nchan) {
+      a0 += g0[k] * xc[0];
+      b0 += g1[k] * xc[0];
+    }
+    y[c] = (1.0 - p) * ((a0 + a1) + (a2 + a3)) + p * ((b0 + b1) + (b2 + b3));
+  }
 }
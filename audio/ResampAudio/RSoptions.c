@@ -4,7 +4,7 @@
 Routine:
   void RSoptions(int argc, const char *argv[], struct FA_FIpar *FI,
                  double *Soffs, double *Sratio, struct Fspec_T *Fspec,
-                 struct FA_FOpar *FO)
+                 int *Nthread, struct FA_FOpar *FO)
 
 Purpose:
   Decode options for ResampAudio
@@ -25,12 +25,14 @@ Parameters:
       Sampling rate ratio
   <-  struct Fspec_T *Fspec
       Filter specification structure
+  <-  int *Nthread
+      Number of threads
   <-  struct RS_FOpar *FO
       Output file parameters
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.22 $  $Date: 2020/11/23 18:31:59 $
+  $Revision: 1.23 $  $Date: 2020/12/06 14:10:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -45,17 +47,19 @@ static const char *OptTable[] = {
   "-i#", "--int*erpolate=",
   "-a#", "--a*lignment=",
   "-f#", "--f*ilter_spec=",
+  "-j#", "--th*reads=",
   NULL
 };
 
 
 void
 RSoptions(int argc, const char *argv[], struct RS_FIpar *FI, double *Soffs,
-          double *Sratio, struct Fspec_T *Fspec, struct RS_FOpar *FO)
+          double *Sratio, struct Fspec_T *Fspec, int *Nthread,
+          struct RS_FOpar *FO)
 
 {
   const char *OptArg;
-  int n, nF;
+  int n, nF, nthread;
   double Nv, Dv, sratio, soffs;
 
 /* Input file defaults */
@@ -68,6 +72,7 @@ RSoptions(int argc, const char *argv[], struct RS_FIpar *FI, double *Soffs,
   sratio = -1.0;
   soffs = 0.0;
   Fspec_T_INIT(Fspec);
+  nthread = 1;
 
 /* Initialization */
   UTsetProg(PROGRAM);
@@ -130,6 +135,12 @@ RSoptions(int argc, const char *argv[], struct RS_FIpar *FI, double *Soffs,
       /* Filter specs */
       RSfiltSpec(OptArg, Fspec);
       break;
+    case 7:
+    case 8:
+      /* Number of threads */
+      if (STdec1int(OptArg, &nthread) || nthread <= 0)
+        ERRSTOP(RSM_BadNthread, OptArg);
+      break;
     default:
       assert(0);
       break;
@@ -145,4 +156,5 @@ RSoptions(int argc, const char *argv[], struct RS_FIpar *FI, double *Soffs,
 /* Set return values */
   *Soffs = soffs;
   *Sratio = sratio;
+  *Nthread = nthread;
 }
@@ -2,22 +2,23 @@
                              McGill University
 
 Routine:
-  int RSrefresh(AFILE *AFpI, long int offs, double x[], int Nx)
+  int RSrefresh(AFILE *AFpI, long int offs, double x[], int Nx,
+                struct Xbuf_T *Xb)
 
 Purpose:
   Read audio data into a buffer, reusing data in the buffer
 
 Description:
   This procedure updates a data buffer with samples beginning at offset offs in
-  the audio file. It keeps internal pointers indicating the sample range present
-  in the buffer. If the offset offs is increasing with each call to this routine
+  the audio file. The structure Xb keeps pointers indicating the sample range
+  present in the buffer. If the offset offs is increasing with each call to this routine
   and the requested data partially overlaps the previous data, the old data is
   moved downward in the buffer and new data from the file is appended to the
   buffer. In other cases (moving backward for instance), this routine reads all
   of the data from the file with no attempt to reuse any overlapping data.
 
-  The internal buffer pointers can be reset by calling this routine with Nx
-  equal to zero. This routine returns the number of new samples read from the
+  The buffer pointers can be reset by calling this routine with Nx equal to
+  zero. This routine returns the number of new samples read from the
   file. On reaching the end-of-file, the number of samples read will be smaller
   than the number requested. The buffer is however padded with zeros to its full
   length.
@@ -33,6 +34,8 @@ Parameters:
       Data buffer
    -> int Nx
       Buffer length
+  <-> struct Xbuf_T *Xb
+      Sample range present in the buffer x
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
@@ -46,24 +49,22 @@ Author / revision:
 
 
 int
-RSrefresh(AFILE *AFpI, long int offs, double x[], int Nx)
+RSrefresh(AFILE *AFpI, long int offs, double x[], int Nx, struct Xbuf_T *Xb)
 
 {
-  static long int lst = 0;
-  static long int lnx = 0;
   int Nkeep, Nshift, Nout;
 
   /* Reset values */
   if (Nx == 0) {
-    lst = 0;
-    lnx = 0;
+    Xb->lst = 0;
+    Xb->lnx = 0;
     return 0;
   }
 
   /* Shift useful data that is already in the buffer */
-  if (offs < lnx && offs >= lst) {
-    Nkeep = (int) MINV(lnx - offs, Nx);
-    Nshift = (int) (offs - lst);
+  if (offs < Xb->lnx && offs >= Xb->lst) {
+    Nkeep = (int) MINV(Xb->lnx - offs, Nx);
+    Nshift = (int) (offs - Xb->lst);
     VRdShift(x, Nkeep, Nshift);
   }
   else
@@ -73,8 +74,8 @@ RSrefresh(AFILE *AFpI, long int offs, double x[], int Nx)
   Nout = AFdReadData(AFpI, offs + Nkeep, &x[Nkeep], Nx - Nkeep);
 
   /* Reset the pointers */
-  lst = offs;
-  lnx = offs + Nx;
+  Xb->lst = offs;
+  Xb->lnx = offs + Nx;
 
   return Nout;
 }
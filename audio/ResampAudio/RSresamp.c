@@ -2,8 +2,9 @@
                            McGill University
 
 Routine:
-  void RSresamp(AFILE *AFpI, AFILE *AFpO, double Sratio, long int Nout,
-                double toffs, const struct Fpoly_T *PF, FILE *fpinfo)
+  void RSresamp(AFILE *AFpI[], int Nthread, AFILE *AFpO, double Sratio,
+                long int Nout, double toffs, const struct Fpoly_T *PF,
+                FILE *fpinfo)
 
 Purpose:
   Resample data from an audio file
@@ -12,9 +13,25 @@ Description:
   This routine resamples data from one audio file and writes it to another audio
   file.
 
+  The output can be calculated by several threads. The output samples are
+  divided into segments, each a number of frames long. Each thread calculates
+  the output for one segment at a time, reading its input data through its own
+  audio file pointer (one per thread, all referring to the same input file).
+  The segments are written to the output file in order. The frame boundaries
+  and the time values at the start of each frame are the same as for a single
+  thread, so the output does not depend on the number of threads.
+
+  The threads are taken from a pool created once for the file (see AOnewPool).
+  Each thread has two output buffers. While the threads calculate a round of
+  segments into one set of buffers, the previous round is written from the
+  other set as a separate task in the same pool, so that writing the output
+  overlaps the calculations.
+
 Parameters:
-   -> AFILE *AFpI
-      Audio file pointer for the input audio file
+   -> AFILE *AFpI[]
+      Audio file pointers for the input audio file, one for each thread
+   -> int Nthread
+      Number of threads (number of input audio file pointers)
    -> AFILE *AFpO
       Audio file pointer for the output audio file
    -> double Sratio
@@ -32,7 +49,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.23 $  $Date: 2020/11/25 01:43:57 $
+  $Revision: 1.26 $  $Date: 2020/12/26 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -44,18 +61,55 @@ Author / revision:
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
 
 #define MAXBUF  8192    /* Buffer size (per channel) */
+#define NSEG    16      /* Frames per segment (multiple threads) */
+
+/* Parameters common to all threads */
+struct RS_par {
+  const struct Fpoly_T *PF;
+  double Ds;
+  long int LNs;
+  int lmem;
+  int NbufO;
+  int Nchan;
+  struct RS_work *W;
+  AFILE *AFpO;
+  int Nwr;          /* Number of segments to be written */
+};
+
+/* Thread state: input file, buffers, and the current segment */
+struct RS_work {
+  AFILE *AFpI;
+  double *buf;      /* Buffer storage */
+  double *x;        /* Input buffer, Nchan*NbufI */
+  double *y;        /* Segment output, Nchan*Nseg*NbufO */
+  double *yw;       /* Previous segment output to be written */
+  struct Xbuf_T Xb; /* Input buffer contents */
+  struct Tval_T Ts; /* Time for the first output sample in the segment */
+  long int Ny;      /* Number of output samples in the segment */
+  long int Nyw;     /* Number of output samples to be written */
+};
+
+static void
+RS_task(int it, void *Arg);
+static void
+RS_segment(int iw, void *Arg);
+static void
+RS_write(const struct RS_par *P);
 
 
 void
-RSresamp(AFILE *AFpI, AFILE *AFpO, double Sratio, long int Nout, double toffs,
-         const struct Fpoly_T *PF, FILE *fpinfo)
+RSresamp(AFILE *AFpI[], int Nthread, AFILE *AFpO, double Sratio,
+         long int Nout, double toffs, const struct Fpoly_T *PF, FILE *fpinfo)
 
 {
-  int lmem, NbufI, NbufO, Nx, Ny, Nxm, i, j;
+  int lmem, NbufI, NbufO, Ny, Nseg, Nw, i, j;
   long int k, Nchan, LNs;
   double Ds;
-  double *buf, *x, *y, *xc, *yc;
+  double *yt;
   struct Tval_T Ts;
+  struct RS_par Par;
+  struct RS_work *W;
+  struct AO_pool *Pool;
 
 /*
   General interpolation:
@@ -224,28 +278,28 @@ RSresamp(AFILE *AFpI, AFILE *AFpO, double Sratio, long int Nout, double toffs,
 /* Multi-channel data:
    The discussion above on filtering has assumed single channel data. For
    multi-channel data, each channel is filtered separately with its own memory.
-
-   For each input channel:
-   - Extract the data from one channel from the channel-interleaved signal x,
-     forming xc;
-   - Filter one channel to form the output signal yc;
-   - Place the output in the channel-interleaved vector y.
+   The data is kept in channel-interleaved form. RSinterp processes the data
+   frame by frame, calculating the filter phase for each output frame once for
+   all channels.
+
+   Multiple threads:
+   Each thread has its own set of buffers. The output for a segment of Nseg
+   frames is kept until all threads have finished their segments. There are
+   two output buffers: one is written while the other is being filled.
 */
-  assert(AFpI->Nchan == AFpO->Nchan);
-  Nchan = AFpI->Nchan;
-  if (Nchan == 1) {
-    buf = (double *) UTmalloc((NbufI + NbufO) * sizeof (double));
-    x = buf;      /* x has NbufI elements */
-    y = buf + NbufI;    /* y has NbufO elements */
-    xc = x;       /* xc is an alias for x */
-    yc = y;       /* yc is an alias for y */
-  }
-  else {
-    buf = (double *) UTmalloc((NbufI + NbufO) * (Nchan + 1) * sizeof (double));
-    x = buf;            /* x has Nchan*NbufI elements */
-    xc = buf + Nchan * NbufI; /* xc has NbufI elements */
-    yc = xc + NbufI;    /* yc has NbufO elements */
-    y = yc + NbufO;     /* y has Nchan*NbufO elements */
+  Nchan = AFpI[0]->Nchan;
+  assert(Nchan == AFpO->Nchan);
+  Nseg = (Nthread > 1) ? NSEG : 1;
+  W = (struct RS_work *) UTmalloc(Nthread * sizeof(struct RS_work));
+  for (i = 0; i < Nthread; ++i) {
+    W[i].AFpI = AFpI[i];
+    W[i].buf = (double *) UTmalloc((NbufI + 2 * Nseg * NbufO) * Nchan
+                                   * sizeof(double));
+    W[i].x = W[i].buf;                  /* x has Nchan*NbufI elements */
+    W[i].y = W[i].buf + Nchan * NbufI;  /* y has Nchan*Nseg*NbufO elements */
+    W[i].yw = W[i].y + Nchan * Nseg * NbufO;    /* yw is the same size */
+    W[i].Nyw = 0L;
+    RSrefresh(W[i].AFpI, 0L, W[i].x, 0, &W[i].Xb);  /* initialize the buffer */
   }
 
 /*
@@ -266,43 +320,113 @@ RSresamp(AFILE *AFpI, AFILE *AFpO, double Sratio, long int Nout, double toffs,
   */
   RSexpTime(toffs, LNs, &Ts);
 
-  RSrefresh(AFpI, 0L, x, 0);   /* initialize the buffer */
+  Par.PF = PF;
+  Par.Ds = Ds;
+  Par.LNs = LNs;
+  Par.lmem = lmem;
+  Par.NbufO = NbufO;
+  Par.Nchan = (int) Nchan;
+  Par.W = W;
+  Par.AFpO = AFpO;
+  Par.Nwr = 0;
+
+  /* Each round calculates up to Nthread segments and writes the segments
+     from the previous round; the last round only writes */
+  Pool = AOnewPool(Nthread);
   k = 0;
-  while (k < Nout) {
-
-    Ny = (int) MINV(NbufO, Nout - k);
-    Nx = (int) ((Ds * (Ny-1)) / LNs) + 3;
-    Nxm = Nx + lmem;
-    assert(Nxm <= NbufI);
-
-    /* Refresh the input buffer */
-    RSrefresh(AFpI, (Ts.n - lmem)*Nchan, x, Nxm*Nchan);
+  while (k < Nout || Par.Nwr > 0) {
 
-    /* Process one channel at a time */
-    for (i = 0; i < Nchan; ++i) {
+    /* Assign a segment to each thread */
+    for (Nw = 0; Nw < Nthread && k < Nout; ++Nw) {
+      W[Nw].Ts = Ts;
+      W[Nw].Ny = MINV(Nseg * NbufO, Nout - k);
 
-      if (Nchan > 1) {
-        for (j = 0; j < Nxm; ++j)
-          xc[j] = x[j*Nchan + i];
+      /* Update the time frame by frame, as is done within the segment */
+      for (j = 0; j < W[Nw].Ny; j += Ny) {
+        Ny = (int) MINV(NbufO, W[Nw].Ny - j);
+        RSincTime(&Ts, Ds*Ny);
       }
+      k += W[Nw].Ny;
+    }
 
-      /* Generate the output samples for channel i */
-      RSinterp(xc, Nxm, yc, Ny, Ds, &Ts, PF);
+    /* Generate the output samples, write the previous output */
+    AOrunPool(Pool, RS_task, &Par, Nw + 1);
 
-      if (Nchan > 1) {
-        for (j = 0; j < Ny; ++j)
-          y[j*Nchan + i] = yc[j];
-      }
+    /* Swap the output buffers */
+    for (i = 0; i < Nw; ++i) {
+      yt = W[i].yw;
+      W[i].yw = W[i].y;
+      W[i].y = yt;
+      W[i].Nyw = W[i].Ny;
     }
+    Par.Nwr = Nw;
+  }
+
+  /* Deallocate the storage */
+  AOfreePool(Pool);
+  for (i = 0; i < Nthread; ++i)
+    UTfree(W[i].buf);
+  UTfree(W);
+}
+
+/* Task it: task 0 writes the previous output, the others calculate segments
+   (task it calculates the segment assigned to thread it-1) */
+
+static void
+RS_task(int it, void *Arg)
 
-    /* Write the output data */
-    AFdWriteData(AFpO, y, Ny*Nchan);
+{
+  if (it == 0)
+    RS_write((const struct RS_par *) Arg);
+  else
+    RS_segment(it - 1, Arg);
+}
+
+/* Generate the output samples for the segment assigned to thread iw */
+
+static void
+RS_segment(int iw, void *Arg)
+
+{
+  const struct RS_par *P;
+  struct RS_work *W;
+  int Nx, Ny, Nxm, Nchan, lmem;
+  long int k;
+  struct Tval_T Ts;
+
+  P = (const struct RS_par *) Arg;
+  W = &P->W[iw];
+  Nchan = P->Nchan;
+  lmem = P->lmem;
+
+  Ts = W->Ts;
+  k = 0;
+  while (k < W->Ny) {
+
+    Ny = (int) MINV(P->NbufO, W->Ny - k);
+    Nx = (int) ((P->Ds * (Ny-1)) / P->LNs) + 3;
+    Nxm = Nx + lmem;
+
+    /* Refresh the input buffer */
+    RSrefresh(W->AFpI, (Ts.n - lmem)*Nchan, W->x, Nxm*Nchan, &W->Xb);
+
+    /* Generate the output frames */
+    RSinterp(W->x, Nxm, Nchan, &W->y[k*Nchan], Ny, P->Ds, &Ts, P->PF);
 
     /* Update the sample pointers */
     k += Ny;
-    RSincTime(&Ts, Ds*Ny);
+    RSincTime(&Ts, P->Ds*Ny);
   }
+}
 
-  /* Deallocate the storage */
-  UTfree(buf);
+/* Write the output samples from the previous round, in order */
+
+static void
+RS_write(const struct RS_par *P)
+
+{
+  int i;
+
+  for (i = 0; i < P->Nwr; ++i)
+    AFdWriteData(P->AFpO, P->W[i].yw, (int) (P->W[i].Nyw * P->Nchan));
 }
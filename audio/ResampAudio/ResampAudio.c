@@ -222,6 +222,12 @@ Options:
                             coefficients are written to the named file.
   -n NSAMPLE, --number_samples=NSAMPLE
       Number of samples (per channel) for the output file.
+  -j NTHREAD, --threads=NTHREAD
+      Number of threads used for resampling, default 1. The output is divided
+      into segments which are calculated in parallel, each thread reading the
+      input file through its own file pointer. The output does not depend on
+      the number of threads. Multiple threads are used only if the input file
+      is a seekable file (not standard input or a pipe).
   -g GAIN, --gain=GAIN
       A gain factor applied to the data from the input files. This gain applies
       to all channels in a file. The gain value can be given as a real number
@@ -237,6 +243,7 @@ Options:
                                    format.
         "WAVE-NOEX" or "wave-noex" - WAVE file; do not use the WAVE file
                                    extensible format
+        "Wave64" or "wave64"     - Wave64 file (64-bit sizes)
         "AIFF-C" or "aiff-c"     - AIFF-C sound file
         "AIFF-C/sowt" or "aiff-c/sowt" - AIFF-C (byte-swapped data)
         "AIFF" or "aiff"         - AIFF sound file
@@ -245,6 +252,21 @@ Options:
         "noheader-big-endian"    - Headerless file (big-endian byte order)
         "noheader-little-endian" - Headerless file (little-endian byte order)
         "text-audio"             - Text audio file (with header)
+  --stats
+      Print data transfer statistics for the audio files when they are closed
+      (requests, bytes, read/write calls, seeks and times), and the time for
+      the interpolation stage.
+  --mmap
+      Map the data of random access input files into memory, instead of
+      reading it with stdio calls. Files which cannot be mapped are read as
+      usual.
+  --async=N
+      Transfer the audio file data in a separate thread for each file, using
+      N buffer blocks. This lets the file reads and writes overlap the
+      processing. The default (0) transfers the data in the program thread.
+  --lazy-info
+      Defer decoding the information records (LIST/INFO, bext and DISP
+      chunks) of random access WAVE input files until they are used.
   -h, --help
       Print a list of options and exit.
   -v, --version
@@ -279,13 +301,14 @@ Environment variables:
   colons (semicolons for Windows).
 
 Author / version:
-  P. Kabal / v10r3  2020-11-30  Copyright (C) 2020
+  P. Kabal / v10r3  2020-12-06  Copyright (C) 2020
 -------------------------------------------------------------------------*/
 
 #include <stdlib.h> /* EXIT_SUCCESS */
 #include <string.h>
 
 #include <libtsp/FIpar.h>
+#include <libtsp/nucleus.h>
 #include "ResampAudio.h"
 #include <AO.h>
 
@@ -296,15 +319,18 @@ main(int argc, const char *argv[])
 {
   struct RS_FIpar FI;
   struct RS_FOpar FO;
-  long int Nsamp, Nchan, NframeI;
+  int Nthread, i;
+  long int Nsamp, Nchan, NframeI, Ns, Nc;
+  double Sf;
   AFILE *AFpI, *AFpO;
+  AFILE **AFpW;
   FILE *fpinfo;
-  double SfreqI, Soffs, Sratio, FDel, toffs;
+  double SfreqI, Soffs, Sratio, FDel, toffs, T;
   struct Fspec_T Fspec;
   struct Fpoly_T PF;
 
 /* Get the input parameters */
-  RSoptions(argc, argv, &FI, &Soffs, &Sratio, &Fspec, &FO);
+  RSoptions(argc, argv, &FI, &Soffs, &Sratio, &Fspec, &Nthread, &FO);
 
 /* If output is to stdout, use stderr for informational messages */
   if (strcmp(FO.Fname, "-") == 0)
@@ -364,16 +390,35 @@ main(int argc, const char *argv[])
     FO.Nframe = (long int) (((NframeI - 1L) - Soffs) * Sratio + 1.5);
   toffs = Soffs + FDel;     /* Time alignment, h[0] <-> toffs */
 
+/* Input file pointers, one for each thread */
+  if (Nthread > 1 && (strcmp(FI.Fname, "-") == 0 || ! FLseekable(AFpI->fp)))
+    Nthread = 1;
+  AFpW = (AFILE **) UTmalloc((Nthread + 1) * sizeof(AFILE *));
+  AFpW[0] = AFpI;
+  for (i = 1; i < Nthread; ++i) {
+    AOsetFIopt(&FI, 0, 1);
+    AFpW[i] = AFopnRead(FI.Fname, &Ns, &Nc, &Sf, NULL);
+    AFpW[i]->ScaleF = AFpI->ScaleF;
+  }
+
 /* Sample interpolation */
-  RSresamp(AFpI, AFpO, Sratio, FO.Nframe, toffs, &PF, fpinfo);
+  T = UTclock();
+  RSresamp(AFpW, Nthread, AFpO, Sratio, FO.Nframe, toffs, &PF, fpinfo);
+  AFpW[Nthread] = AFpO;     /* All files, for the stage statistics */
+  AOprStage(RSM_StageInterp, UTclock() - T, AFpW, Nthread + 1);
 
 /* Close the audio files */
+  for (i = 1; i < Nthread; ++i)
+    AFclose(AFpW[i]);
+  UTfree(AFpW);
   AFclose(AFpI);
   AFclose(AFpO);
 
 /* Clean up allocated storage */
   UTfree(PF.offs);
   MAdFreeMat(PF.hs);
+  UTfree(PF.Pair);
+  UTfree(PF.gp);
 
   return EXIT_SUCCESS;
 }
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.64 $  $Date: 2020/11/30 12:32:46 $
+  $Revision: 1.68 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -55,12 +55,27 @@ struct Fspec_T {
   double Woffs;   /* Kaier window offset (samples) */
 };
 
+/* Bracketing subfilters mr and mr+1 over a common data window
+   The window is x[n-Woffs], ..., x[n-Woffs+L-1]. The coefficients are reversed
+   and zero padded to the window, so that the output of subfilter i (0 or 1) is
+     y = SUM g[i][k] x[n-Woffs+k],  k = ks[i], ..., ks[i]+kn[i]-1
+*/
+struct Fpair_T {
+  const double *g[2]; /* Reversed coefficients, L values each */
+  int Woffs;      /* Offset of the window start relative to the time point */
+  int L;          /* Window length */
+  int ks[2];      /* Start of the non-zero coefficients in g[i] */
+  int kn[2];      /* Number of non-zero coefficients in g[i] */
+};
+
 struct Fpoly_T {
   double **hs;    /* Coefficients in subfilter order, hs[Ir+1][Ncmax] */
   int *offs;      /* Offset of first coefficient in each subfilter */
   int *Nc;        /* Number of coefficients in each subfilter */
   int Ncmax;      /* Maximum number of coefficients in any subfilter */
   int Ir;         /* Number of subfilters */
+  struct Fpair_T *Pair; /* Subfilter pairs (mr, mr+1), Pair[Ir] */
+  double *gp;     /* Storage for the reversed coefficients of the pairs */
 };
 /*
   Note that there is an extra subfilter with the Ir'th one pointing to the
@@ -77,6 +92,12 @@ struct Tval_T {
   long int M;
 };
 
+/* Sample range present in an input data buffer, lst <= n < lnx */
+struct Xbuf_T {
+  long int lst;   /* Offset of the first sample in the buffer */
+  long int lnx;   /* Offset of the sample following the buffer */
+};
+
 #define Fspec_T_INIT(p) { \
   (p)->FFile = NULL; \
   (p)->WFile = NULL; \
@@ -101,6 +122,7 @@ struct Tval_T {
 #define RSM_BadKey "Invalid keyword in filter specification"
 #define RSM_BadNCoef "Invalid number of coefficients"
 #define RSM_BadNSamp "Invalid number of samples"
+#define RSM_BadNthread "Invalid number of threads"
 #define RSM_BadRatio "Invalid interpolation ratio"
 #define RSM_BadSFreqRatio \
   "Incompatible sampling frequency and interpolation ratio"
@@ -116,6 +138,7 @@ struct Tval_T {
 #define RSM_NoFRatio "Filter ratio must be specified"
 #define RSM_NoSFreq "Output sampling rate not specified"
 #define RSM_OpenCErr "Unable to open coefficient file"
+#define RSM_StageInterp "Interpolation"
 
 #define RSM_XFName  "Too many filenames specified"
 
@@ -150,15 +173,20 @@ Options:\n\
                               N=Ncof,span=Wspan,offset=Woffs,write=fname\".\n\
   -n NSAMPLE, --number_samples=NSAMPLE  Number of output samples.\n\
   -g GAIN, --gain=GAIN        Gain factor applied to the input file.\n\
+  -j NTHREAD, --threads=NTHREAD  Number of threads for resampling.\n\
   -F FTYPE, --file-type=FTYPE  Output file type,\n\
                               \"AU\", \"WAVE\", \"WAVE-NOEX\", \"AIFF\",\n\
-                              \"AIFF-C\", \"AIFF-C/sowt\", \"noheader\",\n\
-                              \"noheader-swap\", \"text-audio\".\n\
+                              \"AIFF-C\", \"AIFF-C/sowt\", \"Wave64\",\n\
+                              \"noheader\", \"noheader-swap\", \"text-audio\".\n\
   -D DFORMAT, --data-format=DFORMAT  Data format for the output file,\n\
                               \"mu-law8\", \"mu-lawR8\", \"A-law8\", \"unsigned8\",\n\
                               \"integer8\", \"integer16\", \"integer24\",\n\
                               \"float32\", \"float64\", \"text16\", \"text\".\n\
   -I INFO, --info=INFO        Add a header information record.\n\
+  --stats                     Print data transfer statistics.\n\
+  --mmap                      Map the input file data into memory.\n\
+  --async=N                   Transfer the file data in the background.\n\
+  --lazy-info                 Decode WAVE information records on use.\n\
   -h, --help                  Print a list of options and exit.\n\
   -v, --version               Print the version number and exit.\n\
    Additional options [-t -P -S], see CopyAudio."
@@ -181,19 +209,20 @@ void
 RSintFilt(double Sratio, double Soffs, const struct Fspec_T *Fspec,
           struct Fpoly_T *PF, double *FDel, FILE *fpinfo);
 void
-RSinterp(const double x[], int Nxm, double y[], int Ny, double Ds,
+RSinterp(const double x[], int Nxm, int Nchan, double y[], int Ny, double Ds,
          const struct Tval_T *T, const struct Fpoly_T *PF);
 void
 RSoptions(int argc, const char *argv[], struct RS_FIpar *FI, double *Soffs,
-          double *Sratio, struct Fspec_T *Fspec, struct RS_FOpar *FO);
+          double *Sratio, struct Fspec_T *Fspec, int *Nthread,
+          struct RS_FOpar *FO);
 void
 RSratio(double Sratio, int Ir, long int *Ns, double *Ds, long int NsMax,
         long int DsMax, FILE *fpinfo);
 int
-RSrefresh(AFILE *AFpI, long int offs, double x[], int Nx);
+RSrefresh(AFILE *AFpI, long int offs, double x[], int Nx, struct Xbuf_T *Xb);
 void
-RSresamp(AFILE *AFpI, AFILE *AFpO, double Sratio, long int Nout,
-         double Soffs, const struct Fpoly_T *PF, FILE *fpinfo);
+RSresamp(AFILE *AFpI[], int Nthread, AFILE *AFpO, double Sratio,
+         long int Nout, double Soffs, const struct Fpoly_T *PF, FILE *fpinfo);
 void
 RSwriteCof(const char Fname[], const struct Fspec_T *Fs, const double h[]);
 
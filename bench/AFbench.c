@@ -0,0 +1,92 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  AFbench [options]
+
+Purpose:
+  Measure the throughput of the audio file and signal processing routines
+
+Description:
+  This program times the audio file data converters, the filtering routines,
+  the sample interpolation routine of ResampAudio and end-to-end runs of the
+  audio utilities. The data is synthetic (uniformly distributed pseudo-random
+  values), with a configurable number of samples. Each case is repeated a
+  number of times and the shortest time is used.
+
+  The results are written to standard output, one line per case, with
+  tab-separated fields,
+    GROUP  CASE  NSAMP  TIME  MSAMP/S  MB/S
+  GROUP is the benchmark group ("conv", "filt", "resamp" or "prog"), CASE
+  identifies the routine and its parameters, NSAMP is the number of samples
+  processed, TIME is the time in seconds, MSAMP/S is the throughput in millions
+  of samples per second and MB/S is the throughput in megabytes per second.
+  Lines starting with "#" are comments, giving the program version, the
+  parameters and the field names. The output can be saved and compared across
+  releases.
+
+  conv: Each data format converter used by AFdWriteData and AFdReadData is
+    timed, for both little-endian and big-endian data for multi-byte formats.
+    The data is written to and read from a temporary headerless file (text
+    formats use a text audio file). The byte counts are those of the file data.
+  filt: FIdConvol, FIdConvSI, FIdConvFFT, FIdFiltIIR, FIdCascIIR and FIdFiltAP
+    are timed for a range of filter lengths and numbers of sections. The byte
+    counts are those of the input data (8 bytes per sample).
+  resamp: RSinterp is timed for several sampling rate ratios, interpolation
+    ratios and filter lengths. The byte counts are those of the input data.
+  prog: CopyAudio, FiltAudio and ResampAudio are run on a temporary two
+    channel 16-bit WAVE file. The times include program start-up and file
+    opening. The byte counts are those of the input file data.
+
+  The temporary files are created in the current directory and are removed
+  at the end of the run.
+
+Options:
+  -n NSAMPLE, --number-samples=NSAMPLE
+      Number of samples for each case, default 1000000.
+  -r NREP, --repeat=NREP
+      Number of repetitions for each case, default 3.
+  -g GROUPS, --groups=GROUPS
+      Comma separated list of benchmark groups to be run: "conv", "filt",
+      "resamp", "prog" or "all". The default is all groups.
+  -b DIR, --bin-dir=DIR
+      Directory containing the audio utilities, default "../bin".
+  -f DIR, --filter-dir=DIR
+      Directory containing the filter coefficient files, default "../filters".
+  -h, --help
+      Print a list of options and exit.
+  -v, --version
+      Print the version number and exit.
+
+Author / version:
+  P. Kabal / v10r3  2020-11-30  Copyright (C) 2020
+
+-------------------------------------------------------------------------*/
+
+#include <stdlib.h> /* EXIT_SUCCESS */
+
+#include "AFbench.h"
+
+
+int
+main(int argc, const char *argv[])
+
+{
+  struct BM_par Par;
+
+/* Get the input parameters */
+  BMoptions(argc, argv, &Par);
+
+/* Run the benchmarks */
+  BMheader(&Par);
+  if (Par.Groups & BM_CONV)
+    BMconv(&Par);
+  if (Par.Groups & BM_FILT)
+    BMfilt(&Par);
+  if (Par.Groups & BM_RESAMP)
+    BMresamp(&Par);
+  if (Par.Groups & BM_PROG)
+    BMprog(&Par);
+
+  return EXIT_SUCCESS;
+}
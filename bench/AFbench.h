@@ -0,0 +1,96 @@
+/*------------ Telecommunications & Signal Processing Lab --------------
+                         McGill University
+
+Routine:
+  AFbench.h
+
+Description:
+  Declarations for AFbench
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/17 10:00:00 $
+
+----------------------------------------------------------------------*/
+
+#ifndef AFbench_h_
+#define AFbench_h_
+
+#define PROGRAM "AFbench"
+#define VERSION "v10r3  2020-11-30"
+
+#include <stdio.h>    /* FILENAME_MAX */
+
+#include <libtsp.h>
+#include <AFpar.h>
+
+#define NSAMP_DEFAULT   1000000L
+#define NREP_DEFAULT    3
+#define BINDIR_DEFAULT  "../bin"
+#define FILTDIR_DEFAULT "../filters"
+#define TMPFILE         "AFbench-tmp"   /* Prefix for temporary files */
+
+/* Benchmark groups */
+#define BM_CONV     1     /* Data format converters */
+#define BM_FILT     2     /* Filtering routines */
+#define BM_RESAMP   4     /* Interpolation (RSinterp) */
+#define BM_PROG     8     /* End-to-end program runs */
+#define BM_ALL      (BM_CONV | BM_FILT | BM_RESAMP | BM_PROG)
+
+/* Benchmark parameters */
+struct BM_par {
+  long int Nsamp;         /* Number of samples for each case */
+  int Nrep;               /* Number of repetitions (the best time is used) */
+  int Groups;             /* Benchmark groups to be run */
+  char BinDir[FILENAME_MAX];    /* Directory for the programs */
+  char FiltDir[FILENAME_MAX];   /* Directory for the filter files */
+};
+
+/* Error messages */
+#define BMM_BadGroup  "Invalid benchmark group"
+#define BMM_BadNrep   "Invalid number of repetitions"
+#define BMM_BadNsamp  "Invalid number of samples"
+#define BMM_ProgErr   "Program run failed"
+#define BMM_XFName    "Too many filenames specified"
+
+/* Usage */
+#define BMMF_Usage "\
+Usage: %s [options]\n\
+Options:\n\
+  -n NSAMPLE, --number-samples=NSAMPLE  Number of samples for each case.\n\
+  -r NREP, --repeat=NREP      Number of repetitions for each case.\n\
+  -g GROUPS, --groups=GROUPS  Benchmark groups, list of\n\
+                              \"conv\", \"filt\", \"resamp\", \"prog\", \"all\".\n\
+  -b DIR, --bin-dir=DIR       Directory for the programs.\n\
+  -f DIR, --filter-dir=DIR    Directory for the filter coefficient files.\n\
+  -h, --help                  Print a list of options and exit.\n\
+  -v, --version               Print the version number and exit."
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Prototypes */
+void
+BMconv(const struct BM_par *Par);
+void
+BMdata(double x[], long int N, double Ampl, int seed);
+void
+BMfilt(const struct BM_par *Par);
+void
+BMheader(const struct BM_par *Par);
+void
+BMoptions(int argc, const char *argv[], struct BM_par *Par);
+void
+BMprog(const struct BM_par *Par);
+void
+BMreport(const char Group[], const char Case[], long int Nsamp, double T,
+         double Nbyte);
+void
+BMresamp(const struct BM_par *Par);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AFbench_h_ */
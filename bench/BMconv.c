@@ -0,0 +1,158 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void BMconv(const struct BM_par *Par)
+
+Purpose:
+  Time the audio file data format converters
+
+Description:
+  This routine times writing and reading Par->Nsamp samples for each of the
+  audio file data formats. Multi-byte formats are timed for both little-endian
+  and big-endian data. The binary formats use a headerless file. The text
+  formats use a text audio file. The data is written with AFdWriteData and
+  read back with AFdReadData. The reported byte counts are those of the data
+  written to the file (the text data byte count is not available for reads
+  unless statistics reporting is enabled).
+
+Parameters:
+   -> const struct BM_par *Par
+      Benchmark parameters
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/17 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_SECURE_NO_WARNINGS     /* Allow sprintf */
+#endif
+
+#include <stdio.h>
+
+#include "AFbench.h"
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+#define SFREQ   8000.
+#define NBUF    8192
+#define MAXNAME  31
+
+/* Data formats to be timed */
+static const struct {
+  enum AF_FD_T Format;
+  const char *Name;     /* Format name for AFsetInputPar */
+} BM_Fmt[] = {
+  {FD_MULAW8,  "mu-law8"},
+  {FD_MULAWR8, "mu-lawR8"},
+  {FD_ALAW8,   "A-law8"},
+  {FD_UINT8,   "unsigned8"},
+  {FD_INT8,    "integer8"},
+  {FD_INT16,   "integer16"},
+  {FD_INT24,   "integer24"},
+  {FD_INT32,   "integer32"},
+  {FD_FLOAT32, "float32"},
+  {FD_FLOAT64, "float64"},
+  {FD_TEXT16,  "text16"},
+  {FD_TEXT,    "text"}
+};
+#define NFMT  ((int) (sizeof BM_Fmt / sizeof BM_Fmt[0]))
+
+static void
+BM_convCase(const struct BM_par *Par, const double x[], int ifmt, int EB);
+
+
+void
+BMconv(const struct BM_par *Par)
+
+{
+  int i;
+  double *x;
+
+/* Test data, scaled to avoid clipping of 8-bit data */
+  x = (double *) UTmalloc(Par->Nsamp * sizeof(double));
+  BMdata(x, Par->Nsamp, 0.45, 1);
+
+  for (i = 0; i < NFMT; ++i) {
+    BM_convCase(Par, x, i, 0);
+    if (AF_DL[BM_Fmt[i].Format] > 1)
+      BM_convCase(Par, x, i, 1);
+  }
+
+  UTfree(x);
+  remove(TMPFILE);
+}
+
+/* Time writing and reading for one data format and byte order */
+
+
+static void
+BM_convCase(const struct BM_par *Par, const double x[], int ifmt, int EB)
+
+{
+  AFILE *AFp;
+  enum AF_FTW_T FtypeW;
+  enum AF_FD_T Format;
+  int Text, ir, n;
+  long int Nsamp, Nchan, k;
+  double Sfreq, T, Tw, Tr, Nbyte;
+  double *buf;
+  char Name[MAXNAME+1];
+  char Case[MAXNAME+8];
+  char Spec[160];
+
+  Format = BM_Fmt[ifmt].Format;
+  Text = (AF_DL[Format] == FDL_TEXT);
+  if (Text)
+    FtypeW = FTW_TXAUD;
+  else
+    FtypeW = EB ? FTW_NH_EB : FTW_NH_EL;
+
+  /* Input file parameters for headerless files */
+  sprintf(Spec, "%s,0,%g,%s,1,default", BM_Fmt[ifmt].Name, SFREQ,
+          EB ? "big-endian" : "little-endian");
+
+  buf = (double *) UTmalloc(NBUF * sizeof(double));
+  Tw = 0.0;
+  Tr = 0.0;
+  Nbyte = 0.0;
+  for (ir = 0; ir < Par->Nrep; ++ir) {
+
+    /* Write */
+    T = UTclock();
+    AFp = AFopnWrite(TMPFILE, FtypeW, Format, 1L, SFREQ, NULL);
+    AFdWriteData(AFp, x, (int) Par->Nsamp);
+    Nbyte = (double) AFp->Stats.Nbyte;
+    AFclose(AFp);
+    T = UTclock() - T;
+    if (ir == 0 || T < Tw)
+      Tw = T;
+
+    /* Read (the input options are reset by AFopnRead) */
+    AFsetInputPar(Spec);
+    AFopt.FtypeI = Text ? FT_AUTO : FT_NH;
+    T = UTclock();
+    AFp = AFopnRead(TMPFILE, &Nsamp, &Nchan, &Sfreq, NULL);
+    for (k = 0; k < Nsamp; k += n) {
+      n = (int) MINV(Nsamp - k, NBUF);
+      AFdReadData(AFp, k, buf, n);
+    }
+    AFclose(AFp);
+    T = UTclock() - T;
+    if (ir == 0 || T < Tr)
+      Tr = T;
+  }
+  UTfree(buf);
+
+  if (Text)
+    STcopyMax(BM_Fmt[ifmt].Name, Name, MAXNAME);
+  else
+    sprintf(Name, "%s-%s", BM_Fmt[ifmt].Name, EB ? "be" : "le");
+  sprintf(Case, "write-%s", Name);
+  BMreport("conv", Case, Par->Nsamp, Tw, Nbyte);
+  sprintf(Case, "read-%s", Name);
+  BMreport("conv", Case, Par->Nsamp, Tr, Nbyte);
+}
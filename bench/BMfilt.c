@@ -0,0 +1,209 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void BMfilt(const struct BM_par *Par)
+
+Purpose:
+  Time the filtering routines
+
+Description:
+  This routine times the filtering routines for Par->Nsamp input samples,
+  - FIdConvol and FIdConvFFT (FIR filters) for a range of filter lengths,
+  - FIdConvSI (FIR filter with interpolation and subsampling) for several
+    interpolation ratios, subsampling ratios and filter lengths,
+  - FIdFiltIIR and FIdCascIIR (cascade of biquadratic filters) for a range of
+    numbers of sections. FIdCascIIR is also timed for two interleaved
+    channels.
+  - FIdFiltAP (all-pole filter) for a range of filter orders.
+  The filter coefficients are arbitrary, but give stable filters. The reported
+  byte counts are for the input data (8 bytes per sample).
+
+Parameters:
+   -> const struct BM_par *Par
+      Benchmark parameters
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/17 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_SECURE_NO_WARNINGS     /* Allow sprintf */
+#endif
+
+#include <math.h>
+#include <stdio.h>
+
+#include "AFbench.h"
+
+#define PI      3.14159265358979323846
+#define MAXNAME 39
+
+/* Benchmark cases */
+static const int BM_Ncof[] = {8, 32, 128, 512};
+#define NNCOF ((int) (sizeof BM_Ncof / sizeof BM_Ncof[0]))
+static const int BM_NcofFFT[] = {128, 512, 2048};
+#define NNCOFFFT  ((int) (sizeof BM_NcofFFT / sizeof BM_NcofFFT[0]))
+static const struct {
+  int Ir;       /* Interpolation ratio */
+  int Nsub;     /* Subsampling ratio */
+  int Ncof;     /* Number of filter coefficients */
+} BM_SI[] = {
+  {1, 2, 64},
+  {2, 1, 64},
+  {3, 2, 96},
+  {2, 3, 256}
+};
+#define NSI   ((int) (sizeof BM_SI / sizeof BM_SI[0]))
+static const int BM_Nsec[] = {1, 2, 4, 8};
+#define NNSEC ((int) (sizeof BM_Nsec / sizeof BM_Nsec[0]))
+static const int BM_Np[] = {2, 8, 16};
+#define NNP   ((int) (sizeof BM_Np / sizeof BM_Np[0]))
+
+#define MAXCOF  2048
+#define MAXSEC  8
+#define MAXIR   3
+
+#define BEST(T, ir, Tb)   { if ((ir) == 0 || (T) < (Tb)) (Tb) = (T); }
+
+
+void
+BMfilt(const struct BM_par *Par)
+
+{
+  int N, i, j, k, ir, Ncof, Nout, Ir, Nsub, lmem, Nsec, Np;
+  double T, Tb, r, w;
+  double *x, *xs, *y, *h;
+  double hb[MAXSEC][5];
+  char Case[MAXNAME+1];
+  struct FI_convFFT *Conv;
+  struct FI_cascIIR *Filt;
+
+  N = (int) Par->Nsamp;
+  Tb = 0.0;
+
+/* Input data (with room for the filter memory), output data, coefficients */
+  x = (double *) UTmalloc((MAXCOF + 2 * N) * sizeof(double));
+  BMdata(x, MAXCOF + 2 * N, 0.9, 2);
+  xs = &x[MAXCOF];
+  y = (double *) UTmalloc((MAXIR * N + MAXCOF) * sizeof(double));
+  h = (double *) UTmalloc(MAXCOF * sizeof(double));
+  BMdata(h, MAXCOF, 0.01, 3);
+
+/* Biquadratic sections, poles at radius 0.9 */
+  r = 0.9;
+  for (i = 0; i < MAXSEC; ++i) {
+    w = PI * (i + 1) / (MAXSEC + 2);
+    hb[i][0] = 1.0;
+    hb[i][1] = 2.0;
+    hb[i][2] = 1.0;
+    hb[i][3] = -2.0 * r * cos(w);
+    hb[i][4] = r * r;
+  }
+
+/* FIR filter, direct convolution */
+  for (i = 0; i < NNCOF; ++i) {
+    Ncof = BM_Ncof[i];
+    for (ir = 0; ir < Par->Nrep; ++ir) {
+      T = UTclock();
+      FIdConvol(&xs[-(Ncof-1)], y, N, h, Ncof);
+      T = UTclock() - T;
+      BEST(T, ir, Tb);
+    }
+    sprintf(Case, "FIdConvol-Ncof%d", Ncof);
+    BMreport("filt", Case, Par->Nsamp, Tb, 8.0 * N);
+  }
+
+/* FIR filter, FFT convolution (block size as in FiltAudio) */
+  for (i = 0; i < NNCOFFFT; ++i) {
+    Ncof = BM_NcofFFT[i];
+    for (j = 64; j < Ncof; j *= 2)
+      ;
+    for (ir = 0; ir < Par->Nrep; ++ir) {
+      Conv = FIdAllocConvFFT(h, Ncof, j);
+      T = UTclock();
+      FIdConvFFT(Conv, xs, y, N);
+      T = UTclock() - T;
+      FIdFreeConvFFT(Conv);
+      BEST(T, ir, Tb);
+    }
+    sprintf(Case, "FIdConvFFT-Ncof%d", Ncof);
+    BMreport("filt", Case, Par->Nsamp, Tb, 8.0 * N);
+  }
+
+/* FIR filter with interpolation and subsampling
+   - With mr = 0, N input samples (beyond the filter memory) give
+     Nout = ((N-1)*Ir)/Nsub + 1 output samples
+*/
+  for (i = 0; i < NSI; ++i) {
+    Ir = BM_SI[i].Ir;
+    Nsub = BM_SI[i].Nsub;
+    Ncof = BM_SI[i].Ncof;
+    lmem = (Ncof - 1) / Ir;
+    Nout = (int) (((double) (N - 1) * Ir) / Nsub) + 1;
+    for (ir = 0; ir < Par->Nrep; ++ir) {
+      T = UTclock();
+      FIdConvSI(&xs[-lmem], y, Nout, h, Ncof, 0, Nsub, Ir);
+      T = UTclock() - T;
+      BEST(T, ir, Tb);
+    }
+    sprintf(Case, "FIdConvSI-Ir%d-Nsub%d-Ncof%d", Ir, Nsub, Ncof);
+    BMreport("filt", Case, Par->Nsamp, Tb, 8.0 * N);
+  }
+
+/* Cascade of biquadratic filters */
+  for (i = 0; i < NNSEC; ++i) {
+    Nsec = BM_Nsec[i];
+    for (ir = 0; ir < Par->Nrep; ++ir) {
+      VRdZero(y, 2 * Nsec);
+      T = UTclock();
+      FIdFiltIIR(&xs[-2], y, N, (const double (*)[5]) hb, Nsec);
+      T = UTclock() - T;
+      BEST(T, ir, Tb);
+    }
+    sprintf(Case, "FIdFiltIIR-Nsec%d", Nsec);
+    BMreport("filt", Case, Par->Nsamp, Tb, 8.0 * N);
+  }
+  for (k = 1; k <= 2; ++k) {
+    for (i = 0; i < NNSEC; ++i) {
+      Nsec = BM_Nsec[i];
+      for (ir = 0; ir < Par->Nrep; ++ir) {
+        Filt = FIdAllocCascIIR((const double (*)[5]) hb, Nsec, k);
+        T = UTclock();
+        FIdCascIIR(Filt, xs, y, N / k);
+        T = UTclock() - T;
+        FIdFreeCascIIR(Filt);
+        BEST(T, ir, Tb);
+      }
+      sprintf(Case, "FIdCascIIR-Nsec%d-Nchan%d", Nsec, k);
+      BMreport("filt", Case, (N / k) * k, Tb, 8.0 * (N / k) * k);
+    }
+  }
+
+/* All-pole filter, coefficients of (1 - 0.5/z)^(Np-1) */
+  for (i = 0; i < NNP; ++i) {
+    Np = BM_Np[i];
+    h[0] = 1.0;
+    for (j = 1; j < Np; ++j) {
+      h[j] = 0.0;
+      for (k = j; k > 0; --k)
+        h[k] -= 0.5 * h[k-1];
+    }
+    for (ir = 0; ir < Par->Nrep; ++ir) {
+      VRdZero(y, Np - 1);
+      T = UTclock();
+      FIdFiltAP(xs, y, N, h, Np);
+      T = UTclock() - T;
+      BEST(T, ir, Tb);
+    }
+    sprintf(Case, "FIdFiltAP-Np%d", Np);
+    BMreport("filt", Case, Par->Nsamp, Tb, 8.0 * N);
+  }
+
+  UTfree(x);
+  UTfree(y);
+  UTfree(h);
+}
@@ -0,0 +1,164 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void BMoptions(int argc, const char *argv[], struct BM_par *Par)
+
+Purpose:
+  Decode options for AFbench
+
+Description:
+  This routine decodes options for AFbench.
+
+Parameters:
+   -> int argc
+      Number of command line arguments
+   -> const char *argv[]
+      Array of pointers to argument strings
+  <-  struct BM_par *Par
+      Benchmark parameters
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/17 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <limits.h>
+#include <string.h>
+
+#include <AO.h>
+#include "AFbench.h"
+
+#define ERRSTOP(text,par) UThalt("%s: %s: \"%s\"", PROGRAM, text, par)
+
+#define NGROUP  5
+
+/* Option table */
+static const char *OptTable[] = {
+  "-n#", "--num*ber-samples=",
+  "-r#", "--rep*eat=",
+  "-g#", "--gr*oups=",
+  "-b#", "--bin*-dir=",
+  "-f#", "--fil*ter-dir=",
+  NULL
+};
+
+/* Benchmark group keywords */
+static const char *GroupTab[] = {
+  "conv", "filt", "resamp", "prog", "all", NULL
+};
+static const int GroupVal[NGROUP] = {
+  BM_CONV, BM_FILT, BM_RESAMP, BM_PROG, BM_ALL
+};
+
+static int
+BM_decGroups(const char String[]);
+
+
+void
+BMoptions(int argc, const char *argv[], struct BM_par *Par)
+
+{
+  const char *OptArg;
+  int n;
+  long int Nsamp;
+
+/* Defaults */
+  Par->Nsamp = NSAMP_DEFAULT;
+  Par->Nrep = NREP_DEFAULT;
+  Par->Groups = BM_ALL;
+  STcopyMax(BINDIR_DEFAULT, Par->BinDir, FILENAME_MAX-1);
+  STcopyMax(FILTDIR_DEFAULT, Par->FiltDir, FILENAME_MAX-1);
+
+/* Initialization */
+  UTsetProg(PROGRAM);
+
+/* Decode options */
+  AOinitOpt(argc, argv);
+  while (1) {
+
+    /* Decode help options */
+    n = AOdecHelp(VERSION, BMMF_Usage);
+    if (n >= 1)
+      continue;
+
+    /* Decode program options */
+    n = AOdecOpt(OptTable, &OptArg);
+    if (n == -1)
+      break;
+
+    switch (n) {
+    case -2:
+      UThalt(BMMF_Usage, PROGRAM);
+      break;
+    case 0:
+      /* Filename argument */
+      UThalt("%s: %s", PROGRAM, BMM_XFName);
+      break;
+    case 1:
+    case 2:
+      /* Number of samples */
+      if (STdec1long(OptArg, &Nsamp) || Nsamp <= 0L || Nsamp > INT_MAX / 8)
+        ERRSTOP(BMM_BadNsamp, OptArg);
+      Par->Nsamp = Nsamp;
+      break;
+    case 3:
+    case 4:
+      /* Number of repetitions */
+      if (STdec1int(OptArg, &Par->Nrep) || Par->Nrep <= 0)
+        ERRSTOP(BMM_BadNrep, OptArg);
+      break;
+    case 5:
+    case 6:
+      /* Benchmark groups */
+      Par->Groups = BM_decGroups(OptArg);
+      if (Par->Groups == 0)
+        ERRSTOP(BMM_BadGroup, OptArg);
+      break;
+    case 7:
+    case 8:
+      /* Program directory */
+      STcopyMax(OptArg, Par->BinDir, FILENAME_MAX-1);
+      break;
+    case 9:
+    case 10:
+      /* Filter directory */
+      STcopyMax(OptArg, Par->FiltDir, FILENAME_MAX-1);
+      break;
+    default:
+      assert(0);
+      break;
+    }
+  }
+}
+
+/* Decode a comma separated list of benchmark groups, returns zero for an
+   invalid list */
+
+
+static int
+BM_decGroups(const char String[])
+
+{
+  const char *p;
+  char *Token;
+  int Groups, k;
+
+  Token = (char *) UTmalloc(strlen(String) + 1);
+  Groups = 0;
+  p = String;
+  while (p != NULL) {
+    p = STfindToken(p, ",", "", Token, 1, (int) strlen(String));
+    k = STkeyMatch(Token, GroupTab);
+    if (k < 0) {
+      Groups = 0;
+      break;
+    }
+    Groups |= GroupVal[k];
+  }
+  UTfree(Token);
+
+  return Groups;
+}
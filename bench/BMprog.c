@@ -0,0 +1,128 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void BMprog(const struct BM_par *Par)
+
+Purpose:
+  Time end-to-end runs of the audio utilities
+
+Description:
+  This routine times CopyAudio, FiltAudio and ResampAudio, each run as a
+  separate process. The input is a temporary two channel WAVE file (16-bit
+  data, 48 kHz sampling rate) with Par->Nsamp samples (counted over both
+  channels). The output is written to a temporary file. The times include
+  program start-up and file opening. The reported byte counts are for the
+  input file data. The messages from the programs are discarded. A warning is printed for a program run that fails (for
+  instance if the program or filter file is not found) and that case is
+  skipped.
+
+Parameters:
+   -> const struct BM_par *Par
+      Benchmark parameters
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/17 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_SECURE_NO_WARNINGS     /* Allow sprintf */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>   /* system */
+
+#include "AFbench.h"
+
+#if (SY_OS == SY_OS_WINDOWS)
+#  define NULL_DEV  "NUL"
+#else
+#  define NULL_DEV  "/dev/null"
+#endif
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+#define SFREQ   48000.
+#define NCHAN   2
+#define NBUF    8192
+#define MAXCMD  (3 * FILENAME_MAX + 80)
+
+#define FNAMEI  TMPFILE "-in.wav"
+#define FNAMEO  TMPFILE "-out.wav"
+
+/* Benchmark cases: program, options, filter file (or NULL) */
+static const struct {
+  const char *Case;
+  const char *Prog;
+  const char *Opt;
+  const char *FFile;
+} BM_Prog[] = {
+  {"CopyAudio",               "CopyAudio",   "",               NULL},
+  {"CopyAudio-float32",       "CopyAudio",   "-D float32",     NULL},
+  {"CopyAudio-gain",          "CopyAudio",   "-g 0.5",         NULL},
+  {"FiltAudio-FIR-Ncof177",   "FiltAudio",   "-f",  "STL_LP10k_FIR_48k.cof"},
+  {"FiltAudio-FIR-Ncof603",   "FiltAudio",   "-f",  "STL_BPF100x5k_FIR_16k.cof"},
+  {"FiltAudio-IIR",           "FiltAudio",   "-f",  "STL_G712_IIR_16k.cof"},
+  {"ResampAudio-44100",       "ResampAudio", "-s 44100",       NULL},
+  {"ResampAudio-44100-j2",    "ResampAudio", "-s 44100 -j 2",  NULL},
+  {"ResampAudio-96000",       "ResampAudio", "-s 96000",       NULL}
+};
+#define NPROG ((int) (sizeof BM_Prog / sizeof BM_Prog[0]))
+
+
+void
+BMprog(const struct BM_par *Par)
+
+{
+  AFILE *AFp;
+  int i, ir, n, Fail;
+  long int k;
+  double T, Tb;
+  double *x;
+  char Cmd[MAXCMD+1];
+
+/* Generate the input file */
+  x = (double *) UTmalloc(NBUF * sizeof(double));
+  AFp = AFopnWrite(FNAMEI, FTW_WAVE, FD_INT16, NCHAN, SFREQ, NULL);
+  for (k = 0; k < Par->Nsamp; k += n) {
+    n = (int) MINV(Par->Nsamp - k, NBUF);
+    BMdata(x, n, 0.25, (int) (k / NBUF) + 5);
+    AFdWriteData(AFp, x, n);
+  }
+  AFclose(AFp);
+  UTfree(x);
+
+/* Run the programs */
+  Tb = 0.0;
+  for (i = 0; i < NPROG; ++i) {
+    if (BM_Prog[i].FFile == NULL)
+      sprintf(Cmd, "\"%s/%s\" %s %s %s > %s 2>&1", Par->BinDir,
+              BM_Prog[i].Prog, BM_Prog[i].Opt, FNAMEI, FNAMEO, NULL_DEV);
+    else
+      sprintf(Cmd, "\"%s/%s\" %s \"%s/%s\" %s %s > %s 2>&1", Par->BinDir,
+              BM_Prog[i].Prog, BM_Prog[i].Opt, Par->FiltDir,
+              BM_Prog[i].FFile, FNAMEI, FNAMEO, NULL_DEV);
+
+    Fail = 0;
+    for (ir = 0; ir < Par->Nrep; ++ir) {
+      remove(FNAMEO);     /* Avoid the backup of the output file */
+      T = UTclock();
+      Fail = system(Cmd);
+      T = UTclock() - T;
+      if (Fail)
+        break;
+      if (ir == 0 || T < Tb)
+        Tb = T;
+    }
+    if (Fail)
+      UTwarn("%s: %s: %s", PROGRAM, BMM_ProgErr, BM_Prog[i].Case);
+    else
+      BMreport("prog", BM_Prog[i].Case, Par->Nsamp, Tb, 2.0 * Par->Nsamp);
+  }
+
+  remove(FNAMEI);
+  remove(FNAMEO);
+}
@@ -0,0 +1,108 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void BMheader(const struct BM_par *Par)
+  void BMreport(const char Group[], const char Case[], long int Nsamp,
+                double T, double Nbyte)
+  void BMdata(double x[], long int N, double Ampl, int seed)
+
+Purpose:
+  Print the header lines for the benchmark results
+  Print the result for a benchmark case
+  Generate test data for the benchmarks
+
+Description:
+  BMheader prints comment lines (starting with "#") giving the program
+  version, the benchmark parameters and the names of the result fields.
+
+  BMreport prints one line with tab-separated fields for a benchmark case,
+    GROUP  CASE  NSAMP  TIME  MSAMP/S  MB/S
+  The throughput values are zero if the time is zero.
+
+  BMdata fills an array with uniformly distributed pseudo-random values
+  between -Ampl and Ampl. The same seed gives the same values.
+
+Parameters:
+   -> const struct BM_par *Par
+      Benchmark parameters
+
+   -> const char Group[]
+      Benchmark group name
+   -> const char Case[]
+      Benchmark case name
+   -> long int Nsamp
+      Number of samples processed
+   -> double T
+      Time in seconds
+   -> double Nbyte
+      Number of bytes processed
+
+  <-  double x[]
+      Output array of N values
+   -> long int N
+      Number of values
+   -> double Ampl
+      Maximum amplitude of the values
+   -> int seed
+      Seed for the pseudo-random number generator
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/17 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <limits.h>
+
+#include "AFbench.h"
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+
+void
+BMheader(const struct BM_par *Par)
+
+{
+  printf("# %s %s\n", PROGRAM, VERSION);
+  printf("# Nsamp: %ld, Nrep: %d\n", Par->Nsamp, Par->Nrep);
+  printf("# group\tcase\tnsamp\ttime_s\tMsamp/s\tMB/s\n");
+  fflush(stdout);
+}
+
+
+void
+BMreport(const char Group[], const char Case[], long int Nsamp, double T,
+         double Nbyte)
+
+{
+  double Rs, Rb;
+
+  Rs = 0.0;
+  Rb = 0.0;
+  if (T > 0.0) {
+    Rs = 1e-6 * Nsamp / T;
+    Rb = 1e-6 * Nbyte / T;
+  }
+  printf("%s\t%s\t%ld\t%.6f\t%.3f\t%.3f\n", Group, Case, Nsamp, T, Rs, Rb);
+  fflush(stdout);
+}
+
+
+void
+BMdata(double x[], long int N, double Ampl, int seed)
+
+{
+  struct MS_randGen *Gen;
+  long int k;
+  int i, n;
+
+  Gen = MSallocRandGen(seed, 1);
+  for (k = 0; k < N; k += n) {
+    n = (int) MINV(N - k, INT_MAX);
+    MSdRandUnif(Gen, 0, &x[k], n);
+    for (i = 0; i < n; ++i)
+      x[k+i] = Ampl * (2.0 * x[k+i] - 1.0);
+  }
+  MSfreeRandGen(Gen);
+}
@@ -0,0 +1,161 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void BMresamp(const struct BM_par *Par)
+
+Purpose:
+  Time the sample interpolation routine of ResampAudio
+
+Description:
+  This routine times RSinterp, the routine which calculates the output samples
+  for ResampAudio. The interpolation filter is designed with RSintFilt for
+  several sampling rate ratios, interpolation ratios and filter lengths. The
+  data is processed in blocks, as in ResampAudio, but from an input array
+  rather than from a file. The number of input samples is about Par->Nsamp,
+  counted over all channels. The reported byte counts are for the input data
+  (8 bytes per sample).
+
+Parameters:
+   -> const struct BM_par *Par
+      Benchmark parameters
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/17 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_SECURE_NO_WARNINGS     /* Allow sprintf */
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+
+#include "ResampAudio.h"
+#undef PROGRAM      /* Use the AFbench program name */
+#undef VERSION
+#include "AFbench.h"
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+#define NBUFO   4096    /* Output block size (frames) */
+#define NXTRA   8       /* Extra input frames at the end of the input */
+#define MAXNAME 63
+
+/* Benchmark cases, Ir or Ncof equal to zero gives the default value */
+static const struct {
+  double SfreqI;    /* Input sampling rate */
+  double SfreqO;    /* Output sampling rate */
+  int Ir;           /* Interpolation filter ratio */
+  int Ncof;         /* Number of filter coefficients */
+  int Nchan;        /* Number of channels */
+} BM_RS[] = {
+  {44100., 48000.,  0,    0, 1},
+  {44100., 48000.,  0,    0, 2},
+  {44100., 48000., 64,    0, 1},
+  {44100., 48000., 24,  385, 1},
+  {44100., 48000., 24, 1153, 1},
+  {48000., 44100.,  0,    0, 1},
+  {48000., 44100.,  0,    0, 2},
+  {48000., 44100., 64,    0, 1},
+  {48000., 44100., 24,  385, 1},
+  {16000., 32000.,  0,    0, 1},
+  {16000., 32000.,  0,    0, 2},
+  {32000., 16000.,  0,    0, 1}
+};
+#define NRS   ((int) (sizeof BM_RS / sizeof BM_RS[0]))
+
+static double
+BM_interp(double xbuf[], int lmem, int Nchan, double y[], long int Nout,
+          double Sratio, const struct Fpoly_T *PF);
+
+
+void
+BMresamp(const struct BM_par *Par)
+
+{
+  int i, ir, m, Nchan, Ncof, lmem;
+  long int Nframe, Nout;
+  double Sratio, FDel, T, Tb;
+  double *xbuf, *y;
+  struct Fspec_T Fspec;
+  struct Fpoly_T PF;
+  char Case[MAXNAME+1];
+
+  Tb = 0.0;
+  for (i = 0; i < NRS; ++i) {
+    Nchan = BM_RS[i].Nchan;
+    Sratio = BM_RS[i].SfreqO / BM_RS[i].SfreqI;
+
+    /* Interpolation filter */
+    Fspec_T_INIT(&Fspec);
+    if (BM_RS[i].Ir != 0)
+      Fspec.Ir = BM_RS[i].Ir;
+    if (BM_RS[i].Ncof != 0)
+      Fspec.Ncof = BM_RS[i].Ncof;
+    RSintFilt(Sratio, 0.0, &Fspec, &PF, &FDel, NULL);
+    Ncof = 0;
+    for (m = 0; m < PF.Ir; ++m)
+      Ncof += PF.Nc[m];
+    lmem = PF.Ncmax - 1;
+
+    /* Input data (preceded by lmem frames of filter memory), output data */
+    Nframe = Par->Nsamp / Nchan;
+    Nout = (long int) (Sratio * (Nframe - NXTRA));
+    xbuf = (double *) UTmalloc((lmem + Nframe) * Nchan * sizeof(double));
+    VRdZero(xbuf, lmem * Nchan);
+    BMdata(&xbuf[lmem*Nchan], Nframe * Nchan, 0.9, 4);
+    y = (double *) UTmalloc(NBUFO * Nchan * sizeof(double));
+
+    for (ir = 0; ir < Par->Nrep; ++ir) {
+      T = BM_interp(xbuf, lmem, Nchan, y, Nout, Sratio, &PF);
+      if (ir == 0 || T < Tb)
+        Tb = T;
+    }
+    sprintf(Case, "RSinterp-%g-%g-Ir%d-Ncof%d-Nchan%d", BM_RS[i].SfreqI,
+            BM_RS[i].SfreqO, PF.Ir, Ncof, Nchan);
+    BMreport("resamp", Case, Nframe * Nchan, Tb, 8.0 * Nframe * Nchan);
+
+    UTfree(xbuf);
+    UTfree(y);
+    UTfree(PF.offs);
+    MAdFreeMat(PF.hs);
+    UTfree(PF.Pair);
+    UTfree(PF.gp);
+  }
+}
+
+/* Generate Nout output frames in blocks of NBUFO frames, returns the time */
+
+
+static double
+BM_interp(double xbuf[], int lmem, int Nchan, double y[], long int Nout,
+          double Sratio, const struct Fpoly_T *PF)
+
+{
+  int Nx, Ny, Nxm;
+  long int LNs, k;
+  double Ds, T;
+  struct Tval_T Ts;
+
+  T = UTclock();
+
+/* Sampling rate ratio in rational form, Sratio = Ns / Ds (see RSresamp) */
+  RSratio(Sratio, PF->Ir, &LNs, &Ds, LONG_MAX,
+          (long int) (LONG_MAX / (Sratio + NBUFO)), NULL);
+  RSexpTime(0.0, LNs, &Ts);
+
+/* The data for the block starts lmem frames before the time point */
+  for (k = 0; k < Nout; k += Ny) {
+    Ny = (int) MINV(NBUFO, Nout - k);
+    Nx = (int) ((Ds * (Ny-1)) / LNs) + 3;
+    Nxm = Nx + lmem;
+    RSinterp(&xbuf[Ts.n*Nchan], Nxm, Nchan, y, Ny, Ds, &Ts, PF);
+    RSincTime(&Ts, Ds*Ny);
+  }
+
+  return (UTclock() - T);
+}
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.119 $  $Date: 2020/11/25 17:55:50 $
+  $Revision: 1.125 $  $Date: 2020/12/26 11:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -20,6 +20,7 @@ Author / revision:
 #include <limits.h>       /* LONG_MAX */
 #include <stdio.h>        /* typedef for FILE */
 
+#include <libtsp/sysOS.h> /* SY_THREAD_LOCAL */
 #include <libtsp/UTpar.h> /* Byte swap codes DS_SWAP, etc. */
 
 #ifndef AFILE_t_
@@ -176,7 +177,8 @@ enum AF_FTW_T {
   FTW_NH_SWAP,      /* NH file, swap byte order */
   FTW_NH_EL,        /* NH file, little-endian data */
   FTW_NH_EB,        /* NH file, big-endian data */
-  FTW_TXAUD         /* Text data (with header) */
+  FTW_TXAUD,        /* Text data (with header) */
+  FTW_WAVE64        /* Wave64 file (GUID chunk identifiers, 64-bit sizes) */
 };
 
 /* ------ ------ ----- File operation types in the AFILE structure */
@@ -202,6 +204,8 @@ struct AF_info {
   char *Info;   /* Pointer to string */
   int N;        /* Number of characters (includes nulls) */
   int Nmax;     /* Maximum number of characters (size of Info) */
+  int Alloc;    /* Info is allocated, extended as needed by AFaddInfoChunk */
+  struct AF_infoDefer *Defer; /* Chunks to be decoded on first use or NULL */
 };
 
 /* Data format structure */
@@ -255,6 +259,17 @@ struct AF_chunkInfo {
 
 /* Default values for AF_ChunkInfo structure */
 #define AF_CHUNKINFO_INIT(x) static struct AF_chunkInfo x = {NULL, 0, 0}
+
+/* Deferred information record structure (see AFdecInfoDefer)
+   The information records in the chunks listed in ChunkInfo are decoded on
+   first use by the file type specific routine Decode. Decode ignores chunks
+   which do not carry information records. */
+struct AF_infoDefer {
+  FILE *fp;                             /* File pointer */
+  const struct AF_chunkInfo *ChunkInfo; /* Chunk layout of the file */
+  int (*Decode)(FILE *fp, const struct AF_chunkLim *ChunkLim,
+                struct AF_info *AFInfo);
+};
 #define AF_EoF LONG_MAX
 
 /* Structure with read parameters used before AFILE structure is created */
@@ -264,6 +279,8 @@ struct AF_read {
   struct AF_ndata NData;
   struct AF_info RInfo;
   struct AF_chunkInfo ChunkInfo;
+  int (*InfoDec)(FILE *fp, const struct AF_chunkLim *ChunkLim,
+                 struct AF_info *AFInfo);   /* Deferred info decoding */
 };
 
 /* Default values for AF_read structure */
@@ -272,8 +289,9 @@ struct AF_read {
     {0.0, \
      {FD_UNDEF, DS_NATIVE, 0, AF_FULLSCALE_DEFAULT}, \
      {AF_LDATA_UNDEF, AF_NSAMP_UNDEF, 1L, {'\0'}}, \
+     {NULL, 0, 0, 0, NULL}, \
      {NULL, 0, 0}, \
-     {NULL, 0, 0}}
+     NULL}
 
 /* Structure with write parameters used before AFILE structure is created */
 struct AF_write {
@@ -299,6 +317,66 @@ struct AF_NbS {
 /* Default values for AF_NbS structure */
 #define AF_NBS_INIT(x) static const struct AF_NbS x = {0, 0}
 
+/* Memory mapped data structure (input files) */
+struct AF_mmap {
+  void *Base;                 /* Start of the mapped region (page aligned) */
+  long int Lbase;             /* Length of the mapped region in bytes */
+  const unsigned char *Data;  /* Start of the audio data, NULL if not mapped */
+  long int Ldata;             /* Length of the mapped audio data in bytes */
+  long int Pos;               /* Current byte position in the audio data */
+};
+
+/* Default values for AF_mmap structure */
+#define AF_MMAP_INIT(x) \
+  static const struct AF_mmap x = {NULL, 0L, NULL, 0L, 0L}
+
+/* Retained data window structure (non-random access input files)
+   The window holds the most recently read data bytes, up to Lbuf bytes,
+   stored in circular fashion (byte k of the data at Buf[k % Lbuf]) */
+struct AF_rbuf {
+  unsigned char *Buf;         /* Window buffer, NULL if not used */
+  long int Lbuf;              /* Size of the window buffer in bytes */
+  long int End;               /* Number of data bytes read from the file */
+  long int Pos;               /* Current byte position in the audio data */
+};
+
+/* Default values for AF_rbuf structure */
+#define AF_RBUF_INIT(x) \
+  static const struct AF_rbuf x = {NULL, 0L, 0L, 0L}
+
+/* Sample position index structure (random access text data files)
+   Offs[i] is the byte offset in the file of sample i*Step */
+struct AF_txidx {
+  long int *Offs;             /* Checkpoint byte offsets, NULL if not used */
+  long int N;                 /* Number of checkpoints */
+  long int Nmax;              /* Size of the Offs array */
+  long int Step;              /* Number of samples between checkpoints */
+  long int Next;              /* Sample number for the next checkpoint */
+};
+
+/* Default values for AF_txidx structure */
+#define AF_TXIDX_INIT(x) \
+  static const struct AF_txidx x = {NULL, 0L, 0L, 0L, -1L}
+
+/* Background data I/O structure (defined in AFasyncIO) */
+struct AF_aio;
+
+/* Data transfer statistics structure
+   The counts are always kept. The times are measured only if Report is set. */
+struct AF_stats {
+  int Report;                 /* Measure times, print the statistics on close */
+  long int Nreq;              /* Number of data requests (AFdReadData, etc.) */
+  long int Nbyte;             /* Number of data bytes read or written */
+  long int Ncall;             /* Number of fread or fwrite calls for data */
+  long int Nseek;             /* Number of file positioning calls for data */
+  double Treq;                /* Time in data requests (s) */
+  double Tio;                 /* Time in fread or fwrite calls (s) */
+};
+
+/* Default values for AF_stats structure */
+#define AF_STATS_INIT(x) \
+  static const struct AF_stats x = {0, 0L, 0L, 0L, 0L, 0.0, 0.0}
+
 /* ------ ------ ----- AFILE audio file parameter structure */
 struct AF_filepar {
 
@@ -333,6 +411,21 @@ struct AF_filepar {
   struct AF_info AFInfo;    /* Information structure */
   struct AF_chunkInfo ChunkInfo;  /* Chunk layout parameters */
   unsigned char *SpkrConfig;  /* Speaker location list */
+
+  /* Memory mapped data access (input files) */
+  struct AF_mmap MMap;      /* Mapped data, MMap.Data is NULL for stdio */
+
+  /* Retained data window (non-random access input files) */
+  struct AF_rbuf RBuf;      /* Window for moving back, RBuf.Buf may be NULL */
+
+  /* Sample position index (random access text data files) */
+  struct AF_txidx TxIdx;    /* Checkpoints, TxIdx.Offs may be NULL */
+
+  /* Background data I/O thread (binary data) */
+  struct AF_aio *AIO;       /* Read-ahead / write-behind, NULL if not used */
+
+  /* Data transfer statistics */
+  struct AF_stats Stats;    /* Counts and times */
 };
 /* Scaling values:
 Input files:
@@ -379,6 +472,13 @@ struct AF_opt {
                                  0 - continue on error,
                                  1 - halt on error */
   double ScaleV;              /* Full scale value for program sample data */
+  int Stats;                  /* Data transfer statistics:
+                                 0 - counts only
+                                 1 - counts and times, report on close */
+  int AsyncIO;                /* Background data I/O:
+                                 0 - transfer data in the calling thread
+                                 n - use a separate thread with n blocks of
+                                     buffering */
 /* Input file options */
   int NsampND;                /* Number of samples requirement
                                  0 - Nsamp must be known
@@ -387,6 +487,17 @@ struct AF_opt {
                                  0 - input file can be sequential or random
                                      access
                                  1 - input file must be random access */
+  int MMap;                   /* Memory mapped input:
+                                 0 - read data using stdio
+                                 1 - map the data of random access files */
+  long int Lback;             /* Window (bytes) for moving back in input files
+                                 which are not random access, 0 for none */
+  int HeadOnly;               /* Header-only open:
+                                 0 - open for reading data
+                                 1 - read the header only */
+  int LazyInfo;               /* Information record decoding:
+                                 0 - decode the records on open
+                                 1 - decode the records on first use */
   enum AF_FT_T FtypeI;        /* Input file type, FT_AUTO, FT_AU, etc. */
   struct AF_InputPar InputPar;  /* Default input audio file parameters */
 /* Output file options */
@@ -400,14 +511,20 @@ struct AF_opt {
 };
 #define AF_ERRORHALT_DEFAULT  1       /* Halt on error */
 #define AF_SCALEV_DEFAULT     1.0     /* Program sample data full scale */
+#define AF_STATS_DEFAULT      0       /* No statistics report */
+#define AF_ASYNCIO_DEFAULT    0       /* No background data I/O */
 #define AF_NSAMPND_DEFAULT    0       /* Number of samples must be known */
 #define AF_NBS_DEFAULT        0       /* Bits/Sample unknown */
 #define AF_RACCESS_DEFAULT    0       /* Allow non-random access files */
+#define AF_MMAP_DEFAULT       0       /* Read data using stdio */
+#define AF_LBACK_DEFAULT   1048576L   /* Window for moving back (bytes) */
+#define AF_HEADONLY_DEFAULT   0       /* Open for reading data */
+#define AF_LAZYINFO_DEFAULT   0       /* Decode info records on open */
 #define AF_STDINFO_DEFAULT  AF_STDINFO_ON   /* Generate standard info records */
 
 /* Declaration of the options structure */
-/* Initialized in AFoptions */
-extern struct AF_opt AFopt;
+/* Initialized in AFoptions, each thread has its own copy */
+extern SY_THREAD_LOCAL struct AF_opt AFopt;
 
 /* Values for AFOptions reset categories */
 enum AF_OPT_T {
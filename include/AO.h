@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.44 $  $Date: 2020/11/23 18:35:50 $
+  $Revision: 1.47 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -91,6 +91,7 @@ struct AO_FOpar {
 #define AOM_NotAllNSamp "Number of samples not defined for all files"
 
 /* Error messages */
+#define AOM_BadAsync  "Invalid number of I/O buffer blocks"
 #define AOM_BadData   "Invalid data format specification"
 #define AOM_BadFType  "Invalid file type specification"
 #define AOM_BadGain   "Invalid gain value"
@@ -103,11 +104,15 @@ struct AO_FOpar {
 #define AOM_InvNbS    "Invalid no. bits/sample"
 #define AOM_stdin1    "Error, standard input can be used only once"
 #define AOMF_DataFType  "%s: Invalid data format (%s) for %s"
+#define AOMF_Stage    " %s: %.4f s (computation: %.4f s)\n"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Worker thread pool (see AOnewPool) */
+struct AO_pool;
+
 /* Prototypes */
 struct AO_CmdArg *
 AOArgs(void);
@@ -121,6 +126,8 @@ long int
 AOnFrame(AFILE *AFp[], const struct AO_FIpar FI[], int Nifiles,
          long int Nframe);
 void
+AOprStage(const char Name[], double Tstage, AFILE *AFp[], int Nf);
+void
 AOsetDFormat(struct AO_FOpar *FO, AFILE *AFp[], int Nf);
 void
 AOsetFIopt(const struct AO_FIpar *FI, int NsampND, int RAccess);
@@ -129,6 +136,15 @@ AOsetFOopt(const struct AO_FOpar *FO);
 enum AF_FD_T
 AOsetFormat(const struct AO_FOpar *FO, AFILE *AFp[], int Nf);
 void
+AOfreePool(struct AO_pool *Pool);
+struct AO_pool *
+AOnewPool(int Nthread);
+void
+AOrunChan(void (*Fn)(int ich, void *Arg), void *Arg, int Nchan, int Nthread);
+void
+AOrunPool(struct AO_pool *Pool, void (*Fn)(int ich, void *Arg), void *Arg,
+          int Nchan);
+void
 AOstdin(const struct AO_FIpar FI[], int N);
 
 /* nucleus folder */
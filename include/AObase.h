@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.4 $  $Date: 2020/11/23 18:35:50 $
+  $Revision: 1.6 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -22,6 +22,8 @@ struct AO_CmdArg {
   int Argc;           /* Argument count */
   int Index;          /* Argument index */
   int EndOptions;     /* End-of-options indicator */
+  int MMap;           /* Memory mapped input files */
+  int LazyInfo;       /* Deferred information record decoding */
 };
 
 #ifdef __cplusplus
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 2.119 $  $Date: 2020/11/12 18:35:03 $
+  $Revision: 2.120 $  $Date: 2020/12/26 12:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -21,6 +21,10 @@ Author / revision:
 enum AF_OPT_T;
 enum AF_FTW_T;
 enum AF_FD_T;
+struct AF_opt;
+struct FI_cascIIR;
+struct FI_convFFT;
+struct MS_randGen;
 
 /* Audio file parameter structure */
 #ifndef AFILE_t_
@@ -36,6 +40,10 @@ extern "C" {
 void
 AFclose(AFILE *AFp);
 int
+AFcopyCheck(const AFILE *AFpI, const AFILE *AFpO);
+int
+AFcopyData(AFILE *AFpI, long int offs, AFILE *AFpO, int Nreq);
+int
 AFdReadData(AFILE *AFp, long int offs, double Dbuff[], int Nreq);
 int
 AFdWriteData(AFILE *AFp, const double Dbuff[], int Nval);
@@ -43,16 +51,29 @@ int
 AFfReadData(AFILE *AFp, long int offs, float Dbuff[], int Nreq);
 int
 AFfWriteData(AFILE *AFp, const float Dbuff[], int Nval);
+int
+AFiReadData(AFILE *AFp, long int offs, int Ibuff[], int Nreq);
+int
+AFiWriteData(AFILE *AFp, const int Ibuff[], int Nval);
 AFILE *
 AFopnRead(const char Fname[], long int *Nsamp, long int *Nchan, double *Sfreq,
           FILE *fpinfo);
 AFILE *
+AFopnReadCtx(const char Fname[], long int *Nsamp, long int *Nchan,
+             double *Sfreq, FILE *fpinfo, const struct AF_opt *Opt);
+AFILE *
 AFopnWrite(const char Fname[], enum AF_FTW_T FtypeW, enum AF_FD_T Format,
            long int Nchan, double Sfreq, FILE *fpinfo);
 void
 AFprintChunkLims(const AFILE *AFp, FILE *fpinfo);
 void
 AFprintInfoRecs(const AFILE *AFp, FILE *fpinfo);
+void
+AFprintStats(const AFILE *AFp, FILE *fpinfo);
+int
+AFsReadData(AFILE *AFp, long int offs, short int Sbuff[], int Nreq);
+int
+AFsWriteData(AFILE *AFp, const short int Sbuff[], int Nval);
 int
 AFsetFileType(const char String[]);
 void
@@ -63,9 +84,11 @@ int
 AFsetSpeaker(const char String[]);
 
 /* ----- AF extras ------ */
-/* This prototype is also in libtsp/nucleus.h */
+/* These prototypes are also in libtsp/nucleus.h */
 struct AF_opt *
 AFoptions(enum AF_OPT_T Cat);
+void
+AFcopyOptions(const struct AF_opt *Opt);
 
 /* Deprecated */
 AFILE *
@@ -81,9 +104,17 @@ AFwriteData(AFILE *AFp, const float Dbuff[], int Nval);
 
 
 /* ----- FI Prototypes ----- */
+struct FI_cascIIR *
+FIdAllocCascIIR(const double h[][5], int Nsec, int Nlane);
+struct FI_convFFT *
+FIdAllocConvFFT(const double h[], int Ncof, int Nblk);
 void
 FIdBiquad(const double x[], double y[], int Nout, const double h[5]);
 void
+FIdCascIIR(struct FI_cascIIR *Filt, const double x[], double y[], int Nout);
+void
+FIdConvFFT(struct FI_convFFT *Conv, const double x[], double y[], int Nout);
+void
 FIdConvSI(const double x[], double y[], int Nout, const double h[], int Ncof,
           int mr, int Nsub, int Ir);
 void
@@ -94,6 +125,10 @@ void
 FIdFiltIIR(const double x[], double y[], int Nout, const double h[][5],
            int Nsec);
 void
+FIdFreeCascIIR(struct FI_cascIIR *Filt);
+void
+FIdFreeConvFFT(struct FI_convFFT *Conv);
+void
 FIdKaiserLPF(double h[], int N, double Fc, double alpha);
 int
 FIdReadFilt(const char Fname[], int MaxNcof, double h[], int *Ncof,
@@ -223,6 +258,8 @@ MAlPrint(FILE *fp, const char Header[], const long int *A[], int Nrow,
          int Ncol);
 
 /* ----- MS Prototypes ----- */
+struct MS_randGen *
+MSallocRandGen(int seed, int Nstream);
 int
 MSdConvCof(const double x[], int Nx, const double y[], int Ny, double z[]);
 int
@@ -241,6 +278,10 @@ MSdNint(double x);
 double
 MSdPolyInt(double x, const double xa[], const double ya[], int N,
            double buff[]);
+void
+MSdRandGauss(struct MS_randGen *Gen, int j, double x[], int N, double rms);
+void
+MSdRandUnif(struct MS_randGen *Gen, int j, double x[], int N);
 int
 MSfConvCof(const float x[], int Nx, const float y[], int Ny, float z[]);
 double
@@ -251,6 +292,8 @@ MSfIntLin(const float x[], const float y[], int N, const float xi[],
 void
 MSfIntMC(const float x[], const float y[], int N, const float xi[],
          float yi[], int Ni);
+void
+MSfreeRandGen(struct MS_randGen *Gen);
 double
 MSfUnifRand(void);
 int
@@ -397,6 +440,8 @@ int
 STunQuote(const char Si[], const char Quotes[], char So[]);
 
 /* ----- UT Prototypes ----- */
+double
+UTclock(void);
 char *
 UTdate(int format);
 void
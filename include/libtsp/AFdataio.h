@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.18 $  $Date: 2020/11/23 20:48:52 $
+  $Revision: 1.23 $  $Date: 2020/12/23 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -29,17 +29,67 @@ typedef struct AF_filepar AFILE;  /* Audio file parameters */
 #define AF_SEEK_END LONG_MIN  /* Used as a flag to AFseek */
 
 #define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+#define MAXV(a, b)  (((a) > (b)) ? (a) : (b))
 #define NBBUF   8192
 
 #define UT_UINT1_OFFSET ((UT_UINT1_MAX+1)/2)   /* Offset binary */
 #define UT_INT3_MAX    8388607                 /* 24-bit integer */
 #define UT_INT3_MIN   -8388608
 
-/* Read / write macros with type casting */
+#define AF_TXIDX_STEP  1024L    /* Text data index, samples per checkpoint */
+#define AF_TXFMT_MAXLEN  32     /* Maximum length of a formatted text value */
+
+/* Full scale values for native integer program data (AFsReadData etc.) */
+#define AF_FULLSCALE_INT2  (32768.)
+#define AF_FULLSCALE_INT4  (65536.*32768.)
+
+/* Assemble integer values from bytes in a given byte order
+   b - pointer to unsigned char data, not necessarily aligned
+   The 24-bit values are sign extended.
+*/
+#define AF_GETEL2(b)  ((UT_int2_t) ((b)[0] | ((b)[1] << 8)))
+#define AF_GETEB2(b)  ((UT_int2_t) (((b)[0] << 8) | (b)[1]))
+#define AF_GETEL3(b)  AF_SEXT3((b)[0] | ((b)[1] << 8) | ((b)[2] << 16))
+#define AF_GETEB3(b)  AF_SEXT3(((b)[0] << 16) | ((b)[1] << 8) | (b)[2])
+#define AF_GETEL4(b)  ((UT_int4_t) ( (UT_uint4_t) (b)[0] | \
+                                    ((UT_uint4_t) (b)[1] << 8) | \
+                                    ((UT_uint4_t) (b)[2] << 16) | \
+                                    ((UT_uint4_t) (b)[3] << 24)))
+#define AF_GETEB4(b)  ((UT_int4_t) (((UT_uint4_t) (b)[0] << 24) | \
+                                    ((UT_uint4_t) (b)[1] << 16) | \
+                                    ((UT_uint4_t) (b)[2] << 8) | \
+                                     (UT_uint4_t) (b)[3]))
+#define AF_SEXT3(v)   ((((UT_int4_t) (v)) ^ 0x800000) - 0x800000)
+
+/* Store integer values as bytes in a given byte order */
+#define AF_PUTEL2(b,v) { \
+  (b)[0] = (unsigned char) (v); \
+  (b)[1] = (unsigned char) ((UT_uint4_t) (v) >> 8); }
+#define AF_PUTEB2(b,v) { \
+  (b)[0] = (unsigned char) ((UT_uint4_t) (v) >> 8); \
+  (b)[1] = (unsigned char) (v); }
+#define AF_PUTEL3(b,v) { \
+  (b)[0] = (unsigned char) (v); \
+  (b)[1] = (unsigned char) ((UT_uint4_t) (v) >> 8); \
+  (b)[2] = (unsigned char) ((UT_uint4_t) (v) >> 16); }
+#define AF_PUTEB3(b,v) { \
+  (b)[0] = (unsigned char) ((UT_uint4_t) (v) >> 16); \
+  (b)[1] = (unsigned char) ((UT_uint4_t) (v) >> 8); \
+  (b)[2] = (unsigned char) (v); }
+#define AF_PUTEL4(b,v) { \
+  (b)[0] = (unsigned char) (v); \
+  (b)[1] = (unsigned char) ((UT_uint4_t) (v) >> 8); \
+  (b)[2] = (unsigned char) ((UT_uint4_t) (v) >> 16); \
+  (b)[3] = (unsigned char) ((UT_uint4_t) (v) >> 24); }
+#define AF_PUTEB4(b,v) { \
+  (b)[0] = (unsigned char) ((UT_uint4_t) (v) >> 24); \
+  (b)[1] = (unsigned char) ((UT_uint4_t) (v) >> 16); \
+  (b)[2] = (unsigned char) ((UT_uint4_t) (v) >> 8); \
+  (b)[3] = (unsigned char) (v); }
+
+/* Read macro with type casting */
 #define FREAD(buf,size,nv,fp) \
   (int) fread((char *) buf, (size_t) size, (size_t) nv, fp)
-#define FWRITE(buf,size,nv,fp) \
-  (int) fwrite((const char *) buf, (size_t) size, (size_t) nv, fp)
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,6 +97,12 @@ extern "C" {
 
 /* AF/dataio function prototypes */
 int
+AFaioRead(AFILE *AFp, void *Buf, int Lw, int N);
+int
+AFaioSeek(AFILE *AFp, long int boff);
+int
+AFaioWrite(AFILE *AFp, const void *Buf, int Lw, int N);
+int
 AFdRdAlaw(AFILE *AFp, double Dbuff[], int Nreq);
 int
 AFdRdF4(AFILE *AFp, double Dbuff[], int Nreq);
@@ -91,6 +147,8 @@ AFdWrTA(AFILE *AFp, const double Dbuff[], int Nval);
 int
 AFdWrU1(AFILE *AFp, const double Dbuff[], int Nval);
 int
+AFendAIO(AFILE *AFp);
+int
 AFfRdAlaw(AFILE *AFp, float Dbuff[], int Nreq);
 int
 AFfRdF4(AFILE *AFp, float Dbuff[], int Nreq);
@@ -134,14 +192,67 @@ int
 AFfWrTA(AFILE *AFp, const float Dbuff[], int Nval);
 int
 AFfWrU1(AFILE *AFp, const float Dbuff[], int Nval);
+void
+AFfreeRBuf(AFILE *AFp);
+void
+AFfreeTxIdx(AFILE *AFp);
 char *
 AFgetLine(FILE *fp, enum AF_ERR_T *ErrCode);
 int
+AFiRdI1(AFILE *AFp, int Ibuff[], int Nreq);
+int
+AFiRdI2(AFILE *AFp, int Ibuff[], int Nreq);
+int
+AFiRdI3(AFILE *AFp, int Ibuff[], int Nreq);
+int
+AFiRdI4(AFILE *AFp, int Ibuff[], int Nreq);
+int
+AFiRdU1(AFILE *AFp, int Ibuff[], int Nreq);
+int
+AFiWrI4(AFILE *AFp, const int Ibuff[], int Nval);
+int
+AFmapData(AFILE *AFp);
+int
 AFposition(AFILE *AFp, long int offs);
+long int
+AFrbFill(AFILE *AFp, long int N);
+int
+AFrbRead(AFILE *AFp, void *Buf, int Lw, int N);
+const unsigned char *
+AFrdBuf(AFILE *AFp, void *Buf, int Lw, int N, int *Nr);
+int
+AFsRdI1(AFILE *AFp, short int Sbuff[], int Nreq);
+int
+AFsRdI2(AFILE *AFp, short int Sbuff[], int Nreq);
+int
+AFsRdU1(AFILE *AFp, short int Sbuff[], int Nreq);
+int
+AFsWrI2(AFILE *AFp, const short int Sbuff[], int Nval);
+int
+AFsWrI3(AFILE *AFp, const short int Sbuff[], int Nval);
+int
+AFsWrI4(AFILE *AFp, const short int Sbuff[], int Nval);
 int
 AFseek(FILE *fp, long int pos, enum AF_ERR_T *ErrCode);
+int
+AFsetAIO(AFILE *AFp, int Nblk);
+int
+AFsetRBuf(AFILE *AFp, long int Lbuf);
+int
+AFsetTxIdx(AFILE *AFp);
 long int
 AFtell(FILE *fp, enum AF_ERR_T *ErrCode);
+int
+AFtxFmtVal(char Str[], double Dv);
+void
+AFtxMark(AFILE *AFp, long int Is);
+int
+AFtxRdData(AFILE *AFp, long int Is, double Dbuff[], int Nreq,
+           enum AF_ERR_T *ErrCode);
+void
+AFunmapData(AFILE *AFp);
+int
+AFwrBuf(AFILE *AFp, const void *Buf, int Lw, int N);
 
 #ifdef __cplusplus
 }
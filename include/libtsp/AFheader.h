@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.57 $  $Date: 2020/11/25 17:56:06 $
+  $Revision: 1.58 $  $Date: 2020/12/19 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -63,6 +63,8 @@ extern "C" {
 
 /* AF/header function prototypes */
 int
+AFendHeadBuf(FILE *fp);
+int
 AFfindFtype(FILE *fp);
 AFILE *
 AFrdAIhead(FILE *fp);
@@ -96,10 +98,16 @@ AFrdTAhead(FILE *fp);
 AFILE *
 AFrdWVhead(FILE *fp);
 int
+AFpeekHead(FILE *fp, char Buf[], int N);
+int
 AFreadHead(FILE *fp, void *Buf, int size, int Nelem, int Swapb);
+int
+AFseekHead(FILE *fp, long int pos);
 void
 AFsetChunkLim(const char *ChunkID, long int Start, long int End,
                struct AF_chunkInfo *ChunkInfo);
+void
+AFsetHeadBuf(FILE *fp);
 AFILE *
 AFsetNHread(FILE *fp);
 AFILE *
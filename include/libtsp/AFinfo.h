@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 2.15 $  $Date: 2020/11/25 17:56:06 $
+  $Revision: 2.16 $  $Date: 2020/12/20 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -65,6 +65,8 @@ void
 AFaddInfoRec(const char Ident[], const char text[], int Size,
              struct AF_info *AFInfo);
 int
+AFdecInfoDefer(struct AF_info *AFInfo);
+int
 AFdecSpeaker(const char String[], unsigned char *SpkrConfig, int MaxN);
 int
 AFdecInfoVVU(const char *String, int Type, void *Val, const char *UnitsTable[],
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.70 $  $Date: 2020/11/29 23:44:56 $
+  $Revision: 1.72 $  $Date: 2020/12/21 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -25,6 +25,16 @@ Author / revision:
 #define AFMF_NumFrame   "   Samples / channel : %ld"
 #define AFMF_Sfreq      "   Sampling frequency: %.6g Hz\n"
 
+/* Data transfer statistics printout formats */
+#define AFM_StatsIn     "input file"
+#define AFM_StatsOut    "output file"
+#define AFMF_StatsHead  " Data transfer statistics (%s):\n"
+#define AFMF_StatsReq   "   Requests: %ld, data bytes: %ld\n"
+#define AFMF_StatsCall  "   %s calls: %ld, seeks: %ld\n"
+#define AFMF_StatsMap   "   Memory mapped data, seeks: %ld\n"
+#define AFMF_StatsClip  "   Clipped values: %ld\n"
+#define AFMF_StatsTime  "   Time: %.4f s (I/O: %.4f s, conversion: %.4f s)\n"
+
 /* Error message text */
 
 /* Warning messages for parameter setting routines */
@@ -203,6 +213,7 @@ Author / revision:
 #define AFM_WV_BadBlock "WAVE file: Invalid block align value"
 #define AFM_WV_BadBytesSec \
     "        WAVE file: Inconsistent header value AvgBytesPerSec ignored"
+#define AFM_WV_BadDS64  "WAVE file: Missing or invalid ds64 chunk"
 #define AFM_WV_BadFACT  "WAVE file: Invalid fact chunk size"
 #define AFM_WV_BadFloat "WAVE file: Invalid float data size"
 #define AFM_WV_BadId    "Invalid WAVE file identifier"
@@ -215,7 +226,9 @@ Author / revision:
 #define AFM_WV_BadRIFF  "WAVE file: Invalid RIFF chunk size"
 #define AFM_WV_BadSize  "WAVE file: Header structure size mismatch"
 #define AFM_WV_BadSS    "WAVE file: Inconsistent sample size"
+#define AFM_WV_BigSize  "WAVE file: Chunk size too large for this system"
 #define AFM_WV_FixRIFF  "WAVE file: Fixup for invalid RIFF chunk size"
+#define AFM_WV_NoRF64   "WAVE file: Data too large, no space for RF64 sizes"
 #define AFM_WV_NSSpkr   "WAVE file: Non-standard speaker locations"
 #define AFM_WV_NSSpkrO  "WAVE file: Non-standard speaker order"
 #define AFM_WV_UnkChannel "WAVE file: Unknown Channel/Speaker combination"
@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Date: 2020/11/25 17:56:06 $
+  $Date: 2020/12/21 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -51,7 +51,11 @@ Author / revision:
 
 /* Chunk names and identifiers in file byte order */
 #define ckID_RIFF     "RIFF"
+#define ckID_RF64     "RF64"  /* RIFF with 64-bit sizes (EBU Tech 3306) */
+#define ckID_BW64     "BW64"  /* RIFF with 64-bit sizes (ITU-R BS.2088) */
 #  define FM_WAVE     "WAVE"
+#define ckID_ds64     "ds64"
+#define ckID_JUNK     "JUNK"
 #define ckID_bext     "bext"
 #define ckID_fmt      "fmt "
 #define ckID_fact     "fact"
@@ -187,14 +191,48 @@ static const struct WV_GUID WAVEFORMATEX_TEMPLATE =
 #define IS_VALID_WAVEFORMATEX_GUID(Guid) \
     (!memcmp(&WAVEFORMATEX_TEMPLATE.guidx, &Guid.guidx, 14))
 
+/* Wave64 files use GUID's as chunk identifiers. The first 4 bytes of the
+   GUID's for the WAVE chunks are the RIFF identifiers ("fmt ", "fact",
+   "data", ...); the remaining 12 bytes are common to these chunks. The file
+   preamble uses lower case "riff" and "wave" identifiers. */
+#define W64_ID_riff     "riff"
+#define W64_GUIDX_riff  "\056\221\317\021\245\326\050\333\004\301\000\000"
+#define W64_ID_wave     "wave"
+#define W64_GUIDX_wave  "\363\254\323\021\214\321\000\300\117\216\333\212"
+
 /* WAVE chunk definitions */
 #define ALIGN   2         /* Chunks padded out to a multiple of ALIGN */
+#define W64_ALIGN   8     /* Wave64 chunks are padded to a multiple of 8 */
+#define W64_LPREAMB 24    /* Wave64 chunk preamble: 16-byte GUID, 8-byte size */
+
+/* RF64: A 32-bit size field with value WV_SIZE_64 is replaced by the 64-bit
+   value in the ds64 chunk */
+#define WV_SIZE_64    0xFFFFFFFFUL
+#define WV_DS64_SIZE  28  /* ds64 chunk size without the table */
+
+/* Low and high 32-bit halves of a (non-negative) long int value */
+#define WV_LOW32(x)   ((UT_uint4_t) ((unsigned long int) (x) & 0xFFFFFFFFUL))
+#define WV_HIGH32(x)  ((UT_uint4_t) (((unsigned long int) (x) >> 16) >> 16))
 
 struct WV_Ckpreamb {
   char ckID[4];
   UT_uint4_t ckSize;
 };
 
+/* ds64 chunk (RF64), without the chunk size table; a JUNK chunk of the same
+   size reserves space for the ds64 chunk */
+struct WV_Ckds64 {
+  char ckID[4];
+  UT_uint4_t ckSize;
+  UT_uint4_t riffSizeLow;     /* RIFF chunk size */
+  UT_uint4_t riffSizeHigh;
+  UT_uint4_t dataSizeLow;     /* data chunk size */
+  UT_uint4_t dataSizeHigh;
+  UT_uint4_t sampleCountLow;  /* Number of samples (per channel), fact chunk */
+  UT_uint4_t sampleCountHigh;
+  UT_uint4_t tableLength;     /* Number of entries in the size table */
+};
+
 struct WV_Ckfmt {
   char ckID[4];
   UT_uint4_t ckSize;
@@ -284,6 +322,7 @@ struct WV_CkRIFF {
   char ckID[4];
   UT_uint4_t ckSize;
   char WAVEID[4];
+  struct WV_Ckds64 Ckds64;    /* ds64 or JUNK, not written if ckSize is 0 */
   struct WV_Ckfmt Ckfmt;
   struct WV_Ckfact Ckfact;
 #ifdef WV_INFO_REC
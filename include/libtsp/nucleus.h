@@ -9,7 +9,7 @@ Description:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 2.73 $  $Date: 2020/11/23 20:48:53 $
+  $Revision: 2.75 $  $Date: 2020/12/26 12:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -45,6 +45,8 @@ AFcheckDataPar(FILE *fp, int Lw, long int *Dstart, struct AF_ndata *NData,
                enum AF_FIX_T Fix);
 struct AF_opt *
 AFoptions(enum AF_OPT_T Cat);
+void
+AFcopyOptions(const struct AF_opt *Opt);
 int
 AFpreSetWPar(enum AF_FTW_T FtypeW, enum AF_FD_T Dformat, long int Nchan,
              double Sfreq, struct AF_write *AFw);
@@ -149,6 +151,8 @@ char *
 UTgetHost(void);
 enum UT_DS_T
 UTswapCode(enum UT_DS_T Dbo);
+void
+UTthreadFree(void **Ptr);
 char *
 UTgetUser(void);
 
@@ -16,10 +16,12 @@ Description:
   SY_POSIX: Availability of Posix routines
     0 - Not available
     1 - Available
+  SY_THREAD_LOCAL: Storage class for library state kept separately for each
+    thread (empty if thread-local storage is not supported)
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.15 $  $Date: 2017/06/09 13:10:15 $
+  $Revision: 1.16 $  $Date: 2020/12/25 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -65,4 +67,21 @@ Author / revision:
 #  define SY_POSIX          1
 #endif
 
+/* Thread-local storage
+   - library state (options, error recovery, line buffers) is kept per thread
+     so that files can be opened and decoded concurrently in different threads
+   - _Thread_local is a C11 keyword (__STDC_NO_THREADS__ refers only to the
+     <threads.h> library and does not affect it)
+   - allocated thread-local storage is freed at thread exit (see UTthreadFree)
+*/
+#if (defined(_MSC_VER))
+#  define SY_THREAD_LOCAL   __declspec(thread)
+#elif (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L)
+#  define SY_THREAD_LOCAL   _Thread_local
+#elif (defined(__GNUC__))
+#  define SY_THREAD_LOCAL   __thread
+#else
+#  define SY_THREAD_LOCAL
+#endif
+
 #endif /* sysOS_h_ */
@@ -23,7 +23,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.33 $  $Date: 2020/11/23 18:35:18 $
+  $Revision: 1.34 $  $Date: 2020/12/26 11:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -172,6 +172,7 @@ static const char *FtypeTab[] = {
   "W*AVE", "w*ave",
   "WAVE-EX", "wave-ex",
   "WAVE-NOEX", "wave-noex",
+  "Wave64", "wave64",
   "AIFF", "aiff",
   "AIFF-C", "aiff-c",
   "AIFF-C/sowt", "aiff-c/sowt",
@@ -188,6 +189,7 @@ static const enum AF_FTW_T FtypeCode[NFTYPE] = {
   FTW_WAVE, FTW_WAVE,
   FTW_WAVE_EX, FTW_WAVE_EX,
   FTW_WAVE_NOEX, FTW_WAVE_NOEX,
+  FTW_WAVE64, FTW_WAVE64,
   FTW_AIFF, FTW_AIFF,
   FTW_AIFF_C, FTW_AIFF_C,
   FTW_AIFF_C_SOWT, FTW_AIFF_C_SOWT,
@@ -5,14 +5,28 @@ Routine:
   int AOdecHelp(const char Version[], const char Usage[])
 
 Purpose:
-  Decode help and version options for audio utilities
+  Decode help, version and data access options for audio utilities
 
 Description:
-  This routine decodes a help or version option. The routine AOinitOpt must be
-  called first to initialize the option arguments. If this routine fails to
-  find an input audio file option, the argument pointer is reset to allow
-  another routine to try to decode the option. For the help or version options,
-  a message is printed and execution is halted.
+  This routine decodes a help, version or data access option. The routine
+  AOinitOpt must be called first to initialize the option arguments. If this
+  routine fails to find an input audio file option, the argument pointer is
+  reset to allow another routine to try to decode the option. For the help or
+  version options, a message is printed and execution is halted.
+
+  The statistics option (--stats) sets the AFopt.Stats option. The data
+  transfer statistics (bytes, read/write calls, seeks and times) for the audio
+  files opened subsequently are printed to stderr when the files are closed.
+  The memory mapping option (--mmap) is noted in the argument structure (see
+  AOArgs). The input file options are reset after each input file is opened,
+  so AOsetFIopt sets AFopt.MMap from this value for each input file. The data
+  of random access input files is then mapped into memory. The deferred
+  information record option (--lazy-info) is handled in the same way and sets
+  AFopt.LazyInfo. The information records of WAVE input files are then decoded
+  on first use.
+  The background I/O option (--async=N) sets the AFopt.AsyncIO option. The
+  data of the audio files opened subsequently is then transferred by a
+  separate thread for each file, using N buffer blocks (0 turns this off).
 
 Parameters:
   <-  int AOdecHelp
@@ -27,14 +41,15 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.9 $  $Date: 2020/11/23 18:35:18 $
+  $Revision: 1.14 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
 #include <stdlib.h>   /* EXIT_SUCCESS */
 
 #include <libtsp.h>
-#include <AObase.h>
+#include <AFpar.h>
+#include <AO.h>
 
 #define ROUTINE          "AOdecHelp"
 #define PGM              ((UTgetProg())[0] == '\0' ? ROUTINE : UTgetProg())
@@ -47,6 +62,10 @@ static const char *OThelp[] = {
   "-h",  "--h*elp",
   "-v",  "--v*ersion",
   "--",
+  "--stat*s",
+  "--mmap",
+  "--async=",
+  "--lazy-info",
   "**",
   NULL
 };
@@ -89,6 +108,23 @@ AOdecHelp(const char Version[], const char Usage[])
     /* End of options */
     Carg->EndOptions = 1;
     break;
+  case 6:
+    /* Data transfer statistics */
+    AFopt.Stats = 1;
+    break;
+  case 7:
+    /* Memory mapped input */
+    Carg->MMap = 1;
+    break;
+  case 8:
+    /* Background data I/O */
+    if (STdec1int(OptArg, &AFopt.AsyncIO) || AFopt.AsyncIO < 0)
+      ERRSTOP(AOM_BadAsync, OptArg);
+    break;
+  case 9:
+    /* Deferred information record decoding */
+    Carg->LazyInfo = 1;
+    break;
   default:
     Carg->Index = Sindex;   /* Reset the index */
     n = 0;
@@ -40,7 +40,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.17 $  $Date: 2020/11/23 18:35:18 $
+  $Revision: 1.19 $  $Date: 2020/12/24 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -50,7 +50,7 @@ Author / revision:
 static const char *nullTable[] = { NULL };
 
 /* Initialize the command line argument structure */
-static struct AO_CmdArg AOArg = {NULL, 0, 1, 0};
+static struct AO_CmdArg AOArg = {NULL, 0, 1, 0, 0, 0};
 
 
 void
@@ -62,6 +62,8 @@ AOinitOpt(const int argc, const char *argv[])
   AOArg.Argc = argc;
   AOArg.Index = 1;
   AOArg.EndOptions = 0;
+  AOArg.MMap = 0;
+  AOArg.LazyInfo = 0;
 }
 
 /* Return a pointer to the argument pointer structure */
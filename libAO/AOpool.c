@@ -0,0 +1,261 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  struct AO_pool *AOnewPool(int Nthread)
+  void AOrunPool(struct AO_pool *Pool, void (*Fn)(int ich, void *Arg),
+                 void *Arg, int Nchan)
+  void AOfreePool(struct AO_pool *Pool)
+
+Purpose:
+  Create a pool of worker threads
+  Invoke a per-channel processing routine for each channel using a pool
+  Stop the worker threads and free a pool
+
+Description:
+  These routines distribute independent per-channel calls over a set of
+  threads that persists across calls. A program that processes its data block
+  by block creates the pool once, dispatches the channels of each block with
+  AOrunPool, and frees the pool at the end. The threads are not created and
+  joined for each block.
+
+  AOnewPool creates Nthread-1 worker threads; the thread calling AOrunPool
+  acts as the remaining thread. The workers wait for work between calls. If a
+  thread cannot be created, the pool has fewer workers.
+
+  AOrunPool invokes Fn(ich, Arg) for each of the channels ich = 0, 1, ...,
+  Nchan-1 and returns after all of the calls have completed. The calls for
+  different channels must be independent of each other. Each thread claims
+  the next unprocessed channel when it finishes one, so that channels which
+  take longer do not hold up the others. The order of the calls is not
+  defined.
+
+  AOfreePool stops the worker threads and frees the pool storage.
+
+  Threads are used only on systems with POSIX threads. Otherwise (e.g. for
+  builds with MSVC) and for Nthread of one or less, the pool has no workers
+  and AOrunPool makes the calls in channel order from the calling thread.
+
+  The worker threads have their own audio file options structure. AOnewPool
+  takes a copy of the options of the calling thread and each worker installs
+  it when it starts (see AFcopyOptions). Files opened or written by the
+  per-channel routines then use the same options (e.g. those set from the
+  command line) as in the calling thread. The speaker configuration and
+  information records for output files are not copied. Options changed in
+  the calling thread after the pool is created do not affect the workers.
+
+Parameters:
+  <-  struct AO_pool *AOnewPool
+      Pointer to the pool structure
+   -> int Nthread
+      Maximum number of threads (including the calling thread)
+
+  <-  void AOrunPool
+  <-> struct AO_pool *Pool
+      Pointer to the pool structure
+   -> void (*Fn)(int ich, void *Arg)
+      Routine to be invoked for each channel
+   -> void *Arg
+      Argument passed to Fn
+   -> int Nchan
+      Number of channels
+
+  <-  void AOfreePool
+  <-> struct AO_pool *Pool
+      Pointer to the pool structure
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/26 12:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+
+#if (SY_POSIX)
+#  include <pthread.h>
+#endif
+
+#include <AO.h>
+
+#define MAXTHREAD   64
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+/* Pool of worker threads and the work for the current call */
+struct AO_pool {
+  int Nworker;                  /* Number of worker threads */
+#if (SY_POSIX)
+  pthread_t Tid[MAXTHREAD];
+  pthread_mutex_t Lock;
+  pthread_cond_t Start;         /* New work or stop request */
+  pthread_cond_t Done;          /* Workers finished with the current work */
+#endif
+  struct AF_opt Opt;            /* Options of the creating thread */
+  void (*Fn)(int ich, void *Arg);
+  void *Arg;
+  int Nchan;
+  int Next;                     /* Next channel to be claimed */
+  int Nbusy;                    /* Workers not yet finished with the work */
+  long int Gen;                 /* Work generation count */
+  int Stop;
+};
+
+#if (SY_POSIX)
+static void *
+AO_worker(void *Pool);
+static void
+AO_claimChan(struct AO_pool *Pool);
+#endif
+
+
+struct AO_pool *
+AOnewPool(int Nthread)
+
+{
+  struct AO_pool *Pool;
+#if (SY_POSIX)
+  int Nw, i;
+#endif
+
+  Pool = (struct AO_pool *) UTmalloc(sizeof(struct AO_pool));
+  Pool->Nworker = 0;
+  Pool->Fn = NULL;
+  Pool->Arg = NULL;
+  Pool->Nchan = 0;
+  Pool->Next = 0;
+  Pool->Nbusy = 0;
+  Pool->Gen = 0L;
+  Pool->Stop = 0;
+  Pool->Opt = *AFoptions(AF_OPT_NULL);
+  Pool->Opt.SpkrConfig = NULL;      /* Not copied to the workers */
+  Pool->Opt.UInfo.Info = NULL;
+
+#if (SY_POSIX)
+  pthread_mutex_init(&Pool->Lock, NULL);
+  pthread_cond_init(&Pool->Start, NULL);
+  pthread_cond_init(&Pool->Done, NULL);
+
+  /* The calling thread is the remaining thread */
+  Nw = MINV(Nthread, MAXTHREAD) - 1;
+  for (i = 0; i < Nw; ++i) {
+    if (pthread_create(&Pool->Tid[Pool->Nworker], NULL, AO_worker, Pool) != 0)
+      break;
+    ++Pool->Nworker;
+  }
+#endif
+
+  return Pool;
+}
+
+
+void
+AOrunPool(struct AO_pool *Pool, void (*Fn)(int ich, void *Arg), void *Arg,
+          int Nchan)
+
+{
+  int i;
+
+  if (Pool->Nworker <= 0 || Nchan <= 1) {
+    for (i = 0; i < Nchan; ++i)
+      (*Fn)(i, Arg);
+    return;
+  }
+
+#if (SY_POSIX)
+  /* Post the work, then take part in it */
+  pthread_mutex_lock(&Pool->Lock);
+  Pool->Fn = Fn;
+  Pool->Arg = Arg;
+  Pool->Nchan = Nchan;
+  Pool->Next = 0;
+  Pool->Nbusy = Pool->Nworker;
+  ++Pool->Gen;
+  pthread_cond_broadcast(&Pool->Start);
+  AO_claimChan(Pool);
+
+  /* Each worker checks in once for each generation of work */
+  while (Pool->Nbusy > 0)
+    pthread_cond_wait(&Pool->Done, &Pool->Lock);
+  pthread_mutex_unlock(&Pool->Lock);
+#endif
+
+  return;
+}
+
+
+void
+AOfreePool(struct AO_pool *Pool)
+
+{
+#if (SY_POSIX)
+  int i;
+#endif
+
+  if (Pool == NULL)
+    return;
+
+#if (SY_POSIX)
+  pthread_mutex_lock(&Pool->Lock);
+  Pool->Stop = 1;
+  pthread_cond_broadcast(&Pool->Start);
+  pthread_mutex_unlock(&Pool->Lock);
+  for (i = 0; i < Pool->Nworker; ++i)
+    pthread_join(Pool->Tid[i], NULL);
+
+  pthread_cond_destroy(&Pool->Done);
+  pthread_cond_destroy(&Pool->Start);
+  pthread_mutex_destroy(&Pool->Lock);
+#endif
+
+  UTfree(Pool);
+}
+
+#if (SY_POSIX)
+/* Worker thread: wait for work, process channels, check in */
+
+static void *
+AO_worker(void *Pool)
+
+{
+  struct AO_pool *P;
+  long int Gen;
+
+  P = (struct AO_pool *) Pool;
+  AFcopyOptions(&P->Opt);
+  Gen = 0L;     /* Work posted before the thread runs is still taken up */
+  pthread_mutex_lock(&P->Lock);
+  for (;;) {
+    while (! P->Stop && P->Gen == Gen)
+      pthread_cond_wait(&P->Start, &P->Lock);
+    if (P->Stop)
+      break;
+    Gen = P->Gen;
+
+    AO_claimChan(P);
+    --P->Nbusy;
+    if (P->Nbusy == 0)
+      pthread_cond_signal(&P->Done);
+  }
+  pthread_mutex_unlock(&P->Lock);
+
+  return NULL;
+}
+
+/* Claim and process channels until none are left (called with the lock
+   held, the lock is released while a channel is processed) */
+
+static void
+AO_claimChan(struct AO_pool *Pool)
+
+{
+  int ich;
+
+  while (Pool->Next < Pool->Nchan) {
+    ich = Pool->Next;
+    ++Pool->Next;
+    pthread_mutex_unlock(&Pool->Lock);
+    (*Pool->Fn)(ich, Pool->Arg);
+    pthread_mutex_lock(&Pool->Lock);
+  }
+}
+#endif
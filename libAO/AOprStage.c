@@ -0,0 +1,63 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void AOprStage(const char Name[], double Tstage, AFILE *AFp[], int Nf)
+
+Purpose:
+  Print the time for a processing stage of an audio utility
+
+Description:
+  This routine prints the time taken by a processing stage (for instance,
+  filtering) to stderr. The stage reads data from input audio files and writes
+  data to output audio files. The time spent in the data requests for these
+  files (audio file I/O and data conversion) is taken from the data transfer
+  statistics for the files (see AFprintStats). The remaining time is reported
+  as the computation time for the stage. The times for the data requests are
+  available if the statistics option (--stats, see AOdecHelp) has been set.
+  Nothing is printed if this option is not set.
+
+  The request times for the files are summed. If several threads access their
+  own files at the same time, the computation time is underestimated.
+
+Parameters:
+  <-  void AOprStage
+   -> const char Name[]
+      Name of the processing stage
+   -> double Tstage
+      Elapsed time for the stage in seconds (see UTclock)
+   -> AFILE *AFp[]
+      Array of Nf audio file pointers for the files used in the stage
+   -> int Nf
+      Number of audio files
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/16 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <AO.h>
+
+
+void
+AOprStage(const char Name[], double Tstage, AFILE *AFp[], int Nf)
+
+{
+  int i;
+  double Treq, Tcomp;
+
+  if (!AFopt.Stats)
+    return;
+
+  Treq = 0.0;
+  for (i = 0; i < Nf; ++i)
+    Treq += AFp[i]->Stats.Treq;
+  Tcomp = Tstage - Treq;
+  if (Tcomp < 0.0)
+    Tcomp = 0.0;
+
+  fprintf(stderr, AOMF_Stage, Name, Tstage, Tcomp);
+
+  return;
+}
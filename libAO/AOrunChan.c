@@ -0,0 +1,68 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void AOrunChan(void (*Fn)(int ich, void *Arg), void *Arg, int Nchan,
+                 int Nthread)
+
+Purpose:
+  Invoke a per-channel processing routine for each channel using threads
+
+Description:
+  This routine invokes Fn(ich, Arg) for each of the channels ich = 0, 1, ...,
+  Nchan-1. The channels are distributed over up to Nthread threads, with the
+  calling thread acting as one of the threads. The calls for different
+  channels must be independent of each other. This routine returns after all
+  of the calls have completed.
+
+  The threads are created and joined on each call. A program that dispatches
+  the channels for each block of data should instead create a pool of threads
+  once (see AOnewPool) and use AOrunPool for each block.
+
+  If Nthread is one or less, or threads are not available (systems without
+  POSIX threads, e.g. builds with MSVC), the calls are made in channel order
+  from the calling thread. If a thread cannot be created, the channels are
+  shared among the remaining threads.
+
+Parameters:
+  <-  void AOrunChan
+   -> void (*Fn)(int ich, void *Arg)
+      Routine to be invoked for each channel
+   -> void *Arg
+      Argument passed to Fn
+   -> int Nchan
+      Number of channels
+   -> int Nthread
+      Maximum number of threads
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/24 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <AO.h>
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+
+void
+AOrunChan(void (*Fn)(int ich, void *Arg), void *Arg, int Nchan, int Nthread)
+
+{
+  int Nt, i;
+  struct AO_pool *Pool;
+
+  Nt = MINV(Nthread, Nchan);
+  if (Nt <= 1) {
+    for (i = 0; i < Nchan; ++i)
+      (*Fn)(i, Arg);
+    return;
+  }
+
+  Pool = AOnewPool(Nt);
+  AOrunPool(Pool, Fn, Arg, Nchan);
+  AOfreePool(Pool);
+
+  return;
+}
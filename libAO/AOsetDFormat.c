@@ -29,6 +29,7 @@ Description:
       .afc or .aifc - FTW_AIFF_C, AIFF-C sound file
       .raw, .dat, or .nh - FTW_NH_NATIVE, headerless file
       .txt or .text - FTW_TXAUD, text file (with header)
+      .w64          - FTW_WAVE64, Wave64 file
 
     The file type is checked for validity and the file type in the structure FO
     is updated if necessary.
@@ -61,7 +62,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.16 $  $Date: 2020/11/23 18:35:18 $
+  $Revision: 1.17 $  $Date: 2020/12/26 11:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -116,7 +117,8 @@ static const char *AF_FTWN[] = {
   "Headerless audio file",
   "Headerless audio file",
   "Headerless audio file",
-  "Text audio file"
+  "Text audio file",
+  "Wave64 file"
 };
 
 static const enum AF_FD_T *
@@ -131,7 +133,7 @@ AOsetDFormat(struct AO_FOpar *FO, AFILE *AFp[], int Nf)
   enum AF_FD_T Format;
   const enum AF_FD_T *AllowFD;
 
-  assert(FTW_TXAUD+1 == NELEM(AF_FTWN));
+  assert(FTW_WAVE64+1 == NELEM(AF_FTWN));
   assert(NELEM(PrecD) == AF_NFD);
 
   /* Set the output file type if not set */
@@ -213,6 +215,7 @@ AO_AllowFD(enum AF_FTW_T FtypeW)
   case FTW_WAVE:
   case FTW_WAVE_EX:
   case FTW_WAVE_NOEX:
+  case FTW_WAVE64:
     AllowFD = Allow_WAVE;
     break;
   case FTW_AIFF:
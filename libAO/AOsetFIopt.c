@@ -9,7 +9,9 @@ Purpose:
 
 Description:
   This routine sets the input file options in the audio file options structure
-  from the input file parameter structure.
+  from the input file parameter structure. The memory mapping and deferred
+  information record options are set from the values decoded by AOdecHelp
+  (--mmap and --lazy-info).
 
   Calling this routine as
     AOsetFIopt(FI, 0, 0)
@@ -31,7 +33,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.10 $  $Date: 2020/11/23 18:35:18 $
+  $Revision: 1.12 $  $Date: 2020/12/24 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -46,4 +48,6 @@ AOsetFIopt(const struct AO_FIpar *FI, int NsampND, int RAccess)
   AFopt.RAccess = RAccess;
   AFopt.FtypeI = FI->Ftype;
   AFopt.InputPar = FI->InputPar;
+  AFopt.MMap = (AOArgs())->MMap;
+  AFopt.LazyInfo = (AOArgs())->LazyInfo;
 }
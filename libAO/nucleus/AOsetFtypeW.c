@@ -21,6 +21,7 @@ Description:
     .afc or .aifc - FTW_AIFF_C, AIFF-C sound file
     .raw, .nh, or .dat - FTW_NH_NATIVE, headerless file
     .txt or .text - FTW_TEXT, text audio file (with header)
+    .w64          - FTW_WAVE64, Wave64 file
 
   The file type is checked for validity before returning. For use in an error
   message, the program name should be set using the routine UTsetProg.
@@ -32,7 +33,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.11 $  $Date: 2020/11/23 18:35:28 $
+  $Revision: 1.12 $  $Date: 2020/12/26 11:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -50,6 +51,7 @@ static const char *Ext_keys[] = {
   ".afc", ".aifc",
   ".raw", ".nh", ".dat",
   ".txt", ".text",
+  ".w64",
   NULL
 };
 
@@ -60,7 +62,8 @@ static const int FtypeW_values[] = {
   FTW_AIFF,
   FTW_AIFF_C, FTW_AIFF_C,
   FTW_NH_NATIVE, FTW_NH_NATIVE, FTW_NH_NATIVE,
-  FTW_TXAUD, FTW_TXAUD
+  FTW_TXAUD, FTW_TXAUD,
+  FTW_WAVE64
 };
 
 
@@ -96,6 +99,7 @@ AOsetFtypeW(struct AO_FOpar *FO)
   case FTW_NH_EL:
   case FTW_NH_EB:
   case FTW_TXAUD:
+  case FTW_WAVE64:
     break;
   default:
     UThalt("%s: %s", PGM, AOM_InvFTypeC);
@@ -12,10 +12,14 @@ Description:
   file was opened for write, the file header is updated with the number of
   samples in the file. For both read and write operations, the audio file
   parameter structure associated with the file pointer is deallocated and the
-  file is closed.
+  file is closed. For a file with background I/O (see AFsetAIO), the queued
+  data is written before the header is updated, and the background thread is
+  stopped.
 
   If the file was opened for write, the number of overloads detected during
-  write operations is reported.
+  write operations is reported. If the file was opened with the statistics
+  option set (see AFoptions), the data transfer statistics are printed to
+  stderr (see AFprintStats).
 
 Parameters:
   <-  void AFclose
@@ -25,7 +29,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.58 $  $Date: 2020/11/26 11:21:31 $
+  $Revision: 1.62 $  $Date: 2020/12/22 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -35,6 +39,7 @@ Author / revision:
 #include <libtsp.h>
 #include <AFpar.h>
 #include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
 #include <libtsp/AFheader.h>
 #include <libtsp/AFmsg.h>
 
@@ -73,7 +78,17 @@ AFclose(AFILE *AFp)
   else
     assert(AFp->Op == FO_RO);
 
-/* Close the file */
+/* Stop any background I/O (input files, output files after an error) */
+  (void) AFendAIO(AFp);
+
+/* Data transfer statistics */
+  if (AFp->Stats.Report)
+    AFprintStats(AFp, stderr);
+
+/* Release any memory mapping, data window or index and close the file */
+  AFunmapData(AFp);
+  AFfreeRBuf(AFp);
+  AFfreeTxIdx(AFp);
   fclose(AFp->fp);
 
 /* Reset some AFILE structure values */
@@ -81,6 +96,7 @@ AFclose(AFILE *AFp)
   AFp->Op = FO_NONE;
   UTfree((void *) AFp->SpkrConfig);
   UTfree((void *) AFp->AFInfo.Info);
+  UTfree((void *) AFp->AFInfo.Defer);
   UTfree((void *) AFp->ChunkInfo.ChunkLim);
 
 /* Deallocate the AFILE structure */
@@ -0,0 +1,244 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFcopyCheck(const AFILE *AFpI, const AFILE *AFpO)
+  int AFcopyData(AFILE *AFpI, long int offs, AFILE *AFpO, int Nreq)
+
+Purpose:
+  Check whether audio file data can be copied without conversion
+  Copy data from one audio file to another without conversion
+
+Description:
+  AFcopyCheck determines whether data values can be copied directly from an
+  input audio file to an output audio file, without conversion to double
+  values and back. This is the case when both files use the same binary data
+  format and byte order, and the scaling applied on reading is undone exactly
+  by the scaling applied on writing (no gain is applied to the data). The
+  values written to the output file are then the same as those that would be
+  written using AFdReadData and AFdWriteData. Mu-law data (including
+  bit-reversed mu-law) is excluded: mu-law has two codes for zero, and the
+  negative zero code is written as the positive zero code after conversion.
+
+  AFcopyData copies a specified number of samples at a given sample offset
+  in the input file to the output file. The data values are moved as bytes,
+  directly from the memory mapped input data where available. As for
+  AFdReadData, the input data is considered to be preceded and followed by
+  zero-valued samples; zero-valued samples are written to the output for
+  offsets outside the input data. AFcopyCheck must be used to determine that
+  the files are compatible.
+
+  On encountering an error, the default behaviour is to print an error message
+  and halt execution.
+
+Parameters:
+  <-  int AFcopyCheck
+      Flag, non-zero if the data can be copied without conversion
+   -> const AFILE *AFpI
+      Audio file pointer for an audio file opened by AFopnRead
+   -> const AFILE *AFpO
+      Audio file pointer for an audio file opened by AFopnWrite
+
+  <-  int AFcopyData
+      Number of data values transferred from the input file, counted as for
+      AFdReadData. On reaching the end of the input file, this value may be
+      less than Nreq, in which case the remaining values written to the output
+      file are zero.
+  <-> AFILE *AFpI
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int offs
+      Offset into the input file in samples
+  <-> AFILE *AFpO
+      Audio file pointer for an audio file opened by AFopnWrite
+   -> int Nreq
+      Number of samples to be copied. Nreq may be zero.
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.3 $  $Date: 2020/12/26 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdlib.h>   /* EXIT_FAILURE */
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
+#include <libtsp/AFmsg.h>
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+#define MAXV(a, b)  (((a) > (b)) ? (a) : (b))
+
+#define NBCOPY  65536   /* Buffer size in bytes */
+#define NZBUF   256     /* Size of the buffer of zeros */
+
+static int
+AF_copyZeros(AFILE *AFpO, int N);
+static int
+AF_copyBytes(AFILE *AFpI, AFILE *AFpO, int Lw, int N);
+
+
+int
+AFcopyCheck(const AFILE *AFpI, const AFILE *AFpO)
+
+{
+  int Lw;
+
+  if (AFpI->Op != FO_RO || AFpO->Op != FO_WO || AFpI->Format != AFpO->Format)
+    return 0;
+
+  /* Each code must map to a distinct value (not mu-law, two zero codes) */
+  if (AFpI->Format == FD_MULAW8 || AFpI->Format == FD_MULAWR8)
+    return 0;
+
+  /* Binary data (fixed length records) only */
+  Lw = AF_DL[AFpI->Format];
+  if (Lw <= 0)
+    return 0;
+
+  /* Same byte order (file data relative to the host) */
+  if (Lw > 1 && AFpI->Swapb != AFpO->Swapb)
+    return 0;
+
+  /* Unit gain */
+  return (AFpI->ScaleF * AFpO->ScaleF == 1.0);
+}
+
+
+int
+AFcopyData(AFILE *AFpI, long int offs, AFILE *AFpO, int Nreq)
+
+{
+  int Lw, Nv, Nr, Nout;
+  double T, Tw, Tz;
+
+  assert(AFpI->Op == FO_RO && AFpO->Op == FO_WO);
+  assert(!AFpI->Error);
+  assert(AFcopyCheck(AFpI, AFpO));
+
+/* Start time for the data transfer statistics */
+  T = 0.0;
+  if (AFpI->Stats.Report || AFpO->Stats.Report)
+    T = UTclock();
+  Tw = 0.0;
+  Tz = AFpO->Stats.Treq;
+
+/* Zeros at the beginning of the data */
+  if (offs < 0) {
+    Nout = (int) MINV(-offs, Nreq);
+    AF_copyZeros(AFpO, Nout);
+    offs += Nout;
+  }
+  else
+    Nout = 0;
+
+/* Position the input file */
+  AFpI->Error = AFposition(AFpI, offs);
+
+/* Transfer the data (see AFdReadData) */
+  if (AFpI->Nsamp == AF_NSAMP_UNDEF)
+    Nv = Nreq - Nout;
+  else
+    Nv = (int) MINV(Nreq - Nout, MAXV(AFpI->Nsamp - offs, 0L));
+
+  Lw = AF_DL[AFpI->Format];
+  if (!AFpI->Error && Nv > 0) {
+    Tw = AFpO->Stats.Tio;
+    Nr = AF_copyBytes(AFpI, AFpO, Lw, Nv);
+    Tw = AFpO->Stats.Tio - Tw;
+    Nout += Nr;
+
+/* Check for errors */
+    if (Nr < Nv && !AFpO->Error) {
+      if (ferror(AFpI->fp)) {
+        UTsysMsg("AFcopyData - %s %ld", AFM_ReadErrOffs, AFpI->Isamp);
+        AFpI->Error = AF_IOERR;
+      }
+      else if (AFpI->Nsamp != AF_NSAMP_UNDEF) {
+        UTwarn("AFcopyData - %s %ld", AFM_UEoFOffs, AFpI->Isamp);
+        AFpI->Error = AF_UEOF;
+      }
+      else
+        AFpI->Nsamp = AFpI->Isamp;
+    }
+  }
+
+/* Zeros at the end of the data */
+  if (!AFpO->Error)
+    AF_copyZeros(AFpO, Nreq - Nout);
+
+/* Data transfer statistics: the output file is charged with the time to write
+   the copied data (the zeros are written with AFdWriteData), the input file
+   with the rest of the request time */
+  ++AFpI->Stats.Nreq;
+  ++AFpO->Stats.Nreq;
+  if (AFpI->Stats.Report || AFpO->Stats.Report) {
+    Tz = AFpO->Stats.Treq - Tz;
+    AFpO->Stats.Treq += Tw;
+    AFpI->Stats.Treq += UTclock() - T - Tw - Tz;
+  }
+
+  if ((AFpI->Error || AFpO->Error) && AFopt.ErrorHalt)
+    exit(EXIT_FAILURE);
+
+  return Nout;
+}
+
+/* Write N zero-valued samples */
+
+
+static int
+AF_copyZeros(AFILE *AFpO, int N)
+
+{
+  double Zero[NZBUF];
+  int i, k, Nv, Nw;
+
+  for (i = 0; i < NZBUF; ++i)
+    Zero[i] = 0.0;
+
+  for (k = 0; k < N; k += Nv) {
+    Nv = MINV(N - k, NZBUF);
+    Nw = AFdWriteData(AFpO, Zero, Nv);
+    if (Nw < Nv)
+      return k + Nw;
+  }
+
+  return N;
+}
+
+/* Move N data values (Lw bytes each) from the current position in the input
+   file to the output file */
+
+
+static int
+AF_copyBytes(AFILE *AFpI, AFILE *AFpO, int Lw, int N)
+
+{
+  unsigned char Buf[NBCOPY];
+  const unsigned char *Bp;
+  int k, Nv, Nr, Nw;
+
+  for (k = 0; k < N; k += Nr) {
+
+    /* Mapped data: the whole request at once */
+    Nv = (AFpI->MMap.Data != NULL) ? N - k : MINV(N - k, NBCOPY / Lw);
+    Bp = AFrdBuf(AFpI, Buf, Lw, Nv, &Nr);
+    AFpI->Isamp += Nr;
+
+    Nw = AFwrBuf(AFpO, Bp, Lw, Nr);
+    AFpO->Isamp += Nw;
+    AFpO->Nsamp = MAXV(AFpO->Isamp, AFpO->Nsamp);
+    if (Nw < Nr) {
+      UTsysMsg("AFcopyData: %s", AFM_WriteErr);
+      AFpO->Error = AF_IOERR;
+      return k + Nw;
+    }
+    if (Nr < Nv)
+      return k + Nr;
+  }
+
+  return N;
+}
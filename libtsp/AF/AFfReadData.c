@@ -64,7 +64,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.15 $  $Date: 2020/11/26 11:21:31 $
+  $Revision: 1.16 $  $Date: 2020/12/16 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -101,6 +101,7 @@ AFfReadData(AFILE *AFp, long int offs, float Dbuff[], int Nreq)
 
 {
   int i, Nv, Nr, Nout;
+  double T;
 
 /* Check the operation  */
   assert(AFp->Op == FO_RO);
@@ -108,6 +109,11 @@ AFfReadData(AFILE *AFp, long int offs, float Dbuff[], int Nreq)
   assert(AF_Read[AF_NFD-1] != NULL);
   assert(AFp->Format > 0 && AFp->Format < AF_NFD);
 
+/* Start time for the data transfer statistics */
+  T = 0.0;
+  if (AFp->Stats.Report)
+    T = UTclock();
+
 /* Fill in zeros at the beginning of data */
   if (offs < 0) {
     Nout = MINV(-offs, Nreq);
@@ -174,6 +180,11 @@ AFfReadData(AFILE *AFp, long int offs, float Dbuff[], int Nreq)
   for (i = Nout; i < Nreq; ++i)
     Dbuff[i] = 0;
 
+/* Data transfer statistics */
+  ++AFp->Stats.Nreq;
+  if (AFp->Stats.Report)
+    AFp->Stats.Treq += UTclock() - T;
+
   if (AFp->Error && AFopt.ErrorHalt)
     exit(EXIT_FAILURE);
 
@@ -26,7 +26,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.14 $  $Date: 2020/11/23 20:48:08 $
+  $Revision: 1.15 $  $Date: 2020/12/16 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -55,6 +55,7 @@ AFfWriteData(AFILE *AFp, const float Dbuff[], int Nval)
 {
   int Nw;
   long int Novld;
+  double T;
 
   assert(AFp->Op == FO_WO);
   assert(AF_Write[AF_NFD-1] != NULL);
@@ -73,12 +74,22 @@ AFfWriteData(AFILE *AFp, const float Dbuff[], int Nval)
     AFp->Nsamp - last sample (updated if AFp->Isamp is beyond it)
 */
 
+/* Start time for the data transfer statistics */
+  T = 0.0;
+  if (AFp->Stats.Report)
+    T = UTclock();
+
 /* Transfer data to the audio file */
   Novld = AFp->Novld; /* Save the value before writing */
   Nw = (*AF_Write[AFp->Format])(AFp, Dbuff, Nval);
   AFp->Isamp += Nw;
   AFp->Nsamp = MAXV(AFp->Isamp, AFp->Nsamp);
 
+/* Data transfer statistics */
+  ++AFp->Stats.Nreq;
+  if (AFp->Stats.Report)
+    AFp->Stats.Treq += UTclock() - T;
+
 /* Check for an error */
   if (Nw < Nval) {
     UTsysMsg("AFfWriteData: %s", AFM_WriteErr);
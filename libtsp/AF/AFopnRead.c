@@ -4,9 +4,12 @@
 Routine:
   AFILE *AFopnRead(const char Fname[], long int *Nsamp, long int *Nchan,
                    double *Sfreq, FILE *fpinfo)
+  AFILE *AFopnReadCtx(const char Fname[], long int *Nsamp, long int *Nchan,
+                      double *Sfreq, FILE *fpinfo, const struct AF_opt *Opt)
 
 Purpose:
   Open an audio file for reading
+  Open an audio file for reading, using a given set of options
 
 Description:
   This routine opens an audio file for reading. The companion routine
@@ -26,7 +29,8 @@ Description:
   WAVE file:
     8-bit mu-law, 8-bit A-law, offset-binary 1-bit to 8-bit integer, 9-bit to
     32-bit integer, 32-bit IEEE floating-point, and 64-bit IEEE floating-point
-    data formats are supported.
+    data formats are supported. RF64, BW64 and Wave64 files (64-bit sizes)
+    are read as WAVE files.
   AIFF sound file:
     1-bit to 32-bit integer data formats are supported.
   AIFF-C sound file:
@@ -106,13 +110,47 @@ Description:
     samples.
   - AIFF/AIFF-C files with a perverse header cannot be opened for non-random
     access.
+  - If the MMap option is set (see AFoptions), the data of a random access
+    input file with binary data is mapped into memory. Data reads then decode
+    directly from the mapped data. Input from a stream which does not allow
+    random access continues to use stdio.
+  - For input from a stream which does not allow random access, a window of
+    recently read data is retained (option Lback, see AFoptions). Moving back
+    to data within this window (for instance to reread overlapping blocks of
+    data) is allowed.
+  - For a random access input file with text data, an index of sample
+    positions is built as the data is read. Moving back in the file then
+    starts from the nearest indexed position rather than from the start of
+    the data.
+  - For a random access file, the header is read with one read of a leading
+    block of the file, with a single further read for header chunks beyond
+    that block (see AFsetHeadBuf). Headers of files which are not random access
+    are read from the stream.
+  - If the HeadOnly option is set (see AFoptions), only the file header is
+    read. The file parameters are available, but the data should not be
+    read. The number of samples in a text file may then be undefined.
   - Opening an input file populates the AFinfo record sub-structure in the AFILE
     structure with additional information. See the routine AFsetInfo for the
-    type of information that is extracted from the file.
+    type of information that is extracted from the file. If the LazyInfo
+    option is set (see AFoptions), the information records in the text chunks
+    of a random access WAVE file are decoded on first use instead.
+  - If the AsyncIO option is set (see AFoptions), the binary data of a random
+    access input file which is not memory mapped is read ahead by a background
+    thread (see AFsetAIO). Deferred information records are then decoded when
+    the file is opened.
 
   On encountering an error, the default behaviour is to print an error message
   and halt execution.
 
+  The options used when opening a file are taken from the options structure
+  (see AFoptions). Each thread has its own options structure, so that files
+  can be opened and read concurrently from different threads. AFopnReadCtx
+  takes the general and input file options from the structure Opt instead.
+  The options structure of the calling thread is left unchanged. This allows
+  a single options structure, filled in once, to be shared by several
+  threads. The error option ErrorHalt for subsequent data reads is taken from
+  the options of the calling thread.
+
 Parameters:
   <-  AFILE *AFopnRead
       Audio file pointer for the audio file
@@ -129,9 +167,25 @@ Parameters:
       information about the audio file is printed on the stream selected by
       fpinfo.
 
+  <-  AFILE *AFopnReadCtx
+      Audio file pointer for the audio file
+   -> const char Fname[]
+      Character string specifying the file name
+  <-  long int *Nsamp
+      Total number of samples in the file (all channels)
+  <-  long int *Nchan
+      Number of channels
+  <-  double *Sfreq
+      Sampling frequency
+   -> FILE *fpinfo
+      File pointer for printing audio file information
+   -> const struct AF_opt *Opt
+      Options structure. The general options and the options for input files
+      are used. The output file options are ignored.
+
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.22 $  $Date: 2020/11/26 11:21:31 $
+  $Revision: 1.29 $  $Date: 2020/12/22 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -153,6 +207,7 @@ Author / revision:
 #include <libtsp.h>
 #include <AFpar.h>
 #include <libtsp/nucleus.h>     /* FLseekable */
+#include <libtsp/AFdataio.h>    /* AFmapData, AFsetRBuf, AFsetTxIdx, etc. */
 #include <libtsp/AFheader.h>
 #include <libtsp/AFmsg.h>
 
@@ -164,6 +219,8 @@ static void
 AF_error(const char Fname[], int sysFlag);
 static FILE*
 AF_open_read_bin(const char Fname[]);
+static void
+AF_copyOptR(const struct AF_opt *Opt, struct AF_opt *OptR);
 
 /* If AFopt->ErrorHalt is clear, execution continues after an error */
 
@@ -181,12 +238,19 @@ AFopnRead(const char Fname[], long int *Nsamp, long int *Nchan, double *Sfreq,
   if (fp == NULL)
     return NULL;
 
+/* Buffer the header reads (random access files) */
+  AFsetHeadBuf(fp);
+
 /* Identify the file type */
 /* - pre-set file type from options structure
    - if none, check the file header
 */
   Ftype = AFfindFtype(fp);
 
+/* Text headers are read line by line from the stream */
+  if (Ftype == FT_SPW || Ftype == FT_TXAUD)
+    (void) AFendHeadBuf(fp);
+
 /* Read the header information */
   switch (Ftype) {
   case FT_NH:
@@ -231,6 +295,7 @@ AFopnRead(const char Fname[], long int *Nsamp, long int *Nchan, double *Sfreq,
     AFp = NULL; /* Error or unknown / unsupported file type */
     break;
   }
+  (void) AFendHeadBuf(fp);  /* Release the header buffer after an error */
 
 /* Error messages */
   if (AFp == NULL) {
@@ -239,6 +304,25 @@ AFopnRead(const char Fname[], long int *Nsamp, long int *Nchan, double *Sfreq,
     return NULL;
   }
 
+/* Set up data access (not needed for a header-only open) */
+  if (! AFopt.HeadOnly) {
+
+    /* Map the data into memory (fall back to stdio if not possible) */
+    if (AFopt.MMap)
+      (void) AFmapData(AFp);
+
+    /* Retain data for moving back in files that are not random access */
+    if (AFopt.Lback > 0L)
+      (void) AFsetRBuf(AFp, AFopt.Lback);
+
+    /* Index sample positions in random access text data files */
+    (void) AFsetTxIdx(AFp);
+
+    /* Read ahead in a background thread */
+    if (AFopt.AsyncIO > 0)
+      (void) AFsetAIO(AFp, AFopt.AsyncIO);
+  }
+
 /* Reset read options */
   (void) AFoptions(AF_OPT_INPUT);
 
@@ -253,6 +337,48 @@ AFopnRead(const char Fname[], long int *Nsamp, long int *Nchan, double *Sfreq,
   return AFp;
 }
 
+AFILE *
+AFopnReadCtx(const char Fname[], long int *Nsamp, long int *Nchan,
+             double *Sfreq, FILE *fpinfo, const struct AF_opt *Opt)
+{
+  AFILE *AFp;
+  struct AF_opt OptSave;
+
+/* Substitute the options (this thread only) */
+  AF_copyOptR(&AFopt, &OptSave);
+  AF_copyOptR(Opt, &AFopt);
+
+  AFp = AFopnRead(Fname, Nsamp, Nchan, Sfreq, fpinfo);
+
+/* Restore the options */
+  AF_copyOptR(&OptSave, &AFopt);
+
+  return AFp;
+}
+
+/* Copy the general options and the input file options */
+
+
+static void
+AF_copyOptR(const struct AF_opt *Opt, struct AF_opt *OptR)
+
+{
+  OptR->ErrorHalt = Opt->ErrorHalt;
+  OptR->ScaleV = Opt->ScaleV;
+  OptR->Stats = Opt->Stats;
+  OptR->AsyncIO = Opt->AsyncIO;
+  OptR->NsampND = Opt->NsampND;
+  OptR->RAccess = Opt->RAccess;
+  OptR->MMap = Opt->MMap;
+  OptR->Lback = Opt->Lback;
+  OptR->HeadOnly = Opt->HeadOnly;
+  OptR->LazyInfo = Opt->LazyInfo;
+  OptR->FtypeI = Opt->FtypeI;
+  OptR->InputPar = Opt->InputPar;
+
+  return;
+}
+
 /* Open a file for reading in binary mode */
 
 
@@ -20,6 +20,10 @@ Description:
   or trailer. The routine AFsetInfo can be called before calling this routine
   to specify additional information to be written to the file.
 
+  If the AsyncIO option is set (see AFoptions), binary data is written to the
+  file by a background thread (see AFsetAIO). The remaining data is written by
+  AFclose before the header is updated.
+
   This routine can write AU audio files, AIFF, AIFF-C files, WAVE files, text
   audio files, and headerless audio files.
 
@@ -29,6 +33,8 @@ Description:
   WAVE file:
     8-bit mu-law, 8-bit A-law, offset-binary 8-bit integer, 16/24/32-bit
     integer, and 32/64-bit IEEE floating-point, data formats are supported.
+    A file with a size beyond the range of the 32-bit WAVE size fields is
+    written as an RF64 file.
   AIFF sound file:
     8/16/24/32-bit integer data formats are supported.
   AIFF-C sound file:
@@ -36,7 +42,7 @@ Description:
     floating-point data formats are supported.
   Text audio file:
     text format data, one value to a line. The data is written as a floating
-    point value with 6 digits of precision (%g format).
+    point value with the fewest digits that read back as the same value.
   Headerless file:
     8-bit mu-law, 8-bit A-law, offset-binary 8-bit integer, 8/16/24/32-bit
     integer, 32/64-bit floating-point, and text data formats are supported.
@@ -67,6 +73,7 @@ Description:
     FTW_NH_EL       - noheader file, little-endian data
     FTW_NH_EB       - noheader file, big-endian data
     FTW_TEXT        - Text audio file (with header)
+    FTW_WAVE64      - Wave64 audio file
   The data format codes (defined in AFpar.h) accepted are
     FD_ALAW8   - A-law 8-bit
     FD_MULAW8  - mu-law 8-bit
@@ -83,7 +90,7 @@ Description:
   The data types accepted by the different file types are as follows.
     AU audio files:
       mu-law, A-law, 8/16/24/32-bit integer, 32/64-bit float
-    WAVE files:
+    WAVE and Wave64 files:
       mu-law, A-law, offset-binary 8-bit, 16/24/32-bit integer, 32/64-bit float
     AIFF-C sound files:
       mu-law, A-law, 8/16/24/32-bit integer, 32/64-bit float
@@ -116,7 +123,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.33 $  $Date: 2020/11/30 12:28:08 $
+  $Revision: 1.37 $  $Date: 2020/12/26 11:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -132,6 +139,7 @@ Author / revision:
 
 #include <libtsp.h>
 #include <AFpar.h>
+#include <libtsp/AFdataio.h>
 #include <libtsp/AFheader.h>
 #include <libtsp/AFmsg.h>
 #include <libtsp/nucleus.h>
@@ -185,6 +193,7 @@ AFopnWrite(const char Fname[], enum AF_FTW_T FtypeW, enum AF_FD_T Format,
   case FTW_WAVE:
   case FTW_WAVE_EX:
   case FTW_WAVE_NOEX:
+  case FTW_WAVE64:
     AFp = AFwrWVhead(fp, &AFw);
     break;
   case FTW_AIFF:
@@ -213,6 +222,10 @@ AFopnWrite(const char Fname[], enum AF_FTW_T FtypeW, enum AF_FD_T Format,
     return NULL;
   }
 
+/* Write behind in a background thread */
+  if (AFopt.AsyncIO > 0)
+    (void) AFsetAIO(AFp, AFopt.AsyncIO);
+
 /* Reset output options */
   (void) AFoptions(AF_OPT_OUTPUT);
 
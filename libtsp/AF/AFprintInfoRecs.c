@@ -81,6 +81,9 @@ Description:
          "ITCH" text => "technician:" information record.
        "bext" chunk - information (Broadcast WAVE files) is extracted and
          returned as information records.
+    With the LazyInfo option (see AFoptions), the "DISP", "LIST" and "bext"
+    chunks are decoded when the records are first used, for instance by this
+    routine.
   SPPACK files:
     "comment:" and "command:" information records
   ESPS sampled data feature files:
@@ -127,7 +130,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.16 $  $Date: 2020/11/30 12:28:08 $
+  $Revision: 1.17 $  $Date: 2020/12/20 10:00:00 $
 
 ----------------------------------------------------------------------*/
 
@@ -136,6 +139,7 @@ Author / revision:
 
 #include <libtsp.h>
 #include <AFpar.h>
+#include <libtsp/AFinfo.h>
 #include <libtsp/nucleus.h> /* STstrDots */
 
 struct LS {
@@ -164,6 +168,10 @@ AFprintInfoRecs(const AFILE *AFp, FILE *fpinfo)
 
   AFInfo = &AFp->AFInfo;
 
+  /* Decode deferred information records (AFInfo is modified) */
+  if (AFInfo->Defer != NULL)
+    AFdecInfoDefer((struct AF_info *) AFInfo);
+
   /* AFInfo.Info
   - Should be terminated by a '\0'
   - Should not have a terminating '\n' (considered white-space)
@@ -0,0 +1,85 @@
+/*------------- Telecommunications & Signal Processing Lab -------------
+                           McGill University
+
+Routine:
+  void AFprintStats(const AFILE *AFp, FILE *fpinfo)
+
+Purpose:
+  Print the data transfer statistics for an audio file
+
+Description:
+  This routine prints the data transfer statistics for an audio file. The
+  statistics are kept in the AFp->Stats structure,
+    struct AF_stats {
+      int Report;           Measure times, print the statistics on close
+      long int Nreq;        Number of data requests (AFdReadData, etc.)
+      long int Nbyte;       Number of data bytes read or written
+      long int Ncall;       Number of fread or fwrite calls for data
+      long int Nseek;       Number of file positioning calls for data
+      double Treq;          Time in data requests (s)
+      double Tio;           Time in fread or fwrite calls (s)
+    }
+  The counts are always kept. The times are measured only if the AFopt.Stats
+  option was set when the file was opened (see AFoptions). The time spent in
+  the data requests is split into the time spent in fread/fwrite calls and the
+  remaining time, which is mostly data conversion. For memory mapped input
+  files, the data is accessed without read calls. For output files, the number
+  of clipped values (AFp->Novld) is also printed.
+
+  The statistics are printed by AFclose for files opened with the AFopt.Stats
+  option set.
+
+Parameters:
+  <-  void AFprintStats
+   -> const AFILE *AFp
+      Audio file parameter structure
+  <-> FILE *fpinfo
+      Output stream for the statistics. If fpinfo is NULL, no information
+      is written.
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/16 10:00:00 $
+
+----------------------------------------------------------------------*/
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/AFmsg.h>
+
+
+void
+AFprintStats(const AFILE *AFp, FILE *fpinfo)
+
+{
+  const struct AF_stats *Stats;
+  double Tconv;
+
+  if (fpinfo == NULL)
+    return;
+
+  Stats = &AFp->Stats;
+  if (AFp->Op == FO_WO) {
+    fprintf(fpinfo, AFMF_StatsHead, AFM_StatsOut);
+    fprintf(fpinfo, AFMF_StatsReq, Stats->Nreq, Stats->Nbyte);
+    fprintf(fpinfo, AFMF_StatsCall, "fwrite", Stats->Ncall, Stats->Nseek);
+    fprintf(fpinfo, AFMF_StatsClip, AFp->Novld);
+  }
+  else {
+    fprintf(fpinfo, AFMF_StatsHead, AFM_StatsIn);
+    fprintf(fpinfo, AFMF_StatsReq, Stats->Nreq, Stats->Nbyte);
+    if (AFp->MMap.Data != NULL)
+      fprintf(fpinfo, AFMF_StatsMap, Stats->Nseek);
+    else
+      fprintf(fpinfo, AFMF_StatsCall, "fread", Stats->Ncall, Stats->Nseek);
+  }
+
+  if (Stats->Report) {
+    Tconv = Stats->Treq - Stats->Tio;
+    if (Tconv < 0.0)
+      Tconv = 0.0;
+    fprintf(fpinfo, AFMF_StatsTime, Stats->Treq, Stats->Tio, Tconv);
+  }
+
+  return;
+}
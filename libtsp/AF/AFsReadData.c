@@ -0,0 +1,301 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFsReadData(AFILE *AFp, long int offs, short int Sbuff[], int Nreq)
+  int AFiReadData(AFILE *AFp, long int offs, int Ibuff[], int Nreq)
+
+Purpose:
+  Read data from an audio file (return 16-bit integer values)
+  Read data from an audio file (return 32-bit integer values)
+
+Description:
+  These routines return a specified number of samples at a given sample offset
+  in an audio file. The data is returned as native 16-bit integers (AFsReadData)
+  or 32-bit integers (AFiReadData). As for AFdReadData, the sample data in the
+  file is considered to be preceded and followed by zero-valued samples. The
+  file must have been opened using routine AFopnRead.
+
+  The output values are scaled such that the full scale value of the file data
+  corresponds to the full scale value of the integer type (32768 or
+  2147483648). The program data scaling (see AFoptions) does not apply. For
+  instance, 16-bit integer file data is returned unchanged by AFsReadData and
+  is returned multiplied by 65536 by AFiReadData.
+
+  For integer file data with the default full scale value, the data is
+  converted directly from the file data (with a byte swap if necessary) when
+  the output has at least as many bits as the file data. Other file data
+  (including 8-bit mu-law and A-law data, floating-point data and text data)
+  is converted to double values, and then scaled, rounded and clipped to the
+  range of the integer type.
+
+  On encountering an error, the default behaviour is to print an error message
+  and halt execution.
+
+Parameters:
+  <-  int AFsReadData
+      Number of data values transferred from the file. On reaching the end of
+      the file, this value may be less than Nreq, in which case the last
+      elements are set to zero.
+   -> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int offs
+      Offset into the file in samples (see AFdReadData)
+  <-  short int Sbuff[]
+      Array of 16-bit integers to receive Nreq samples. The data is organized
+      as sequential frames of samples, where each frame contains samples for
+      each of the channels.
+   -> int Nreq
+      Number of samples requested. Nreq may be zero.
+
+  <-  int AFiReadData
+      Number of data values transferred from the file
+   -> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int offs
+      Offset into the file in samples
+  <-  int Ibuff[]
+      Array of 32-bit integers to receive Nreq samples
+   -> int Nreq
+      Number of samples requested. Nreq may be zero.
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/16 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdlib.h>   /* EXIT_FAILURE */
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/AFdataio.h>
+#include <libtsp/AFmsg.h>
+#include <libtsp/UTtypes.h>
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+#define NDBUF   1024    /* Size of the buffer for converted data */
+
+/* Reading routines, direct conversion (NULL if not available) */
+static int
+(*AF_sRead[AF_NFD])(AFILE *AFp, short int Sbuff[], int Nreq) =
+                   {NULL,     NULL,      NULL,       NULL,
+                    AFsRdU1,  AFsRdI1,   AFsRdI2,    NULL,
+                    NULL,     NULL,      NULL,       NULL,
+                    NULL};
+static int
+(*AF_iRead[AF_NFD])(AFILE *AFp, int Ibuff[], int Nreq) =
+                   {NULL,     NULL,      NULL,       NULL,
+                    AFiRdU1,  AFiRdI1,   AFiRdI2,    AFiRdI3,
+                    AFiRdI4,  NULL,      NULL,       NULL,
+                    NULL};
+
+/* Reading routines, double values */
+static int
+(*AF_dRead[AF_NFD])(AFILE *AFp, double Dbuff[], int Nreq) =
+                   {NULL,     AFdRdAlaw, AFdRdMulaw, AFdRdMulawR,
+                    AFdRdU1,  AFdRdI1,   AFdRdI2,    AFdRdI3,
+                    AFdRdI4,  AFdRdF4,   AFdRdF8,    AFdRdTA,
+                    AFdRdTA};
+
+static int
+AF_readN(AFILE *AFp, long int offs, void *Nbuff, int Lw, int Nreq,
+         const char Name[]);
+static int
+AF_rdN(AFILE *AFp, void *Nbuff, int Lw, int k, int N);
+static void
+AF_zeroN(void *Nbuff, int Lw, int k, int N);
+static UT_int4_t
+AF_rndClip(double Dv, double Dmin, double Dmax);
+
+
+int
+AFsReadData(AFILE *AFp, long int offs, short int Sbuff[], int Nreq)
+
+{
+  return AF_readN(AFp, offs, (void *) Sbuff, FDL_INT16, Nreq, "AFsReadData");
+}
+
+
+int
+AFiReadData(AFILE *AFp, long int offs, int Ibuff[], int Nreq)
+
+{
+  return AF_readN(AFp, offs, (void *) Ibuff, FDL_INT32, Nreq, "AFiReadData");
+}
+
+/* Read data as Lw-byte integers (see AFdReadData for the error handling) */
+
+
+static int
+AF_readN(AFILE *AFp, long int offs, void *Nbuff, int Lw, int Nreq,
+         const char Name[])
+
+{
+  int Nv, Nr, Nout;
+  double T;
+
+/* Check the operation  */
+  assert(AFp->Op == FO_RO);
+  assert(!AFp->Error);
+  assert(AFp->Format > 0 && AFp->Format < AF_NFD);
+
+/* Start time for the data transfer statistics */
+  T = 0.0;
+  if (AFp->Stats.Report)
+    T = UTclock();
+
+/* Fill in zeros at the beginning of data */
+  if (offs < 0) {
+    Nout = (int) MINV(-offs, Nreq);
+    AF_zeroN(Nbuff, Lw, 0, Nout);
+    offs += Nout;
+  }
+  else
+    Nout = 0;
+
+/* Position the file */
+  AFp->Error = AFposition(AFp, offs);
+
+/* Transfer data from the file */
+  if (AFp->Nsamp == AF_NSAMP_UNDEF)
+    Nv = Nreq - Nout;
+  else if (offs < 0)
+    Nv = 0;
+  else
+    Nv = (int) MINV(Nreq - Nout, AFp->Nsamp - offs);     /* offs >= 0 */
+
+  if (!AFp->Error && Nv > 0) {
+    Nr = AF_rdN(AFp, Nbuff, Lw, Nout, Nv);
+    Nout += Nr;
+    AFp->Isamp += Nr;
+
+/* Check for errors */
+    if (Nr < Nv) {
+      if (ferror(AFp->fp)) {
+        UTsysMsg("%s - %s %ld", Name, AFM_ReadErrOffs, AFp->Isamp);
+        AFp->Error = AF_IOERR;
+      }
+      else if (AFp->Error)
+        UTwarn("%s - %s %ld", Name, AFM_ReadErrOffs, AFp->Isamp);
+      else if (AFp->Nsamp != AF_NSAMP_UNDEF) {
+        UTwarn("%s - %s %ld", Name, AFM_UEoFOffs, AFp->Isamp);
+        AFp->Error = AF_UEOF;
+      }
+      else
+        AFp->Nsamp = AFp->Isamp;
+    }
+  }
+
+/* Zeros at the end of the file */
+  AF_zeroN(Nbuff, Lw, Nout, Nreq - Nout);
+
+/* Data transfer statistics */
+  ++AFp->Stats.Nreq;
+  if (AFp->Stats.Report)
+    AFp->Stats.Treq += UTclock() - T;
+
+  if (AFp->Error && AFopt.ErrorHalt)
+    exit(EXIT_FAILURE);
+
+  return Nout;
+}
+
+/* Read N values from the current file position into Nbuff[k], ... */
+
+
+static int
+AF_rdN(AFILE *AFp, void *Nbuff, int Lw, int k, int N)
+
+{
+  short int *Sbuff;
+  int *Ibuff;
+  int is, Nb, Nr, i;
+  double Dbuff[NDBUF];
+  double g;
+
+  Sbuff = &((short int *) Nbuff)[k];
+  Ibuff = &((int *) Nbuff)[k];
+
+/* Direct conversion from integer data */
+  if (AFp->FullScale == AF_FULLSCALE[AFp->Format]) {
+    if (Lw == FDL_INT16 && AF_sRead[AFp->Format] != NULL)
+      return (*AF_sRead[AFp->Format])(AFp, Sbuff, N);
+    else if (Lw == FDL_INT32 && AF_iRead[AFp->Format] != NULL)
+      return (*AF_iRead[AFp->Format])(AFp, Ibuff, N);
+  }
+
+/* Conversion from double values, Dbuff[i] = ScaleV * x / FullScale */
+  if (Lw == FDL_INT16)
+    g = AF_FULLSCALE_INT2 / AFp->ScaleV;
+  else
+    g = AF_FULLSCALE_INT4 / AFp->ScaleV;
+
+  for (is = 0; is < N; ) {
+    Nb = MINV(NDBUF, N - is);
+    Nr = (*AF_dRead[AFp->Format])(AFp, Dbuff, Nb);
+    if (Lw == FDL_INT16) {
+      for (i = 0; i < Nr; ++i)
+        Sbuff[is+i] = (short int) AF_rndClip(g * Dbuff[i],
+                                             UT_INT2_MIN, UT_INT2_MAX);
+    }
+    else {
+      for (i = 0; i < Nr; ++i)
+        Ibuff[is+i] = AF_rndClip(g * Dbuff[i], UT_INT4_MIN, UT_INT4_MAX);
+    }
+    is += Nr;
+
+    if (Nr < Nb)
+      break;
+  }
+
+  return is;
+}
+
+/* Set Nbuff[k], ..., Nbuff[k+N-1] to zero */
+
+
+static void
+AF_zeroN(void *Nbuff, int Lw, int k, int N)
+
+{
+  int i;
+
+  if (Lw == FDL_INT16) {
+    for (i = k; i < k+N; ++i)
+      ((short int *) Nbuff)[i] = 0;
+  }
+  else {
+    for (i = k; i < k+N; ++i)
+      ((int *) Nbuff)[i] = 0;
+  }
+
+  return;
+}
+
+/* Round (halfway cases away from zero) and clip (see AFdWrIx) */
+
+
+static UT_int4_t
+AF_rndClip(double Dv, double Dmin, double Dmax)
+
+{
+  UT_int4_t Iv;
+  double Dr;
+
+  if (Dv >= Dmax)
+    return ((UT_int4_t) Dmax);
+  else if (Dv <= Dmin)
+    return ((UT_int4_t) Dmin);
+
+  Iv = (UT_int4_t) Dv;          /* Truncate toward zero */
+  Dr = Dv - Iv;                 /* Exact */
+  if (Dr >= 0.5)
+    ++Iv;
+  else if (Dr <= -0.5)
+    --Iv;
+
+  return Iv;
+}
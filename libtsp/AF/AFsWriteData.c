@@ -0,0 +1,200 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFsWriteData(AFILE *AFp, const short int Sbuff[], int Nval)
+  int AFiWriteData(AFILE *AFp, const int Ibuff[], int Nval)
+
+Purpose:
+  Write data to an audio file (16-bit integer input values)
+  Write data to an audio file (32-bit integer input values)
+
+Description:
+  These routines write a specified number of samples to an audio file. The
+  input data is in the form of native 16-bit integers (AFsWriteData) or 32-bit
+  integers (AFiWriteData). The full scale value of the integer type (32768 or
+  2147483648) corresponds to the full scale value for the file data. The
+  program data scaling (see AFoptions) does not apply. For instance, 16-bit
+  integer values written to a 16-bit integer file by AFsWriteData are written
+  unchanged.
+
+  If the file data is integer data with at least as many bits as the input
+  integers, the data is converted directly (with a byte swap if necessary).
+  Otherwise, the data is converted to double values and written as for
+  AFdWriteData. A warning message is printed if the values exceed the dynamic
+  range of the file data representation.
+
+Parameters:
+  <-  int AFsWriteData
+      Number of samples written
+   -> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnWrite
+   -> const short int Sbuff[]
+      Array of 16-bit integers with Nval samples
+   -> int Nval
+      Number of samples to be written
+
+  <-  int AFiWriteData
+      Number of samples written
+   -> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnWrite
+   -> const int Ibuff[]
+      Array of 32-bit integers with Nval samples
+   -> int Nval
+      Number of samples to be written
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/16 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdlib.h>   /* EXIT_FAILURE */
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/AFdataio.h>
+#include <libtsp/AFmsg.h>
+
+#define MAXV(a, b)  (((a) > (b)) ? (a) : (b))
+
+#define NDBUF   1024    /* Size of the buffer for converted data */
+
+/* Writing routines, direct conversion (NULL if not available) */
+static int
+(*AF_sWrite[AF_NFD])(AFILE *AFp, const short int Sbuff[], int Nval) =
+                    {NULL,     NULL,      NULL,       NULL,
+                     NULL,     NULL,      AFsWrI2,    AFsWrI3,
+                     AFsWrI4,  NULL,      NULL,       NULL,
+                     NULL};
+static int
+(*AF_iWrite[AF_NFD])(AFILE *AFp, const int Ibuff[], int Nval) =
+                    {NULL,     NULL,      NULL,       NULL,
+                     NULL,     NULL,      NULL,       NULL,
+                     AFiWrI4,  NULL,      NULL,       NULL,
+                     NULL};
+
+/* Writing routines, double values */
+static int
+(*AF_dWrite[AF_NFD])(AFILE *AFp, const double Dbuff[], int Nval) =
+                    {NULL,     AFdWrAlaw, AFdWrMulaw, AFdWrMulawR,
+                     AFdWrU1,  AFdWrI1,   AFdWrI2,    AFdWrI3,
+                     AFdWrI4,  AFdWrF4,   AFdWrF8,    AFdWrTA,
+                     AFdWrTA};
+
+static int
+AF_writeN(AFILE *AFp, const void *Nbuff, int Lw, int Nval, const char Name[]);
+static int
+AF_wrN(AFILE *AFp, const void *Nbuff, int Lw, int Nval);
+
+
+int
+AFsWriteData(AFILE *AFp, const short int Sbuff[], int Nval)
+
+{
+  return AF_writeN(AFp, (const void *) Sbuff, FDL_INT16, Nval,
+                   "AFsWriteData");
+}
+
+
+int
+AFiWriteData(AFILE *AFp, const int Ibuff[], int Nval)
+
+{
+  return AF_writeN(AFp, (const void *) Ibuff, FDL_INT32, Nval,
+                   "AFiWriteData");
+}
+
+/* Write Lw-byte integer data (see AFdWriteData for the error handling) */
+
+
+static int
+AF_writeN(AFILE *AFp, const void *Nbuff, int Lw, int Nval, const char Name[])
+
+{
+  int Nw;
+  long int Novld;
+  double T;
+
+  assert(AFp->Op == FO_WO);
+  assert(AFp->Format > 0 && AFp->Format < AF_NFD);
+
+/* Start time for the data transfer statistics */
+  T = 0.0;
+  if (AFp->Stats.Report)
+    T = UTclock();
+
+/* Transfer data to the audio file */
+  Novld = AFp->Novld; /* Save the value before writing */
+  Nw = AF_wrN(AFp, Nbuff, Lw, Nval);
+  AFp->Isamp += Nw;
+  AFp->Nsamp = MAXV(AFp->Isamp, AFp->Nsamp);
+
+/* Data transfer statistics */
+  ++AFp->Stats.Nreq;
+  if (AFp->Stats.Report)
+    AFp->Stats.Treq += UTclock() - T;
+
+/* Check for an error */
+  if (Nw < Nval) {
+    UTsysMsg("%s: %s", Name, AFM_WriteErr);
+    if (AFopt.ErrorHalt)
+      exit(EXIT_FAILURE);
+    AFp->Error = AF_IOERR;
+  }
+
+/* Check for overloads (print a message the first time only) */
+  if (Novld == 0L && AFp->Novld != 0L)
+    UTwarn("%s - %s", Name, AFM_Clip);
+
+  return Nw;
+}
+
+/* Write Nval values to the file */
+
+
+static int
+AF_wrN(AFILE *AFp, const void *Nbuff, int Lw, int Nval)
+
+{
+  const short int *Sbuff;
+  const int *Ibuff;
+  int is, Nb, Nw, i;
+  double Dbuff[NDBUF];
+  double g;
+
+  Sbuff = (const short int *) Nbuff;
+  Ibuff = (const int *) Nbuff;
+
+/* Direct conversion to integer data */
+  if (Lw == FDL_INT16 && AF_sWrite[AFp->Format] != NULL)
+    return (*AF_sWrite[AFp->Format])(AFp, Sbuff, Nval);
+  else if (Lw == FDL_INT32 && AF_iWrite[AFp->Format] != NULL)
+    return (*AF_iWrite[AFp->Format])(AFp, Ibuff, Nval);
+
+/* Conversion to double values, scaled by ScaleV / full scale */
+  if (Lw == FDL_INT16)
+    g = AFp->ScaleV / AF_FULLSCALE_INT2;
+  else
+    g = AFp->ScaleV / AF_FULLSCALE_INT4;
+
+  for (is = 0; is < Nval; ) {
+    Nb = MINV(NDBUF, Nval - is);
+    if (Lw == FDL_INT16) {
+      for (i = 0; i < Nb; ++i)
+        Dbuff[i] = g * Sbuff[is+i];
+    }
+    else {
+      for (i = 0; i < Nb; ++i)
+        Dbuff[i] = g * Ibuff[is+i];
+    }
+    Nw = (*AF_dWrite[AFp->Format])(AFp, Dbuff, Nb);
+    is += Nw;
+
+    if (Nw < Nb)
+      break;
+  }
+
+  return is;
+}
@@ -0,0 +1,530 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFsetAIO (AFILE *AFp, int Nblk)
+  int AFendAIO (AFILE *AFp)
+  int AFaioRead (AFILE *AFp, void *Buf, int Lw, int N)
+  int AFaioWrite (AFILE *AFp, const void *Buf, int Lw, int N)
+  int AFaioSeek (AFILE *AFp, long int boff)
+
+Purpose:
+  Start a background I/O thread for the data of an audio file
+  Complete the background I/O and stop the thread
+  Read data values through the read-ahead buffers
+  Write data values through the write-behind buffers
+  Move to a data position in an input file with background reads
+
+Description:
+  With background I/O, the data transfers for an audio file are done by a
+  separate thread, so that the file I/O overlaps the processing of the data in
+  the calling thread. The data passes through a ring of Nblk blocks of LBLK
+  bytes each. For an input file, the thread reads ahead, filling the free
+  blocks with the data following the data already read. For an output file,
+  the data values are collected into blocks and the thread writes each block
+  to the file as it is filled.
+
+  AFsetAIO starts the background thread. It is used only for files with binary
+  data (fixed length records) that are not memory mapped and do not have a
+  retained data window. Input files must be random access. For an input file,
+  any deferred information records (LazyInfo option, see AFoptions) are
+  decoded first, since decoding them repositions the file. Background I/O uses
+  Posix threads. If it cannot be set up, the data is transferred by the calling
+  thread. The background thread runs with a copy of the audio file options of
+  the calling thread (see AFcopyOptions). While the thread is active, the file stream should be accessed only
+  through the AF data routines.
+
+  AFendAIO completes the background I/O. For an output file, the partially
+  filled block is queued and the routine waits until all of the data has been
+  written. The thread is then stopped and the buffers are released. The fread
+  or fwrite calls made by the thread are added to the data transfer statistics
+  for the file. This routine is called by AFupdHead and AFclose. It is a no-op
+  for files without background I/O.
+
+  AFaioRead is used by AFrdBuf to get the next N data values (Lw bytes each).
+  The routine waits only if the thread has not yet read the data. On reaching
+  the end of the data or on a read error, the thread stops reading and fewer
+  than N values are returned. The error indicator for the file stream is then
+  set as for a direct read.
+
+  AFaioWrite is used by AFwrBuf to write N data values. The routine waits only
+  if all of the blocks are waiting to be written. A write error in the thread
+  is reported by later calls (zero values written) and by AFendAIO. The system
+  error code (errno) is then set to that for the failed write.
+
+  AFaioSeek is used by AFposition. A move forward to data that has already
+  been read ahead discards the intervening data. Otherwise the thread is held,
+  the data read ahead is discarded, the file is positioned, and reading ahead
+  restarts from the new position.
+
+Parameters:
+  <-  int AFsetAIO
+      Status, zero if the background thread has been started
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead or AFopnWrite
+   -> int Nblk
+      Number of buffer blocks
+
+  <-  int AFendAIO
+      Error status, nonzero if a write error has occurred
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead or AFopnWrite
+
+  <-  int AFaioRead
+      Number of data values read. On reaching the end of the data, this
+      value may be less than N.
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+  <-  void *Buf
+      Buffer to receive the data values (N*Lw bytes)
+   -> int Lw
+      Size of each data value in bytes
+   -> int N
+      Number of data values requested
+
+  <-  int AFaioWrite
+      Number of data values written. If this value is less than N, an error
+      has occurred.
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnWrite
+   -> const void *Buf
+      Buffer with the data values (N*Lw bytes)
+   -> int Lw
+      Size of each data value in bytes
+   -> int N
+      Number of data values to be written
+
+  <-  int AFaioSeek
+      Error status, zero for no error
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int boff
+      Data byte offset
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/26 12:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <errno.h>
+#include <string.h>
+
+#include <libtsp/sysOS.h>
+
+#if (SY_POSIX)
+#  include <pthread.h>
+#endif
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
+#include <libtsp/AFinfo.h>
+
+#define LBLK  65536L    /* Block size in bytes */
+
+#if (SY_POSIX)
+
+/* Background I/O structure
+  - The blocks in use are Head, Head+1, ..., Head+Count-1 (modulo Nblk). For
+    input, these hold the data read ahead, with the next data at offset Off in
+    block Head. For output, these are the blocks waiting to be written. Block
+    Head+Count is being filled, with Off bytes so far.
+  - Cpos is the data byte position for the calling thread. Fpos is the data
+    byte position of the file stream. Lend is the length of the input data in
+    bytes (-1 if not known).
+  - The thread sets Idle while it waits with the file stream unused.
+*/
+struct AF_aio {
+  pthread_t Tid;
+  pthread_mutex_t Lock;
+  pthread_cond_t Cond;        /* Signals any change of state */
+  FILE *fp;                   /* File pointer */
+  enum AF_FO_T Op;            /* Operation (read, write) */
+  unsigned char *Buf;         /* Nblk blocks of LBLK bytes */
+  long int *Nd;               /* Number of data bytes in each block */
+  int Nblk;                   /* Number of blocks */
+  int Head;                   /* First block in use */
+  int Count;                  /* Number of blocks in use */
+  long int Off;               /* Byte offset in the current block */
+  long int Cpos;              /* Data byte position, calling thread */
+  long int Fpos;              /* Data byte position, file stream */
+  long int Lend;              /* Input data length in bytes */
+  int Hold;                   /* Request to hold the thread (input) */
+  int Idle;                   /* Thread is waiting */
+  int Eof;                    /* End of data or read error (input) */
+  int Error;                  /* Write error, errno value (output) */
+  int Stop;                   /* Request to stop the thread */
+  long int Ncall;             /* Number of fread or fwrite calls */
+  struct AF_opt Opt;          /* Options of the calling thread */
+};
+
+static void
+AF_aioAdv (struct AF_aio *AIO, long int n);
+static void *
+AF_aioReader (void *Arg);
+static void *
+AF_aioWriter (void *Arg);
+
+#endif
+
+
+int
+AFsetAIO (AFILE *AFp, int Nblk)
+
+{
+#if (SY_POSIX)
+  int Lw;
+  struct AF_aio *AIO;
+
+  Lw = AF_DL[AFp->Format];
+  if (AFp->AIO != NULL || Nblk <= 0 || Lw <= 0 || AFp->MMap.Data != NULL ||
+      AFp->RBuf.Buf != NULL)
+    return 1;
+  if (AFp->Op == FO_RO) {
+    if (! FLseekable (AFp->fp))
+      return 1;
+    (void) AFdecInfoDefer (&AFp->AFInfo);
+  }
+
+  AIO = (struct AF_aio *) UTmalloc (sizeof (struct AF_aio));
+  AIO->fp = AFp->fp;
+  AIO->Op = AFp->Op;
+  AIO->Buf = (unsigned char *) UTmalloc (Nblk * LBLK);
+  AIO->Nd = (long int *) UTmalloc (Nblk * sizeof (long int));
+  AIO->Nblk = Nblk;
+  AIO->Head = 0;
+  AIO->Count = 0;
+  AIO->Off = 0L;
+  AIO->Cpos = Lw * AFp->Isamp;
+  AIO->Fpos = AIO->Cpos;
+  AIO->Lend = -1L;
+  if (AFp->Op == FO_RO && AFp->Nsamp != AF_NSAMP_UNDEF)
+    AIO->Lend = Lw * AFp->Nsamp;
+  AIO->Hold = 0;
+  AIO->Idle = 0;
+  AIO->Eof = 0;
+  AIO->Error = 0;
+  AIO->Stop = 0;
+  AIO->Ncall = 0L;
+  AIO->Opt = AFopt;
+  AIO->Opt.SpkrConfig = NULL;     /* Not copied to the thread */
+  AIO->Opt.UInfo.Info = NULL;
+
+  pthread_mutex_init (&AIO->Lock, NULL);
+  pthread_cond_init (&AIO->Cond, NULL);
+  if (pthread_create (&AIO->Tid, NULL,
+                      (AFp->Op == FO_RO) ? AF_aioReader : AF_aioWriter,
+                      AIO) != 0) {
+    pthread_cond_destroy (&AIO->Cond);
+    pthread_mutex_destroy (&AIO->Lock);
+    UTfree ((void *) AIO->Nd);
+    UTfree ((void *) AIO->Buf);
+    UTfree ((void *) AIO);
+    return 1;
+  }
+  AFp->AIO = AIO;
+
+  return 0;
+#else
+  return 1;
+#endif
+}
+
+
+int
+AFendAIO (AFILE *AFp)
+
+{
+#if (SY_POSIX)
+  int Error;
+  struct AF_aio *AIO;
+
+  AIO = AFp->AIO;
+  if (AIO == NULL)
+    return 0;
+
+  pthread_mutex_lock (&AIO->Lock);
+
+  /* Queue the partially filled block */
+  if (AIO->Op == FO_WO && AIO->Off > 0L) {
+    while (AIO->Count == AIO->Nblk)
+      pthread_cond_wait (&AIO->Cond, &AIO->Lock);
+    AIO->Nd[(AIO->Head + AIO->Count) % AIO->Nblk] = AIO->Off;
+    ++AIO->Count;
+    AIO->Off = 0L;
+  }
+
+  /* The writer thread stops once all of the blocks have been written */
+  AIO->Stop = 1;
+  pthread_cond_broadcast (&AIO->Cond);
+  pthread_mutex_unlock (&AIO->Lock);
+  pthread_join (AIO->Tid, NULL);
+
+  AFp->Stats.Ncall += AIO->Ncall;
+  Error = AIO->Error;
+  if (Error)
+    errno = Error;
+
+  pthread_cond_destroy (&AIO->Cond);
+  pthread_mutex_destroy (&AIO->Lock);
+  UTfree ((void *) AIO->Nd);
+  UTfree ((void *) AIO->Buf);
+  UTfree ((void *) AIO);
+  AFp->AIO = NULL;
+
+  return (Error != 0);
+#else
+  return 0;
+#endif
+}
+
+
+int
+AFaioRead (AFILE *AFp, void *Buf, int Lw, int N)
+
+{
+#if (SY_POSIX)
+  unsigned char *Bp;
+  long int Nb, k, n;
+  struct AF_aio *AIO;
+
+  AIO = AFp->AIO;
+  Bp = (unsigned char *) Buf;
+  Nb = (long int) Lw * N;
+
+  pthread_mutex_lock (&AIO->Lock);
+  for (k = 0; k < Nb; k += n) {
+    while (AIO->Count == 0 && ! AIO->Eof)
+      pthread_cond_wait (&AIO->Cond, &AIO->Lock);
+    if (AIO->Count == 0)
+      break;      /* End of data or read error, the thread is waiting */
+    n = MINV (Nb - k, AIO->Nd[AIO->Head] - AIO->Off);
+    memcpy (&Bp[k], &AIO->Buf[AIO->Head * LBLK + AIO->Off], (size_t) n);
+    AF_aioAdv (AIO, n);
+  }
+  AIO->Cpos += k;
+  pthread_mutex_unlock (&AIO->Lock);
+
+  return (int) (k / Lw);
+#else
+  return 0;
+#endif
+}
+
+
+int
+AFaioWrite (AFILE *AFp, const void *Buf, int Lw, int N)
+
+{
+#if (SY_POSIX)
+  const unsigned char *Bp;
+  long int Nb, k, n;
+  int i;
+  struct AF_aio *AIO;
+
+  AIO = AFp->AIO;
+  Bp = (const unsigned char *) Buf;
+  Nb = (long int) Lw * N;
+
+  pthread_mutex_lock (&AIO->Lock);
+  if (AIO->Error) {
+    errno = AIO->Error;
+    pthread_mutex_unlock (&AIO->Lock);
+    return 0;
+  }
+
+  for (k = 0; k < Nb; k += n) {
+    while (AIO->Count == AIO->Nblk)
+      pthread_cond_wait (&AIO->Cond, &AIO->Lock);
+    i = (AIO->Head + AIO->Count) % AIO->Nblk;
+    n = MINV (Nb - k, LBLK - AIO->Off);
+    memcpy (&AIO->Buf[i * LBLK + AIO->Off], &Bp[k], (size_t) n);
+    AIO->Off += n;
+    if (AIO->Off == LBLK) {
+      AIO->Nd[i] = LBLK;
+      ++AIO->Count;
+      AIO->Off = 0L;
+      pthread_cond_broadcast (&AIO->Cond);
+    }
+  }
+  pthread_mutex_unlock (&AIO->Lock);
+
+  return N;
+#else
+  return 0;
+#endif
+}
+
+
+int
+AFaioSeek (AFILE *AFp, long int boff)
+
+{
+#if (SY_POSIX)
+  long int n;
+  enum AF_ERR_T ErrCode;
+  struct AF_aio *AIO;
+
+  AIO = AFp->AIO;
+  ErrCode = AF_NOERR;
+
+  pthread_mutex_lock (&AIO->Lock);
+
+  /* Move forward through the data read ahead */
+  while (AIO->Cpos < boff && AIO->Count > 0) {
+    n = MINV (boff - AIO->Cpos, AIO->Nd[AIO->Head] - AIO->Off);
+    AF_aioAdv (AIO, n);
+    AIO->Cpos += n;
+  }
+
+  /* Hold the thread, discard the data, and position the file */
+  if (AIO->Cpos != boff) {
+    AIO->Hold = 1;
+    pthread_cond_broadcast (&AIO->Cond);
+    while (! AIO->Idle)
+      pthread_cond_wait (&AIO->Cond, &AIO->Lock);
+
+    AIO->Head = 0;
+    AIO->Count = 0;
+    AIO->Off = 0L;
+    ++AFp->Stats.Nseek;
+    ErrCode = AFseek (AFp->fp, AFp->Start + boff, NULL);
+    AIO->Eof = (ErrCode != AF_NOERR);
+    AIO->Cpos = boff;
+    AIO->Fpos = boff;
+
+    AIO->Hold = 0;
+    pthread_cond_broadcast (&AIO->Cond);
+  }
+  pthread_mutex_unlock (&AIO->Lock);
+
+  return ErrCode;
+#else
+  return AF_IOERR;
+#endif
+}
+
+#if (SY_POSIX)
+
+/* Advance n bytes in the current input block (the lock is held) */
+
+
+static void
+AF_aioAdv (struct AF_aio *AIO, long int n)
+
+{
+  AIO->Off += n;
+  if (AIO->Off == AIO->Nd[AIO->Head]) {
+    AIO->Head = (AIO->Head + 1) % AIO->Nblk;
+    --AIO->Count;
+    AIO->Off = 0L;
+    pthread_cond_broadcast (&AIO->Cond);    /* Free block */
+  }
+
+  return;
+}
+
+/* Read-ahead thread: fill the free blocks (the lock is released during each
+   read) */
+
+
+static void *
+AF_aioReader (void *Arg)
+
+{
+  int k;
+  long int Nb, Nr;
+  struct AF_aio *AIO;
+
+  AIO = (struct AF_aio *) Arg;
+  AFcopyOptions (&AIO->Opt);
+
+  pthread_mutex_lock (&AIO->Lock);
+  while (1) {
+    while (! AIO->Stop && (AIO->Hold || AIO->Eof || AIO->Count == AIO->Nblk)) {
+      AIO->Idle = 1;
+      pthread_cond_broadcast (&AIO->Cond);
+      pthread_cond_wait (&AIO->Cond, &AIO->Lock);
+    }
+    if (AIO->Stop)
+      break;
+    AIO->Idle = 0;
+
+    k = (AIO->Head + AIO->Count) % AIO->Nblk;
+    Nb = LBLK;
+    if (AIO->Lend >= 0L)
+      Nb = MINV (Nb, AIO->Lend - AIO->Fpos);
+    Nr = 0L;
+    if (Nb > 0L) {
+      pthread_mutex_unlock (&AIO->Lock);
+      Nr = (long int) fread (&AIO->Buf[k * LBLK], 1, (size_t) Nb, AIO->fp);
+      pthread_mutex_lock (&AIO->Lock);
+      ++AIO->Ncall;
+    }
+
+    AIO->Fpos += Nr;
+    if (Nr > 0L) {
+      AIO->Nd[k] = Nr;
+      ++AIO->Count;
+    }
+    if (Nb <= 0L || Nr < Nb)
+      AIO->Eof = 1;
+    pthread_cond_broadcast (&AIO->Cond);
+  }
+  AIO->Idle = 1;
+  pthread_mutex_unlock (&AIO->Lock);
+
+  return NULL;
+}
+
+/* Write-behind thread: write the queued blocks (the lock is released during
+   each write). After a write error, the remaining blocks are discarded. */
+
+
+static void *
+AF_aioWriter (void *Arg)
+
+{
+  int k;
+  long int Nb, Nw;
+  struct AF_aio *AIO;
+
+  AIO = (struct AF_aio *) Arg;
+  AFcopyOptions (&AIO->Opt);
+
+  pthread_mutex_lock (&AIO->Lock);
+  while (1) {
+    while (! AIO->Stop && AIO->Count == 0) {
+      AIO->Idle = 1;
+      pthread_cond_wait (&AIO->Cond, &AIO->Lock);
+    }
+    if (AIO->Count == 0)
+      break;      /* Stop request, all blocks written */
+    AIO->Idle = 0;
+
+    k = AIO->Head;
+    Nb = AIO->Nd[k];
+    if (! AIO->Error) {
+      pthread_mutex_unlock (&AIO->Lock);
+      errno = 0;
+      Nw = (long int) fwrite (&AIO->Buf[k * LBLK], 1, (size_t) Nb, AIO->fp);
+      pthread_mutex_lock (&AIO->Lock);
+      ++AIO->Ncall;
+      if (Nw < Nb)
+        AIO->Error = (errno != 0) ? errno : EIO;
+    }
+
+    AIO->Head = (k + 1) % AIO->Nblk;
+    --AIO->Count;
+    AIO->Fpos += Nb;
+    pthread_cond_broadcast (&AIO->Cond);
+  }
+  AIO->Idle = 1;
+  pthread_mutex_unlock (&AIO->Lock);
+
+  return NULL;
+}
+
+#endif
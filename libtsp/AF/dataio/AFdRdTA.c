@@ -20,6 +20,11 @@ Description:
   file contains values smaller in magnitude than a double can represent, the
   decoded values are set to zero.
 
+  The values are decoded by AFtxRdData, which takes the characters directly
+  from the stdio buffer and uses a fast decoder for common number formats.
+  For random access files, checkpoints for the sample position index are
+  recorded as the values are decoded (see AFsetTxIdx).
+
 Parameters:
   <-  int AFdRdTA
       Number of data values transferred from the file.  On reaching the end of
@@ -33,18 +38,10 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.12 $  $Date: 2017/06/09 15:05:06 $
+  $Revision: 1.14 $  $Date: 2020/12/11 10:30:00 $
 
 -------------------------------------------------------------------------*/
 
-#include <libtsp/sysOS.h>
-#if (SY_OS == SY_OS_WINDOWS)
-#  define _CRT_SECURE_NO_WARNINGS     /* Allow fscanf */
-#endif
-
-#include <errno.h>
-#include <float.h>
-
 #include <libtsp.h>
 #include <AFpar.h>
 #include <libtsp/AFdataio.h>
@@ -54,30 +51,13 @@ int
 AFdRdTA (AFILE *AFp, double Dbuff[], int Nreq)
 
 {
-  int nv, n;
+  int i, n;
   enum AF_ERR_T ErrCode;
-  double Dv;
-
-  ErrCode = AF_NOERR;
 
 /* Read the data */
-
-  for (n = 0; n < Nreq; ++n) {
-    errno = 0;
-    nv = fscanf (AFp->fp, "%lg", &Dv);
-    if (nv == 1)
-      Dbuff[n] = AFp->ScaleF * Dv;
-    else if (nv == EOF)
-      break;
-    else if (errno != 0) {
-      ErrCode = AF_IOERR;
-      break;
-    }
-    else {
-      ErrCode = AF_DECERR;
-      break;
-    }
-  }
+  n = AFtxRdData (AFp, AFp->Isamp, Dbuff, Nreq, &ErrCode);
+  for (i = 0; i < n; ++i)
+    Dbuff[i] = AFp->ScaleF * Dbuff[i];
 
 /* Check for errors */
   if (ErrCode)
@@ -26,7 +26,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.13 $  $Date: 2017/05/24 16:07:40 $
+  $Revision: 1.14 $  $Date: 2020/12/16 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -37,24 +37,31 @@ Author / revision:
 #define LW4   FDL_FLOAT32
 #define LW8   FDL_FLOAT64
 
-
+/* The byte swap test is done once per block of data, rather than for each
+   sample.
+*/
+
 int
 AFdWrF4 (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
   int is, N, Nw, i;
+  double ScaleF;
   UT_float4_t Buf[NBBUF/LW4];
 
 /* Write data to the audio file */
+  ScaleF = AFp->ScaleF;
   is = 0;
   while (is < Nval) {
     N = MINV (NBBUF / LW4, Nval - is);
-    for (i = 0; i < N; ++i) {
-      Buf[i] = (UT_float4_t) (AFp->ScaleF * Dbuff[i+is]);
-      if (AFp->Swapb == DS_SWAP)
+    for (i = 0; i < N; ++i)
+      Buf[i] = (UT_float4_t) (ScaleF * Dbuff[i+is]);
+    if (AFp->Swapb == DS_SWAP) {
+      for (i = 0; i < N; ++i)
         BSWAP4 (&Buf[i]);
     }
-    Nw = FWRITE (Buf, LW4, N, AFp->fp);
+
+    Nw = AFwrBuf (AFp, Buf, LW4, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -68,18 +75,22 @@ AFdWrF8 (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
   int is, N, Nw, i;
+  double ScaleF;
   UT_float8_t Buf[NBBUF/LW8];
 
 /* Write data to the audio file */
+  ScaleF = AFp->ScaleF;
   is = 0;
   while (is < Nval) {
     N = MINV (NBBUF / LW8, Nval - is);
-    for (i = 0; i < N; ++i) {
-      Buf[i] = AFp->ScaleF * Dbuff[i+is];
-      if (AFp->Swapb == DS_SWAP)
+    for (i = 0; i < N; ++i)
+      Buf[i] = ScaleF * Dbuff[i+is];
+    if (AFp->Swapb == DS_SWAP) {
+      for (i = 0; i < N; ++i)
         BSWAP8 (&Buf[i]);
     }
-    Nw = FWRITE (Buf, LW8, N, AFp->fp);
+
+    Nw = AFwrBuf (AFp, Buf, LW8, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -32,12 +32,10 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.14 $  $Date: 2017/04/24 03:01:10 $
+  $Revision: 1.16 $  $Date: 2020/12/26 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
-#include <math.h>
-
 #include <AFpar.h>
 #include <libtsp/nucleus.h>
 #include <libtsp/AFdataio.h>
@@ -48,67 +46,109 @@ Author / revision:
 #define LW3   FDL_INT24
 #define LW4   FDL_INT32
 
-
+/* The byte swap test is done once per block of data, rather than for each
+   sample. The multi-byte values are stored directly as bytes in file byte
+   order (AF_PUTELx / AF_PUTEBx). The count of clipped values is kept in a
+   local variable and added to AFp->Novld for each block.
+
+   For the 8 and 16-bit formats, each block is converted in two passes without
+   branches: the scaled values are limited (AF_LimW), then rounded, counted,
+   clipped and stored (AF_RndC). GCC (version 12) vectorizes both loops at -O3
+   (or -O2 -ftree-vectorize -fvect-cost-model=dynamic). At the default -O (and
+   at -O2) no loops are vectorized; the branchless loops are still faster than
+   the single pass. The 24-bit and 32-bit routines keep a single pass with
+   branches (AF_RndOL). For 24-bit data, the two passes are faster only where
+   the 3-byte stores are vectorized (AVX2, e.g. -march=x86-64-v3). For 32-bit
+   data, the limits plus one do not fit in 32 bits.
+*/
 
-/* Round, clip, return integer value */
-static inline UT_int4_t AF_RndOL (double Dv, double Dmin, double Dmax,
-                                  long int *Novld)
+/* Round, clip, return integer value
+   The value is rounded to the nearest integer, with halfway cases rounded away
+   from zero (as for the C library round function). The value is compared
+   against the limits before rounding, so that the rounding can be done in
+   integer arithmetic without a library call.
+*/
+static inline UT_int4_t
+AF_RndOL (double Dv, double Dmin, double Dmax, long int *Novld)
 {
-  Dv = round (Dv);
-  if (Dv > Dmax) {
-    Dv = Dmax;
+  UT_int4_t Iv;
+  double Dr;
+
+  if (Dv >= Dmax + 0.5) {
     ++*Novld;
+    return ((UT_int4_t) Dmax);
   }
-  else if (Dv < Dmin) {
-    Dv = Dmin;
+  else if (Dv <= Dmin - 0.5) {
     ++*Novld;
+    return ((UT_int4_t) Dmin);
   }
 
-  return ((UT_int4_t) Dv);
+  Iv = (UT_int4_t) Dv;          /* Truncate toward zero */
+  Dr = Dv - Iv;                 /* Exact */
+  if (Dr >= 0.5)
+    ++Iv;
+  else if (Dr <= -0.5)
+    --Iv;
 
+  return Iv;
 }
 
-/* Demote a 4 byte integer to a 3 byte integer
-   Iv - integer (4 bytes) in host byte order
-   Buf - output (3 chars) in host byte order
-   HBO - Host byte order (DS_EL or DS_EB)
+/* Limit the value to the range [Dmin-1, Dmax+1]
+   Values beyond these limits round to a value outside [Dmin, Dmax] just as
+   the original value would. The limited value can be converted to a 32-bit
+   integer (Dmin and Dmax are at most 16-bit values).
 */
-static inline void
-AF_DemoteB43 (UT_int4_t Iv, unsigned char *Buf, int HBO)
+static inline double
+AF_LimW (double Dv, double Dmin, double Dmax)
 {
-  unsigned char *cp;
-  cp = (unsigned char *) &Iv;
+  Dv = (Dv > Dmax + 1.0) ? Dmax + 1.0 : Dv;
+  return ((Dv < Dmin - 1.0) ? Dmin - 1.0 : Dv);
+}
 
-  if (HBO == DS_EL) {
-    Buf[0] = cp[0];
-    Buf[1] = cp[1];
-    Buf[2] = cp[2];
-  }
-  else {
-    Buf[0] = cp[1];
-    Buf[1] = cp[2];
-    Buf[2] = cp[3];
-  }
+/* Round, clip, return integer value (limited input value)
+   The value is rounded to the nearest integer, with halfway cases rounded away
+   from zero. With Dt = (int) Dv (truncation toward zero), the value
+   Dv + (Dv - Dt) = Dt + 2 (Dv - Dt) is computed exactly and truncates to the
+   rounded value. A rounded value outside [Imin, Imax] (i.e. Dv >= Imax + 0.5
+   or Dv <= Imin - 0.5, as for AF_RndOL) is counted and clipped.
+*/
+static inline UT_int4_t
+AF_RndC (double Dv, UT_int4_t Imin, UT_int4_t Imax, int *Novld)
+{
+  UT_int4_t Iv;
+  double Dt;
 
-  return;
+  Dt = (UT_int4_t) Dv;
+  Iv = (UT_int4_t) (Dv + (Dv - Dt));
+  *Novld += (Iv > Imax) + (Iv < Imin);
+  Iv = (Iv > Imax) ? Imax : Iv;
+
+  return ((Iv < Imin) ? Imin : Iv);
 }
 
 int
 AFdWrU1 (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
-  int is, N, Nw, i;
+  int is, N, Nw, i, Novld;
+  double ScaleF;
+  double Dc[NBBUF/LW1];
   UT_uint1_t Buf[NBBUF/LW1];
 
 /* Write data to the audio file */
+  ScaleF = AFp->ScaleF;
   is = 0;
   while (is < Nval) {
     N = MINV (NBBUF / LW1, Nval - is);
     for (i = 0; i < N; ++i)
-      Buf[i] = AF_RndOL (AFp->ScaleF * Dbuff[i+is] + UT_UINT1_OFFSET,
-                         0, UT_UINT1_MAX, &AFp->Novld);
+      Dc[i] = AF_LimW (ScaleF * Dbuff[i+is] + UT_UINT1_OFFSET,
+                       0, UT_UINT1_MAX);
+    Novld = 0;
+    for (i = 0; i < N; ++i)
+      Buf[i] = (UT_uint1_t) AF_RndC (Dc[i], 0, UT_UINT1_MAX, &Novld);
+    AFp->Novld += Novld;
 
-    Nw = FWRITE (Buf, LW1, N, AFp->fp);
+    Nw = AFwrBuf (AFp, Buf, LW1, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -121,18 +161,24 @@ int
 AFdWrI1 (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
-  int is, N, Nw, i;
+  int is, N, Nw, i, Novld;
+  double ScaleF;
+  double Dc[NBBUF/LW1];
   UT_int1_t Buf[NBBUF/LW1];
 
 /* Write data to the audio file */
+  ScaleF = AFp->ScaleF;
   is = 0;
   while (is < Nval) {
     N = MINV (NBBUF / LW1, Nval - is);
     for (i = 0; i < N; ++i)
-      Buf[i] = AF_RndOL (AFp->ScaleF * Dbuff[i+is], UT_INT1_MIN, UT_INT1_MAX,
-                         &AFp->Novld);
+      Dc[i] = AF_LimW (ScaleF * Dbuff[i+is], UT_INT1_MIN, UT_INT1_MAX);
+    Novld = 0;
+    for (i = 0; i < N; ++i)
+      Buf[i] = (UT_int1_t) AF_RndC (Dc[i], UT_INT1_MIN, UT_INT1_MAX, &Novld);
+    AFp->Novld += Novld;
 
-    Nw = FWRITE (Buf, LW1, N, AFp->fp);
+    Nw = AFwrBuf (AFp, Buf, LW1, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -145,20 +191,35 @@ int
 AFdWrI2 (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
-  int is, N, Nw, i;
-  UT_int2_t Buf[NBBUF/LW2];
+  int is, N, Nw, i, Novld;
+  double ScaleF;
+  double Dc[NBBUF/LW2];
+  UT_int4_t Iv;
+  unsigned char Buf[NBBUF];
 
 /* Write data to the audio file */
+  ScaleF = AFp->ScaleF;
   is = 0;
   while (is < Nval) {
     N = MINV (NBBUF / LW2, Nval - is);
-    for (i = 0; i < N; ++i) {
-      Buf[i] = AF_RndOL (AFp->ScaleF * Dbuff[i+is], UT_INT2_MIN, UT_INT2_MAX,
-                         &AFp->Novld);
-      if (AFp->Swapb == DS_SWAP)
-        BSWAP2 (&Buf[i]);
+    for (i = 0; i < N; ++i)
+      Dc[i] = AF_LimW (ScaleF * Dbuff[i+is], UT_INT2_MIN, UT_INT2_MAX);
+    Novld = 0;
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < N; ++i) {
+        Iv = AF_RndC (Dc[i], UT_INT2_MIN, UT_INT2_MAX, &Novld);
+        AF_PUTEL2 (&Buf[i*LW2], Iv);
+      }
     }
-    Nw = FWRITE (Buf, LW2, N, AFp->fp);
+    else {
+      for (i = 0; i < N; ++i) {
+        Iv = AF_RndC (Dc[i], UT_INT2_MIN, UT_INT2_MAX, &Novld);
+        AF_PUTEB2 (&Buf[i*LW2], Iv);
+      }
+    }
+    AFp->Novld += Novld;
+
+    Nw = AFwrBuf (AFp, Buf, LW2, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -171,23 +232,33 @@ int
 AFdWrI3 (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
-  int is, N, Nw, i, Hbo;
+  int is, N, Nw, i;
+  long int Novld;
+  double ScaleF;
   UT_int4_t Iv;
   unsigned char Buf[NBBUF];
 
 /* Write data to the audio file */
-  Hbo = UTbyteOrder ();
+  ScaleF = AFp->ScaleF;
   is = 0;
   while (is < Nval) {
     N = MINV (NBBUF / LW3, Nval - is);
-    for (i = 0; i < N; ++i) {
-      Iv = AF_RndOL (AFp->ScaleF * Dbuff[i+is], UT_INT3_MIN, UT_INT3_MAX,
-                     &AFp->Novld);
-      AF_DemoteB43 (Iv, &Buf[i*LW3], Hbo);
-      if (AFp->Swapb == DS_SWAP)
-        BSWAP3 (&Buf[i*LW3]);
+    Novld = 0;
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < N; ++i) {
+        Iv = AF_RndOL (ScaleF * Dbuff[i+is], UT_INT3_MIN, UT_INT3_MAX, &Novld);
+        AF_PUTEL3 (&Buf[i*LW3], Iv);
+      }
+    }
+    else {
+      for (i = 0; i < N; ++i) {
+        Iv = AF_RndOL (ScaleF * Dbuff[i+is], UT_INT3_MIN, UT_INT3_MAX, &Novld);
+        AF_PUTEB3 (&Buf[i*LW3], Iv);
+      }
     }
-    Nw = FWRITE (Buf, LW3, N, AFp->fp);
+    AFp->Novld += Novld;
+
+    Nw = AFwrBuf (AFp, Buf, LW3, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -201,19 +272,32 @@ AFdWrI4 (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
   int is, N, Nw, i;
-  UT_int4_t Buf[NBBUF/LW4];
+  long int Novld;
+  double ScaleF;
+  UT_int4_t Iv;
+  unsigned char Buf[NBBUF];
 
 /* Write data to the audio file */
+  ScaleF = AFp->ScaleF;
   is = 0;
   while (is < Nval) {
     N = MINV (NBBUF / LW4, Nval - is);
-    for (i = 0; i < N; ++i) {
-      Buf[i] = AF_RndOL (AFp->ScaleF * Dbuff[i+is], UT_INT4_MIN, UT_INT4_MAX,
-                         &AFp->Novld);
-      if (AFp->Swapb == DS_SWAP)
-        BSWAP4 (&Buf[i]);
+    Novld = 0;
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < N; ++i) {
+        Iv = AF_RndOL (ScaleF * Dbuff[i+is], UT_INT4_MIN, UT_INT4_MAX, &Novld);
+        AF_PUTEL4 (&Buf[i*LW4], Iv);
+      }
+    }
+    else {
+      for (i = 0; i < N; ++i) {
+        Iv = AF_RndOL (ScaleF * Dbuff[i+is], UT_INT4_MIN, UT_INT4_MAX, &Novld);
+        AF_PUTEB4 (&Buf[i*LW4], Iv);
+      }
     }
-    Nw = FWRITE (Buf, LW4, N, AFp->fp);
+    AFp->Novld += Novld;
+
+    Nw = AFwrBuf (AFp, Buf, LW4, N);
     is += Nw;
     if (Nw < N)
       break;
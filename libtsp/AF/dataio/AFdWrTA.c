@@ -10,7 +10,10 @@ Purpose:
 Description:
   These routines write a specified number of samples to an audio file.
   The input to these routine is a buffer of double values.  The output file
-  contains the text representation of the data values.
+  contains the text representation of the data values. Each value is
+  formatted with the fewest digits that decode back to the same double value
+  (see AFtxFmtVal). The text is assembled in a buffer and written out in
+  blocks.
 
 Parameters:
   <-  int AFdWrTA
@@ -25,7 +28,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.11 $  $Date: 2017/05/18 17:07:35 $
+  $Revision: 1.13 $  $Date: 2020/12/16 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -37,22 +40,28 @@ int
 AFdWrTA (AFILE *AFp, const double Dbuff[], int Nval)
 
 {
-  int i, Nc, Nmod;
+  int i, k, Nw, Nmod;
+  char Buf[NBBUF];
 
   /* Print a frame of samples on the same line */
   Nmod = AFp->Nchan;
   if (Nmod > 5 || Nval % AFp->Nchan != 0)
     Nmod = 1;
 
+  /* Format the values into a buffer, write the buffer when it fills up */
+  k = 0;
+  Nw = 0;
   for (i = 0; i < Nval; ++i) {
-    if (i % Nmod < Nmod - 1)
-      Nc = fprintf (AFp->fp, "%g ", AFp->ScaleF * Dbuff[i]);
-    else
-      Nc = fprintf (AFp->fp, "%g\n", AFp->ScaleF * Dbuff[i]);
+    k += AFtxFmtVal (&Buf[k], AFp->ScaleF * Dbuff[i]);
+    Buf[k++] = (i % Nmod < Nmod - 1) ? ' ' : '\n';
 
-    if (Nc < 0)   /* fprintf returns a negative valued error code */
-      break;
+    if (k > NBBUF - (AF_TXFMT_MAXLEN + 2) || i == Nval - 1) {
+      if (AFwrBuf (AFp, Buf, 1, k) < k)
+        break;
+      Nw = i + 1;
+      k = 0;
+    }
   }
 
-  return i;
+  return Nw;
 }
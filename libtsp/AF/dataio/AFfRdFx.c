@@ -30,6 +30,8 @@ Author / revision:
 
 -------------------------------------------------------------------------*/
 
+#include <string.h>   /* memcpy */
+
 #include <AFpar.h>
 #include <libtsp/AFdataio.h>
 #include <libtsp/UTtypes.h>
@@ -37,26 +39,43 @@ Author / revision:
 #define LW4   FDL_FLOAT32
 #define LW8   FDL_FLOAT64
 
-
+/* The byte swap test is done once per block of data, rather than for each
+   sample. The values are copied out of the data buffer with memcpy, since
+   memory mapped data need not be aligned.
+*/
+
 int
 AFfRdF4 (AFILE *AFp, float Dbuff[], int Nreq)
 
 {
   int is, N, i, Nr;
+  double ScaleF;
+  UT_float4_t Fv;
   UT_float4_t Buf[NBBUF/LW4];
+  const unsigned char *Bp;
 
+  ScaleF = AFp->ScaleF;
   for (is = 0; is < Nreq; ) {
 
     /* Read data from the audio file */
     N = MINV (NBBUF / LW4, Nreq - is);
-    Nr = FREAD (Buf, LW4, N, AFp->fp);
+    Bp = AFrdBuf (AFp, Buf, LW4, N, &Nr);
 
     /* Byte swap and scale */
-    for (i = 0; i < Nr; ++i, ++is) {
-      if (AFp->Swapb == DS_SWAP)
-        BSWAP4 (&Buf[i]);
-      Dbuff[is] = (float) (AFp->ScaleF * Buf[i]);
+    if (AFp->Swapb == DS_SWAP) {
+      for (i = 0; i < Nr; ++i) {
+        memcpy (&Fv, &Bp[i*LW4], LW4);
+        BSWAP4 (&Fv);
+        Dbuff[is+i] = (float) (ScaleF * Fv);
+      }
     }
+    else {
+      for (i = 0; i < Nr; ++i) {
+        memcpy (&Fv, &Bp[i*LW4], LW4);
+        Dbuff[is+i] = (float) (ScaleF * Fv);
+      }
+    }
+    is += Nr;
 
     if (Nr < N)
       break;
@@ -70,20 +89,34 @@ AFfRdF8 (AFILE *AFp, float Dbuff[], int Nreq)
 
 {
   int is, N, i, Nr;
+  double ScaleF;
+  UT_float8_t Fv;
   UT_float8_t Buf[NBBUF/LW8];
+  const unsigned char *Bp;
 
+  ScaleF = AFp->ScaleF;
   for (is = 0; is < Nreq; ) {
 
     /* Read data from the audio file */
     N = MINV (NBBUF / LW8, Nreq - is);
-    Nr = FREAD (Buf, LW8, N, AFp->fp);
+    Bp = AFrdBuf (AFp, Buf, LW8, N, &Nr);
 
     /* Byte swap and scale */
-    for (i = 0; i < Nr; ++i, ++is) {
-      if (AFp->Swapb == DS_SWAP)
-        BSWAP8 (&Buf[i]);
-      Dbuff[is] = (float) (AFp->ScaleF * Buf[i]);
+    if (AFp->Swapb == DS_SWAP) {
+      for (i = 0; i < Nr; ++i) {
+        memcpy (&Fv, &Bp[i*LW8], LW8);
+        BSWAP8 (&Fv);
+        Dbuff[is+i] = (float) (ScaleF * Fv);
+      }
+    }
+    else {
+      for (i = 0; i < Nr; ++i) {
+        memcpy (&Fv, &Bp[i*LW8], LW8);
+        Dbuff[is+i] = (float) (ScaleF * Fv);
+      }
     }
+    is += Nr;
+
     if (Nr < N)
       break;
   }
@@ -20,6 +20,11 @@ Description:
   file contains values smaller in magnitude than a float can represent, the
   decoded values are set to zero.
 
+  The values are decoded by AFtxRdData, which takes the characters directly
+  from the stdio buffer and uses a fast decoder for common number formats.
+  For random access files, checkpoints for the sample position index are
+  recorded as the values are decoded (see AFsetTxIdx).
+
 Parameters:
   <-  int AFfRdTA
       Number of data values transferred from the file.  On reaching the end of
@@ -33,50 +38,36 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.6 $  $Date: 2017/06/26 23:44:10 $
+  $Revision: 1.8 $  $Date: 2020/12/11 10:30:00 $
 
 -------------------------------------------------------------------------*/
 
-#include <libtsp/sysOS.h>
-#if (SY_OS == SY_OS_WINDOWS)
-#  define _CRT_SECURE_NO_WARNINGS     /* Allow fscanf */
-#endif
-
-#include <errno.h>
-#include <float.h>
-
 #include <libtsp.h>
 #include <AFpar.h>
 #include <libtsp/AFdataio.h>
 
+#define NBUF  (NBBUF / (int) sizeof (double))
+
 
 int
 AFfRdTA (AFILE *AFp, float Dbuff[], int Nreq)
 
 {
-  int nv, n;
+  int i, n, Nv, Nr;
   enum AF_ERR_T ErrCode;
-  double Dv;
+  double Dv[NBUF];
 
+/* Read the data, in blocks of doubles */
   ErrCode = AF_NOERR;
-
-/* Read the data */
-
-  for (n = 0; n < Nreq; ++n) {
-    errno = 0;
-    nv = fscanf (AFp->fp, "%lg", &Dv);
-    if (nv == 1)
-      Dbuff[n] = (float) (AFp->ScaleF * Dv);
-    else if (nv == EOF)
-      break;
-    else if (errno != 0) {
-      ErrCode = AF_IOERR;
-      break;
-    }
-    else {
-      ErrCode = AF_DECERR;
+  n = 0;
+  while (n < Nreq) {
+    Nv = MINV (Nreq - n, NBUF);
+    Nr = AFtxRdData (AFp, AFp->Isamp + n, Dv, Nv, &ErrCode);
+    for (i = 0; i < Nr; ++i)
+      Dbuff[n+i] = (float) (AFp->ScaleF * Dv[i]);
+    n += Nr;
+    if (Nr < Nv)
       break;
-    }
   }
 
 /* Check for errors */
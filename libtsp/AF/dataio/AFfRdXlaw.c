@@ -121,6 +121,7 @@ AFfRdAlaw (AFILE *AFp, float Dbuff[], int Nreq)
 {
   int is, N, i, Nr;
   UT_uint1_t Buf[NBBUF/LW1];
+  const unsigned char *Bp;
 
   /*
   The following table implements the conversion from A-law, with the output
@@ -167,11 +168,11 @@ AFfRdAlaw (AFILE *AFp, float Dbuff[], int Nreq)
 
     /* Read data from the audio file */
     N = MINV (NBBUF / LW1, Nreq - is);
-    Nr = FREAD (Buf, LW1, N, AFp->fp);
+    Bp = AFrdBuf (AFp, Buf, LW1, N, &Nr);
 
     /* Scale */
     for (i = 0; i < Nr; ++i, ++is)
-      Dbuff[is] = (float) (AFp->ScaleF * Atab[Buf[i]]);
+      Dbuff[is] = (float) (AFp->ScaleF * Atab[Bp[i]]);
 
     if (Nr < N)
       break;
@@ -186,6 +187,7 @@ AFfRdMulaw (AFILE *AFp, float Dbuff[], int Nreq)
 {
   int is, N, i, Nr;
   UT_uint1_t Buf[NBBUF/LW1];
+  const unsigned char *Bp;
 
   /*
   The following table implements the conversion from mu-law, with the output
@@ -231,11 +233,11 @@ AFfRdMulaw (AFILE *AFp, float Dbuff[], int Nreq)
 
     /* Read data from the audio file */
     N = MINV (NBBUF / LW1, Nreq - is);
-    Nr = FREAD (Buf, LW1, N, AFp->fp);
+    Bp = AFrdBuf (AFp, Buf, LW1, N, &Nr);
 
     /* Convert and scale */
     for (i = 0; i < Nr; ++i, ++is)
-      Dbuff[is] = (float) (AFp->ScaleF * Mutab[Buf[i]]);
+      Dbuff[is] = (float) (AFp->ScaleF * Mutab[Bp[i]]);
 
     if (Nr < N)
       break;
@@ -250,6 +252,7 @@ AFfRdMulawR (AFILE *AFp, float Dbuff[], int Nreq)
 {
   int is, N, i, Nr;
   UT_uint1_t Buf[NBBUF/LW1];
+  const unsigned char *Bp;
 
   /*
   The following table implements the conversion from my-law, with the output
@@ -295,11 +298,11 @@ AFfRdMulawR (AFILE *AFp, float Dbuff[], int Nreq)
 
     /* Read data from the audio file */
     N = MINV (NBBUF / LW1, Nreq - is);
-    Nr = FREAD (Buf, LW1, N, AFp->fp);
+    Bp = AFrdBuf (AFp, Buf, LW1, N, &Nr);
 
     /* Convert and scale */
     for (i = 0; i < Nr; ++i, ++is)
-      Dbuff[is] = (float) (AFp->ScaleF * MuRtab[Buf[i]]);
+      Dbuff[is] = (float) (AFp->ScaleF * MuRtab[Bp[i]]);
 
     if (Nr < N)
       break;
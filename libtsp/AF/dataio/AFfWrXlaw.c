@@ -49,10 +49,12 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.3 $  $Date: 2020/09/09 21:19:05 $
+  $Revision: 1.4 $  $Date: 2020/12/16 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
+#include <math.h>
+
 #include <libtsp.h>
 #include <AFpar.h>
 #include <libtsp/AFdataio.h>
@@ -60,9 +62,9 @@ Author / revision:
 
 #define LW1   FDL_ALAW8     /* Also FDL_MULAW8 and FDL_MULAWR8 */
 #define NLEV    256
-#define MAX_ALAW    32768  /* Xq[NLEV-1] + (Xq[NLEV-1] - Xq[NLEV-2]) */
+#define MAX_ALAW    32768  /* 31744 + (31744 - 30720) */
 #define MIN_ALAW    (-MAX_MULAW)
-#define MAX_MULAW   32636  /* Xq[NLEV-1] + (Xq[NLEV-1] - Xq[NLEV-2]) */
+#define MAX_MULAW   32636  /* 31612 + (31612 - 30588) */
 #define MIN_MULAW   (-MAX_MULAW)
 
 /* ITU-T Recommendation G.711
@@ -76,11 +78,11 @@ Author / revision:
    positive values on the decision levels move upward (away from zero) and
    negative values on the decision levels also move upward (toward zero).
 
-   The present implementation uses a direct quantization.  For the quantization
-   routine SPdQuantL, the intervals are defined as Xq[i-1] <= x < Xq[i], and
-   so input values which lie at the decision level move upward.  For integer
-   valued inputs, the results match exactly the results of the STL96 G.711
-   reference routine.
+   The present implementation uses a direct quantization.  The quantizer
+   regions are defined as Xq[i-1] <= x < Xq[i] (as for the quantization routine
+   SPdQuantL), and so input values which lie at the decision level move upward.
+   For integer valued inputs, the results match exactly the results of the
+   STL96 G.711 reference routine.
 
    A-law data is stored in sign-magnitude alternate-bit-complemented format.
    The sign bit is 1 for positive data.  The uncomplemented byte is in
@@ -115,11 +117,72 @@ Author / revision:
    becomes 1011 001 0, with the sign-bit now in the least significant position
    in the byte.
 
-   SPdQuantL is used to find the quantization region corresponding to eacj input
-   value.  There are 256 quantizer regions.  The A-law, mu-law, or bit-reversed
-   mu-law value is found using a table lookup.
+   The quantization region corresponding to each input value is found directly
+   from the segment and mantissa of the input value (see AF_AlawIndex and
+   AF_MulawIndex), rather than by a search over the 255 decision levels.  There
+   are 256 quantizer regions.  The A-law, mu-law, or bit-reversed mu-law value
+   is found using a table lookup.
 */
 
+/* Quantizer region index for A-law data
+   The decision levels for A-law are multiples of 16 and are symmetric about
+   zero. For positive values, the region index is found from the segment and
+   mantissa of v = floor(Dv)/16. A negative value Dv with k = floor(Dv) lies in
+   the region which is the mirror image of the region for the positive value
+   ~k = -k-1. This reproduces the decision level behaviour of SPdQuantL
+   (Xq[i-1] <= x < Xq[i]) exactly, including values which lie on a decision
+   level.
+*/
+static inline int
+AF_AlawIndex (double Dv)
+{
+  int k, v, seg, P;
+
+  if (! (Dv < MAX_ALAW))    /* Also catches NaN values, as for SPdQuantL */
+    return NLEV-1;
+  else if (Dv < MIN_ALAW)
+    return 0;
+
+  k = (int) floor (Dv);
+  v = ((k >= 0) ? k : ~k) >> 4;     /* 0 <= v < 2048 */
+  if (v < 32)
+    P = v;                  /* Segments 0 and 1, step size 1 */
+  else {
+    for (seg = 2; v >= (64 << (seg-2)); ++seg)
+      ;
+    P = 16 * seg + ((v >> (seg-1)) & 0xF);
+  }
+
+  return ((k >= 0) ? NLEV/2 + P : NLEV/2 - 1 - P);
+}
+
+/* Quantizer region index for mu-law data
+   The decision levels for mu-law are multiples of 4 and are symmetric about
+   zero. For positive values, the region index is found from the segment and
+   mantissa of v + 33, where v = floor(Dv)/4 and 33 is the mu-law bias. As for
+   A-law, negative values use the mirror image region.
+*/
+static inline int
+AF_MulawIndex (double Dv)
+{
+  int k, w, seg;
+
+  if (! (Dv < MAX_MULAW))   /* Also catches NaN values, as for SPdQuantL */
+    return NLEV-1;
+  else if (Dv < MIN_MULAW)
+    return 0;
+
+  k = (int) floor (Dv);
+  w = (((k >= 0) ? k : ~k) >> 2) + 33;      /* 33 <= w < 8192 */
+  for (seg = 0; w >= (64 << seg); ++seg)
+    ;
+
+  if (k >= 0)
+    return (NLEV/2 + 16 * seg + ((w >> (seg+1)) & 0xF));
+  else
+    return (NLEV/2 - 1 - 16 * seg - ((w >> (seg+1)) & 0xF));
+}
+
 int
 AFfWrAlaw (AFILE *AFp, const float Dbuff[], int Nval)
 
@@ -128,41 +191,6 @@ AFfWrAlaw (AFILE *AFp, const float Dbuff[], int Nval)
   UT_uint1_t Buf[NBBUF/LW1];
   double Dv;
 
-  const double Xq[NLEV-1] = {
-     -31744, -30720, -29696, -28672, -27648, -26624, -25600,
-     -24576, -23552, -22528, -21504, -20480, -19456, -18432, -17408,
-     -16384, -15872, -15360, -14848, -14336, -13824, -13312, -12800,
-     -12288, -11776, -11264, -10752, -10240,  -9728,  -9216,  -8704,
-     -8192,   -7936,  -7680,  -7424,  -7168,  -6912,  -6656,  -6400,
-     -6144,   -5888,  -5632,  -5376,  -5120,  -4864,  -4608,  -4352,
-     -4096,   -3968,  -3840,  -3712,  -3584,  -3456,  -3328,  -3200,
-     -3072,   -2944,  -2816,  -2688,  -2560,  -2432,  -2304,  -2176,
-     -2048,   -1984,  -1920,  -1856,  -1792,  -1728,  -1664,  -1600,
-     -1536,   -1472,  -1408,  -1344,  -1280,  -1216,  -1152,  -1088,
-     -1024,    -992,   -960,   -928,   -896,   -864,   -832,   -800,
-      -768,    -736,   -704,   -672,   -640,   -608,   -576,   -544,
-      -512,    -496,   -480,   -464,   -448,   -432,   -416,   -400,
-      -384,    -368,   -352,   -336,   -320,   -304,   -288,   -272,
-      -256,    -240,   -224,   -208,   -192,   -176,   -160,   -144,
-      -128,    -112,    -96,    -80,    -64,    -48,    -32,    -16,
-         0,
-        16,      32,     48,     64,     80,     96,    112,    128,
-       144,     160,    176,    192,    208,    224,    240,    256,
-       272,     288,    304,    320,    336,    352,    368,    384,
-       400,     416,    432,    448,    464,    480,    496,    512,
-       544,     576,    608,    640,    672,    704,    736,    768,
-       800,     832,    864,    896,    928,    960,    992,   1024,
-      1088,    1152,   1216,   1280,   1344,   1408,   1472,   1536,
-      1600,    1664,   1728,   1792,   1856,   1920,   1984,   2048,
-      2176,    2304,   2432,   2560,   2688,   2816,   2944,   3072,
-      3200,    3328,   3456,   3584,   3712,   3840,   3968,   4096,
-      4352,    4608,   4864,   5120,   5376,   5632,   5888,   6144,
-      6400,    6656,   6912,   7168,   7424,   7680,   7936,   8192,
-      8704,    9216,   9728,  10240,  10752,  11264,  11776,  12288,
-     12800,   13312,  13824,  14336,  14848,  15360,  15872,  16384,
-     17408,   18432,  19456,  20480,  21504,  22528,  23552,  24576,
-     25600,   26624,  27648,  28672,  29696,  30720,  31744
-  };
   const UT_uint1_t C[NLEV] = {
     0x2A, 0x2B, 0x28, 0x29, 0x2E, 0x2F, 0x2C, 0x2D,
     0x22, 0x23, 0x20, 0x21, 0x26, 0x27, 0x24, 0x25,
@@ -206,9 +234,9 @@ AFfWrAlaw (AFILE *AFp, const float Dbuff[], int Nval)
       Dv = AFp->ScaleF * Dbuff[i+is];
       if (Dv > MAX_ALAW || Dv < MIN_ALAW)
         ++AFp->Novld;
-      Buf[i] = C[SPdQuantL (Dv, Xq, NLEV)];   /* A-law code */
+      Buf[i] = C[AF_AlawIndex (Dv)];   /* A-law code */
     }
-    Nw = FWRITE (Buf, LW1, N, AFp->fp);
+    Nw = AFwrBuf (AFp, Buf, LW1, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -225,41 +253,6 @@ AFfWrMulaw (AFILE *AFp, const float Dbuff[], int Nval)
   UT_uint1_t Buf[NBBUF/LW1];
   double Dv;
 
-  const double Xq[NLEV-1] = {
-     -31612, -30588, -29564, -28540, -27516, -26492, -25468,
-     -24444, -23420, -22396, -21372, -20348, -19324, -18300, -17276,
-     -16252, -15740, -15228, -14716, -14204, -13692, -13180, -12668,
-     -12156, -11644, -11132, -10620, -10108,  -9596,  -9084,  -8572,
-      -8060,  -7804,  -7548,  -7292,  -7036,  -6780,  -6524,  -6268,
-      -6012,  -5756,  -5500,  -5244,  -4988,  -4732,  -4476,  -4220,
-      -3964,  -3836,  -3708,  -3580,  -3452,  -3324,  -3196,  -3068,
-      -2940,  -2812,  -2684,  -2556,  -2428,  -2300,  -2172,  -2044,
-      -1916,  -1852,  -1788,  -1724,  -1660,  -1596,  -1532,  -1468,
-      -1404,  -1340,  -1276,  -1212,  -1148,  -1084,  -1020,   -956,
-       -892,   -860,   -828,   -796,   -764,   -732,   -700,   -668,
-       -636,   -604,   -572,   -540,   -508,   -476,   -444,   -412,
-       -380,   -364,   -348,   -332,   -316,   -300,   -284,   -268,
-       -252,   -236,   -220,   -204,   -188,   -172,   -156,   -140,
-       -124,   -116,   -108,   -100,    -92,    -84,    -76,    -68,
-        -60,    -52,    -44,    -36,    -28,    -20,    -12,     -4,
-          0,
-          4,     12,     20,     28,     36,     44,     52,     60,
-         68,     76,     84,     92,    100,    108,    116,    124,
-        140,    156,    172,    188,    204,    220,    236,    252,
-        268,    284,    300,    316,    332,    348,    364,    380,
-        412,    444,    476,    508,    540,    572,    604,    636,
-        668,    700,    732,    764,    796,    828,    860,    892,
-        956,   1020,   1084,   1148,   1212,   1276,   1340,   1404,
-       1468,   1532,   1596,   1660,   1724,   1788,   1852,   1916,
-       2044,   2172,   2300,   2428,   2556,   2684,   2812,   2940,
-       3068,   3196,   3324,   3452,   3580,   3708,   3836,   3964,
-       4220,   4476,   4732,   4988,   5244,   5500,   5756,   6012,
-       6268,   6524,   6780,   7036,   7292,   7548,   7804,   8060,
-       8572,   9084,   9596,  10108,  10620,  11132,  11644,  12156,
-      12668,  13180,  13692,  14204,  14716,  15228,  15740,  16252,
-      17276,  18300,  19324,  20348,  21372,  22396,  23420,  24444,
-      25468,  26492,  27516,  28540,  29564,  30588,  31612
-  };
   const UT_uint1_t C[NLEV] = {
     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
     0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
@@ -303,9 +296,9 @@ AFfWrMulaw (AFILE *AFp, const float Dbuff[], int Nval)
       Dv = AFp->ScaleF * Dbuff[i+is];
       if (Dv > MAX_MULAW || Dv < MIN_MULAW)
         ++AFp->Novld;
-      Buf[i] = C[SPdQuantL (Dv, Xq, NLEV)];   /* mu-law code */
+      Buf[i] = C[AF_MulawIndex (Dv)];  /* mu-law code */
     }
-    Nw = FWRITE (Buf, LW1, N, AFp->fp);
+    Nw = AFwrBuf (AFp, Buf, LW1, N);
     is += Nw;
     if (Nw < N)
       break;
@@ -322,41 +315,6 @@ AFfWrMulawR (AFILE *AFp, const float Dbuff[], int Nval)
   UT_uint1_t Buf[NBBUF/LW1];
   double Dv;
 
-  const double Xq[NLEV-1] = {
-     -31612, -30588, -29564, -28540, -27516, -26492, -25468,
-     -24444, -23420, -22396, -21372, -20348, -19324, -18300, -17276,
-     -16252, -15740, -15228, -14716, -14204, -13692, -13180, -12668,
-     -12156, -11644, -11132, -10620, -10108,  -9596,  -9084,  -8572,
-      -8060,  -7804,  -7548,  -7292,  -7036,  -6780,  -6524,  -6268,
-      -6012,  -5756,  -5500,  -5244,  -4988,  -4732,  -4476,  -4220,
-      -3964,  -3836,  -3708,  -3580,  -3452,  -3324,  -3196,  -3068,
-      -2940,  -2812,  -2684,  -2556,  -2428,  -2300,  -2172,  -2044,
-      -1916,  -1852,  -1788,  -1724,  -1660,  -1596,  -1532,  -1468,
-      -1404,  -1340,  -1276,  -1212,  -1148,  -1084,  -1020,   -956,
-       -892,   -860,   -828,   -796,   -764,   -732,   -700,   -668,
-       -636,   -604,   -572,   -540,   -508,   -476,   -444,   -412,
-       -380,   -364,   -348,   -332,   -316,   -300,   -284,   -268,
-       -252,   -236,   -220,   -204,   -188,   -172,   -156,   -140,
-       -124,   -116,   -108,   -100,    -92,    -84,    -76,    -68,
-        -60,    -52,    -44,    -36,    -28,    -20,    -12,     -4,
-          0,
-          4,     12,     20,     28,     36,     44,     52,     60,
-         68,     76,     84,     92,    100,    108,    116,    124,
-        140,    156,    172,    188,    204,    220,    236,    252,
-        268,    284,    300,    316,    332,    348,    364,    380,
-        412,    444,    476,    508,    540,    572,    604,    636,
-        668,    700,    732,    764,    796,    828,    860,    892,
-        956,   1020,   1084,   1148,   1212,   1276,   1340,   1404,
-       1468,   1532,   1596,   1660,   1724,   1788,   1852,   1916,
-       2044,   2172,   2300,   2428,   2556,   2684,   2812,   2940,
-       3068,   3196,   3324,   3452,   3580,   3708,   3836,   3964,
-       4220,   4476,   4732,   4988,   5244,   5500,   5756,   6012,
-       6268,   6524,   6780,   7036,   7292,   7548,   7804,   8060,
-       8572,   9084,   9596,  10108,  10620,  11132,  11644,  12156,
-      12668,  13180,  13692,  14204,  14716,  15228,  15740,  16252,
-      17276,  18300,  19324,  20348,  21372,  22396,  23420,  24444,
-      25468,  26492,  27516,  28540,  29564,  30588,  31612
-  };
   const UT_uint1_t C[NLEV] = {
     0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
     0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
@@ -400,9 +358,9 @@ AFfWrMulawR (AFILE *AFp, const float Dbuff[], int Nval)
       Dv = AFp->ScaleF * Dbuff[i+is];
       if (Dv > MAX_MULAW || Dv < MIN_MULAW)
         ++AFp->Novld;
-      Buf[i] = C[SPdQuantL (Dv, Xq, NLEV)];   /* mu-law code */
+      Buf[i] = C[AF_MulawIndex (Dv)];  /* mu-law code */
     }
-    Nw = FWRITE (Buf, LW1, N, AFp->fp);
+    Nw = AFwrBuf (AFp, Buf, LW1, N);
     is += Nw;
     if (Nw < N)
       break;
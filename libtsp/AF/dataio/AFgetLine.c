@@ -22,8 +22,9 @@ Parameters:
       Pointer to the text string.  This is NULL if end-of-file is encountered
       and the line is empty.  Otherwise, when end-of-file is encountered, the
       line is treated as if it were terminated with a newline.  The text string
-      is in an internal storage area; each call to this routine overlays this
-      storage. The pointer is also NULL if Errcode is set.
+      is in an internal storage area; each call to this routine from the same
+      thread overlays this storage. The pointer is also NULL if Errcode is
+      set.
    -> FILE *fp
       File pointer to the file
   <-> enum AF_ERR_T ErrCode
@@ -53,7 +54,7 @@ AFgetLine (FILE *fp, enum AF_ERR_T *ErrCode)
 {
   char *p;
   int nc;
-  static char line[NBUF];
+  static SY_THREAD_LOCAL char line[NBUF];
 
   if (*ErrCode)
     return NULL;
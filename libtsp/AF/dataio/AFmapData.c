@@ -0,0 +1,180 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFmapData (AFILE *AFp)
+  void AFunmapData (AFILE *AFp)
+  const unsigned char *AFrdBuf (AFILE *AFp, void *Buf, int Lw, int N, int *Nr)
+
+Purpose:
+  Map the audio data of an input file into memory
+  Release the memory mapping for the audio data
+  Get a pointer to the next block of data values from an audio file
+
+Description:
+  AFmapData maps the audio data of an input file into memory. The file must be
+  random access, the data must be binary (fixed length records), and the
+  number of samples must be known. The data limits are taken from AFp->Start
+  and AFp->Nsamp. The mapping is truncated to the actual file size, so that a
+  file with fewer samples than indicated in the header gives an end-of-file
+  indication on reading, as for stdio access. If the data cannot be mapped, the
+  file continues to be accessed using stdio.
+
+  AFunmapData releases the memory mapping set up by AFmapData. It is a no-op
+  for files whose data is not mapped.
+
+  AFrdBuf is used by the data conversion routines to get the next N data values
+  (Lw bytes each). For mapped data, a pointer into the mapped region is
+  returned and Buf is not used. Otherwise the data is read into Buf and a
+  pointer to Buf is returned (the data is read through the retained data
+  window if one has been set up, see AFsetRBuf, or from the read-ahead buffers
+  if background I/O has been set up, see AFsetAIO). In either case the values
+  are in file byte order and may not be aligned on a data value boundary. The
+  data transfer statistics for the file are updated. The time spent in the
+  read is measured if statistics reporting is enabled. With background I/O,
+  this is the time spent waiting for the data.
+
+Parameters:
+  <-  int AFmapData
+      Status, zero if the data has been mapped
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+
+  <-  void AFunmapData
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+
+  <-  const unsigned char *AFrdBuf
+      Pointer to the data values
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> void *Buf
+      Buffer used for stdio access (N*Lw bytes)
+   -> int Lw
+      Size of each data value in bytes
+   -> int N
+      Number of data values requested
+  <-  int *Nr
+      Number of data values available. On reaching the end of the data, this
+      value may be less than N.
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.5 $  $Date: 2020/12/23 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+
+#if (SY_POSIX)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
+
+
+int
+AFmapData (AFILE *AFp)
+
+{
+#if (SY_POSIX)
+  int Lw;
+  long int Lpage, Boffs, Ldata;
+  void *Base;
+  struct stat Fstat;
+
+  Lw = AF_DL[AFp->Format];
+  if (AFp->MMap.Data != NULL || AFp->Op != FO_RO || Lw <= 0 ||
+      AFp->Nsamp == AF_NSAMP_UNDEF || ! FLseekable (AFp->fp))
+    return 1;
+
+/* Limit the data length to the file size */
+  if (fstat (fileno (AFp->fp), &Fstat) != 0 || ! S_ISREG (Fstat.st_mode))
+    return 1;
+  Ldata = (long int) Fstat.st_size - AFp->Start;
+  Ldata = MINV (Ldata, Lw * AFp->Nsamp);
+  if (Ldata <= 0L)
+    return 1;
+
+/* The mapping must start on a page boundary */
+  Lpage = sysconf (_SC_PAGESIZE);
+  if (Lpage <= 0L)
+    return 1;
+  Boffs = (AFp->Start / Lpage) * Lpage;
+  Base = mmap (NULL, (size_t) (AFp->Start - Boffs + Ldata), PROT_READ,
+               MAP_SHARED, fileno (AFp->fp), (off_t) Boffs);
+  if (Base == MAP_FAILED)
+    return 1;
+#  ifdef MADV_SEQUENTIAL
+  (void) madvise (Base, (size_t) (AFp->Start - Boffs + Ldata),
+                  MADV_SEQUENTIAL);
+#  endif
+
+  AFp->MMap.Base = Base;
+  AFp->MMap.Lbase = AFp->Start - Boffs + Ldata;
+  AFp->MMap.Data = (const unsigned char *) Base + (AFp->Start - Boffs);
+  AFp->MMap.Ldata = Ldata;
+  AFp->MMap.Pos = MINV (Lw * AFp->Isamp, Ldata);
+
+  return 0;
+#else
+  return 1;
+#endif
+}
+
+
+void
+AFunmapData (AFILE *AFp)
+
+{
+#if (SY_POSIX)
+  if (AFp->MMap.Data != NULL)
+    munmap (AFp->MMap.Base, (size_t) AFp->MMap.Lbase);
+#endif
+
+  AFp->MMap.Base = NULL;
+  AFp->MMap.Lbase = 0L;
+  AFp->MMap.Data = NULL;
+  AFp->MMap.Ldata = 0L;
+  AFp->MMap.Pos = 0L;
+}
+
+
+const unsigned char *
+AFrdBuf (AFILE *AFp, void *Buf, int Lw, int N, int *Nr)
+
+{
+  const unsigned char *Bp;
+  double T;
+
+  if (AFp->MMap.Data == NULL) {
+    T = 0.0;
+    if (AFp->Stats.Report)
+      T = UTclock ();
+    if (AFp->RBuf.Buf != NULL)
+      *Nr = AFrbRead (AFp, Buf, Lw, N);    /* Retained data window */
+    else if (AFp->AIO != NULL)
+      *Nr = AFaioRead (AFp, Buf, Lw, N);   /* Background reads */
+    else {
+      *Nr = FREAD (Buf, Lw, N, AFp->fp);
+      ++AFp->Stats.Ncall;
+    }
+    AFp->Stats.Nbyte += (long int) *Nr * Lw;
+    if (AFp->Stats.Report)
+      AFp->Stats.Tio += UTclock () - T;
+    return (const unsigned char *) Buf;
+  }
+
+  /* Mapped data, no read calls */
+  Bp = &AFp->MMap.Data[AFp->MMap.Pos];
+  *Nr = (int) MINV (N, MAXV (0L, AFp->MMap.Ldata - AFp->MMap.Pos) / Lw);
+  AFp->MMap.Pos += (long int) *Nr * Lw;
+  AFp->Stats.Nbyte += (long int) *Nr * Lw;
+
+  return Bp;
+}
@@ -21,20 +21,22 @@ Parameters:
       position, the position is moved to offs either by seeking (random access
       binary file) or by reading (non-random access or text data). If offset
       is before offs, move by seeking (random access binary file) or by
-      rewinding and reading (random access text file).
+      rewinding and reading (random access text file). For memory mapped
+      data, only the data position in the mapping is changed. For a file with
+      a retained data window (see AFsetRBuf), a move to data within the window
+      changes only the position in the window, and a move forward beyond the
+      window reads the data into the window. For a file with background reads
+      (see AFsetAIO), a move forward to data already read ahead discards the
+      intervening data. For a text file with a sample
+      position index (see AFsetTxIdx), the move starts from the nearest
+      checkpoint.
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.12 $  $Date: 2017/06/09 15:05:31 $
+  $Revision: 1.18 $  $Date: 2020/12/23 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
-#include <libtsp/sysOS.h>
-#if (SY_OS == SY_OS_WINDOWS)
-#  define _CRT_SECURE_NO_WARNINGS     /* Allow fscanf */
-#endif
-
-#include <errno.h>
 #include <string.h>
 
 #include <libtsp.h>
@@ -43,10 +45,16 @@ Author / revision:
 #include <libtsp/AFdataio.h>
 #include <libtsp/AFmsg.h>
 
-#define AFSEEK(AFp,boff)  AFseek ((AFp)->fp, (AFp)->Start + (boff), NULL)
+/* Seek to a data byte offset, counted in the data transfer statistics */
+#define AFSEEK(AFp,boff) \
+  (++(AFp)->Stats.Nseek, AFseek ((AFp)->fp, (AFp)->Start + (boff), NULL))
 
 /* Local functions */
 static enum AF_ERR_T
+AF_moveRBuf (AFILE *AFp, long int offs);
+static enum AF_ERR_T
+AF_moveTxIdx (AFILE *AFp, long int offs);
+static enum AF_ERR_T
 AF_skipNFields (AFILE *AFp, long int N);
 static enum AF_ERR_T
 AF_skipNVal (AFILE *AFp, long int N);
@@ -81,7 +89,19 @@ AFposition (AFILE *AFp, long int offs)
   if (Lw > 0) {
 
 /* Fixed length records */
-    if (FLseekable (AFp->fp)) {
+    if (AFp->MMap.Data != NULL) {
+      /* Memory mapped data, the mapping may be shorter than the data */
+      AFp->MMap.Pos = MINV (Lw * offs, AFp->MMap.Ldata);
+      AFp->Isamp = offs;
+    }
+    else if (AFp->RBuf.Buf != NULL)
+      ErrCode = AF_moveRBuf (AFp, offs);  /* Retained data window */
+    else if (AFp->AIO != NULL) {
+      ErrCode = AFaioSeek (AFp, Lw * offs); /* Background reads */
+      if (! ErrCode)
+        AFp->Isamp = offs;
+    }
+    else if (FLseekable (AFp->fp)) {
       ErrCode = AFSEEK (AFp, Lw * offs);
       if (! ErrCode)
         AFp->Isamp = offs;
@@ -97,7 +117,9 @@ AFposition (AFILE *AFp, long int offs)
   else {
 
 /* Variable length (text) records */
-    if (offs < AFp->Isamp) {
+    if (AFp->TxIdx.Offs != NULL)
+      ErrCode = AF_moveTxIdx (AFp, offs);   /* Sample position index */
+    else if (offs < AFp->Isamp) {
       if (FLseekable (AFp->fp)) {
         ErrCode = AFSEEK (AFp, 0L); /* Rewinding to start of data */
         if (! ErrCode)
@@ -117,6 +139,75 @@ AFposition (AFILE *AFp, long int offs)
   return ErrCode;
 }
 
+/* Move within or beyond the retained data window */
+
+
+static enum AF_ERR_T
+AF_moveRBuf (AFILE *AFp, long int offs)
+
+{
+  int Lw;
+  long int Nb, Nr;
+  enum AF_ERR_T ErrCode;
+
+  Lw = AF_DL[AFp->Format];
+  ErrCode = AF_NOERR;
+
+  /* Before the window */
+  if (Lw * offs < AFp->RBuf.End - AFp->RBuf.Lbuf) {
+    UTwarn ("AFposition: %s", AFM_MoveBack);
+    return AF_IOERR;
+  }
+
+  /* Beyond the window, read forward */
+  Nr = Nb = Lw * offs - AFp->RBuf.End;
+  if (Nb > 0L)
+    Nr = AFrbFill (AFp, Nb);
+
+  if (Nr < Nb) {
+    AFp->Isamp = AFp->RBuf.End / Lw;
+    if (ferror (AFp->fp)) {
+      UTsysMsg ("AFposition: %s %ld", AFM_ReadErrOffs, AFp->Isamp);
+      ErrCode = AF_IOERR;
+    }
+    else if (AFp->Nsamp != AF_NSAMP_UNDEF) {
+      UTwarn ("AFposition: %s %ld", AFM_UEoFOffs, AFp->Isamp);
+      ErrCode = AF_UEOF;
+    }
+    else
+      AFp->Nsamp = AFp->Isamp;
+  }
+  else
+    AFp->Isamp = offs;
+  AFp->RBuf.Pos = Lw * AFp->Isamp;
+
+  return ErrCode;
+}
+
+/* Move to the checkpoint nearest to (at or before) offs, if that is closer
+   than the current position */
+
+
+static enum AF_ERR_T
+AF_moveTxIdx (AFILE *AFp, long int offs)
+
+{
+  long int j, Is;
+  enum AF_ERR_T ErrCode;
+
+  ErrCode = AF_NOERR;
+  j = MINV (offs / AFp->TxIdx.Step, AFp->TxIdx.N - 1);
+  Is = j * AFp->TxIdx.Step;
+  if (offs < AFp->Isamp || Is > AFp->Isamp) {
+    ++AFp->Stats.Nseek;
+    ErrCode = AFseek (AFp->fp, AFp->TxIdx.Offs[j], NULL);
+    if (! ErrCode)
+      AFp->Isamp = Is;
+  }
+
+  return ErrCode;
+}
+
 /* Skip N values */
 
 #define NBUF  256
@@ -137,6 +228,8 @@ AF_skipNVal (AFILE *AFp, long int N)
   while (nl < N) {
     Nreq = (int) MINV ((int) (sizeof Buf) / Lw, N - nl);
     Nv = FREAD (Buf, Lw, Nreq, AFp->fp);
+    ++AFp->Stats.Ncall;
+    AFp->Stats.Nbyte += (long int) Nv * Lw;
     nl += Nv;
     if (Nv < Nreq)
       break;
@@ -167,28 +260,19 @@ static int
 AF_skipNFields (AFILE *AFp, long int N)
 
 {
-  int nv;
+  int Nv, Nr;
   enum AF_ERR_T ErrCode;
   long int n;
-  double Dv;
 
-/* Read N values */
+/* Decode and discard N values */
   ErrCode = AF_NOERR;
-  for (n = 0; n < N; ++n) {
-    errno = 0;
-    nv = fscanf (AFp->fp, "%lg", &Dv);
-    if (nv == 1)
-      continue;
-    else if (nv == EOF)
-      break;
-    else if (errno != 0) {
-      ErrCode = AF_IOERR;
+  n = 0;
+  while (n < N) {
+    Nv = (int) MINV (N - n, NBBUF);
+    Nr = AFtxRdData (AFp, AFp->Isamp + n, NULL, Nv, &ErrCode);
+    n += Nr;
+    if (Nr < Nv)
       break;
-    }
-    else {
-      ErrCode = AF_DECERR;
-      break;
-    }
   }
   AFp->Isamp += n;
 
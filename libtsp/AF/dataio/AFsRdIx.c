@@ -0,0 +1,304 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFsRdU1 (AFILE *AFp, short int Sbuff[], int Nreq)
+  int AFsRdI1 (AFILE *AFp, short int Sbuff[], int Nreq)
+  int AFsRdI2 (AFILE *AFp, short int Sbuff[], int Nreq)
+  int AFiRdU1 (AFILE *AFp, int Ibuff[], int Nreq)
+  int AFiRdI1 (AFILE *AFp, int Ibuff[], int Nreq)
+  int AFiRdI2 (AFILE *AFp, int Ibuff[], int Nreq)
+  int AFiRdI3 (AFILE *AFp, int Ibuff[], int Nreq)
+  int AFiRdI4 (AFILE *AFp, int Ibuff[], int Nreq)
+
+Purpose:
+  Read offset-binary 8-bit integer data from an audio file (return 16-bit int)
+  Read 8-bit integer data from an audio file (return 16-bit integer values)
+  Read 16-bit integer data from an audio file (return 16-bit integer values)
+  Read offset-binary 8-bit integer data from an audio file (return 32-bit int)
+  Read 8-bit integer data from an audio file (return 32-bit integer values)
+  Read 16-bit integer data from an audio file (return 32-bit integer values)
+  Read 24-bit integer data from an audio file (return 32-bit integer values)
+  Read 32-bit integer data from an audio file (return 32-bit integer values)
+
+Description:
+  These routines read a specified number of integer samples from an audio file.
+  The data in the file is returned as native 16-bit or 32-bit integer values.
+  The file values are multiplied by an integer gain, the ratio of the full
+  scale value for the output integers to the full scale value for the file
+  data (AFp->FullScale). These routines are used only for the default full
+  scale values, for which the gain is an integer and the results fit in the
+  output integers. The conversion is then exact.
+
+Parameters:
+  <-  int AFsRdIx, int AFiRdIx
+      Number of data values transferred from the file.  On reaching the end of
+      the file, this value may be less than Nreq.
+   -> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+  <-  short int Sbuff[], int Ibuff[]
+      Array of integers to receive the samples
+   -> int Nreq
+      Number of samples requested.  Nreq may be zero.
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/09 10:30:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <AFpar.h>
+#include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
+#include <libtsp/UTtypes.h>
+
+#define LW1   FDL_INT8
+#define LW2   FDL_INT16
+#define LW3   FDL_INT24
+#define LW4   FDL_INT32
+
+/* The values are assembled from the bytes in file byte order as for AFdRdIx.
+   For 16-bit data returned as 16-bit integers and 32-bit data returned as
+   32-bit integers, the gain is one and the values are copied (with a byte
+   swap if necessary).
+*/
+
+int
+AFsRdU1 (AFILE *AFp, short int Sbuff[], int Nreq)
+
+{
+  int is, N, i, Nr, G;
+  UT_uint1_t Buf[NBBUF/LW1];
+  const unsigned char *Bp;
+
+  G = (int) (AF_FULLSCALE_INT2 / AFp->FullScale);
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF / LW1, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW1, N, &Nr);
+
+    /* Convert and scale */
+    for (i = 0; i < Nr; ++i)
+      Sbuff[is+i] = (short int) (G * ((int) Bp[i] - UT_UINT1_OFFSET));
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFsRdI1 (AFILE *AFp, short int Sbuff[], int Nreq)
+
+{
+  int is, N, i, Nr, G;
+  UT_int1_t Buf[NBBUF/LW1];
+  const unsigned char *Bp;
+
+  G = (int) (AF_FULLSCALE_INT2 / AFp->FullScale);
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF / LW1, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW1, N, &Nr);
+
+    /* Scale */
+    for (i = 0; i < Nr; ++i)
+      Sbuff[is+i] = (short int) (G * (UT_int1_t) Bp[i]);
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFsRdI2 (AFILE *AFp, short int Sbuff[], int Nreq)
+
+{
+  int is, N, i, Nr;
+  UT_int2_t Buf[NBBUF/LW2];
+  const unsigned char *Bp;
+
+  /* The gain is one (AFsReadData) */
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF / LW2, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW2, N, &Nr);
+
+    /* Assemble the values (file byte order) */
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < Nr; ++i)
+        Sbuff[is+i] = AF_GETEL2 (&Bp[i*LW2]);
+    }
+    else {
+      for (i = 0; i < Nr; ++i)
+        Sbuff[is+i] = AF_GETEB2 (&Bp[i*LW2]);
+    }
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFiRdU1 (AFILE *AFp, int Ibuff[], int Nreq)
+
+{
+  int is, N, i, Nr, G;
+  UT_uint1_t Buf[NBBUF/LW1];
+  const unsigned char *Bp;
+
+  G = (int) (AF_FULLSCALE_INT4 / AFp->FullScale);
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF / LW1, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW1, N, &Nr);
+
+    /* Convert and scale */
+    for (i = 0; i < Nr; ++i)
+      Ibuff[is+i] = G * ((int) Bp[i] - UT_UINT1_OFFSET);
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFiRdI1 (AFILE *AFp, int Ibuff[], int Nreq)
+
+{
+  int is, N, i, Nr, G;
+  UT_int1_t Buf[NBBUF/LW1];
+  const unsigned char *Bp;
+
+  G = (int) (AF_FULLSCALE_INT4 / AFp->FullScale);
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF / LW1, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW1, N, &Nr);
+
+    /* Scale */
+    for (i = 0; i < Nr; ++i)
+      Ibuff[is+i] = G * (UT_int1_t) Bp[i];
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFiRdI2 (AFILE *AFp, int Ibuff[], int Nreq)
+
+{
+  int is, N, i, Nr, G;
+  UT_int2_t Buf[NBBUF/LW2];
+  const unsigned char *Bp;
+
+  G = (int) (AF_FULLSCALE_INT4 / AFp->FullScale);
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF / LW2, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW2, N, &Nr);
+
+    /* Assemble the values (file byte order) and scale */
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < Nr; ++i)
+        Ibuff[is+i] = G * AF_GETEL2 (&Bp[i*LW2]);
+    }
+    else {
+      for (i = 0; i < Nr; ++i)
+        Ibuff[is+i] = G * AF_GETEB2 (&Bp[i*LW2]);
+    }
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFiRdI3 (AFILE *AFp, int Ibuff[], int Nreq)
+
+{
+  int is, N, i, Nr, G;
+  unsigned char Buf[NBBUF];
+  const unsigned char *Bp;
+
+  G = (int) (AF_FULLSCALE_INT4 / AFp->FullScale);
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF/LW3, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW3, N, &Nr);
+
+    /* Assemble the values (file byte order), extend the sign and scale */
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < Nr; ++i)
+        Ibuff[is+i] = G * AF_GETEL3 (&Bp[i*LW3]);
+    }
+    else {
+      for (i = 0; i < Nr; ++i)
+        Ibuff[is+i] = G * AF_GETEB3 (&Bp[i*LW3]);
+    }
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFiRdI4 (AFILE *AFp, int Ibuff[], int Nreq)
+
+{
+  int is, N, i, Nr;
+  UT_int4_t Buf[NBBUF/LW4];
+  const unsigned char *Bp;
+
+  /* The gain is one (AFiReadData) */
+  for (is = 0; is < Nreq; ) {
+
+    /* Read data from the audio file */
+    N = MINV (NBBUF / LW4, Nreq - is);
+    Bp = AFrdBuf (AFp, Buf, LW4, N, &Nr);
+
+    /* Assemble the values (file byte order) */
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < Nr; ++i)
+        Ibuff[is+i] = AF_GETEL4 (&Bp[i*LW4]);
+    }
+    else {
+      for (i = 0; i < Nr; ++i)
+        Ibuff[is+i] = AF_GETEB4 (&Bp[i*LW4]);
+    }
+    is += Nr;
+
+    if (Nr < N)
+      break;
+  }
+
+  return is;
+}
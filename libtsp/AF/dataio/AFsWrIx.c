@@ -0,0 +1,179 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFsWrI2 (AFILE *AFp, const short int Sbuff[], int Nval)
+  int AFsWrI3 (AFILE *AFp, const short int Sbuff[], int Nval)
+  int AFsWrI4 (AFILE *AFp, const short int Sbuff[], int Nval)
+  int AFiWrI4 (AFILE *AFp, const int Ibuff[], int Nval)
+
+Purpose:
+  Write 16-bit integer data to an audio file (16-bit integer input values)
+  Write 24-bit integer data to an audio file (16-bit integer input values)
+  Write 32-bit integer data to an audio file (16-bit integer input values)
+  Write 32-bit integer data to an audio file (32-bit integer input values)
+
+Description:
+  These routines write a specified number of integer samples to an audio file.
+  The input to these routines is a buffer of native 16-bit or 32-bit integer
+  values. The values are multiplied by an integer gain, the ratio of the full
+  scale value for the file data to the full scale value for the input
+  integers. The file data has at least as many bits as the input integers, so
+  that the conversion is exact and no clipping occurs.
+
+Parameters:
+  <-  int AFsWrIx, int AFiWrIx
+      Number of samples written.  If this value is less than Nval, an error
+      has occurred.
+   -> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnWrite
+   -> const short int Sbuff[], const int Ibuff[]
+      Array of integers with the samples to be written
+   -> int Nval
+      Number of samples to be written
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/16 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <AFpar.h>
+#include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
+#include <libtsp/UTtypes.h>
+
+#define LW2   FDL_INT16
+#define LW3   FDL_INT24
+#define LW4   FDL_INT32
+
+/* The values are stored directly as bytes in file byte order as for AFdWrIx.
+*/
+
+int
+AFsWrI2 (AFILE *AFp, const short int Sbuff[], int Nval)
+
+{
+  int is, N, Nw, i;
+  unsigned char Buf[NBBUF];
+
+/* Write data to the audio file (unit gain) */
+  is = 0;
+  while (is < Nval) {
+    N = MINV (NBBUF / LW2, Nval - is);
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < N; ++i)
+        AF_PUTEL2 (&Buf[i*LW2], Sbuff[i+is]);
+    }
+    else {
+      for (i = 0; i < N; ++i)
+        AF_PUTEB2 (&Buf[i*LW2], Sbuff[i+is]);
+    }
+
+    Nw = AFwrBuf (AFp, Buf, LW2, N);
+    is += Nw;
+    if (Nw < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFsWrI3 (AFILE *AFp, const short int Sbuff[], int Nval)
+
+{
+  int is, N, Nw, i;
+  UT_int4_t G, Iv;
+  unsigned char Buf[NBBUF];
+
+/* Write data to the audio file */
+  G = (UT_int4_t) (AF_FULLSCALE[AFp->Format] / AF_FULLSCALE_INT2);
+  is = 0;
+  while (is < Nval) {
+    N = MINV (NBBUF / LW3, Nval - is);
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < N; ++i) {
+        Iv = G * Sbuff[i+is];
+        AF_PUTEL3 (&Buf[i*LW3], Iv);
+      }
+    }
+    else {
+      for (i = 0; i < N; ++i) {
+        Iv = G * Sbuff[i+is];
+        AF_PUTEB3 (&Buf[i*LW3], Iv);
+      }
+    }
+
+    Nw = AFwrBuf (AFp, Buf, LW3, N);
+    is += Nw;
+    if (Nw < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFsWrI4 (AFILE *AFp, const short int Sbuff[], int Nval)
+
+{
+  int is, N, Nw, i;
+  UT_int4_t G, Iv;
+  unsigned char Buf[NBBUF];
+
+/* Write data to the audio file */
+  G = (UT_int4_t) (AF_FULLSCALE[AFp->Format] / AF_FULLSCALE_INT2);
+  is = 0;
+  while (is < Nval) {
+    N = MINV (NBBUF / LW4, Nval - is);
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < N; ++i) {
+        Iv = G * Sbuff[i+is];
+        AF_PUTEL4 (&Buf[i*LW4], Iv);
+      }
+    }
+    else {
+      for (i = 0; i < N; ++i) {
+        Iv = G * Sbuff[i+is];
+        AF_PUTEB4 (&Buf[i*LW4], Iv);
+      }
+    }
+
+    Nw = AFwrBuf (AFp, Buf, LW4, N);
+    is += Nw;
+    if (Nw < N)
+      break;
+  }
+
+  return is;
+}
+
+int
+AFiWrI4 (AFILE *AFp, const int Ibuff[], int Nval)
+
+{
+  int is, N, Nw, i;
+  unsigned char Buf[NBBUF];
+
+/* Write data to the audio file (unit gain) */
+  is = 0;
+  while (is < Nval) {
+    N = MINV (NBBUF / LW4, Nval - is);
+    if (UTbyteCode (AFp->Swapb) == DS_EL) {
+      for (i = 0; i < N; ++i)
+        AF_PUTEL4 (&Buf[i*LW4], Ibuff[i+is]);
+    }
+    else {
+      for (i = 0; i < N; ++i)
+        AF_PUTEB4 (&Buf[i*LW4], Ibuff[i+is]);
+    }
+
+    Nw = AFwrBuf (AFp, Buf, LW4, N);
+    is += Nw;
+    if (Nw < N)
+      break;
+  }
+
+  return is;
+}
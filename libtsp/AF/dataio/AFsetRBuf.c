@@ -0,0 +1,201 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFsetRBuf (AFILE *AFp, long int Lbuf)
+  void AFfreeRBuf (AFILE *AFp)
+  int AFrbRead (AFILE *AFp, void *Buf, int Lw, int N)
+  long int AFrbFill (AFILE *AFp, long int N)
+
+Purpose:
+  Set up a retained data window for an input file that is not random access
+  Release the retained data window
+  Read data values through the retained data window
+  Read data bytes from the file into the retained data window
+
+Description:
+  For an input file that is not random access (for instance a file stream from
+  a pipe), moving back in the file is not possible. A retained data window
+  keeps the most recently read data bytes in a circular buffer. Requests for
+  data that lies within the window are served from memory, so that data can be
+  reread, as long as the move back does not go before the start of the window.
+
+  AFsetRBuf sets up a window of Lbuf bytes. The window is used only for files
+  opened for reading, with binary data (fixed length records), that are not
+  random access and are not memory mapped. The window starts at the current
+  data position.
+
+  AFfreeRBuf releases the window set up by AFsetRBuf. It is a no-op for files
+  without a window.
+
+  AFrbRead is used by AFrdBuf to get the next N data values (Lw bytes each)
+  starting at the current position in the window (AFp->RBuf.Pos). Values up to
+  the end of the data read from the file are copied from the window. Any
+  further values are read from the file directly into Buf and are then added
+  to the window.
+
+  AFrbFill is used by AFposition to move forward. The data bytes are read
+  from the file into the window in large blocks. The current position is not
+  changed.
+
+Parameters:
+  <-  int AFsetRBuf
+      Status, zero if the window has been set up
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int Lbuf
+      Size of the window in bytes
+
+  <-  void AFfreeRBuf
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+
+  <-  int AFrbRead
+      Number of data values read. On reaching the end of the data, this
+      value may be less than N.
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+  <-  void *Buf
+      Buffer to receive the data values (N*Lw bytes)
+   -> int Lw
+      Size of each data value in bytes
+   -> int N
+      Number of data values requested
+
+  <-  long int AFrbFill
+      Number of bytes read. On reaching the end of the file, this value may be
+      less than N.
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int N
+      Number of bytes to be read
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/16 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
+
+static void
+AF_rbSave (AFILE *AFp, const unsigned char *Bp, long int N);
+
+
+int
+AFsetRBuf (AFILE *AFp, long int Lbuf)
+
+{
+  int Lw;
+
+  Lw = AF_DL[AFp->Format];
+  if (AFp->RBuf.Buf != NULL || AFp->Op != FO_RO || Lw <= 0 || Lbuf < Lw ||
+      AFp->MMap.Data != NULL || FLseekable (AFp->fp))
+    return 1;
+
+  AFp->RBuf.Buf = (unsigned char *) UTmalloc (Lbuf);
+  AFp->RBuf.Lbuf = Lbuf;
+  AFp->RBuf.End = Lw * AFp->Isamp;
+  AFp->RBuf.Pos = AFp->RBuf.End;
+
+  return 0;
+}
+
+
+void
+AFfreeRBuf (AFILE *AFp)
+
+{
+  UTfree ((void *) AFp->RBuf.Buf);
+
+  AFp->RBuf.Buf = NULL;
+  AFp->RBuf.Lbuf = 0L;
+  AFp->RBuf.End = 0L;
+  AFp->RBuf.Pos = 0L;
+}
+
+
+int
+AFrbRead (AFILE *AFp, void *Buf, int Lw, int N)
+
+{
+  unsigned char *Bp;
+  long int Nb, k, n, i, Pos;
+
+  Bp = (unsigned char *) Buf;
+  Nb = (long int) Lw * N;
+  Pos = AFp->RBuf.Pos;
+
+/* Copy the data in the window (at most two pieces) */
+  for (k = 0; k < Nb && Pos < AFp->RBuf.End; k += n) {
+    i = Pos % AFp->RBuf.Lbuf;
+    n = MINV (MINV (Nb - k, AFp->RBuf.End - Pos), AFp->RBuf.Lbuf - i);
+    memcpy (&Bp[k], &AFp->RBuf.Buf[i], (size_t) n);
+    Pos += n;
+  }
+
+/* Read the remaining data from the file and add it to the window */
+  if (k < Nb) {
+    n = (long int) fread (&Bp[k], 1, (size_t) (Nb - k), AFp->fp);
+    ++AFp->Stats.Ncall;
+    AF_rbSave (AFp, &Bp[k], n);
+    k += n;
+  }
+
+/* Only complete values are counted */
+  AFp->RBuf.Pos += (k / Lw) * Lw;
+
+  return (int) (k / Lw);
+}
+
+
+long int
+AFrbFill (AFILE *AFp, long int N)
+
+{
+  long int k, n, nr, i;
+
+/* Read directly into the window */
+  for (k = 0; k < N; k += nr) {
+    i = AFp->RBuf.End % AFp->RBuf.Lbuf;
+    n = MINV (N - k, AFp->RBuf.Lbuf - i);
+    nr = (long int) fread (&AFp->RBuf.Buf[i], 1, (size_t) n, AFp->fp);
+    ++AFp->Stats.Ncall;
+    AFp->Stats.Nbyte += nr;
+    AFp->RBuf.End += nr;
+    if (nr < n)
+      return k + nr;
+  }
+
+  return N;
+}
+
+/* Add N bytes to the end of the window (only the last Lbuf bytes are kept) */
+
+
+static void
+AF_rbSave (AFILE *AFp, const unsigned char *Bp, long int N)
+
+{
+  long int k, n, i;
+
+  if (N > AFp->RBuf.Lbuf) {
+    AFp->RBuf.End += N - AFp->RBuf.Lbuf;
+    Bp += N - AFp->RBuf.Lbuf;
+    N = AFp->RBuf.Lbuf;
+  }
+
+  for (k = 0; k < N; k += n) {
+    i = AFp->RBuf.End % AFp->RBuf.Lbuf;
+    n = MINV (N - k, AFp->RBuf.Lbuf - i);
+    memcpy (&AFp->RBuf.Buf[i], &Bp[k], (size_t) n);
+    AFp->RBuf.End += n;
+  }
+
+  return;
+}
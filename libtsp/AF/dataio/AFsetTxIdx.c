@@ -0,0 +1,125 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFsetTxIdx (AFILE *AFp)
+  void AFfreeTxIdx (AFILE *AFp)
+  void AFtxMark (AFILE *AFp, long int Is)
+
+Purpose:
+  Set up a sample position index for a random access text data file
+  Release the sample position index
+  Add a checkpoint to the sample position index
+
+Description:
+  Text data has variable length records. Moving to a given sample requires
+  decoding all of the preceding values. For random access files with text
+  data, a sparse index of (sample number, byte offset) checkpoints is built
+  as the data is decoded. A checkpoint is recorded every AF_TXIDX_STEP
+  samples. AFposition uses the index to move to the nearest checkpoint at or
+  before the desired sample, and decodes values forward from there.
+
+  AFsetTxIdx sets up an index for a file opened for reading with text data
+  that is random access. The first checkpoint is the start of the data. The
+  file must be positioned at the start of the data.
+
+  AFfreeTxIdx releases the index set up by AFsetTxIdx. It is a no-op for files
+  without an index.
+
+  AFtxMark is called by the text data decoding routines before decoding sample
+  Is, when Is is equal to AFp->TxIdx.Next. The current file position is
+  recorded as the next checkpoint. The index is extended in order as the data
+  is decoded; checkpoints are never recorded out of order.
+
+Parameters:
+  <-  int AFsetTxIdx
+      Status, zero if the index has been set up
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+
+  <-  void AFfreeTxIdx
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+
+  <-  void AFtxMark
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int Is
+      Sample number of the next value to be decoded
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/10 09:40:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
+
+#define NCHKPT  256     /* Initial number of checkpoints allocated */
+
+
+int
+AFsetTxIdx (AFILE *AFp)
+
+{
+  if (AFp->TxIdx.Offs != NULL || AFp->Op != FO_RO ||
+      AF_DL[AFp->Format] > 0 || AFp->Isamp != 0L || ! FLseekable (AFp->fp))
+    return 1;
+
+  AFp->TxIdx.Offs = (long int *) UTmalloc (NCHKPT * sizeof (long int));
+  AFp->TxIdx.Nmax = NCHKPT;
+  AFp->TxIdx.N = 0L;
+  AFp->TxIdx.Step = AF_TXIDX_STEP;
+  AFp->TxIdx.Next = 0L;
+  AFtxMark (AFp, 0L);
+
+  return (AFp->TxIdx.Offs == NULL);
+}
+
+
+void
+AFfreeTxIdx (AFILE *AFp)
+
+{
+  UTfree ((void *) AFp->TxIdx.Offs);
+
+  AFp->TxIdx.Offs = NULL;
+  AFp->TxIdx.N = 0L;
+  AFp->TxIdx.Nmax = 0L;
+  AFp->TxIdx.Step = 0L;
+  AFp->TxIdx.Next = -1L;
+}
+
+
+void
+AFtxMark (AFILE *AFp, long int Is)
+
+{
+  long int pos;
+  enum AF_ERR_T ErrCode;
+
+  if (AFp->TxIdx.Offs == NULL || Is != AFp->TxIdx.Next)
+    return;
+
+  /* File position; on an error, give up on the index */
+  ErrCode = AF_NOERR;
+  pos = AFtell (AFp->fp, &ErrCode);
+  if (ErrCode) {
+    AFfreeTxIdx (AFp);
+    return;
+  }
+
+  if (AFp->TxIdx.N >= AFp->TxIdx.Nmax) {
+    AFp->TxIdx.Nmax = 2 * AFp->TxIdx.Nmax;
+    AFp->TxIdx.Offs = (long int *) UTrealloc (AFp->TxIdx.Offs,
+                               (int) (AFp->TxIdx.Nmax * sizeof (long int)));
+  }
+  AFp->TxIdx.Offs[AFp->TxIdx.N] = pos;
+  ++AFp->TxIdx.N;
+  AFp->TxIdx.Next = AFp->TxIdx.N * AFp->TxIdx.Step;
+
+  return;
+}
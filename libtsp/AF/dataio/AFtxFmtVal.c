@@ -0,0 +1,370 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFtxFmtVal (char Str[], double Dv)
+
+Purpose:
+  Format a double value as text, using the fewest digits that round-trip
+
+Description:
+  This routine generates the text representation of a double value. The
+  representation uses the smallest number of significant digits for which
+  decoding the text gives back exactly the same double value. The layout is
+  that of printf with a "%.17g" format (fixed notation for decimal exponents
+  from -4 to 16, exponential notation otherwise), with trailing zeros removed.
+  For instance, 0.5 is formatted as "0.5", 32767 as "32767" and 1/32768 as
+  "3.0517578125e-05".
+
+  The number of digits is found with a binary search over candidates with 1
+  to 17 significant digits (a value that can be represented with p digits can
+  also be represented with more digits). Most candidates are checked by
+  hand-coded conversion. For a candidate with D as the integer formed from
+  the digits and 10^s as the scaling, the value D / 10^s is computed exactly
+  rounded (D and 10^s are exact doubles when D is less than 2^53 and 10^s is
+  at most 10^22). The candidate is accepted only if this gives back the
+  original value. Candidates with D of 2^53 or more (16 or 17 digits) are
+  formed from the exact product of the value and 10^s, computed as the sum of
+  two doubles. The candidate is accepted if it lies within half the spacing
+  between the value and its neighbour. This check needs double operations
+  without extra precision (FLT_EVAL_METHOD of zero). Other candidates (values
+  of 10^16 or more or less than about 10^-6 with 16 or 17 digits, values
+  with extreme exponents) are formatted with sprintf and checked by decoding
+  the text with strtod. Infinities and NaN's are formatted with sprintf.
+
+Parameters:
+  <-  int AFtxFmtVal
+      Number of characters in the string (not including the terminating null)
+  <-  char Str[]
+      Output string. This string should have room for AF_TXFMT_MAXLEN
+      characters plus a terminating null.
+   -> double Dv
+      Value to be formatted
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.3 $  $Date: 2020/12/26 11:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_SECURE_NO_WARNINGS     /* Allow sprintf */
+#endif
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>   /* atoi, strtod */
+#include <string.h>
+
+#include <AFpar.h>
+#include <libtsp/AFdataio.h>
+
+#define TWO53   9007199254740992.   /* 2^53, doubles are exact integers */
+#define NDIG    17                  /* Digits for an exact representation */
+#define NDIGS   15                  /* Digits with D below 2^53 */
+#define SPLIT   134217729.          /* 2^27 + 1, splits a double into halves */
+
+/* Double operations are carried out without extra precision */
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0)
+#  define EXACT_FP  1
+#else
+#  define EXACT_FP  0
+#endif
+
+/* Powers of 10 that are exactly representable as doubles */
+static const double AF_P10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+#define NP10  ((int) (sizeof AF_P10 / sizeof AF_P10[0]))
+
+static int
+AF_cand (double a, int X, int p, double *D, int *n, int *s);
+#if (EXACT_FP)
+static int
+AF_candX (double a, int s, double *D, int *n);
+static void
+AF_twoProd (double a, double b, double *p, double *e);
+#endif
+static int
+AF_candLib (double a, int p, char Str[]);
+
+
+int
+AFtxFmtVal (char Str[], double Dv)
+
+{
+  int Neg, X, Xexact, p, lo, hi, n, np, s, sp, nd, i, k, Lib, status;
+  char Dig[NDIG+1];
+  char Ebuf[AF_TXFMT_MAXLEN+1], Tbuf[AF_TXFMT_MAXLEN+1];
+  unsigned long int Dl, Dh;
+  double a, D, Dp, q, r;
+
+  if (Dv != Dv || Dv > DBL_MAX || Dv < -DBL_MAX)
+    return sprintf (Str, "%g", Dv);   /* NaN or infinity */
+
+  k = 0;
+  Neg = (Dv < 0.0 || (Dv == 0.0 && 1.0 / Dv < 0.0));
+  if (Neg)
+    Str[k++] = '-';
+  if (Dv == 0.0) {
+    Str[k++] = '0';
+    Str[k] = '\0';
+    return k;
+  }
+
+/* Search for the fewest digits that give back the value
+   - X is the decimal exponent (hand-coded checks are used only if X is
+     determined exactly)
+   - A value that can be represented with p digits can also be represented
+     with more digits, so a binary search is used. The search interval is
+     [lo, hi], with hi = NDIG+1 indicating that no candidate has been found.
+     The search is first confined to candidates with up to NDIGS digits.
+     Only if none of these gives back the value are NDIGS+1 and then NDIG
+     digits tried. Candidates with NDIG digits always give back the value.
+   - Candidates that cannot be checked by hand are checked with sprintf and
+     strtod. Lib indicates that the accepted candidate is in Ebuf.
+*/
+  a = fabs (Dv);
+  Xexact = 1;
+  if (a >= 1.0 && a < AF_P10[NP10-1]) {
+    for (X = 0; a >= AF_P10[X+1]; ++X)
+      ;
+  }
+  else if (a < 1.0 && a * AF_P10[NP10-1] >= 1.0) {
+    for (X = -1; a * AF_P10[-X] < 1.0; --X)
+      ;
+  }
+  else {
+    X = 0;
+    Xexact = 0;
+  }
+  D = 0.0;
+  n = 0;
+  s = 0;
+  Dp = -1.0;
+  np = 0;
+  sp = 0;
+  Lib = 0;
+  lo = 1;
+  hi = NDIG + 1;
+  while (lo < hi) {
+    p = (lo <= NDIGS) ? (lo + MINV (hi, NDIGS + 1)) / 2 : lo;
+    status = (Xexact) ? AF_cand (a, X, p, &Dp, &np, &sp) : -1;
+    if (status < 0)
+      status = AF_candLib (a, p, Tbuf);
+    if (status > 0) {
+      hi = p;
+      Lib = (Xexact == 0 || Dp < 0.0);
+      if (Lib)
+        strcpy (Ebuf, Tbuf);
+      D = Dp;
+      n = np;
+      s = sp;
+    }
+    else
+      lo = p + 1;
+  }
+
+/* Digits (in reverse order), trailing zeros removed */
+  nd = 0;
+  if (Lib) {
+    /* Ebuf has the form d.ddde+XX */
+    for (i = 0; Ebuf[i] != 'e'; ++i)
+      ;
+    X = atoi (&Ebuf[i+1]);
+    while (Ebuf[i-1] == '0' || Ebuf[i-1] == '.')
+      --i;
+    while (i > 0) {
+      --i;
+      if (Ebuf[i] != '.')
+        Dig[nd++] = Ebuf[i];
+    }
+  }
+  else {
+    /* D + n (less than about 10^17) is split into two parts, each less than
+       10^8, so that the digits can be generated with integer arithmetic */
+    q = floor (D / 1e8);
+    r = (D - 1e8 * q) + n;
+    if (r < 0.0) {
+      q -= 1.0;
+      r += 1e8;
+    }
+    else if (r >= 1e8) {
+      q += 1.0;
+      r -= 1e8;
+    }
+    Dl = (unsigned long int) r;
+    Dh = (unsigned long int) q;
+    for (i = 0; Dl > 0 || Dh > 0; ++i) {
+      if (i == 8) {
+        Dl = Dh;
+        Dh = 0;
+      }
+      if (nd > 0 || Dl % 10 != 0)
+        Dig[nd++] = (char) ('0' + Dl % 10);
+      else
+        --s;
+      Dl = Dl / 10;
+    }
+    X = nd - 1 - s;   /* Decimal exponent of the first digit */
+  }
+
+/* Layout */
+  if (X < -4 || X >= NDIG) {
+    Str[k++] = Dig[--nd];
+    if (nd > 0)
+      Str[k++] = '.';
+    while (nd > 0)
+      Str[k++] = Dig[--nd];
+    k += sprintf (&Str[k], "e%c%02d", (X < 0) ? '-' : '+', (X < 0) ? -X : X);
+  }
+  else if (X < 0) {
+    Str[k++] = '0';
+    Str[k++] = '.';
+    for (i = X + 1; i < 0; ++i)
+      Str[k++] = '0';
+    while (nd > 0)
+      Str[k++] = Dig[--nd];
+    Str[k] = '\0';
+  }
+  else {
+    for (i = 0; i <= X; ++i)
+      Str[k++] = (nd > 0) ? Dig[--nd] : '0';
+    if (nd > 0)
+      Str[k++] = '.';
+    while (nd > 0)
+      Str[k++] = Dig[--nd];
+    Str[k] = '\0';
+  }
+
+  return k;
+}
+
+/* Form a candidate with p digits, value (D + n) / 10^s. Returns 1 if the
+   candidate gives back the value a, 0 if not, and -1 if the candidate cannot
+   be checked with exact operations (D is then set to -1). */
+
+
+static int
+AF_cand (double a, int X, int p, double *D, int *n, int *s)
+
+{
+  int i;
+  double Dc;
+
+  *s = p - 1 - X;
+  *D = -1.0;
+  *n = 0;
+  if (*s >= NP10 || -*s >= NP10)
+    return -1;
+  Dc = (*s >= 0) ? floor (a * AF_P10[*s] + 0.5) : floor (a / AF_P10[-*s] + 0.5);
+  if (Dc >= TWO53) {
+#if (EXACT_FP)
+    if (*s >= 0)
+      return AF_candX (a, *s, D, n);
+#endif
+    return -1;
+  }
+  if (Dc < 1.0)
+    return 0;
+  *D = Dc;
+
+  /* D / 10^s is exactly rounded since D and 10^s are exact. With 15 or more
+     digits, the rounding error in forming D can be comparable to one unit,
+     and the neighbouring values are also checked. */
+  for (i = 0; i < ((p >= 15) ? 3 : 1); ++i) {
+    Dc = *D + ((i == 0) ? 0.0 : ((i == 1) ? -1.0 : 1.0));
+    if (((*s >= 0) ? Dc / AF_P10[*s] : Dc * AF_P10[-*s]) == a) {
+      *D = Dc;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+#if (EXACT_FP)
+
+/* Form a candidate with 16 or 17 digits (D + n >= 2^53), value
+   (D + n) / 10^s, 0 <= s <= 22. The product a * 10^s is formed exactly as
+   y1 + y2. With y1 >= 2^53, y1 is an integer and the nearest integer to
+   a * 10^s is y1 + n, with n the nearest integer to y2. The difference
+   f = a * 10^s - (D + n) is exact. The candidate gives back the value a if
+   f / 10^s is no more than half the spacing between a and its neighbour in
+   the direction of the candidate. If a is a power of 2, the spacing below a
+   is half of that above, and the candidate above a is tried as well.
+   Returns 1 if the candidate gives back the value a and 0 if not. */
+
+
+static int
+AF_candX (double a, int s, double *D, int *n)
+
+{
+  int e, Even, status;
+  double P, y1, y2, m, f, Hu, Hl;
+
+  P = AF_P10[s];
+  AF_twoProd (a, P, &y1, &y2);
+
+  /* y1 is even, ties go to an even D + n */
+  m = floor (y2);
+  f = y2 - m;
+  if (f > 0.5 || (f == 0.5 && fmod (m, 2.) != 0.)) {
+    m += 1.0;
+    f -= 1.0;
+  }
+  *D = y1;
+  *n = (int) m;
+
+  /* Half spacings above and below a, scaled by 10^s */
+  Even = (fmod (ldexp (frexp (a, &e), 53), 2.) == 0.);
+  Hu = ldexp (P, e - 54);
+  Hl = (a == ldexp (0.5, e)) ? 0.5 * Hu : Hu;
+
+  if (f >= 0.0)
+    status = (f < Hl || (f == Hl && Even));
+  else
+    status = (-f < Hu || (-f == Hu && Even));
+  if (status == 0 && f > 0.0 && Hl < Hu) {
+    f -= 1.0;
+    status = (-f < Hu || (-f == Hu && Even));
+    if (status)
+      ++(*n);
+  }
+
+  return status;
+}
+
+/* Product of a and b as p + e exactly (Dekker's algorithm) */
+
+
+static void
+AF_twoProd (double a, double b, double *p, double *e)
+
+{
+  double t, ah, al, bh, bl;
+
+  t = SPLIT * a;
+  ah = t - (t - a);
+  al = a - ah;
+  t = SPLIT * b;
+  bh = t - (t - b);
+  bl = b - bh;
+  *p = a * b;
+  *e = ((ah * bh - *p) + ah * bl + al * bh) + al * bl;
+}
+#endif
+
+/* Format a candidate with p digits using sprintf (exponential notation).
+   Returns a non-zero value if decoding the text gives back the value a. */
+
+
+static int
+AF_candLib (double a, int p, char Str[])
+
+{
+  sprintf (Str, "%.*e", p - 1, a);
+
+  return (strtod (Str, NULL) == a);
+}
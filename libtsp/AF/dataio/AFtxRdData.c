@@ -0,0 +1,377 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFtxRdData (AFILE *AFp, long int Is, double Dbuff[], int Nreq,
+                  enum AF_ERR_T *ErrCode)
+
+Purpose:
+  Decode values from a text data file
+
+Description:
+  This routine decodes text data values from an audio file. The values are
+  separated by white space. Each value is isolated as a token and converted to
+  a double value. A hand-coded decoder handles numbers with up to 18
+  significant digits and decimal exponents from -22 to 22. Numbers with up to
+  15 or so digits are decoded with a single multiply or divide. Longer
+  numbers, such as the 17-digit values needed for arbitrary doubles, are
+  decoded with extra precision arithmetic. The result is the correctly
+  rounded value. Other numbers (more than 18 digits, large exponents, long
+  numbers that lie very close to the midpoint between two double values,
+  hexadecimal values, infinities and NaN's) are converted by strtod. The
+  results are the same as for fscanf with a "%lg" format.
+
+  The file is locked once for the whole request and characters are taken
+  directly from the stdio buffer. The file position stays in step with the
+  decoded values, so that checkpoints for the sample position index can be
+  recorded as the values are decoded (see AFsetTxIdx).
+
+  If statistics reporting is enabled, the number of bytes read is determined
+  from the file position (for seekable files) and the request is counted as a
+  single read call.
+
+  This routine reads values until (i) Nreq values have been decoded, or (ii)
+  end-of-file is reached, or (iii) an error is encountered. A read error gives
+  the error code AF_IOERR. Text that cannot be decoded as a number gives the
+  error code AF_DECERR.
+
+  If the input file contains values larger in magnitude than a double can
+  represent, the decoded values are set to HUGE_VAL with the appropriate sign.
+  If the input file contains values smaller in magnitude than a double can
+  represent, the decoded values are set to zero.
+
+Parameters:
+  <-  int AFtxRdData
+      Number of data values decoded. On reaching the end of the file, this
+      value may be less than Nreq.
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnRead
+   -> long int Is
+      Sample number of the first value to be decoded (used for the index
+      checkpoints)
+  <-  double Dbuff[]
+      Array of doubles to receive the values. If Dbuff is NULL, the values are
+      decoded but not stored (skip values).
+   -> int Nreq
+      Number of values requested. Nreq may be zero.
+  <-  enum AF_ERR_T *ErrCode
+      Error code, set to AF_NOERR, AF_IOERR or AF_DECERR
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.3 $  $Date: 2020/12/26 11:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>   /* strtod */
+
+#include <libtsp/sysOS.h>
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/AFdataio.h>
+
+/* Unlocked character input within a locked section */
+#if (SY_POSIX)
+#  define LOCKFILE(fp)    flockfile (fp)
+#  define UNLOCKFILE(fp)  funlockfile (fp)
+#  define GETC(fp)        getc_unlocked (fp)
+#elif (defined(_MSC_VER))
+#  define LOCKFILE(fp)    _lock_file (fp)
+#  define UNLOCKFILE(fp)  _unlock_file (fp)
+#  define GETC(fp)        _getc_nolock (fp)
+#else
+#  define LOCKFILE(fp)
+#  define UNLOCKFILE(fp)
+#  define GETC(fp)        getc (fp)
+#endif
+
+#define NTOKEN  512           /* Maximum token length */
+#define TWO53   9007199254740992.   /* 2^53, doubles are exact integers */
+#define NDMAX   18            /* Maximum digits for AF_decodeX */
+#define SPLIT   134217729.    /* 2^27 + 1, splits a double into halves */
+#define DSCALE  1.00000095367431640625    /* 1 + 2^-20 */
+
+/* Double operations are carried out without extra precision */
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0)
+#  define EXACT_FP  1
+#else
+#  define EXACT_FP  0
+#endif
+
+/* Characters that can appear in a number, including hexadecimal numbers,
+   infinities and NaN's */
+#define NUMCHAR(c)  (isalnum (c) || (c) == '+' || (c) == '-' || (c) == '.' \
+                     || (c) == '(' || (c) == ')' || (c) == '_')
+
+/* Powers of 10 that are exactly representable as doubles */
+static const double AF_P10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+#define NP10  ((int) (sizeof AF_P10 / sizeof AF_P10[0]))
+
+static int
+AF_getToken (FILE *fp, char Token[]);
+static int
+AF_decode (const char Token[], double *Dv);
+static int
+AF_decodeX (const char Dig[], int Ns, int k, double *Dv);
+#if (EXACT_FP)
+static void
+AF_twoProd (double a, double b, double *p, double *e);
+#endif
+
+
+int
+AFtxRdData (AFILE *AFp, long int Is, double Dbuff[], int Nreq,
+            enum AF_ERR_T *ErrCode)
+
+{
+  int n, nc;
+  char Token[NTOKEN+1];
+  char *p;
+  long int Pos;
+  double Dv;
+
+  *ErrCode = AF_NOERR;
+  Pos = -1L;
+  if (AFp->Stats.Report)
+    Pos = ftell (AFp->fp);
+
+  LOCKFILE (AFp->fp);
+  for (n = 0; n < Nreq; ++n) {
+    if (Is + n == AFp->TxIdx.Next)
+      AFtxMark (AFp, Is + n);     /* Index checkpoint */
+
+    nc = AF_getToken (AFp->fp, Token);
+    if (nc < 0) {
+      if (ferror (AFp->fp))
+        *ErrCode = AF_IOERR;
+      else if (nc < EOF)
+        *ErrCode = AF_DECERR;     /* Token too long */
+      break;                      /* End-of-file */
+    }
+
+    /* Decode, fast path first */
+    if (! AF_decode (Token, &Dv)) {
+      Dv = strtod (Token, &p);
+      if (nc == 0 || *p != '\0') {
+        *ErrCode = ferror (AFp->fp) ? AF_IOERR : AF_DECERR;
+        break;
+      }
+    }
+    if (Dbuff != NULL)
+      Dbuff[n] = Dv;
+  }
+  UNLOCKFILE (AFp->fp);
+
+  ++AFp->Stats.Ncall;
+  if (Pos >= 0L) {
+    Pos = ftell (AFp->fp) - Pos;
+    if (Pos > 0L)
+      AFp->Stats.Nbyte += Pos;
+  }
+
+  return n;
+}
+
+/* Isolate the next token: skip white space, then gather the characters that
+   can form a number. The character that ends the token is put back. Returns
+   the number of characters in the token (zero if the next character cannot
+   start a number), EOF at end-of-file or on a read error, or EOF-1 if the
+   token is too long.
+*/
+
+
+static int
+AF_getToken (FILE *fp, char Token[])
+
+{
+  int c, nc;
+
+  do {
+    c = GETC (fp);
+  } while (c != EOF && isspace (c));
+  if (c == EOF)
+    return EOF;
+
+  for (nc = 0; c != EOF && NUMCHAR (c); ++nc) {
+    if (nc >= NTOKEN)
+      return EOF-1;
+    Token[nc] = (char) c;
+    c = GETC (fp);
+  }
+  Token[nc] = '\0';
+  if (c != EOF)
+    ungetc (c, fp);
+
+  return nc;
+}
+
+/*
+  Fast decoding of a decimal number. The value is m * 10^k, where the digits
+  of the mantissa form the integer m. If m is exactly representable (m < 2^53)
+  and 10^k is exactly representable (|k| <= 22), a single multiplication or
+  division gives the correctly rounded result. Returns zero if the token is not
+  handled, in which case strtod is used. Longer mantissas are decoded by
+  AF_decodeX.
+*/
+
+
+static int
+AF_decode (const char Token[], double *Dv)
+
+{
+  const char *p;
+  int Neg, Nd, Ns, k, e, Neg_e;
+  char Dig[NDMAX];
+  double m;
+
+  p = Token;
+  Neg = (*p == '-');
+  if (*p == '+' || *p == '-')
+    ++p;
+
+  /* Mantissa
+     - m is exact while it is below 2^53
+     - The Ns significant digits (leading zeros removed) are saved in Dig
+  */
+  m = 0.0;
+  Nd = 0;
+  Ns = 0;
+  k = 0;
+  for (; *p >= '0' && *p <= '9'; ++p, ++Nd) {
+    if (Ns > 0 || *p != '0') {
+      if (Ns >= NDMAX)
+        return 0;
+      Dig[Ns++] = *p;
+    }
+    m = 10. * m + (*p - '0');
+  }
+  if (*p == '.') {
+    for (++p; *p >= '0' && *p <= '9'; ++p, ++Nd) {
+      if (Ns > 0 || *p != '0') {
+        if (Ns >= NDMAX)
+          return 0;
+        Dig[Ns++] = *p;
+      }
+      m = 10. * m + (*p - '0');
+      --k;
+    }
+  }
+  if (Nd == 0)
+    return 0;
+
+  /* Exponent */
+  if (*p == 'e' || *p == 'E') {
+    ++p;
+    Neg_e = (*p == '-');
+    if (*p == '+' || *p == '-')
+      ++p;
+    if (! (*p >= '0' && *p <= '9'))
+      return 0;
+    for (e = 0; *p >= '0' && *p <= '9' && e < 10000; ++p)
+      e = 10 * e + (*p - '0');
+    k += Neg_e ? -e : e;
+  }
+  if (*p != '\0')
+    return 0;
+
+  /* Scaling */
+  if (m == 0.0)
+    ;
+  else if (k <= -NP10 || k >= NP10)
+    return 0;
+  else if (m < TWO53)
+    m = (k >= 0) ? m * AF_P10[k] : m / AF_P10[-k];
+  else if (! AF_decodeX (Dig, Ns, k, &m))
+    return 0;
+
+  *Dv = Neg ? -m : m;
+  return 1;
+}
+
+/*
+  Decoding of long mantissas. The Ns digits in Dig (up to NDMAX digits, which
+  covers the 17 digits needed to represent any double value) form the integer
+  m, with m >= 2^53. The value is m * 10^k with |k| <= 22. m is split as
+  hi + lo (both exact doubles). The product or quotient with 10^|k| is formed
+  as q1 + c, where q1 is the rounded result and c is the rounding error. The
+  error in q1 + c is many orders of magnitude below the spacing of double
+  values. The rounded sum z of q1 and c is the correctly rounded value unless
+  q1 + c lies very close to the midpoint between z and one of its neighbours.
+  Such numbers (for instance decimal numbers that are exact midpoints) are
+  left to strtod (return value zero). The hand-coded computation needs double
+  operations without extra precision (FLT_EVAL_METHOD of zero). Otherwise,
+  all long mantissas are left to strtod.
+*/
+
+
+static int
+AF_decodeX (const char Dig[], int Ns, int k, double *Dv)
+
+{
+#if (EXACT_FP)
+  int i;
+  double mh, ml, hi, lo, P, q1, c, r, p1, p2, z, d;
+
+  /* m = mh * 10^8 + ml = hi + lo */
+  mh = 0.0;
+  for (i = 0; i < Ns - 8; ++i)
+    mh = 10. * mh + (Dig[i] - '0');
+  ml = 0.0;
+  for (; i < Ns; ++i)
+    ml = 10. * ml + (Dig[i] - '0');
+  mh = 1e8 * mh;
+  hi = mh + ml;
+  lo = ml - (hi - mh);
+
+  /* q1 + c is the value */
+  P = AF_P10[(k >= 0) ? k : -k];
+  if (k >= 0) {
+    AF_twoProd (hi, P, &q1, &p2);
+    c = p2 + lo * P;
+  }
+  else {
+    q1 = hi / P;
+    AF_twoProd (q1, P, &p1, &p2);
+    r = ((hi - p1) - p2) + lo;
+    c = r / P;
+  }
+
+  /* Rounded sum z, with z + d = q1 + c exactly. If z + d is very close to a
+     midpoint, a slightly larger d rounds away from z. */
+  z = q1 + c;
+  d = c - (z - q1);
+  if (z + DSCALE * d != z)
+    return 0;
+
+  *Dv = z;
+  return 1;
+#else
+  return 0;
+#endif
+}
+#if (EXACT_FP)
+
+/* Product of a and b as p + e exactly (Dekker's algorithm) */
+
+
+static void
+AF_twoProd (double a, double b, double *p, double *e)
+
+{
+  double t, ah, al, bh, bl;
+
+  t = SPLIT * a;
+  ah = t - (t - a);
+  al = a - ah;
+  t = SPLIT * b;
+  bh = t - (t - b);
+  bl = b - bh;
+  *p = a * b;
+  *e = ((ah * bh - *p) + ah * bl + al * bh) + al * bl;
+}
+#endif
@@ -0,0 +1,65 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFwrBuf (AFILE *AFp, const void *Buf, int Lw, int N)
+
+Purpose:
+  Write a block of data values to an audio file
+
+Description:
+  This routine is used by the data conversion routines to write N data values
+  (Lw bytes each) to an audio file. The values are in file byte order. If
+  background I/O has been set up (see AFsetAIO), the values are queued to be
+  written by the background thread. The data transfer statistics for the file
+  are updated. The time spent in the write is measured if statistics
+  reporting is enabled.
+
+Parameters:
+  <-  int AFwrBuf
+      Number of data values written. If this value is less than N, an error
+      has occurred.
+  <-> AFILE *AFp
+      Audio file pointer for an audio file opened by AFopnWrite
+   -> const void *Buf
+      Buffer with the data values (N*Lw bytes)
+   -> int Lw
+      Size of each data value in bytes
+   -> int N
+      Number of data values to be written
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/22 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/AFdataio.h>
+
+
+int
+AFwrBuf (AFILE *AFp, const void *Buf, int Lw, int N)
+
+{
+  int Nw;
+  double T;
+
+  T = 0.0;
+  if (AFp->Stats.Report)
+    T = UTclock ();
+
+  if (AFp->AIO != NULL)
+    Nw = AFaioWrite (AFp, Buf, Lw, N);    /* Background writes */
+  else {
+    Nw = (int) fwrite ((const char *) Buf, (size_t) Lw, (size_t) N, AFp->fp);
+    ++AFp->Stats.Ncall;
+  }
+
+  AFp->Stats.Nbyte += (long int) Nw * Lw;
+  if (AFp->Stats.Report)
+    AFp->Stats.Tio += UTclock () - T;
+
+  return Nw;
+}
@@ -12,7 +12,8 @@ Description:
   the header of the file to identify the type of file. This check consists of
   looking for a file magic value in a known location in the header of the file.
   The file must be positioned at the start of file. The file position is
-  restored to the start of file.
+  restored to the start of file. If header reads are being buffered (see
+  AFsetHeadBuf), the header bytes are taken from the buffer.
 
   The routine AFsetNHpar can be used to control the behaviour of this routine
   for audio files which do not have a header (raw audio files) or audio files
@@ -47,7 +48,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.102 $  $Date: 2020/11/25 17:54:49 $
+  $Revision: 1.104 $  $Date: 2020/12/21 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -96,6 +97,12 @@ static const struct AF_magic MagicS[] = {
   MAGIC_S(FT_AU, 24, 0L, ".snd"),
   /* WAVE file */
   MAGIC_D(FT_WAVE, 44, 0L, "RIFF", 8L, "WAVE"),
+  /* WAVE file with 64-bit sizes (RF64, BW64, Wave64) */
+  MAGIC_D(FT_WAVE, 80, 0L, "RF64", 8L, "WAVE"),
+  MAGIC_D(FT_WAVE, 80, 0L, "BW64", 8L, "WAVE"),
+  MAGIC_D(FT_WAVE, 104, 0L,
+          "riff\056\221\317\021\245\326\050\333\004\301\000\000", 24L,
+          "wave\363\254\323\021\214\321\000\300\117\216\333\212"),
   /* AIFF sound file */
   MAGIC_D(FT_AIFF, 54, 0L, "FORM", 8L, "AIFF"),
   /* AIFF-C sound file */
@@ -145,58 +152,56 @@ static const struct AF_magic MagicS[] = {
   MAGIC_S(FT_TXAUD, 6, 0L, "%//\r\n"),
 
 /* ===== Unsupported audio file formats */
-  /* RF64/WAVE file */
-  MAGIC_D(FTU_CODE(0), 104, 0L, "RF64", 8L, "WAVE"),
   /* RIFX/WAVE file */
-  MAGIC_D(FTU_CODE(1), 44, 0L, "RIFX", 8L, "WAVE"),
+  MAGIC_D(FTU_CODE(0), 44, 0L, "RIFX", 8L, "WAVE"),
   /* Comdisco SPW (version 2.8.2 format) */
-  MAGIC_S(FTU_CODE(2), 90, 0L, "\n$\n"),
+  MAGIC_S(FTU_CODE(1), 90, 0L, "\n$\n"),
   /* Sound Blaster VOC file */
-  MAGIC_S(FTU_CODE(3), 26, 0L, "Creative Voice File\032\032"),
+  MAGIC_S(FTU_CODE(2), 26, 0L, "Creative Voice File\032\032"),
   /* Amiga SVX file */
-  MAGIC_D(FTU_CODE(4), 20, 0L, "FORM", 8L, "8SVX"),
+  MAGIC_D(FTU_CODE(3), 20, 0L, "FORM", 8L, "8SVX"),
   /* Amiga maud file */
-  MAGIC_D(FTU_CODE(5), 40, 0L, "FORM", 8L, "MAUD"),
+  MAGIC_D(FTU_CODE(4), 40, 0L, "FORM", 8L, "MAUD"),
   /* sndtool file */
-  MAGIC_S(FTU_CODE(6), 96, 0L, "SOUND\032"),
+  MAGIC_S(FTU_CODE(5), 96, 0L, "SOUND\032"),
   /* Psion alaw */
-  MAGIC_S(FTU_CODE(7), 32, 0L, "ALawSoundFile**"),
+  MAGIC_S(FTU_CODE(6), 32, 0L, "ALawSoundFile**"),
   /* SampleVision file */
-  MAGIC_S(FTU_CODE(8), 112, 0L, "SOUND SAMPLE DATA 2.1"),
+  MAGIC_S(FTU_CODE(7), 112, 0L, "SOUND SAMPLE DATA 2.1"),
   /* Audio Visual Research file */
-  MAGIC_S(FTU_CODE(9), 128, 0L, "2BIT"),
+  MAGIC_S(FTU_CODE(8), 128, 0L, "2BIT"),
   /* Entropic Esignal file */
-  MAGIC_S(FTU_CODE(10), 48, 0L, "Esignal\n"),
+  MAGIC_S(FTU_CODE(9), 48, 0L, "Esignal\n"),
   /* Macintosh HCOM file */
-  MAGIC_D(FTU_CODE(11), 128, 65L, "FSSD", 128L, "HCOM"),
+  MAGIC_D(FTU_CODE(10), 128, 65L, "FSSD", 128L, "HCOM"),
   /* Gravis Ultrasound Patch file */
-  MAGIC_S(FTU_CODE(12), 240, 0L, "GF1PATCH"),
+  MAGIC_S(FTU_CODE(11), 240, 0L, "GF1PATCH"),
   /* Gold sample file */
-  MAGIC_S(FTU_CODE(13), 10, 0L, "GOLD SAMPLE"),
+  MAGIC_S(FTU_CODE(12), 10, 0L, "GOLD SAMPLE"),
   /* SRFS file */
-  MAGIC_S(FTU_CODE(14), 4, 0L, "SRFS"),
+  MAGIC_S(FTU_CODE(13), 4, 0L, "SRFS"),
   /* SoundFont 2.0 file */
-  MAGIC_D(FTU_CODE(15), 18, 0L, "RIFF", 8L, "sfbk"),
+  MAGIC_D(FTU_CODE(14), 18, 0L, "RIFF", 8L, "sfbk"),
   /* DiamondWare Digitized */
-  MAGIC_S(FTU_CODE(16), 56, 0L, "DiamondWare Digitized\n\0\032"),
+  MAGIC_S(FTU_CODE(15), 56, 0L, "DiamondWare Digitized\n\0\032"),
   /* MIDI file  */
-  MAGIC_S(FTU_CODE(17), 4, 0L, "MThd"),
+  MAGIC_S(FTU_CODE(16), 4, 0L, "MThd"),
   /* RealAudio file  */
-  MAGIC_S(FTU_CODE(18), 4, 0L, ".ra\375"),
+  MAGIC_S(FTU_CODE(17), 4, 0L, ".ra\375"),
   /* MP3 files, *** duplicate codes *** */
-  MAGIC_S(FTU_CODE(19), 2, 0L, "\377\373"),
-  MAGIC_S(FTU_CODE(19), 2, 0L, "\377\372"),
+  MAGIC_S(FTU_CODE(18), 2, 0L, "\377\373"),
+  MAGIC_S(FTU_CODE(18), 2, 0L, "\377\372"),
   /* Nyvalla DSP StdHead files *** duplicate codes *** */
-  MAGIC_S(FTU_CODE(20), 1024, 0L, "file=samp\r\n"),
-  MAGIC_S(FTU_CODE(20), 1024, 0L, "data=int16\r\nfile=samp\r\n"),
+  MAGIC_S(FTU_CODE(19), 1024, 0L, "file=samp\r\n"),
+  MAGIC_S(FTU_CODE(19), 1024, 0L, "data=int16\r\nfile=samp\r\n"),
   /* ILS Sampled Data files */
-  MAGIC_S(FTU_CODE(21), 512, 124, "\0\203\225\175"),
+  MAGIC_S(FTU_CODE(20), 512, 124, "\0\203\225\175"),
   /* Littmann E4000 Digital Stethoscope files */
-  MAGIC_S(FTU_CODE(22), 51, 22, "E4000 digital stethoscope"),
+  MAGIC_S(FTU_CODE(21), 51, 22, "E4000 digital stethoscope"),
   /* FLAC file */
-  MAGIC_S(FTU_CODE(23), 4, 0L, "fLaC"),
+  MAGIC_S(FTU_CODE(22), 4, 0L, "fLaC"),
   /* OGG file */
-  MAGIC_S(FTU_CODE(24), 4, 0L, "OggS")
+  MAGIC_S(FTU_CODE(23), 4, 0L, "OggS")
 };
 
 /* The file signature tables are a bit messy to maintain
@@ -225,7 +230,6 @@ static const struct AF_magic MagicS[] = {
 
 /* Descriptions of unsupported audio file formats */
 static const char *FTU_desc[] = {
-  "RF64 WAVE file",
   "RIFX WAVE file",
   "Comdisco SPW (version 2.8.2) Signal file",
   "Sound Blaster VOC file",
@@ -256,9 +260,6 @@ static const char *FTU_desc[] = {
 /* LHEADBUF is the number of header bytes to be read */
 #define LHEADBUF  (252 + 2)  /* SPPACK requires the most lookahead */
 
-#define FREAD(buf,size,nv,fp) (int) fread((char *) buf, (size_t) size, \
-                                          (size_t) nv, fp)
-
 /* Local functions */
 static int
 AF_checkMagic(const char Header[], int Nh, const struct AF_magic MagicS[],
@@ -289,13 +290,10 @@ AFfindFtype(FILE *fp)
       return FT_ERROR;
     }
 
-    /* Read in (part of) the header */
-    Nh = FREAD(Header, 1, LHEADBUF, fp);
-    rewind(fp);    /* Rewind the file */
-    if (Nh < LHEADBUF && ferror(fp)) {
-      UTsysMsg("AFfindFtype - %s", AFM_ReadErr);
+    /* Get (part of) the header, the file position is not changed */
+    Nh = AFpeekHead(fp, Header, LHEADBUF);
+    if (Nh < 0)
       return FT_ERROR;
-    }
 
     /* Test for the audio file magic values */
     Ftype = AF_checkMagic(Header, Nh, MagicS, NTEST);
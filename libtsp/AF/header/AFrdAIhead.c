@@ -50,7 +50,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.91 $  $Date: 2020/11/30 02:05:08 $
+  $Revision: 1.92 $  $Date: 2020/12/19 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -69,7 +69,7 @@ Author / revision:
 #define ALIGN   2 /* Chunks are padded out to a multiple of ALIGN */
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFR_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFR_JMPENV;
 
 /* Local functions */
 static int
@@ -243,7 +243,7 @@ AFrdAIhead(FILE *fp)
 
   /* Position at the start of data */
   if (!AtData) {
-    if (AFseek(fp, Dstart, NULL))
+    if (AFseekHead(fp, Dstart))
       return NULL;
   }
 
@@ -51,7 +51,7 @@ Author / revision:
 #include <libtsp/AUpar.h>
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFR_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFR_JMPENV;
 
 AF_READ_DEFAULT(AFr_default); /* Define the AF_read defaults */
 
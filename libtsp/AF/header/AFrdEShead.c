@@ -163,7 +163,7 @@ struct ES_genItem {
   VRswapBytes((const void *) &(x), (void *) &(y), sizeof(x), 1)
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFR_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFR_JMPENV;
 
 AF_READ_DEFAULT(AFr_default); /* Define the AF_read defaults */
 
@@ -76,7 +76,7 @@ struct IN_head {
 #define IN_MAXINFO  LHEAD
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFR_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFR_JMPENV;
 
 AF_READ_DEFAULT(AFr_default); /* Define the AF_read defaults */
 
@@ -72,7 +72,7 @@ Author / revision:
 #define NS_MAXABS_UNDEF   (UT_UINT2_MAX)
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFR_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFR_JMPENV;
 
 AF_READ_DEFAULT(AFr_default); /* Define the AF_read defaults */
 
@@ -183,7 +183,7 @@ end_head
 */
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFR_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFR_JMPENV;
 
 /* Local function prototypes */
 static int
@@ -106,7 +106,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.71 $  $Date: 2020/11/26 11:29:47 $
+  $Revision: 1.72 $  $Date: 2020/12/20 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -220,9 +220,13 @@ AF_procTAhead(FILE *fp, struct AF_read *AFr)
   tInfo3.Info = Info3;
   tInfo3.N = 0;
   tInfo3.Nmax = sizeof(Info3);
+  tInfo3.Alloc = 0;
+  tInfo3.Defer = NULL;
   tInfo4.Info = Info4;
   tInfo4.N = 0;
   tInfo4.Nmax = sizeof(Info4);
+  tInfo4.Alloc = 0;
+  tInfo4.Defer = NULL;
 
 /* Check for the file identifier */
   poffs = 0;
@@ -37,6 +37,21 @@ Description:
      +4     4    int    Chunk length
      +8    ...   ...      Audio data
 
+  RF64 (and BW64) files have the same structure as WAVE files, but with
+  "RF64" (or "BW64") in place of "RIFF". The first chunk is a "ds64" chunk with
+  64-bit values for the RIFF chunk size, the data chunk size and the number of
+  samples. These values are used in place of the RIFF and data chunk size
+  fields and the fact chunk sample count when the latter have the value
+  0xFFFFFFFF. The chunk size table in the ds64 chunk is ignored.
+
+  Wave64 files use 16-byte GUID's as chunk identifiers and 8-byte chunk sizes
+  which include the 24-byte chunk preamble. Chunks are padded out to a multiple
+  of 8 bytes. The GUID's for the fmt, fact, data and bext chunks are recognized;
+  other chunks are skipped.
+
+  The chunk sizes are stored as long int values. On systems with a 32-bit long
+  int, a file with a size which does not fit in a long int is rejected.
+
   For WAVE files text information can appear in several different chunks. This
   information is extracted and stored in the audio file parameter structure.
   - "afsp" chunk text is extracted and stored as individual information
@@ -60,6 +75,12 @@ Description:
     - "ISRC" text is stored as a "source:" information record.
     - "ISRF" text is stored as a "source_form:" information record.
     - "ITCH" text is stored as a "technician:" information record.
+  There is no fixed limit on the total size of the information records.
+
+  With the LazyInfo option (see AFoptions), the "DISP", "LIST" and "bext"
+  chunks of a random access file are skipped. Their information records are
+  decoded on first use (see AFdecInfoDefer), with the chunks located using the
+  chunk layout information. This option does not apply to Wave64 files.
 
 Parameters:
   <-  AFILE *AFrdWVhead
@@ -69,7 +90,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.127 $  $Date: 2020/11/26 11:29:47 $
+  $Revision: 1.133 $  $Date: 2020/12/26 11:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -78,6 +99,7 @@ Author / revision:
 #  define _CRT_SECURE_NO_WARNINGS     /* Allow sprintf */
 #endif
 
+#include <limits.h>
 #include <setjmp.h>
 #include <string.h>
 
@@ -94,9 +116,21 @@ Author / revision:
 
 #define WV_FMT_MINSIZE  16
 #define WV_LHMIN  (8 + 4 + 8 + WV_FMT_MINSIZE + 8)
+#define W64_LHMIN (40 + W64_LPREAMB + WV_FMT_MINSIZE + W64_LPREAMB)
+
+/* File forms */
+#define WV_RIFF   1   /* RIFF/WAVE */
+#define WV_RF64   2   /* RF64/WAVE or BW64/WAVE, sizes in a ds64 chunk */
+#define WV_W64    3   /* Wave64, GUID chunk identifiers, 64-bit sizes */
+
+/* File form and file length from the preamble */
+struct WV_form {
+  int Form;
+  long int LRIFF;
+};
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFR_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFR_JMPENV;
 
 AF_READ_DEFAULT(AFr_default); /* Define the AF_read defaults */
 
@@ -107,18 +141,26 @@ AF_addInfoRec(const char Ident[], const char text[], int Size,
 static int
 AF_decFMT(const struct WV_Ckfmt *Ckfmt, struct AF_read *AFr);
 static int
+AF_decInfoChunk(FILE *fp, const struct AF_chunkLim *ChunkLim,
+                struct AF_info *AFInfo);
+static int
 AF_rdbext(FILE *fp, int Size, struct AF_info *RInfo);
 static int
+AF_rdCkHead(FILE *fp, int Form, const struct WV_Ckds64 *Ckds64, char ckID[4],
+            long int *ckSize);
+static int
 AF_rdDISP_text(FILE *fp, int Size, struct AF_info *RInfo);
 static int
-AF_rdFMT(FILE *fp, struct WV_Ckfmt *Ckfmt);
+AF_rdFMT(FILE *fp, long int ckSize, struct WV_Ckfmt *Ckfmt);
 static int
-AF_rdFACT(FILE *fp, struct WV_Ckfact *Ckfact);
+AF_rdFACT(FILE *fp, long int ckSize, struct WV_Ckfact *Ckfact);
 static int
 AF_rdLIST_INFO(FILE *fp, int Size, struct AF_info *RInfo, long int pos,
                struct AF_chunkInfo *ChunkInfo);
-static int
+static struct WV_form
 AF_rdRIFF_WAVE(FILE *fp, struct WV_CkRIFF *CkRIFF);
+static long int
+AF_size64(UT_uint4_t Low, UT_uint4_t High);
 static void
 AF_UnsFormat(int FormatTag);
 static void
@@ -130,12 +172,14 @@ AFrdWVhead(FILE *fp)
 
 {
   AFILE *AFp;
-  int AtData, Ftype, BWF;
-  long int offs, poffs, LRIFF, Fact_Nframe, Dstart, EoD;
-  char Info[AF_MAXINFO];
+  int AtData, Ftype, BWF, Lazy, Form, Align, Lpreamb;
+  long int offs, poffs, LRIFF, Fact_Nframe, Dstart, EoD, ckSize;
   struct WV_CkRIFF CkRIFF;
-  struct WV_Ckpreamb CkHead;
+  struct WV_form WVform;
+  char ckID[4];
   struct AF_read AFr;
+  /* Information records, storage is kept and extended as needed */
+  static SY_THREAD_LOCAL struct AF_info RInfo = {NULL, 0, 0, 1, NULL};
 
 /* Set the long jump environment; on error return a NULL */
   if (setjmp(AFR_JMPENV))
@@ -143,94 +187,132 @@ AFrdWVhead(FILE *fp)
 
 /* Defaults and initial values */
   AFr = AFr_default;
-  AFr.RInfo.Info = Info;
-  AFr.RInfo.N = 0;
-  AFr.RInfo.Nmax = sizeof(Info);
+  RInfo.N = 0;
+  UTthreadFree((void **) &RInfo.Info);  /* Freed when the thread exits */
   BWF = 0;
 
   Fact_Nframe = AF_NFRAME_UNDEF;
 
-/* Check the file magic for a RIFF/WAVE file */
-  if (AF_rdRIFF_WAVE(fp, &CkRIFF))
+/* Check the file magic for a RIFF/WAVE, RF64/WAVE or Wave64 file */
+  WVform = AF_rdRIFF_WAVE(fp, &CkRIFF);
+  Form = WVform.Form;
+  LRIFF = WVform.LRIFF;
+  if (Form == 0)
     return NULL;
-  offs = 12L; /* Positioned after RIFF/WAVE preamble */
-  LRIFF = CkRIFF.ckSize + 8;
-  AFsetChunkLim(ckID_RIFF, 0, LRIFF, &AFr.ChunkInfo);
-  AFsetChunkLim(FM_WAVE, 8, offs, &AFr.ChunkInfo);
+  AFsetChunkLim(CkRIFF.ckID, 0, LRIFF, &AFr.ChunkInfo);
+  if (Form == WV_W64) {
+    offs = 40L; /* Positioned after the riff/wave preamble */
+    AFsetChunkLim(W64_ID_wave, 24, offs, &AFr.ChunkInfo);
+    Align = W64_ALIGN;
+    Lpreamb = W64_LPREAMB;
+  }
+  else {
+    offs = 12L; /* Positioned after RIFF/WAVE preamble */
+    AFsetChunkLim(FM_WAVE, 8, offs, &AFr.ChunkInfo);
+    if (Form == WV_RF64) {
+      AFsetChunkLim(ckID_ds64, offs,
+                    offs + 8 + RNDUPV(CkRIFF.Ckds64.ckSize, ALIGN),
+                    &AFr.ChunkInfo);
+      offs += 8 + RNDUPV(CkRIFF.Ckds64.ckSize, ALIGN);
+    }
+    Align = ALIGN;
+    Lpreamb = 8;
+  }
+  Lazy = (AFopt.LazyInfo && FLseekable(fp) && Form != WV_W64);
 
   Dstart = 0L;
   EoD = 0L;
   AtData = 0;
-  while (offs < LRIFF-8) {  /* Leave 8 bytes for the chunk preamble */
+  while (offs < LRIFF-Lpreamb) {  /* Leave room for the chunk preamble */
 
     poffs = offs;     /* Position at start of chunk */
 
     /* Read the chunk preamble */
-    offs += RHEAD_S(fp, CkHead.ckID);
+    offs += AF_rdCkHead(fp, Form, &CkRIFF.Ckds64, ckID, &ckSize);
 
     /* fmt chunk */
-    if (SAME_CSTR(CkHead.ckID, ckID_fmt)) {
-      offs += AF_rdFMT(fp, &CkRIFF.Ckfmt);
+    if (SAME_CSTR(ckID, ckID_fmt)) {
+      offs += AF_rdFMT(fp, ckSize, &CkRIFF.Ckfmt);
       if (AF_decFMT(&CkRIFF.Ckfmt, &AFr))
         return NULL;
-      AFsetChunkLim(CkHead.ckID, poffs, offs, &AFr.ChunkInfo);
+      AFsetChunkLim(ckID, poffs, offs, &AFr.ChunkInfo);
     }
 
     /* fact chunk */
-    else if (SAME_CSTR(CkHead.ckID, ckID_fact)) {
-      offs += AF_rdFACT(fp, &CkRIFF.Ckfact);
-      Fact_Nframe = CkRIFF.Ckfact.dwSampleLength;
-      AFsetChunkLim(CkHead.ckID, poffs, offs, &AFr.ChunkInfo);
+    else if (SAME_CSTR(ckID, ckID_fact)) {
+      offs += AF_rdFACT(fp, ckSize, &CkRIFF.Ckfact);
+      if (Form == WV_RF64 && CkRIFF.Ckfact.dwSampleLength == WV_SIZE_64)
+        Fact_Nframe = AF_size64(CkRIFF.Ckds64.sampleCountLow,
+                                CkRIFF.Ckds64.sampleCountHigh);
+      else
+        Fact_Nframe = AF_size64(CkRIFF.Ckfact.dwSampleLength, 0);
+      AFsetChunkLim(ckID, poffs, offs, &AFr.ChunkInfo);
     }
 
     /* data chunk */
-    else if (SAME_CSTR(CkHead.ckID, ckID_data)) {
-      offs += RHEAD_V(fp, CkRIFF.Ckdata.ckSize, DS_EL);
-      AFr.NData.Ldata = CkRIFF.Ckdata.ckSize;
+    else if (SAME_CSTR(ckID, ckID_data)) {
+      AFr.NData.Ldata = ckSize;
       Dstart = offs;
-      EoD = RNDUPV(Dstart + AFr.NData.Ldata, ALIGN);
-      AFsetChunkLim(CkHead.ckID, poffs, EoD, &AFr.ChunkInfo);
+      EoD = RNDUPV(Dstart + AFr.NData.Ldata, Align);
+      if (Form == WV_W64 && EoD > LRIFF && Dstart + AFr.NData.Ldata <= LRIFF)
+        EoD = LRIFF;    /* Padding at the end of the file omitted */
+      AFsetChunkLim(ckID, poffs, EoD, &AFr.ChunkInfo);
       if (EoD >= LRIFF || !FLseekable(fp)) {
         AtData = 1;
         break;
       }
       else {
         AtData = 0;
-        offs += RSKIP(fp, EoD - Dstart);
+        if (AFseekHead(fp, EoD))  /* The data can exceed the int range */
+          return NULL;
+        offs = EoD;
       }
     }
 
+    /* Text chunks decoded on first use */
+    else if (Lazy && (SAME_CSTR(ckID, ckID_bext) ||
+                      SAME_CSTR(ckID, ckID_DISP) ||
+                      SAME_CSTR(ckID, ckID_LIST))) {
+      offs += RSKIP(fp, RNDUPV(ckSize, ALIGN));
+      AFsetChunkLim(ckID, poffs, offs, &AFr.ChunkInfo);
+      AFr.InfoDec = AF_decInfoChunk;
+      if (SAME_CSTR(ckID, ckID_bext))
+        BWF = 1;
+    }
+
     /* BWF bext chunk */
-    else if (SAME_CSTR(CkHead.ckID, ckID_bext)) {
-      offs += RHEAD_V(fp, CkHead.ckSize, DS_EL);
-      offs += AF_rdbext(fp, (int) CkHead.ckSize, &AFr.RInfo);
-      AFsetChunkLim(CkHead.ckID, poffs, offs, &AFr.ChunkInfo);
+    else if (SAME_CSTR(ckID, ckID_bext)) {
+      offs += AF_rdbext(fp, (int) ckSize, &RInfo);
+      AFsetChunkLim(ckID, poffs, offs, &AFr.ChunkInfo);
       BWF = 1;
     }
 
     /* Text chunks */
-    else if (SAME_CSTR(CkHead.ckID, ckID_afsp)) {
-      offs += RHEAD_V(fp, CkHead.ckSize, DS_EL);
-      offs += AFrdInfoAFspText(fp, (int) CkHead.ckSize, &AFr.RInfo, ALIGN);
-      AFsetChunkLim(CkHead.ckID, poffs, offs, &AFr.ChunkInfo);
+    else if (SAME_CSTR(ckID, ckID_afsp)) {
+      offs += AFrdInfoAFspText(fp, (int) ckSize, &RInfo, ALIGN);
+      AFsetChunkLim(ckID, poffs, offs, &AFr.ChunkInfo);
     }
-    else if (SAME_CSTR(CkHead.ckID, ckID_DISP)) {
-      offs += RHEAD_V(fp, CkHead.ckSize, DS_EL);
-      offs += AF_rdDISP_text(fp, (int) CkHead.ckSize, &AFr.RInfo);
-      AFsetChunkLim(CkHead.ckID, poffs, offs, &AFr.ChunkInfo);
+    else if (SAME_CSTR(ckID, ckID_DISP)) {
+      offs += AF_rdDISP_text(fp, (int) ckSize, &RInfo);
+      AFsetChunkLim(ckID, poffs, offs, &AFr.ChunkInfo);
     }
-    else if (SAME_CSTR(CkHead.ckID, ckID_LIST)) {
-      offs += RHEAD_V(fp, CkHead.ckSize, DS_EL);
-      AFsetChunkLim(CkHead.ckID, poffs, RNDUPV(offs + CkHead.ckSize, ALIGN),
+    else if (SAME_CSTR(ckID, ckID_LIST)) {
+      AFsetChunkLim(ckID, poffs, RNDUPV(offs + ckSize, ALIGN),
                     &AFr.ChunkInfo);
-      offs += AF_rdLIST_INFO(fp, (int) CkHead.ckSize, &AFr.RInfo, offs,
-                             &AFr.ChunkInfo);
+      offs += AF_rdLIST_INFO(fp, (int) ckSize, &RInfo, offs, &AFr.ChunkInfo);
     }
     /* Miscellaneous chunks */
     else {
-      offs += RHEAD_V(fp, CkHead.ckSize, DS_EL);
-      offs += RSKIP(fp, RNDUPV(CkHead.ckSize, ALIGN));
-      AFsetChunkLim(CkHead.ckID, poffs, offs, &AFr.ChunkInfo);
+      offs += RSKIP(fp, RNDUPV(ckSize, Align));
+      AFsetChunkLim(ckID, poffs, offs, &AFr.ChunkInfo);
+    }
+
+    /* Wave64: skip to the next multiple of 8 bytes (the padding is part of
+       the chunk) */
+    if (Align != ALIGN && RNDUPV(offs, Align) <= LRIFF &&
+        RNDUPV(offs, Align) > offs) {
+      offs += RSKIP(fp, RNDUPV(offs, Align) - offs);
+      AFr.ChunkInfo.ChunkLim[AFr.ChunkInfo.N-1].End = offs - 1;
     }
   }
   /* Error Checks */
@@ -251,7 +333,7 @@ AFrdWVhead(FILE *fp)
 
   /* Position at the start of data */
   if (!AtData) {
-    if (AFseek(fp, Dstart, NULL))
+    if (AFseekHead(fp, Dstart))
       return NULL;
   }
 
@@ -268,73 +350,194 @@ AFrdWVhead(FILE *fp)
     else
       Ftype = FT_WAVE;
   }
+  AFr.RInfo = RInfo;
   AFp = AFsetRead(fp, Ftype, &AFr, AF_FIX_NSAMP_HIGH + AF_FIX_LDATA_HIGH);
 
   return AFp;
 }
-
-/* Check the RIFF/WAVE file preamble */
 
+/* Check the file preamble, return the file form (Form is 0 for an error).
+   For an RF64 file, the ds64 chunk which follows the preamble is also read.
+   LRIFF is set to the size of the file as given by the RIFF chunk size. The
+   values are returned in a structure, since the caller uses setjmp. */
 
-static int
+
+static struct WV_form
 AF_rdRIFF_WAVE(FILE *fp, struct WV_CkRIFF *CkRIFF)
 
 {
-  long int Lfile, LRIFF;
+  int Form, offs;
+  long int Lfile, Lhmin;
+  struct WV_form WVform;
+  UT_uint4_t Size, SizeHigh;
+  char guidx[12];
+  struct WV_Ckds64 *Ckds64;
+
+  WVform.Form = 0;
+  WVform.LRIFF = 0L;
 
   RHEAD_S(fp, CkRIFF->ckID);
-  if (!SAME_CSTR(CkRIFF->ckID, ckID_RIFF)) {
+  if (SAME_CSTR(CkRIFF->ckID, ckID_RIFF))
+    Form = WV_RIFF;
+  else if (SAME_CSTR(CkRIFF->ckID, ckID_RF64) ||
+           SAME_CSTR(CkRIFF->ckID, ckID_BW64))
+    Form = WV_RF64;
+  else if (SAME_CSTR(CkRIFF->ckID, W64_ID_riff)) {
+    RHEAD_S(fp, guidx);
+    if (!SAME_CSTR(guidx, W64_GUIDX_riff)) {
+      UTwarn("AFrdWVhead - %s", AFM_WV_BadId);
+      return WVform;
+    }
+    Form = WV_W64;
+  }
+  else {
     UTwarn("AFrdWVhead - %s", AFM_WV_BadId);
-    return 1;
+    return WVform;
+  }
+
+  /* Wave64: 64-bit size (including the preamble) */
+  if (Form == WV_W64) {
+    RHEAD_V(fp, Size, DS_EL);
+    RHEAD_V(fp, SizeHigh, DS_EL);
+    WVform.LRIFF = AF_size64(Size, SizeHigh);
+    Lhmin = W64_LHMIN;
+    RHEAD_S(fp, CkRIFF->WAVEID);
+    RHEAD_S(fp, guidx);
+    if (!SAME_CSTR(CkRIFF->WAVEID, W64_ID_wave) ||
+        !SAME_CSTR(guidx, W64_GUIDX_wave)) {
+      UTwarn("AFrdWVhead - %s", AFM_WV_BadId);
+      return WVform;
+    }
+  }
+  else {
+    RHEAD_V(fp, CkRIFF->ckSize, DS_EL);
+    if (Form == WV_RIFF || CkRIFF->ckSize != WV_SIZE_64)
+      WVform.LRIFF = AF_size64(CkRIFF->ckSize, 0) + 8;
+    Lhmin = WV_LHMIN;
+    RHEAD_S(fp, CkRIFF->WAVEID);
+    if (!SAME_CSTR(CkRIFF->WAVEID, FM_WAVE)) {
+      UTwarn("AFrdWVhead - %s", AFM_WV_BadId);
+      return WVform;
+    }
   }
 
-  RHEAD_V(fp, CkRIFF->ckSize, DS_EL);
-  LRIFF = CkRIFF->ckSize + 8;
-  if (LRIFF < WV_LHMIN) {
+  /* RF64: The ds64 chunk must be the first chunk */
+  if (Form == WV_RF64) {
+    Ckds64 = &CkRIFF->Ckds64;
+    RHEAD_S(fp, Ckds64->ckID);
+    RHEAD_V(fp, Ckds64->ckSize, DS_EL);
+    if (!SAME_CSTR(Ckds64->ckID, ckID_ds64) || Ckds64->ckSize < WV_DS64_SIZE) {
+      UTwarn("AFrdWVhead - %s", AFM_WV_BadDS64);
+      return WVform;
+    }
+    offs  = RHEAD_V(fp, Ckds64->riffSizeLow, DS_EL);
+    offs += RHEAD_V(fp, Ckds64->riffSizeHigh, DS_EL);
+    offs += RHEAD_V(fp, Ckds64->dataSizeLow, DS_EL);
+    offs += RHEAD_V(fp, Ckds64->dataSizeHigh, DS_EL);
+    offs += RHEAD_V(fp, Ckds64->sampleCountLow, DS_EL);
+    offs += RHEAD_V(fp, Ckds64->sampleCountHigh, DS_EL);
+    offs += RHEAD_V(fp, Ckds64->tableLength, DS_EL);
+    RSKIP(fp, RNDUPV(Ckds64->ckSize, ALIGN) - offs);  /* Skip the table */
+    if (CkRIFF->ckSize == WV_SIZE_64)
+      WVform.LRIFF = AF_size64(Ckds64->riffSizeLow,
+                               Ckds64->riffSizeHigh) + 8;
+  }
+
+  if (WVform.LRIFF < Lhmin) {
     UTwarn("AFrdWVhead - %s", AFM_WV_BadRIFF);
-    return 1;
+    return WVform;
   }
 
   if (FLseekable(fp)) {
     Lfile = FLfileSize(fp);
-    if (LRIFF > Lfile) {
-      CkRIFF->ckSize = Lfile - 8;
+    if (WVform.LRIFF > Lfile) {
+      WVform.LRIFF = Lfile;
       UTwarn("AFrdWVhead - %s", AFM_WV_FixRIFF);
     }
   }
 
-  RHEAD_S(fp, CkRIFF->WAVEID);
-  if (!SAME_CSTR(CkRIFF->WAVEID, FM_WAVE)) {
-    UTwarn("AFrdWVhead - %s", AFM_WV_BadId);
-    return 1;
+  WVform.Form = Form;
+  return WVform;
+}
+
+/* Read a chunk preamble, returning the chunk identifier and the size of the
+   chunk (not including the preamble) */
+
+
+static int
+AF_rdCkHead(FILE *fp, int Form, const struct WV_Ckds64 *Ckds64, char ckID[4],
+            long int *ckSize)
+
+{
+  int offs;
+  UT_uint4_t Size, SizeHigh;
+  char guidx[12];
+
+  offs = RHEAD_SN(fp, ckID, 4);
+
+  /* Wave64: chunks other than the WAVE chunks get a blank identifier */
+  if (Form == WV_W64) {
+    offs += RHEAD_S(fp, guidx);
+    if (!SAME_CSTR(guidx, W64_GUIDX_wave))
+      memset(ckID, '\0', 4);
+    offs += RHEAD_V(fp, Size, DS_EL);
+    offs += RHEAD_V(fp, SizeHigh, DS_EL);
+    *ckSize = AF_size64(Size, SizeHigh) - W64_LPREAMB;
+    if (*ckSize < 0) {
+      UTwarn("AFrdWVhead - %s", AFM_WV_BadHead);
+      longjmp(AFR_JMPENV, 1);
+    }
+  }
+  else {
+    offs += RHEAD_V(fp, Size, DS_EL);
+    if (Form == WV_RF64 && Size == WV_SIZE_64 &&
+        memcmp(ckID, ckID_data, 4) == 0)
+      *ckSize = AF_size64(Ckds64->dataSizeLow, Ckds64->dataSizeHigh);
+    else
+      *ckSize = AF_size64(Size, 0);
   }
 
-  return 0;
+  return offs;
 }
-
-/* Read the fmt chunk, starting at ckSize */
+
+/* Form a size from 32-bit halves, checking that it fits in a long int */
+
+
+static long int
+AF_size64(UT_uint4_t Low, UT_uint4_t High)
+
+{
+  if ((double) High * 4294967296. + (double) Low >= (double) LONG_MAX) {
+    UTwarn("AFrdWVhead - %s", AFM_WV_BigSize);
+    longjmp(AFR_JMPENV, 1);
+  }
+
+  return (((long int) High << 16) << 16) + (long int) Low;
+}
+
+/* Read the fmt chunk, starting after the chunk preamble */
 
 
 static int
-AF_rdFMT(FILE *fp, struct WV_Ckfmt *Ckfmt)
+AF_rdFMT(FILE *fp, long int ckSize, struct WV_Ckfmt *Ckfmt)
 
 {
   int offs, NB;
 
-  offs = RHEAD_V(fp, Ckfmt->ckSize, DS_EL);
-  if (Ckfmt->ckSize < WV_FMT_MINSIZE) {
+  if (ckSize < WV_FMT_MINSIZE || ckSize > INT_MAX / 2) {
     UTwarn("AFrdWVhead - %s", AFM_WV_BadfmtSize);
     longjmp(AFR_JMPENV, 1);
   }
+  Ckfmt->ckSize = (UT_uint4_t) ckSize;
 
-  offs += RHEAD_V(fp, Ckfmt->wFormatTag, DS_EL);
+  offs  = RHEAD_V(fp, Ckfmt->wFormatTag, DS_EL);
   offs += RHEAD_V(fp, Ckfmt->nChannels, DS_EL);
   offs += RHEAD_V(fp, Ckfmt->nSamplesPerSec, DS_EL);
   offs += RHEAD_V(fp, Ckfmt->nAvgBytesPerSec, DS_EL);
   offs += RHEAD_V(fp, Ckfmt->nBlockAlign, DS_EL);
   offs += RHEAD_V(fp, Ckfmt->wBitsPerSample, DS_EL);
 
-  NB = ((int) Ckfmt->ckSize + 4) - offs;
+  NB = (int) Ckfmt->ckSize - offs;
   if (NB >= 24) {
     offs += RHEAD_V(fp, Ckfmt->cbSize, DS_EL);
     if (Ckfmt->cbSize >= 22) {
@@ -348,7 +551,7 @@ AF_rdFMT(FILE *fp, struct WV_Ckfmt *Ckfmt)
   }
 
   /* Skip over any extra data at the end of the fmt chunk */
-  offs += RSKIP(fp, RNDUPV(Ckfmt->ckSize + 4, ALIGN) - offs);
+  offs += RSKIP(fp, RNDUPV(Ckfmt->ckSize, ALIGN) - offs);
 
   return offs;
 }
@@ -500,22 +703,22 @@ AF_decFMT(const struct WV_Ckfmt *Ckfmt, struct AF_read *AFr)
   return 0;
 }
 
-/* Read the fact chunk */
+/* Read the fact chunk, starting after the chunk preamble */
 
 
 static int
-AF_rdFACT(FILE *fp, struct WV_Ckfact *Ckfact)
+AF_rdFACT(FILE *fp, long int ckSize, struct WV_Ckfact *Ckfact)
 
 {
   int offs;
 
-  offs = RHEAD_V(fp, Ckfact->ckSize, DS_EL);
-  if (Ckfact->ckSize < 4) {
+  if (ckSize < 4 || ckSize > INT_MAX / 2) {
     UTwarn("AFrdWVhead - %s", AFM_WV_BadFACT);
     longjmp(AFR_JMPENV, 1);
   }
-  offs += RHEAD_V(fp, Ckfact->dwSampleLength, DS_EL);
-  offs += RSKIP(fp, RNDUPV(Ckfact->ckSize + 4, ALIGN) - offs);
+  Ckfact->ckSize = (UT_uint4_t) ckSize;
+  offs  = RHEAD_V(fp, Ckfact->dwSampleLength, DS_EL);
+  offs += RSKIP(fp, RNDUPV(Ckfact->ckSize, ALIGN) - offs);
 
   return offs;
 }
@@ -677,7 +880,8 @@ AF_rdDISP_text(FILE *fp, int Size, struct AF_info *RInfo)
   return offs;
 }
 
-/* Read the LIST-INFO records from the header */
+/* Read the LIST-INFO records from the header (the limits of the sub-chunks
+   are not noted if ChunkInfo is NULL) */
 
 
 static int
@@ -692,14 +896,16 @@ AF_rdLIST_INFO(FILE *fp, int Size, struct AF_info *RInfo, long int pos,
 
   offs = RHEAD_S(fp, ID);
   if (SAME_CSTR(ID, FM_INFO)) {
-    AFsetChunkLim(FM_INFO, pos, pos + offs, ChunkInfo);
+    if (ChunkInfo != NULL)
+      AFsetChunkLim(FM_INFO, pos, pos + offs, ChunkInfo);
 
     poffs = offs;
     while (offs < Size) {
       offs += RHEAD_S(fp, CkHead.ckID);
       offs += RHEAD_V(fp, CkHead.ckSize, DS_EL);
-      AFsetChunkLim(CkHead.ckID, pos + poffs,
-                    RNDUPV(pos + offs + CkHead.ckSize, ALIGN), ChunkInfo);
+      if (ChunkInfo != NULL)
+        AFsetChunkLim(CkHead.ckID, pos + poffs,
+                      RNDUPV(pos + offs + CkHead.ckSize, ALIGN), ChunkInfo);
 
       /* Look for standard INFO ID values */
       for (k = 0; k < N_LIMAP; ++k) {
@@ -725,6 +931,43 @@ AF_rdLIST_INFO(FILE *fp, int Size, struct AF_info *RInfo, long int pos,
   return offs;
 }
 
+/* Decode the information records in a chunk noted for deferred decoding (see
+   AFdecInfoDefer); other chunks are ignored */
+
+
+static int
+AF_decInfoChunk(FILE *fp, const struct AF_chunkLim *ChunkLim,
+                struct AF_info *AFInfo)
+
+{
+  struct WV_Ckpreamb CkHead;
+
+  if (!(SAME_CSTR(ChunkLim->ID, ckID_bext) ||
+        SAME_CSTR(ChunkLim->ID, ckID_DISP) ||
+        SAME_CSTR(ChunkLim->ID, ckID_LIST)))
+    return 0;
+
+/* Set the long jump environment; on error return an error flag */
+  if (setjmp(AFR_JMPENV))
+    return 1;
+
+  if (fseek(fp, ChunkLim->Start, SEEK_SET)) {
+    UTwarn("AFrdWVhead - %s", AFM_FilePosErr);
+    return 1;
+  }
+  RHEAD_S(fp, CkHead.ckID);
+  RHEAD_V(fp, CkHead.ckSize, DS_EL);
+
+  if (SAME_CSTR(CkHead.ckID, ckID_bext))
+    AF_rdbext(fp, (int) CkHead.ckSize, AFInfo);
+  else if (SAME_CSTR(CkHead.ckID, ckID_DISP))
+    AF_rdDISP_text(fp, (int) CkHead.ckSize, AFInfo);
+  else if (SAME_CSTR(CkHead.ckID, ckID_LIST))
+    AF_rdLIST_INFO(fp, (int) CkHead.ckSize, AFInfo, ChunkLim->Start + 8, NULL);
+
+  return 0;
+}
+
 /* Decode channel/speaker information */
 
 
@@ -3,12 +3,20 @@
 
 Routine:
   int AFreadHead(FILE *fp, void *Buf, int Size, int Nv, int Swapb)
+  void AFsetHeadBuf(FILE *fp)
+  int AFendHeadBuf(FILE *fp)
+  int AFpeekHead(FILE *fp, char Buf[], int N)
+  int AFseekHead(FILE *fp, long int pos)
 
 Purpose:
   Read and optionally swap audio file header values
+  Start buffered header reads for a file
+  End buffered header reads, setting the file position
+  Get the header bytes at the current position, without moving ahead
+  Set the header read position
 
 Description:
-  This routine reads data from an audio file header. The information to be read
+  AFreadHead reads data from an audio file header. The information to be read
   is considered to be organized as Nv elements each of Size bytes. The
   information (Nv * Size bytes) is read into memory in file byte order. Then,
   optionally each of the Nv elements is byte swapped.
@@ -19,6 +27,28 @@ Description:
   If end-of-file is encountered or an error occurs, this routine issues a
   longjmp to the AFR_JMPENV environment set up by the calling routine.
 
+  Buffered header reads:
+  Reading a header field by field from the stream costs a file system access
+  for each small read or skip, which is slow on network file systems. For a
+  random access file, AFsetHeadBuf reads a leading block of the file in a
+  single read. The header reads and skips are then done in memory. A read
+  which extends beyond the buffered data, for instance for the chunks after the
+  audio data in a WAVE file, is satisfied with a single follow-up read of a new
+  block starting at the read position. For files which are not random access
+  (pipes), AFsetHeadBuf does nothing, and the header is read from the stream.
+  There is one header buffer per thread.
+
+  The stream position does not track the header read position while the reads
+  are buffered. AFseekHead sets the header read position (instead of AFseek).
+  AFendHeadBuf releases the buffer and positions the file at the header read
+  position. It must be called before the stream is used directly (for
+  instance, by AFtell or for reading text lines). A call for a file which is
+  not being buffered has no effect.
+
+  AFpeekHead copies up to N bytes starting at the current header read position,
+  without changing the position. It returns the number of bytes copied (less
+  than N at end-of-file), or -1 for a read error.
+
 Parameters:
   <-  int AFreadHead
       Number of bytes read (normally equal to Nv * Size)
@@ -38,17 +68,44 @@ Parameters:
       DS_NATIVE - File data is in native byte order
       DS_SWAP   - File data is byte-swapped
 
+  <-  void AFsetHeadBuf
+   -> FILE *fp
+      File pointer associated with the audio file
+
+  <-  int AFendHeadBuf
+      Error flag, zero for no error
+   -> FILE *fp
+      File pointer associated with the audio file
+
+  <-  int AFpeekHead
+      Number of bytes copied, -1 for an error
+   -> FILE *fp
+      File pointer associated with the audio file
+  <-  char Buf[]
+      Output buffer of N bytes
+   -> int N
+      Number of bytes requested
+
+  <-  int AFseekHead
+      Error flag, zero for no error
+   -> FILE *fp
+      File pointer associated with the audio file
+   -> long int pos
+      New header read position (bytes from the start of the file)
+
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.28 $  $Date: 2020/11/25 17:54:50 $
+  $Revision: 1.30 $  $Date: 2020/12/19 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
 #include <setjmp.h>
+#include <string.h>
 
 #include <libtsp.h>
 #include <AFpar.h>
 #include <libtsp/nucleus.h>
+#include <libtsp/AFdataio.h>
 #include <libtsp/AFheader.h>
 #include <libtsp/AFmsg.h>
 
@@ -58,9 +115,40 @@ Author / revision:
                                           (size_t) nv, fp)
 
 #define NBUF  256
+#define LHEADBUF  8192    /* Header buffer size (bytes) */
+#define LALIGN    4096    /* Alignment for buffer fills (bytes) */
+
+/* Header read buffer
+  - Buf holds N bytes of the file, starting at file position Bstart
+  - Pos is the header read position
+  - Each fill reads Nmax bytes (the allocated size) or up to the end-of-file.
+    Limiting the read to the file size avoids a further read to detect the
+    end-of-file. A fill after the first starts at a multiple of LALIGN bytes.
+    Positioning a stdio stream at other offsets can cost an extra read.
+*/
+struct AF_headBuf {
+  FILE *fp;             /* File being buffered, NULL if none */
+  char *Buf;            /* Buffer */
+  int Nmax;             /* Allocated size */
+  int N;                /* Number of bytes in the buffer */
+  long int Bstart;      /* File position of Buf[0] */
+  long int Pos;         /* Header read position */
+  long int Lfile;       /* File size */
+};
+#define AF_HEADBUF_INIT {NULL, NULL, 0, 0, 0L, 0L, 0L}
+
+static SY_THREAD_LOCAL struct AF_headBuf AF_HB = AF_HEADBUF_INIT;
+
+/* Local functions */
+static int
+AF_fillHeadBuf(int L);
+static void
+AF_freeHeadBuf(void);
+static int
+AF_readHeadBuf(void *Buf, int L);
 
 /* setjmp / longjmp environment */
-jmp_buf AFR_JMPENV;   /* Defining point */
+SY_THREAD_LOCAL jmp_buf AFR_JMPENV;  /* Defining point, one per thread */
 
 
 int
@@ -70,7 +158,23 @@ AFreadHead(FILE *fp, void *Buf, int Size, int Nv, int Swapb)
   double Lbuf[NBUF];
   int Nvr, n, Nreq, status;
 
-  if (Buf == NULL) {
+  if (AF_HB.fp == fp && fp != NULL) {
+
+    /* Buffered header reads */
+    if (Buf == NULL) {
+      AF_HB.Pos += Size * Nv;
+      n = Nv;
+    }
+    else {
+      n = AF_readHeadBuf(Buf, Size * Nv);
+      n = (n < 0) ? 0 : n / Size;
+      AF_HB.Pos += Size * n;
+      if (Size != 1 && UTswapCode(Swapb) == DS_SWAP)
+        VRswapBytes(Buf, Buf, Size, n);
+    }
+  }
+
+  else if (Buf == NULL) {
 
     /* Skip data */
     n = 0;
@@ -117,3 +221,164 @@ AFreadHead(FILE *fp, void *Buf, int Size, int Nv, int Swapb)
 
   return (Size * n);
 }
+
+
+void
+AFsetHeadBuf(FILE *fp)
+
+{
+  long int pos;
+
+  /* Release a buffer left from another file */
+  AF_freeHeadBuf();
+
+  if (! FLseekable(fp))
+    return;
+  pos = ftell(fp);
+  if (pos < 0L)
+    return;
+
+  /* Read the leading block */
+  AF_HB.fp = fp;
+  AF_HB.Buf = (char *) UTmalloc(LHEADBUF);
+  AF_HB.Nmax = LHEADBUF;
+  AF_HB.Pos = pos;
+  AF_HB.Lfile = FLfileSize(fp);
+  (void) AF_fillHeadBuf(0);
+
+  return;
+}
+
+
+int
+AFendHeadBuf(FILE *fp)
+
+{
+  int status;
+
+  status = 0;
+  if (AF_HB.fp == fp && fp != NULL) {
+    status = fseek(fp, AF_HB.Pos, SEEK_SET);
+    if (status)
+      UTwarn("AFendHeadBuf: %s", AFM_FilePosErr);
+    AF_freeHeadBuf();
+  }
+
+  return status;
+}
+
+
+int
+AFpeekHead(FILE *fp, char Buf[], int N)
+
+{
+  long int pos;
+  int n;
+
+  if (AF_HB.fp == fp && fp != NULL)
+    n = AF_readHeadBuf(Buf, N);
+
+  else {
+    pos = ftell(fp);
+    n = FREAD(Buf, 1, N, fp);
+    if (n < N && ferror(fp))
+      n = -1;
+    if (pos < 0L || fseek(fp, pos, SEEK_SET))
+      n = -1;
+  }
+  if (n < 0)
+    UTsysMsg("AFpeekHead - %s", AFM_ReadErr);
+
+  return n;
+}
+
+
+int
+AFseekHead(FILE *fp, long int pos)
+
+{
+  int status;
+
+  status = 0;
+  if (AF_HB.fp == fp && fp != NULL)
+    AF_HB.Pos = pos;
+  else
+    status = AFseek(fp, pos, NULL);
+
+  return status;
+}
+
+/* Copy L bytes at the header read position from the buffer (refilling the
+   buffer if necessary), returns the number of bytes copied or -1 for a read
+   error. The read position is not changed. */
+
+
+static int
+AF_readHeadBuf(void *Buf, int L)
+
+{
+  long int offs;
+  int n;
+
+  offs = AF_HB.Pos - AF_HB.Bstart;
+  if (offs < 0L || offs > AF_HB.N ||
+      (offs + L > AF_HB.N && AF_HB.Bstart + AF_HB.N < AF_HB.Lfile)) {
+    if (AF_fillHeadBuf(L))
+      return -1;
+    offs = AF_HB.Pos - AF_HB.Bstart;
+  }
+
+  n = (int) MINV(L, AF_HB.N - offs);
+  if (n <= 0)
+    return 0;     /* End-of-file */
+  memcpy(Buf, &AF_HB.Buf[offs], (size_t) n);
+
+  return n;
+}
+
+/* Fill the buffer, covering at least L bytes from the header read position
+   (if available). Returns a nonzero value for an error. */
+
+
+static int
+AF_fillHeadBuf(int L)
+
+{
+  FILE *fp;
+  long int Bstart;
+  int Nreq;
+
+  fp = AF_HB.fp;
+  Bstart = AF_HB.Pos;
+  if (ftell(fp) != Bstart)
+    Bstart -= Bstart % LALIGN;
+  if (AF_HB.Pos - Bstart + L > AF_HB.Nmax) {
+    AF_HB.Nmax = (int) (AF_HB.Pos - Bstart) + L;
+    AF_HB.Buf = (char *) UTrealloc(AF_HB.Buf, AF_HB.Nmax);
+  }
+
+  AF_HB.Bstart = Bstart;
+  AF_HB.N = 0;
+  if (ftell(fp) != Bstart && fseek(fp, Bstart, SEEK_SET))
+    return 1;
+  Nreq = (int) MINV(AF_HB.Nmax, AF_HB.Lfile - Bstart);
+  if (Nreq > 0)
+    AF_HB.N = FREAD(AF_HB.Buf, 1, Nreq, fp);
+
+  return (AF_HB.N < Nreq && ferror(fp));
+}
+
+/* Release the buffer */
+
+
+static void
+AF_freeHeadBuf(void)
+
+{
+  static const struct AF_headBuf AF_HB_init = AF_HEADBUF_INIT;
+
+  UTfree(AF_HB.Buf);
+  AF_HB = AF_HB_init;
+
+  return;
+}
@@ -33,7 +33,7 @@ Author / revision:
 #include <libtsp/AIpar.h>
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFW_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFW_JMPENV;
 
 
 int
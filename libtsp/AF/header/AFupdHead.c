@@ -8,7 +8,9 @@ Purpose:
   Update the header for an audio file
 
 Description:
-  This routine updates the header for an audio file opened for write.
+  This routine updates the header for an audio file opened for write. Any
+  data queued for background writes (see AFsetAIO) is written first and the
+  background thread is stopped.
 
 Parameters:
   <-  int AFupdHead
@@ -18,7 +20,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.14 $  $Date: 2020/11/25 17:54:50 $
+  $Revision: 1.15 $  $Date: 2020/12/22 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -43,6 +45,13 @@ AFupdHead(AFILE *AFp)
   assert(AFp->Op == FO_WO);
   assert(!AFp->Error);
 
+  /* Complete the background writes */
+  if (AFendAIO(AFp)) {
+    UTsysMsg("AFupdHead: %s", AFM_WriteErr);
+    AFp->Error = AF_IOERR;
+    return AFp->Error;
+  }
+
   /* Set up the appropriate routine */
   AF_upd = NULL;
   switch (AFp->Ftype) {
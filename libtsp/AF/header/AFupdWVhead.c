@@ -11,6 +11,16 @@ Description:
   This routine updates the data length fields of a RIFF WAVE file. The file is
   assumed to have been opened with routine AFopnWrite.
 
+  The chunks to be updated are located using the chunk layout noted by
+  AFwrWVhead. If the file size exceeds the range of the 32-bit size fields,
+  the file is changed to an RF64 file. The JUNK chunk reserved by AFwrWVhead
+  becomes a ds64 chunk with the 64-bit sizes, and the 32-bit size fields are
+  set to 0xFFFFFFFF. An error is reported if no space was reserved.
+
+  For a Wave64 file (noted by a "riff" identifier in the chunk layout), the
+  64-bit file length, fact chunk sample count and data chunk size are updated.
+  The data is padded out to a multiple of 8 bytes.
+
 Parameters:
   <-  int AFupdWVhead
       Error code, zero for no error
@@ -19,7 +29,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.51 $  $Date: 2020/11/25 17:54:50 $
+  $Revision: 1.53 $  $Date: 2020/12/26 11:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -31,12 +41,15 @@ Author / revision:
 #include <AFpar.h>
 #include <libtsp/AFdataio.h>
 #include <libtsp/AFheader.h>
+#include <libtsp/AFmsg.h>
 #include <libtsp/WVpar.h>
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFW_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFW_JMPENV;
 
 /* Local functions */
+static int
+AF_updW64(AFILE *AFp);
 #ifdef WV_TEXT_CHUNKS
 static int
 AF_setTextChunks(struct WV_CkRIFF *CkRIFF, struct AF_info *TInfo, char *Text);
@@ -49,14 +62,21 @@ int
 AFupdWVhead(AFILE *AFp)
 
 {
-  int PCM;
-  long int SLoffset, Nbytes, Ldata;
+  int i, RF64;
+  long int Nbytes, Ldata, Nframe, Presv, Pfact;
+  const struct AF_chunkLim *ChunkLim;
+  struct WV_Ckds64 Ckds64;
   UT_uint4_t val;
 
 /* Set the long jump environment; on error return a 1 */
   if (setjmp(AFW_JMPENV))
     return 1;   /* Return from a header write error */
 
+/* Wave64 file */
+  if (AFp->ChunkInfo.N > 0 &&
+      SAME_CSTR(AFp->ChunkInfo.ChunkLim[0].ID, W64_ID_riff))
+    return AF_updW64(AFp);
+
 /* Add a padding byte (if needed) to the sound data; this padding byte is not
    included in the data chunk ckSize field, but is included in the RIFF chunk
    ckSize field
@@ -69,43 +89,148 @@ AFupdWVhead(AFILE *AFp)
   if (AFp->Nframe != AF_NFRAME_UNDEF && AFp->Isamp  == AFp->Nframe * AFp->Nchan)
     return 0;
 
+/* Locate the ds64 (or JUNK) and fact chunks */
+  Presv = 0L;
+  Pfact = 0L;
+  ChunkLim = AFp->ChunkInfo.ChunkLim;
+  for (i = 0; i < AFp->ChunkInfo.N; ++i) {
+    if (SAME_CSTR(ChunkLim[i].ID, ckID_ds64) ||
+        SAME_CSTR(ChunkLim[i].ID, ckID_JUNK))
+      Presv = ChunkLim[i].Start;
+    else if (SAME_CSTR(ChunkLim[i].ID, ckID_fact))
+      Pfact = ChunkLim[i].Start;
+  }
+
+/* Sizes beyond the 32-bit range need an RF64 file */
+  Nframe = AFp->Nsamp / AFp->Nchan;
+  RF64 = ((unsigned long int) (Nbytes - 8) > WV_SIZE_64);
+  if (RF64 && Presv == 0L) {
+    UTwarn("AFupdWVhead - %s", AFM_WV_NoRF64);
+    return 1;
+  }
+
 /* Update the "RIFF" chunk ckSize field (at the beginning of the file) */
-  if (AFseek(AFp->fp, 4L, NULL))  /* Back at the beginning of the file */
+  if (AFseek(AFp->fp, 0L, NULL))  /* Back at the beginning of the file */
     return 1;
-  val = (UT_uint4_t) (Nbytes - 8);
+  if (RF64) {
+    WHEAD_SN(AFp->fp, ckID_RF64, 4);
+    val = (UT_uint4_t) WV_SIZE_64;
+  }
+  else {
+    WHEAD_SN(AFp->fp, ckID_RIFF, 4);
+    val = (UT_uint4_t) (Nbytes - 8);
+  }
   WHEAD_V(AFp->fp, val, DS_EL);
 
-/* Header layout:
-               RIFF  fmt   fact ...  data
-               WAVE
-   PCM         0-11  12-35   -      Start-8...
-   non-PCM     0-11  12-37 38-49    Start-8...
-   PCM-Ext     0-11  12-59   -      Start-8...
-   non-PCM-Ext 0-11  12-59 60-71    Start-8...
-*/
-  PCM = (AFp->Format == FD_UINT8 || AFp->Format == FD_INT16 ||
-         AFp->Format == FD_INT24 || AFp->Format == FD_INT32);
-  SLoffset = 0;
-  if (!PCM) {    /* Float/double or mu-law/A-law */
-    if (AFp->Ftype == FT_WAVE)
-      SLoffset = 46;
-    else
-      SLoffset = 68;
+/* Update the ds64 chunk (or the JUNK chunk reserving space for it) */
+  if (Presv > 0L) {
+    if (RF64) {
+      MCOPY(ckID_ds64, Ckds64.ckID);
+      Ckds64.riffSizeLow = WV_LOW32(Nbytes - 8);
+      Ckds64.riffSizeHigh = WV_HIGH32(Nbytes - 8);
+      Ckds64.dataSizeLow = WV_LOW32(Ldata);
+      Ckds64.dataSizeHigh = WV_HIGH32(Ldata);
+      Ckds64.sampleCountLow = WV_LOW32(Nframe);
+      Ckds64.sampleCountHigh = WV_HIGH32(Nframe);
+    }
+    else {
+      MCOPY(ckID_JUNK, Ckds64.ckID);
+      Ckds64.riffSizeLow = 0;
+      Ckds64.riffSizeHigh = 0;
+      Ckds64.dataSizeLow = 0;
+      Ckds64.dataSizeHigh = 0;
+      Ckds64.sampleCountLow = 0;
+      Ckds64.sampleCountHigh = 0;
+    }
+    Ckds64.ckSize = WV_DS64_SIZE;
+    if (AFseek(AFp->fp, Presv, NULL))
+      return 1;
+    WHEAD_S(AFp->fp, Ckds64.ckID);
+    WHEAD_V(AFp->fp, Ckds64.ckSize, DS_EL);
+    WHEAD_V(AFp->fp, Ckds64.riffSizeLow, DS_EL);
+    WHEAD_V(AFp->fp, Ckds64.riffSizeHigh, DS_EL);
+    WHEAD_V(AFp->fp, Ckds64.dataSizeLow, DS_EL);
+    WHEAD_V(AFp->fp, Ckds64.dataSizeHigh, DS_EL);
+    WHEAD_V(AFp->fp, Ckds64.sampleCountLow, DS_EL);
+    WHEAD_V(AFp->fp, Ckds64.sampleCountHigh, DS_EL);
   }
 
-/* Update the "fact" chunk SampleLength field */
-  if (SLoffset > 0) {
-    if (AFseek(AFp->fp, SLoffset, NULL))
+/* Update the "fact" chunk SampleLength field (present for non-PCM data) */
+  if (Pfact > 0L) {
+    if (AFseek(AFp->fp, Pfact + 8, NULL))
       return 1;
-    val = (UT_uint4_t) (AFp->Nsamp / AFp->Nchan);
+    if (RF64)
+      val = (UT_uint4_t) WV_SIZE_64;
+    else
+      val = (UT_uint4_t) Nframe;
     WHEAD_V(AFp->fp, val, DS_EL);
   }
 
 /* Update the "data" chunk ckSize field */
   if (AFseek(AFp->fp, AFp->Start - 4, NULL))
     return 1;
-  val = (UT_uint4_t) Ldata;
+  if (RF64)
+    val = (UT_uint4_t) WV_SIZE_64;
+  else
+    val = (UT_uint4_t) Ldata;
   WHEAD_V(AFp->fp, val, DS_EL); /* Number of data bytes */
 
   return 0;
 }
+
+/* Update a Wave64 header (called with the long jump environment set) */
+
+
+static int
+AF_updW64(AFILE *AFp)
+
+{
+  int i;
+  long int Nbytes, Ldata, Nframe, Pfact;
+  const struct AF_chunkLim *ChunkLim;
+  UT_uint4_t val;
+
+/* Pad the data to a multiple of 8 bytes (included in the file size) */
+  Ldata = AF_DL[AFp->Format] * AFp->Nsamp;
+  Nbytes = AFp->Start + Ldata;
+  Nbytes += WRPAD(AFp->fp, Nbytes, W64_ALIGN);
+
+  if (AFp->Nframe != AF_NFRAME_UNDEF && AFp->Isamp  == AFp->Nframe * AFp->Nchan)
+    return 0;
+
+  Pfact = 0L;
+  ChunkLim = AFp->ChunkInfo.ChunkLim;
+  for (i = 0; i < AFp->ChunkInfo.N; ++i) {
+    if (SAME_CSTR(ChunkLim[i].ID, ckID_fact))
+      Pfact = ChunkLim[i].Start;
+  }
+  Nframe = AFp->Nsamp / AFp->Nchan;
+
+/* File size (after the riff GUID) */
+  if (AFseek(AFp->fp, 16L, NULL))
+    return 1;
+  val = WV_LOW32(Nbytes);
+  WHEAD_V(AFp->fp, val, DS_EL);
+  val = WV_HIGH32(Nbytes);
+  WHEAD_V(AFp->fp, val, DS_EL);
+
+/* fact chunk sample count */
+  if (Pfact > 0L) {
+    if (AFseek(AFp->fp, Pfact + W64_LPREAMB, NULL))
+      return 1;
+    val = WV_LOW32(Nframe);
+    WHEAD_V(AFp->fp, val, DS_EL);
+    val = WV_HIGH32(Nframe);
+    WHEAD_V(AFp->fp, val, DS_EL);
+  }
+
+/* data chunk size (including the preamble) */
+  if (AFseek(AFp->fp, AFp->Start - 8, NULL))
+    return 1;
+  val = WV_LOW32(Ldata + W64_LPREAMB);
+  WHEAD_V(AFp->fp, val, DS_EL);
+  val = WV_HIGH32(Ldata + W64_LPREAMB);
+  WHEAD_V(AFp->fp, val, DS_EL);
+
+  return 0;
+}
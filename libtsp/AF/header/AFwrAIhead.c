@@ -52,7 +52,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.73 $  $Date: 2020/11/25 17:54:50 $
+  $Revision: 1.74 $  $Date: 2020/12/20 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -74,7 +74,7 @@ Author / revision:
 #define ALIGN   2          /* Chunks padded out to a multiple of ALIGN */
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFW_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFW_JMPENV;
 
 /* Local functions */
 static void
@@ -150,6 +150,8 @@ AFwrAIhead(FILE *fp, struct AF_write *AFw)
   memcpy(TInfo.Info, AFw->WInfo.Info, NInfo);
   TInfo.N = NInfo;
   TInfo.Nmax = NInfo;
+  TInfo.Alloc = 0;
+  TInfo.Defer = NULL;
 
   Text = TempBuff + NInfo;
   Nmax = NInfo - 1;      /* Room available for the next text string not counting
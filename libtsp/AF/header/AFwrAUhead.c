@@ -51,7 +51,7 @@ Author / revision:
 #define ALIGN   4 /* Header length is a multiple of ALIGN */
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFW_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFW_JMPENV;
 
 /* Local function */
 static int
@@ -33,6 +33,35 @@ Description:
     D+4     4    int    Chunk length
     D+8    ...   ...      Audio data
 
+  If the number of frames is not specified, a 36-byte "JUNK" chunk is written
+  after the "WAVE" identifier. If the size of the file turns out to exceed the
+  range of the 32-bit size fields, AFupdWVhead turns the file into an RF64
+  file, with the JUNK chunk replaced by a "ds64" chunk containing the 64-bit
+  sizes. If the number of frames is specified and the file size exceeds the
+  range of the 32-bit size fields, an RF64 file is written directly. The
+  layout of the chunks written is noted in the audio file structure.
+
+  Wave64 file (file type FTW_WAVE64):
+   Offset Length Type    Contents
+      0    16    GUID   "riff" file identifier
+     16     8    int    File length
+     24    16    GUID   "wave" identifier
+     40    16    GUID   "fmt " chunk identifier
+     56     8    int    Chunk length (including the 24-byte preamble)
+     64    ...   ...      fmt chunk contents as for a WAVE file
+      C    16    GUID   "fact" chunk identifier (only for non-PCM data)
+    C+16    8    int    Chunk length (32)
+    C+24    8    int      Number of samples (per channel)
+    ...   ...    ...    ...
+      D    16    GUID   "data" chunk identifier
+    D+16    8    int    Chunk length (including the 24-byte preamble)
+    D+24   ...   ...      Audio data
+  Chunks are padded out to a multiple of 8 bytes. The chunk identifiers are
+  the RIFF identifiers followed by the common 12-byte GUID tail for WAVE
+  chunks. The 64-bit sizes are filled in by AFupdWVhead when the file is
+  closed. The information records are written to an "afsp" chunk; no DISP or
+  LIST/INFO chunks are written.
+
 Parameters:
   <-  AFILE *AFwrWVhead
       Audio file pointer for the audio file. This routine allocates the space
@@ -45,7 +74,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.86 $  $Date: 2020/11/26 11:29:47 $
+  $Revision: 1.89 $  $Date: 2020/12/26 11:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -70,28 +99,41 @@ Author / revision:
 #define ALIGN   2 /* Chunks padded out to a multiple of ALIGN */
 
 /* setjmp / longjmp environment */
-extern jmp_buf AFW_JMPENV;
+extern SY_THREAD_LOCAL jmp_buf AFW_JMPENV;
 
 /* Local functions */
+static void
+AF_setChunkLims(const struct WV_CkRIFF *CkRIFF, int PCM,
+                struct AF_chunkInfo *ChunkInfo);
 static int
 AF_setFMT(struct WV_Ckfmt *Ckfmt, const struct AF_write *AFw);
 static int
 AF_setTextChunks(struct WV_CkRIFF *CkRIFF, struct AF_info *TInfo, char *Text);
+static int
+AF_setW64Text(struct WV_CkRIFF *CkRIFF, const struct AF_info *TInfo);
+static void
+AF_setW64ChunkLims(const struct WV_CkRIFF *CkRIFF, int PCM,
+                   struct AF_chunkInfo *ChunkInfo);
 static UT_uint4_t
 AF_spkrConfigMask(const unsigned char *SpkrConfig);
 static int
-AF_wrFMT(FILE *fp, const struct WV_Ckfmt *Ckfmt);
+AF_wrFMT(FILE *fp, const struct WV_Ckfmt *Ckfmt, int W64);
 static void
 AF_wrRIFF(FILE *fp, const struct WV_CkRIFF *CkRIFF);
 static int
 AF_wrTextChunks(FILE *fp, const struct WV_CkRIFF *CkRIFF);
+static void
+AF_wrW64(FILE *fp, const struct WV_CkRIFF *CkRIFF, long int size,
+         long int Ldata, long int Nframe);
+static int
+AF_wrW64Preamb(FILE *fp, const char ckID[4], long int Lck);
 
 AFILE *
 AFwrWVhead(FILE *fp, struct AF_write *AFw)
 
 {
   AFILE *AFp;
-  int Ext, Lw, PCM;
+  int Ext, Lw, PCM, Resv, RF64, W64;
   long int size, Ldata;
   struct WV_CkRIFF CkRIFF;
   char *TempBuff, *Text;
@@ -104,10 +146,14 @@ AFwrWVhead(FILE *fp, struct AF_write *AFw)
 
 /* Set up the encoding parameters */
   Lw = AF_DL[AFw->DFormat.Format];
+  W64 = (AFw->FtypeW == FTW_WAVE64);
+  Resv = 0;
   if (AFw->Nframe != AF_NFRAME_UNDEF)
     Ldata = AFw->Nframe * AFw->Nchan * Lw;
-  else if (FLseekable(fp))
+  else if (FLseekable(fp)) {
     Ldata = 0L;
+    Resv = !W64;  /* Reserve space for a ds64 chunk */
+  }
   else {
     UTwarn("AFwrWVhead - %s", AFM_WV_WRAccess);
     return NULL;
@@ -145,22 +191,85 @@ AFwrWVhead(FILE *fp, struct AF_write *AFw)
   memcpy(TInfo.Info, AFw->WInfo.Info, NInfo);
   TInfo.N = NInfo;
   TInfo.Nmax = NInfo;
+  TInfo.Alloc = 0;
+  TInfo.Defer = NULL;
   Text = TempBuff + NInfo;
 
   /* Fill in the DISP, LIST/INFO, afsp chunks */
-  sizeT = AF_setTextChunks(&CkRIFF, &TInfo, Text);
+  if (W64)
+    sizeT = AF_setW64Text(&CkRIFF, &TInfo);
+  else
+    sizeT = AF_setTextChunks(&CkRIFF, &TInfo, Text);
 
-  /* data chunk */
-  MCOPY(ckID_data, CkRIFF.Ckdata.ckID);
-  CkRIFF.Ckdata.ckSize = (UT_uint4_t) Ldata;
+  /* Wave64: 64-bit sizes, no RF64 handling needed */
+  if (W64) {
+    size = 40 + W64_LPREAMB + RNDUPV(CkRIFF.Ckfmt.ckSize, W64_ALIGN);
+    if (!PCM)
+      size += W64_LPREAMB + 8;
+    size += sizeT;
+    size += W64_LPREAMB + RNDUPV(Ldata, W64_ALIGN);
+
+    AFw->DFormat.Swapb = DS_EL;
+    AF_wrW64(fp, &CkRIFF, size, Ldata, AFw->Nframe);
+    UTfree(TempBuff);
+
+    AFp = AFsetWrite(fp, Ext ? FT_WAVE_EX : FT_WAVE, AFw);
+    if (AFp != NULL)
+      AF_setW64ChunkLims(&CkRIFF, PCM, &AFp->ChunkInfo);
+
+    return AFp;
+  }
 
   /* Fill in the RIFF chunk size */
   size  = 4 + 8 + RNDUPV(CkRIFF.Ckfmt.ckSize, ALIGN);
   if (!PCM)
     size += 8 + RNDUPV(CkRIFF.Ckfact.ckSize, ALIGN);
   size += sizeT;
-  size += 8 + RNDUPV(CkRIFF.Ckdata.ckSize, ALIGN);
-  CkRIFF.ckSize = (UT_uint4_t) size;
+  size += 8 + RNDUPV(Ldata, ALIGN);
+  if (Resv)
+    size += 8 + WV_DS64_SIZE;
+
+  /* Sizes beyond the 32-bit range: RF64 file with a ds64 chunk */
+  RF64 = ((unsigned long int) size > WV_SIZE_64);
+  if (RF64 && !Resv) {
+    Resv = 1;
+    size += 8 + WV_DS64_SIZE;
+  }
+
+  /* ds64 chunk, or a JUNK chunk reserving space for it */
+  if (RF64) {
+    MCOPY(ckID_RF64, CkRIFF.ckID);
+    MCOPY(ckID_ds64, CkRIFF.Ckds64.ckID);
+    CkRIFF.Ckds64.riffSizeLow = WV_LOW32(size);
+    CkRIFF.Ckds64.riffSizeHigh = WV_HIGH32(size);
+    CkRIFF.Ckds64.dataSizeLow = WV_LOW32(Ldata);
+    CkRIFF.Ckds64.dataSizeHigh = WV_HIGH32(Ldata);
+    CkRIFF.Ckds64.sampleCountLow = WV_LOW32(AFw->Nframe);
+    CkRIFF.Ckds64.sampleCountHigh = WV_HIGH32(AFw->Nframe);
+    CkRIFF.Ckfact.dwSampleLength = (UT_uint4_t) WV_SIZE_64;
+  }
+  else {
+    MCOPY(ckID_JUNK, CkRIFF.Ckds64.ckID);
+    CkRIFF.Ckds64.riffSizeLow = 0;
+    CkRIFF.Ckds64.riffSizeHigh = 0;
+    CkRIFF.Ckds64.dataSizeLow = 0;
+    CkRIFF.Ckds64.dataSizeHigh = 0;
+    CkRIFF.Ckds64.sampleCountLow = 0;
+    CkRIFF.Ckds64.sampleCountHigh = 0;
+  }
+  CkRIFF.Ckds64.tableLength = 0;
+  CkRIFF.Ckds64.ckSize = Resv ? WV_DS64_SIZE : 0;
+
+  /* data chunk */
+  MCOPY(ckID_data, CkRIFF.Ckdata.ckID);
+  if (RF64) {
+    CkRIFF.ckSize = (UT_uint4_t) WV_SIZE_64;
+    CkRIFF.Ckdata.ckSize = (UT_uint4_t) WV_SIZE_64;
+  }
+  else {
+    CkRIFF.ckSize = (UT_uint4_t) size;
+    CkRIFF.Ckdata.ckSize = (UT_uint4_t) Ldata;
+  }
 
 /* Update relevant parts of AFw */
   AFw->DFormat.Swapb = DS_EL;
@@ -178,6 +287,10 @@ AFwrWVhead(FILE *fp, struct AF_write *AFw)
   else
     AFp = AFsetWrite(fp, FT_WAVE, AFw);
 
+  /* Note the chunk layout (used by AFupdWVhead) */
+  if (AFp != NULL)
+    AF_setChunkLims(&CkRIFF, PCM, &AFp->ChunkInfo);
+
   return AFp;
 }
 
@@ -321,7 +434,20 @@ AF_wrRIFF(FILE *fp, const struct WV_CkRIFF *CkRIFF)
   WHEAD_V(fp, CkRIFF->ckSize, DS_EL);
   WHEAD_S(fp, CkRIFF->WAVEID);
 
-  AF_wrFMT(fp, &CkRIFF->Ckfmt);
+  /* Write the ds64 or JUNK chunk */
+  if (CkRIFF->Ckds64.ckSize > 0) {
+    WHEAD_S(fp, CkRIFF->Ckds64.ckID);
+    WHEAD_V(fp, CkRIFF->Ckds64.ckSize, DS_EL);
+    WHEAD_V(fp, CkRIFF->Ckds64.riffSizeLow, DS_EL);
+    WHEAD_V(fp, CkRIFF->Ckds64.riffSizeHigh, DS_EL);
+    WHEAD_V(fp, CkRIFF->Ckds64.dataSizeLow, DS_EL);
+    WHEAD_V(fp, CkRIFF->Ckds64.dataSizeHigh, DS_EL);
+    WHEAD_V(fp, CkRIFF->Ckds64.sampleCountLow, DS_EL);
+    WHEAD_V(fp, CkRIFF->Ckds64.sampleCountHigh, DS_EL);
+    WHEAD_V(fp, CkRIFF->Ckds64.tableLength, DS_EL);
+  }
+
+  AF_wrFMT(fp, &CkRIFF->Ckfmt, 0);
 
   /* Write the Fact chunk if the data format is not PCM */
   if (!(CkRIFF->Ckfmt.wFormatTag == WAVE_FORMAT_PCM ||
@@ -341,18 +467,71 @@ AF_wrRIFF(FILE *fp, const struct WV_CkRIFF *CkRIFF)
   return;
 }
 
-/* Write the format chunk */
+/* Note the limits of the chunks in the header */
+
+
+static void
+AF_setChunkLims(const struct WV_CkRIFF *CkRIFF, int PCM,
+                struct AF_chunkInfo *ChunkInfo)
+
+{
+  long int offs, Lck;
+
+  AFsetChunkLim(CkRIFF->ckID, 0, AF_EoF, ChunkInfo);
+  AFsetChunkLim(FM_WAVE, 8, 12, ChunkInfo);
+  offs = 12;
+
+  if (CkRIFF->Ckds64.ckSize > 0) {
+    Lck = 8 + RNDUPV(CkRIFF->Ckds64.ckSize, ALIGN);
+    AFsetChunkLim(CkRIFF->Ckds64.ckID, offs, offs + Lck, ChunkInfo);
+    offs += Lck;
+  }
+  Lck = 8 + RNDUPV(CkRIFF->Ckfmt.ckSize, ALIGN);
+  AFsetChunkLim(ckID_fmt, offs, offs + Lck, ChunkInfo);
+  offs += Lck;
+  if (!PCM) {
+    Lck = 8 + RNDUPV(CkRIFF->Ckfact.ckSize, ALIGN);
+    AFsetChunkLim(ckID_fact, offs, offs + Lck, ChunkInfo);
+    offs += Lck;
+  }
+  if (CkRIFF->CkDISP.ckSize > 0) {
+    Lck = 8 + RNDUPV(CkRIFF->CkDISP.ckSize, ALIGN);
+    AFsetChunkLim(ckID_DISP, offs, offs + Lck, ChunkInfo);
+    offs += Lck;
+  }
+  if (CkRIFF->CkLIST.ckSize > 0) {
+    Lck = 8 + RNDUPV(CkRIFF->CkLIST.ckSize, ALIGN);
+    AFsetChunkLim(ckID_LIST, offs, offs + Lck, ChunkInfo);
+    offs += Lck;
+  }
+  if (CkRIFF->Ckafsp.ckSize > 0) {
+    Lck = 8 + RNDUPV(CkRIFF->Ckafsp.ckSize, ALIGN);
+    AFsetChunkLim(ckID_afsp, offs, offs + Lck, ChunkInfo);
+    offs += Lck;
+  }
+  AFsetChunkLim(ckID_data, offs, AF_EoF, ChunkInfo);
+
+  return;
+}
+
+/* Write the format chunk (Wave64: GUID preamble and padding) */
 
 
 static int
-AF_wrFMT(FILE *fp, const struct WV_Ckfmt *Ckfmt)
+AF_wrFMT(FILE *fp, const struct WV_Ckfmt *Ckfmt, int W64)
 
 {
   long int offs, LFMT;
 
-  offs  = WHEAD_S(fp, Ckfmt->ckID);
-  offs += WHEAD_V(fp, Ckfmt->ckSize, DS_EL);
-  LFMT = Ckfmt->ckSize + 8;
+  if (W64) {
+    offs = AF_wrW64Preamb(fp, Ckfmt->ckID, Ckfmt->ckSize);
+    LFMT = Ckfmt->ckSize + W64_LPREAMB;
+  }
+  else {
+    offs  = WHEAD_S(fp, Ckfmt->ckID);
+    offs += WHEAD_V(fp, Ckfmt->ckSize, DS_EL);
+    LFMT = Ckfmt->ckSize + 8;
+  }
   offs += WHEAD_V(fp, Ckfmt->wFormatTag, DS_EL);
   offs += WHEAD_V(fp, Ckfmt->nChannels, DS_EL);
   offs += WHEAD_V(fp, Ckfmt->nSamplesPerSec, DS_EL);
@@ -369,6 +548,8 @@ AF_wrFMT(FILE *fp, const struct WV_Ckfmt *Ckfmt)
   }
 
   assert(offs == LFMT);
+  if (W64)
+    offs += WRPAD(fp, offs, W64_ALIGN);
 
   return offs;
 }
@@ -509,3 +690,133 @@ AF_wrTextChunks(FILE *fp, const struct WV_CkRIFF *CkRIFF)
 
   return offs;
 }
+
+/* Set up the afsp chunk for a Wave64 file (all information records) */
+
+
+static int
+AF_setW64Text(struct WV_CkRIFF *CkRIFF, const struct AF_info *TInfo)
+
+{
+  struct WV_Ckafsp *Ckafsp;
+
+  CkRIFF->CkDISP.ckSize = 0;
+  CkRIFF->CkLIST.ckSize = 0;
+  CkRIFF->CkLIST.N = 0;
+
+  Ckafsp = &CkRIFF->Ckafsp;
+  if (TInfo->N > 0) {
+    MCOPY(ckID_afsp, Ckafsp->ckID);
+    Ckafsp->ckSize = 4 + TInfo->N;
+    MCOPY(FM_AFSP, Ckafsp->AFspID);
+    Ckafsp->text = TInfo->Info;
+    return W64_LPREAMB + RNDUPV(Ckafsp->ckSize, W64_ALIGN);
+  }
+
+  Ckafsp->ckSize = 0;
+  return 0;
+}
+
+/* Write a Wave64 header */
+
+
+static void
+AF_wrW64(FILE *fp, const struct WV_CkRIFF *CkRIFF, long int size,
+         long int Ldata, long int Nframe)
+
+{
+  int offs;
+  UT_uint4_t val;
+  const struct WV_Ckafsp *Ckafsp;
+
+  /* riff / wave preamble */
+  WHEAD_SN(fp, W64_ID_riff, 4);
+  WHEAD_SN(fp, W64_GUIDX_riff, 12);
+  val = WV_LOW32(size);
+  WHEAD_V(fp, val, DS_EL);
+  val = WV_HIGH32(size);
+  WHEAD_V(fp, val, DS_EL);
+  WHEAD_SN(fp, W64_ID_wave, 4);
+  WHEAD_SN(fp, W64_GUIDX_wave, 12);
+
+  AF_wrFMT(fp, &CkRIFF->Ckfmt, 1);
+
+  /* fact chunk with a 64-bit sample count */
+  if (!(CkRIFF->Ckfmt.wFormatTag == WAVE_FORMAT_PCM ||
+      (CkRIFF->Ckfmt.wFormatTag == WAVE_FORMAT_EXTENSIBLE &&
+       CkRIFF->Ckfmt.SubFormat.wFormatTag == WAVE_FORMAT_PCM))) {
+    if (Nframe == AF_NFRAME_UNDEF)
+      Nframe = 0L;
+    AF_wrW64Preamb(fp, ckID_fact, 8L);
+    val = WV_LOW32(Nframe);
+    WHEAD_V(fp, val, DS_EL);
+    val = WV_HIGH32(Nframe);
+    WHEAD_V(fp, val, DS_EL);
+  }
+
+  /* afsp chunk */
+  Ckafsp = &CkRIFF->Ckafsp;
+  if (Ckafsp->ckSize > 0) {
+    offs  = AF_wrW64Preamb(fp, Ckafsp->ckID, Ckafsp->ckSize);
+    offs += WHEAD_S(fp, Ckafsp->AFspID);
+    offs += WHEAD_SN(fp, Ckafsp->text, Ckafsp->ckSize - 4);
+    WRPAD(fp, offs, W64_ALIGN);
+  }
+
+  AF_wrW64Preamb(fp, ckID_data, Ldata);
+
+  return;
+}
+
+/* Write a Wave64 chunk preamble: GUID and 64-bit size (including the
+   preamble) */
+
+
+static int
+AF_wrW64Preamb(FILE *fp, const char ckID[4], long int Lck)
+
+{
+  int offs;
+  UT_uint4_t val;
+
+  offs  = WHEAD_SN(fp, ckID, 4);
+  offs += WHEAD_SN(fp, W64_GUIDX_wave, 12);
+  val = WV_LOW32(Lck + W64_LPREAMB);
+  offs += WHEAD_V(fp, val, DS_EL);
+  val = WV_HIGH32(Lck + W64_LPREAMB);
+  offs += WHEAD_V(fp, val, DS_EL);
+
+  return offs;
+}
+
+/* Note the limits of the chunks in a Wave64 header */
+
+
+static void
+AF_setW64ChunkLims(const struct WV_CkRIFF *CkRIFF, int PCM,
+                   struct AF_chunkInfo *ChunkInfo)
+
+{
+  long int offs, Lck;
+
+  AFsetChunkLim(W64_ID_riff, 0, AF_EoF, ChunkInfo);
+  AFsetChunkLim(W64_ID_wave, 24, 40, ChunkInfo);
+  offs = 40;
+
+  Lck = W64_LPREAMB + RNDUPV(CkRIFF->Ckfmt.ckSize, W64_ALIGN);
+  AFsetChunkLim(ckID_fmt, offs, offs + Lck, ChunkInfo);
+  offs += Lck;
+  if (!PCM) {
+    Lck = W64_LPREAMB + 8;
+    AFsetChunkLim(ckID_fact, offs, offs + Lck, ChunkInfo);
+    offs += Lck;
+  }
+  if (CkRIFF->Ckafsp.ckSize > 0) {
+    Lck = W64_LPREAMB + RNDUPV(CkRIFF->Ckafsp.ckSize, W64_ALIGN);
+    AFsetChunkLim(ckID_afsp, offs, offs + Lck, ChunkInfo);
+    offs += Lck;
+  }
+  AFsetChunkLim(ckID_data, offs, AF_EoF, ChunkInfo);
+
+  return;
+}
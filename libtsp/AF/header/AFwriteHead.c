@@ -60,7 +60,7 @@ Author / revision:
 #define NPAD  16  /* Number of bytes */
 
 /* setjmp / longjmp environment */
-jmp_buf AFW_JMPENV;   /* Defining point */
+SY_THREAD_LOCAL jmp_buf AFW_JMPENV;  /* Defining point, one per thread */
 
 
 int
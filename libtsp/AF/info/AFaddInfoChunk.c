@@ -15,6 +15,11 @@ Description:
 
   A trailing null is appended if one is not present.
 
+  If the information record structure is marked as allocated (Alloc nonzero),
+  the storage is allocated or extended as needed. Otherwise, if the records do
+  not fit in the space available, a warning message is printed and the records
+  are not added.
+
 Parameters:
   <-  AFaddInfoChunk
       Number of characters added to the information record structure
@@ -28,7 +33,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.5 $  $Date: 2017/07/12 17:29:43 $
+  $Revision: 1.6 $  $Date: 2020/12/20 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -44,7 +49,7 @@ int
 AFaddInfoChunk (const char Recs[], int Nc, struct AF_info *AFInfo)
 
 {
-  int NI, Nt;
+  int NI, Nt, Nmax;
 
   /* Info record chunks can have several trailing nulls due to file padding */
   /* Find the last non-null character */
@@ -53,8 +58,17 @@ AFaddInfoChunk (const char Recs[], int Nc, struct AF_info *AFInfo)
       break;
   }
 
+  /* Extend allocated storage (at least doubling the size) */
   NI = AFInfo->N;
-  if (AFInfo == NULL || NI + Nc + 1 > AFInfo->Nmax) {
+  if (AFInfo->Alloc && NI + Nc + 1 > AFInfo->Nmax) {
+    Nmax = 2 * AFInfo->Nmax;
+    if (Nmax < NI + Nc + 1)
+      Nmax = NI + Nc + 1;
+    AFInfo->Info = (char *) UTrealloc (AFInfo->Info, Nmax);
+    AFInfo->Nmax = Nmax;
+  }
+
+  if (NI + Nc + 1 > AFInfo->Nmax) {
     UTwarn ("AFaddInfoChunk - %s", AFM_LongInfo);
     Nc = 0;
   }
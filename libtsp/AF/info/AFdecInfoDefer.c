@@ -0,0 +1,80 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  int AFdecInfoDefer(struct AF_info *AFInfo)
+
+Purpose:
+  Decode deferred information records
+
+Description:
+  An input audio file opened with the LazyInfo option (see AFoptions) does not
+  have the information records in some header chunks decoded on open. Instead,
+  a deferred information record structure is attached to the information
+  record structure. This structure refers to the chunk layout of the file and
+  to a file type specific routine which decodes the information records in a
+  chunk. This routine reads the chunks from the file and appends their
+  information records to the information record structure. The deferred
+  structure is then released, so that the records are decoded only once. This
+  routine is called by AFgetInfoRec and AFprintInfoRecs.
+
+  The file position is restored after decoding, so that this routine can be
+  called between reads of the audio data. It should not be called while
+  another thread is reading data from the same file. If an error occurs, the
+  records decoded up to that point are kept.
+
+Parameters:
+  <-  int AFdecInfoDefer
+      Error flag, zero for no error
+  <-> struct AF_info *AFInfo
+      Information record structure
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/20 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp.h>
+#include <AFpar.h>
+#include <libtsp/AFinfo.h>
+#include <libtsp/AFmsg.h>
+
+
+int
+AFdecInfoDefer(struct AF_info *AFInfo)
+
+{
+  struct AF_infoDefer *Defer;
+  const struct AF_chunkInfo *ChunkInfo;
+  long int pos;
+  int i, ErrCode;
+
+  Defer = AFInfo->Defer;
+  if (Defer == NULL)
+    return 0;
+  AFInfo->Defer = NULL;
+
+/* Save the file position */
+  pos = ftell(Defer->fp);
+  if (pos < 0L) {
+    UTwarn("AFdecInfoDefer - %s", AFM_FilePosErr);
+    UTfree((void *) Defer);
+    return 1;
+  }
+
+/* Decode the chunks (chunks without information records are ignored) */
+  ErrCode = 0;
+  ChunkInfo = Defer->ChunkInfo;
+  for (i = 0; i < ChunkInfo->N && ErrCode == 0; ++i)
+    ErrCode = (*Defer->Decode)(Defer->fp, &ChunkInfo->ChunkLim[i], AFInfo);
+
+/* Restore the file position */
+  if (fseek(Defer->fp, pos, SEEK_SET)) {
+    UTwarn("AFdecInfoDefer - %s", AFM_FilePosErr);
+    ErrCode = 1;
+  }
+  UTfree((void *) Defer);
+
+  return ErrCode;
+}
@@ -46,8 +46,6 @@ Author / revision:
 #include <libtsp/AFinfo.h>
 #include <libtsp/AFmsg.h>
 
-static const char *Ident[] = {NULL, NULL};
-
 
 int
 AFgetDelInfoRec (const char *RecID[],  struct AF_info *WInfo, char text[],
@@ -55,8 +53,10 @@ AFgetDelInfoRec (const char *RecID[],  struct AF_info *WInfo, char text[],
 
 {
   const char *p;
+  const char *Ident[2];
   int k, Nc;
 
+  Ident[1] = NULL;
   Nc = 0;
   p = NULL;
   for (k = 0; RecID[k] != NULL; ++k) {
@@ -17,6 +17,10 @@ Description:
   The records are separated by nulls.  If an information record does not have
   a terminating null, the last unterminated record will not be checked.
 
+  Information records whose decoding has been deferred (see AFdecInfoDefer)
+  are decoded and appended to the information structure before the search.
+  The structure is modified in this case, even though it is declared const.
+
   AFsp Information Records:
     The header information records are separated by null characters.  The name
     field is the first part of the record and the value field is the remainder.
@@ -38,13 +42,14 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.39 $  $Date: 2017/05/24 16:17:28 $
+  $Revision: 1.41 $  $Date: 2020/12/24 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
 #include <string.h> /* memchr definition */
 
 #include <AFpar.h>
+#include <libtsp/AFinfo.h>
 #include <libtsp/nucleus.h>
 
 /* Local function */
@@ -58,7 +63,12 @@ const char *AFgetInfoRec (const char *RecID[], const struct AF_info *AFInfo)
   const char *p;
   int i;
 
+/* Decode deferred information records */
+  if (AFInfo != NULL && AFInfo->Defer != NULL)
+    AFdecInfoDefer ((struct AF_info *) AFInfo);
+
 /* Search for named records in an AFsp information structure */
+  p = NULL;
   for (i = 0; RecID[i] != NULL; ++i) {
     p = AF_getInfoRec (RecID[i], AFInfo);
     if (p != NULL) {
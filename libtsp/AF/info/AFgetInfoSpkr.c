@@ -23,7 +23,9 @@ Description:
 Parameters:
   <-  unsigned char *AFgetInfoSpkr
       Loudspeaker configuration - This is a null terminated list of loudspeaker
-      position codes as unsigned bytes.
+      position codes as unsigned bytes. The list is in an internal storage
+      area; each call to this routine from the same thread overlays this
+      storage.
    -> const struct AF_info *AFInfo
       AFsp information structure
 
@@ -46,7 +48,7 @@ AFgetInfoSpkr (const struct AF_info *AFInfo)
 
 {
   const char *p;
-  static unsigned char SpkrConfig[AF_MAXN_SPKR+1];
+  static SY_THREAD_LOCAL unsigned char SpkrConfig[AF_MAXN_SPKR+1];
 
 /* Search for named records in an AFsp information structure */
   p = AFgetInfoRec (RecID, AFInfo);
@@ -36,7 +36,8 @@ Description:
 
   If the data does not have fixed length elements (for instance, text data),
   Nsamp may not be specified. If the text file is seekable, the number of data
-  records is determined and used to get Nsamp.
+  records is determined and used to get Nsamp. This is not done for a
+  header-only open (HeadOnly option, see AFoptions).
 
   The file must be initially positioned at the start of the audio data.
 
@@ -60,7 +61,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.9 $  $Date: 2020/11/29 23:17:27 $
+  $Revision: 1.10 $  $Date: 2020/12/18 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -193,14 +194,15 @@ AF_setNsamp(FILE *fp, int Lw, struct AF_ndata *NData, enum AF_FIX_T Fix)
     }
   }
   /* Lw == 0, text file */
-  else if (NData->Nsamp == AF_NSAMP_UNDEF && FLseekable (fp)) {
+  else if (NData->Nsamp == AF_NSAMP_UNDEF && FLseekable (fp)
+           && ! AFopt.HeadOnly) {
     NData->Nsamp = AF_NtextVal(fp);
     if (NData->Nsamp == AF_NSAMP_UNDEF)
       return 1; /* Error in AF_Nrec */
   }
 
   /* Check if an "unknown" Nsamp is allowed */
-  if (NData->Nsamp == AF_NSAMP_UNDEF && !AFopt.NsampND) {
+  if (NData->Nsamp == AF_NSAMP_UNDEF && !AFopt.NsampND && !AFopt.HeadOnly) {
     UTwarn("AFsetRead - %s", AFM_NoNsamp);
     return 1;
   }
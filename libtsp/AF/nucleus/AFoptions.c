@@ -3,10 +3,13 @@
 
 Routine:
   struct AF_opt *AFoptions(unsigned int Cat)
+  void AFcopyOptions(const struct AF_opt *Opt)
 
 Purpose:
   Reset all or part of the audio file options structure to its default setting
   and return a pointer to the structure.
+  Set the options structure of the calling thread from a copy of the options
+  of another thread
 
 Description:
   This routine returns a pointer to the audio file options structure. The
@@ -17,6 +20,24 @@ Description:
   opening an output file. Changes to other options persist until reset. The
   routine AFresetOptions can be used to reset some or all of the options.
 
+  Each thread has its own options structure, initialized to the default
+  values. Options set in one thread do not affect files opened in another
+  thread. A new thread does not by itself inherit the options of the thread
+  that created it. The worker threads of a thread pool (see AOnewPool) and
+  the background I/O threads (see AFsetAIO) are given the options of the
+  creating thread: a copy of the options structure is taken when the threads
+  are created, and each thread installs it with AFcopyOptions. Other threads
+  can do the same, or pass options explicitly to AFopnReadCtx.
+
+  AFcopyOptions copies the general options, the input file options and the
+  number of frames and bits per sample of the output file options into the
+  options structure of the calling thread. The speaker configuration and the
+  user information records are allocated storage belonging to the thread
+  which set them (they are freed when an output file is opened in that
+  thread); they are not copied, and those of the calling thread are left
+  unchanged. A copy of an options structure made by structure assignment can
+  be used, provided these two fields are not otherwise used.
+
   Program Behaviour:
   Error Control (int ErrorHalt):
     The top level AF routines (AFopnRead, AFopnWrite, AFdReadData, etc.)
@@ -34,6 +55,25 @@ Description:
     ScaleV. For a given value of ScaleV, integer file data on input will be
     scaled to the interval between -ScaleV and +ScaleV. When writing to an
     output file, the inverse scaling is used. The default value for ScaleV is 1.
+  Data transfer statistics (int Stats):
+    Counts of the data bytes, fread/fwrite calls and positioning calls are
+    kept for each audio file (see AFprintStats). This option controls whether
+    the time spent in data transfers is also measured.
+      0 - Keep counts only (default behaviour)
+      1 - Also measure times. The statistics are printed to stderr when the
+          file is closed.
+  Background data I/O (int AsyncIO):
+    This option lets the file I/O overlap the processing of the data. The data
+    of a file with binary data is transferred by a separate thread through a
+    ring of AsyncIO buffer blocks (see AFsetAIO). For input files, the thread
+    reads ahead of the data requests. For output files, the thread writes the
+    data behind the data requests, and write errors may only be reported on a
+    later write or when the file is closed. Text data files, memory mapped
+    input files and input files that are not random access are not affected.
+    Threads are not available on all systems; the data is then transferred by
+    the calling thread.
+      0 - Transfer the data in the calling thread (default behaviour)
+      n - Use a background thread with n buffer blocks
 
   Options for Input Files:
   Number of samples (long int NsampND):
@@ -55,9 +95,47 @@ Description:
     file will be opened if it does not support random access (viz. file streams
     from a pipe are not random access).
       0 - Allow input files which are not random access (default behaviour). If
-          an attempt is made to reposition such a file during a read operation,
-          an error condition will occur.
+          an attempt is made to reposition such a file to a point before the
+          retained data window (see Lback), an error condition will occur.
       1 - Do not open input audio files which are not random access.
+  Memory mapped input (int MMap):
+    This parameter controls how the audio data of an input file is accessed.
+    For a random access file with binary data, the data can be mapped into
+    memory. The data conversion routines then decode directly from the mapped
+    data, avoiding the intermediate buffer copy and the file positioning
+    calls. Files that are not random access (viz. file streams from a pipe)
+    and text data files always use stdio.
+      0 - Read the data using stdio (default behaviour)
+      1 - Map the data of random access input files into memory if possible
+  Window for moving back (long int Lback):
+    For an input file that is not random access (viz. a file stream from a
+    pipe) with binary data, the most recently read Lback bytes of data are
+    retained in memory. A request to move back to data within this window is
+    served from memory. Moving back to data before the window is an error. A
+    value of zero disables the window. The default is 1048576 bytes.
+  Header-only open (int HeadOnly):
+    This parameter is used by programs which only need the file parameters
+    (for instance to list the properties of many files). Only the file header
+    is read. The number of samples in a text file which is not given in the
+    header is not determined by reading the data (it is returned as
+    AF_NSAMP_UNDEF). The data is not mapped into memory and no window for
+    moving back is allocated. Data should not be read from a file opened this
+    way.
+      0 - Open the file for reading data (default behaviour)
+      1 - Read the header only
+  Information record decoding (int LazyInfo):
+    This parameter is used by programs which stream the audio data and do not
+    need the information records (for instance to process many files). For
+    random access WAVE files, the LIST/INFO, bext and DISP chunks are not read
+    when the file is opened; only their positions are noted. The information
+    records in these chunks are decoded on first use, when the records are
+    searched with AFgetInfoRec (or the AFgetInfoXXX routines based on it) or
+    printed with AFprintInfoRecs. Records used to set the file parameters
+    ("sample_rate:", "bits_per_sample:" and "loudspeakers:" in the afsp chunk)
+    are always decoded when the file is opened. The chunk layout (see
+    AFprintChunkLims) then does not show the sub-chunks of a LIST chunk.
+      0 - Decode the information records on open (default behaviour)
+      1 - Decode the information records on first use
   Input File Type (enum AF_FT_T FtypeI):
     Input audio file type (default FT_AUTO). This parameter can be set with
     named parameters using the routine AFsetFileType.
@@ -110,9 +188,13 @@ Parameters:
         AF_OPT_OUTPUT  - Output file options
         AF_OPT_ALL     - By itself, resets all options
 
+  Routine AFcopyOptions
+   -> const struct AF_opt *Opt
+      Options to be copied (typically a copy of the options of another thread)
+
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.36 $  $Date: 2020/11/26 11:33:35 $
+  $Revision: 1.43 $  $Date: 2020/12/26 12:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -123,14 +205,17 @@ Author / revision:
 #define AF_INPUTPAR_DEFAULT \
   {FD_UNDEF, 0L, AF_SFREQ_DEFAULT, DS_NATIVE, 1L, AF_FULLSCALE_DEFAULT}
 #define AF_UINFO_DEFAULT \
-  {NULL, 0, 0}
+  {NULL, 0, 0, 0, NULL}
 #define AF_OPT_DEFAULT \
-  {AF_ERRORHALT_DEFAULT, AF_SCALEV_DEFAULT, \
-   AF_NSAMPND_DEFAULT, AF_RACCESS_DEFAULT, FT_AUTO, AF_INPUTPAR_DEFAULT, \
+  {AF_ERRORHALT_DEFAULT, AF_SCALEV_DEFAULT, AF_STATS_DEFAULT, \
+   AF_ASYNCIO_DEFAULT, \
+   AF_NSAMPND_DEFAULT, AF_RACCESS_DEFAULT, AF_MMAP_DEFAULT, \
+   AF_LBACK_DEFAULT, AF_HEADONLY_DEFAULT, AF_LAZYINFO_DEFAULT, FT_AUTO, \
+   AF_INPUTPAR_DEFAULT, \
    AF_NFRAME_UNDEF, AF_NBS_DEFAULT, NULL, AF_STDINFO_DEFAULT, AF_UINFO_DEFAULT}
 
-/* Initialization of the global options structure */
-struct AF_opt AFopt = AF_OPT_DEFAULT;
+/* Initialization of the options structure (one per thread) */
+SY_THREAD_LOCAL struct AF_opt AFopt = AF_OPT_DEFAULT;
 
 
 struct AF_opt *
@@ -143,11 +228,17 @@ AFoptions(unsigned int Cat)
   if (Cat & AF_OPT_GENERAL) {
     AFopt.ErrorHalt = AFopt_def.ErrorHalt;
     AFopt.ScaleV = AFopt_def.ScaleV;
+    AFopt.Stats = AFopt_def.Stats;
+    AFopt.AsyncIO = AFopt_def.AsyncIO;
   }
 
   if (Cat & AF_OPT_INPUT) {
     AFopt.NsampND = AFopt_def.NsampND;
     AFopt.RAccess = AFopt_def.RAccess;
+    AFopt.MMap = AFopt_def.MMap;
+    AFopt.Lback = AFopt_def.Lback;
+    AFopt.HeadOnly = AFopt_def.HeadOnly;
+    AFopt.LazyInfo = AFopt_def.LazyInfo;
     AFopt.FtypeI = AFopt_def.FtypeI;
     AFopt.InputPar = AFopt_def.InputPar;
   }
@@ -164,3 +255,33 @@ AFoptions(unsigned int Cat)
 
   return &AFopt;
 }
+
+
+void
+AFcopyOptions(const struct AF_opt *Opt)
+
+{
+  if (Opt == &AFopt)
+    return;
+
+  AFopt.ErrorHalt = Opt->ErrorHalt;
+  AFopt.ScaleV = Opt->ScaleV;
+  AFopt.Stats = Opt->Stats;
+  AFopt.AsyncIO = Opt->AsyncIO;
+
+  AFopt.NsampND = Opt->NsampND;
+  AFopt.RAccess = Opt->RAccess;
+  AFopt.MMap = Opt->MMap;
+  AFopt.Lback = Opt->Lback;
+  AFopt.HeadOnly = Opt->HeadOnly;
+  AFopt.LazyInfo = Opt->LazyInfo;
+  AFopt.FtypeI = Opt->FtypeI;
+  AFopt.InputPar = Opt->InputPar;
+
+  /* Output options: not the allocated SpkrConfig and UInfo fields */
+  AFopt.Nframe = Opt->Nframe;
+  AFopt.NbS = Opt->NbS;
+  AFopt.StdInfo = Opt->StdInfo;
+
+  return;
+}
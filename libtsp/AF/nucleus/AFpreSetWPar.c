@@ -22,6 +22,7 @@ Description:
     AFw->DFormat.NbS
     AFw->SpkrConfig
     AFw->WInfo        Space allocated in AF_genInfo, de-allocated next call
+                      from the same thread
     AFw->Nframe
   Fields preset to tentative values
     AFw->DFormat.ScaleF
@@ -43,7 +44,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.60 $  $Date: 2020/11/26 11:33:35 $
+  $Revision: 1.63 $  $Date: 2020/12/26 11:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -178,6 +179,7 @@ AF_checkDT(enum AF_FTW_T FtypeW, enum AF_FD_T Format)
   case FTW_WAVE:
   case FTW_WAVE_EX:
   case FTW_WAVE_NOEX:
+  case FTW_WAVE64:
     if (DT_WAVE[Format] == 0) {
       UTwarn("AFopnWrite - %s: \"%s\"", AFM_WV_UnsData, AF_DTN[Format]);
       Err = 1;
@@ -243,6 +245,7 @@ AF_checkIEEE(enum AF_FTW_T FtypeW, enum AF_FD_T Format)
   case FTW_WAVE:
   case FTW_WAVE_EX:
   case FTW_WAVE_NOEX:
+  case FTW_WAVE64:
     if ((Format == FD_FLOAT32 || Format == FD_FLOAT64) && !UTcheckIEEE ()) {
       UTwarn("AFwrWVhead - %s", AFM_NoIEEE);
       Err = 1;
@@ -341,7 +344,7 @@ AF_genInfo(const enum AF_STDINFO_T StdInfo, const struct AF_info *UInfo,
 {
   char SInfo[MAX_SINFO];
   int Nc, ns, nu;
-  static struct AF_info WInfo = {NULL, 0, 0};
+  static SY_THREAD_LOCAL struct AF_info WInfo = {NULL, 0, 0, 0, NULL};
 
   /* Size of the standard info records */
   if (StdInfo == AF_STDINFO_ON)
@@ -362,6 +365,7 @@ AF_genInfo(const enum AF_STDINFO_T StdInfo, const struct AF_info *UInfo,
   UTfree((void *) WInfo.Info);
   WInfo.Info = (char *) UTmalloc(Nc);
   WInfo.Nmax = Nc;
+  UTthreadFree((void **) &WInfo.Info);  /* Freed when the thread exits */
 
 /* Form the output information records */
   MCOPYN(SInfo, WInfo.Info, ns);
@@ -449,6 +453,7 @@ AF_stdInfo(const struct AF_write *AFw, char *Sinfo)
   /* AIFF/AIFC have this, as well as WAVE-ex => WAVE will be promoted to
      WAVE-ex */
   if (!(AFw->FtypeW == FTW_WAVE        || AFw->FtypeW == FTW_WAVE_EX ||
+        AFw->FtypeW == FTW_WAVE64      ||
         AFw->FtypeW == FTW_AIFF        || AFw->FtypeW == FTW_AIFF_C) ||
         AFw->FtypeW == FTW_AIFF_C_SOWT || AFw->FtypeW == FTW_TXAUD) {
     Res = 8 * AF_DL[AFw->DFormat.Format];
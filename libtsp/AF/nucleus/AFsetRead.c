@@ -18,8 +18,13 @@ Description:
      information record).
   4. Fill in the bits/sample field (check for a value in an information record).
   5. Fill in the loudspeaker configuration (check in an information record).
+  6. If the header routine has deferred the decoding of some information
+     records (AFr->InfoDec not NULL), set up the deferred information record
+     structure (see AFdecInfoDefer).
 
-  The file must be positioned at the start of the audio data.
+  The file must be positioned at the start of the audio data. Buffered header
+  reads for the file (see AFsetHeadBuf) are ended here, leaving the stream
+  positioned at the start of the audio data.
 
 Parameters:
   <-  AFILE *AFsetRead
@@ -40,7 +45,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.72 $  $Date: 2020/11/26 11:33:35 $
+  $Revision: 1.77 $  $Date: 2020/12/22 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -56,6 +61,7 @@ Author / revision:
 #include <libtsp.h>
 #include <AFpar.h>
 #include <libtsp/nucleus.h>
+#include <libtsp/AFheader.h>   /* AFendHeadBuf */
 #include <libtsp/AFinfo.h>
 #include <libtsp/AFmsg.h>
 
@@ -80,10 +86,19 @@ AFsetRead(FILE *fp, int Ftype, const struct AF_read *AFr, enum AF_FIX_T Fix)
   long int Dstart;
   int Lw;
   struct AF_ndata NData;
+  struct AF_infoDefer *Defer;
+  AF_MMAP_INIT(AF_MMap_init);
+  AF_RBUF_INIT(AF_RBuf_init);
+  AF_TXIDX_INIT(AF_TxIdx_init);
+  AF_STATS_INIT(AF_Stats_init);
 
   assert(Ftype > 0 && Ftype < AF_NFT);
   assert(AFr->DFormat.Format > 0 && AFr->DFormat.Format < AF_NFD);
 
+/* Position the stream at the start of data (end buffered header reads) */
+  if (AFendHeadBuf(fp))
+    return NULL;
+
 /* Check data layout consistency */
   Lw = AF_DL[AFr->DFormat.Format];
   NData = AFr->NData;     /* Copy, now writeable */
@@ -140,6 +155,30 @@ AFsetRead(FILE *fp, int Ftype, const struct AF_read *AFr, enum AF_FIX_T Fix)
   AFp->ChunkInfo = AFr->ChunkInfo;
   /* Set up the loudspeaker configuration */
   AFp->SpkrConfig = AF_setSpeaker(NData.SpkrConfig, &AFp->AFInfo);
+  /* Deferred information records, attached after the records used above */
+  if (AFr->InfoDec != NULL) {
+    Defer = (struct AF_infoDefer *) UTmalloc(sizeof(struct AF_infoDefer));
+    Defer->fp = fp;
+    Defer->ChunkInfo = &AFp->ChunkInfo;
+    Defer->Decode = AFr->InfoDec;
+    AFp->AFInfo.Defer = Defer;
+  }
+
+  /* Memory mapped data access - set up by AFmapData */
+  AFp->MMap = AF_MMap_init;
+
+  /* Retained data window - set up by AFsetRBuf */
+  AFp->RBuf = AF_RBuf_init;
+
+  /* Text data sample position index - set up by AFsetTxIdx */
+  AFp->TxIdx = AF_TxIdx_init;
+
+  /* Background data I/O - set up by AFsetAIO */
+  AFp->AIO = NULL;
+
+  /* Data transfer statistics */
+  AFp->Stats = AF_Stats_init;
+  AFp->Stats.Report = AFopt.Stats;
 
   return AFp;
 }
@@ -172,6 +211,8 @@ AF_setInfo(const struct AF_info *RInfo)
     AFInfo.N = N;
     AFInfo.Nmax = N;
   }
+  AFInfo.Alloc = 1;     /* Extended by deferred records */
+  AFInfo.Defer = NULL;
 
   return AFInfo;
 }
@@ -24,7 +24,7 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.66 $  $Date: 2020/11/26 11:33:35 $
+  $Revision: 1.70 $  $Date: 2020/12/22 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
@@ -54,6 +54,10 @@ AFsetWrite(FILE *fp, enum AF_FT_T Ftype, const struct AF_write *AFw)
   int Nspkr;
   enum AF_ERR_T ErrCode;
   AF_CHUNKINFO_INIT(AF_chunkInfo_init);
+  AF_MMAP_INIT(AF_MMap_init);
+  AF_RBUF_INIT(AF_RBuf_init);
+  AF_TXIDX_INIT(AF_TxIdx_init);
+  AF_STATS_INIT(AF_Stats_init);
 
   assert(Ftype == FT_WAVE || Ftype == FT_WAVE_EX ||
          Ftype == FT_AU   ||
@@ -123,6 +127,18 @@ AFsetWrite(FILE *fp, enum AF_FT_T Ftype, const struct AF_write *AFw)
     STcopyMax((const char *) AFw->SpkrConfig, (char *) AFp->SpkrConfig, Nspkr);
   }
 
+  /* Memory mapped data access, data window and index - not used for write */
+  AFp->MMap = AF_MMap_init;
+  AFp->RBuf = AF_RBuf_init;
+  AFp->TxIdx = AF_TxIdx_init;
+
+  /* Background data I/O - set up by AFsetAIO */
+  AFp->AIO = NULL;
+
+  /* Data transfer statistics */
+  AFp->Stats = AF_Stats_init;
+  AFp->Stats.Report = AFopt.Stats;
+
   return AFp;
 }
 
@@ -138,13 +154,17 @@ AF_setInfo(const struct AF_info *WInfo, struct AF_info *InfoOut)
   if (WInfo == NULL || WInfo->N <= 0) {
     InfoOut->Info = NULL;
     InfoOut->N = 0;
+    InfoOut->Nmax = 0;
   }
   else {
     N = WInfo->N;
     InfoOut->Info = (char *) UTmalloc(N);
     memcpy(InfoOut->Info, WInfo->Info, N);
     InfoOut->N = N;
+    InfoOut->Nmax = N;
   }
+  InfoOut->Alloc = 1;
+  InfoOut->Defer = NULL;
 }
 
 /* Set the bits/sample value */
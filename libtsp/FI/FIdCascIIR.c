@@ -0,0 +1,206 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  struct FI_cascIIR *FIdAllocCascIIR (const double h[][5], int Nsec,
+                                      int Nlane)
+  void FIdCascIIR (struct FI_cascIIR *Filt, const double x[], double y[],
+                   int Nout)
+  void FIdFreeCascIIR (struct FI_cascIIR *Filt)
+
+Purpose:
+  Set up a multichannel cascade of biquadratic IIR filters
+  Filter multichannel data with a cascade of biquadratic IIR filters
+  Deallocate a multichannel cascade of biquadratic IIR filters
+
+Description:
+  These routines filter Nlane interleaved signals (for instance the channels
+  of a multichannel audio signal) with the same cascade of biquadratic filter
+  sections. Each signal (lane) has its own filter memory. Each filter section
+  has the z-transform
+
+             h(i,0)*z^2 + h(i,1)*z + h(i,2)
+    H(i,z) = ------------------------------ .
+                z^2 + h(i,3)*z + h(i,4)
+
+  The sections are implemented in transposed direct form II. For section i,
+  with input u(n) and output v(n),
+    v(n)  = h(i,0) u(n) + s1(n-1),
+    s1(n) = h(i,1) u(n) - h(i,3) v(n) + s2(n-1),
+    s2(n) = h(i,2) u(n) - h(i,4) v(n).
+  All sections are applied to a sample before moving on to the next sample, so
+  that the intermediate values are not stored in arrays. The calculations for
+  the lanes are done together in an inner loop over the lanes. This loop has
+  no dependencies between iterations and can be vectorized by the compiler.
+  The results differ from those of FIdFiltIIR (direct form I, one section at a
+  time) only by round-off error.
+
+  FIdAllocCascIIR allocates the filter structure. The filter memory is
+  initialized to zero. The structure should be deallocated using
+  FIdFreeCascIIR.
+
+  FIdCascIIR filters Nout new samples for each lane. The filter memory is kept
+  in the filter structure; each call continues from where the previous call
+  left off. The input and output arrays contain interleaved data, with the
+  values for sample n of the lanes at x[n*Nlane], ..., x[n*Nlane+Nlane-1]. The
+  output array can share storage with the input array.
+
+Parameters:
+  <-  struct FI_cascIIR *FIdAllocCascIIR
+      Pointer to the filter structure
+   -> const double h[][5]
+      Array of filter coefficients for the filter sections. Each filter
+      section is defined by 5 filter coefficients.
+   -> int Nsec
+      Number of filter sections
+   -> int Nlane
+      Number of interleaved signals (lanes)
+
+  <-  void FIdCascIIR
+  <-> struct FI_cascIIR *Filt
+      Filter structure
+   -> const double x[]
+      Input array of Nout*Nlane interleaved values
+  <-  double y[]
+      Output array of Nout*Nlane interleaved values. This array can share
+      storage with x[].
+   -> int Nout
+      Number of samples per lane to be filtered
+
+  <-  void FIdFreeCascIIR
+  <-> struct FI_cascIIR *Filt
+      Filter structure to be deallocated
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/12 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp.h>
+
+/* Filter structure
+  - h holds the filter coefficients, 5 per section
+  - s holds the filter memory, 2 vectors of Nlane values per section: s1 for
+    the lanes at s[2*i*Nlane] and s2 for the lanes at s[(2*i+1)*Nlane]
+*/
+struct FI_cascIIR {
+  int Nsec;     /* Number of sections */
+  int Nlane;    /* Number of lanes */
+  double *h;    /* Filter coefficients, 5*Nsec */
+  double *s;    /* Filter memory, 2*Nsec*Nlane */
+};
+
+static void
+FI_cascIIR1 (struct FI_cascIIR *Filt, const double x[], double y[],
+             int Nout);
+
+
+struct FI_cascIIR *
+FIdAllocCascIIR (const double h[][5], int Nsec, int Nlane)
+
+{
+  struct FI_cascIIR *Filt;
+  int i, j;
+
+  Filt = (struct FI_cascIIR *) UTmalloc (sizeof (struct FI_cascIIR));
+  Filt->Nsec = Nsec;
+  Filt->Nlane = Nlane;
+  Filt->h = (double *) UTmalloc (5 * Nsec * sizeof (double));
+  Filt->s = (double *) UTmalloc (2 * Nsec * Nlane * sizeof (double));
+
+  for (i = 0; i < Nsec; ++i) {
+    for (j = 0; j < 5; ++j)
+      Filt->h[5*i+j] = h[i][j];
+  }
+  VRdZero (Filt->s, 2 * Nsec * Nlane);
+
+  return Filt;
+}
+
+
+void
+FIdCascIIR (struct FI_cascIIR *Filt, const double x[], double y[], int Nout)
+
+{
+  int i, l, n, Nlane;
+  const double *hp;
+  double *s1, *s2, *v;
+  double b0, b1, b2, a1, a2, t;
+
+  Nlane = Filt->Nlane;
+  if (Nlane == 1) {
+    FI_cascIIR1 (Filt, x, y, Nout);
+    return;
+  }
+
+  for (n = 0; n < Nout; ++n) {
+    v = &y[n*Nlane];
+    for (l = 0; l < Nlane; ++l)
+      v[l] = x[n*Nlane+l];
+
+/* All sections for sample n, vector operations across the lanes */
+    for (i = 0; i < Filt->Nsec; ++i) {
+      hp = &Filt->h[5*i];
+      b0 = hp[0];
+      b1 = hp[1];
+      b2 = hp[2];
+      a1 = hp[3];
+      a2 = hp[4];
+      s1 = &Filt->s[2*i*Nlane];
+      s2 = &s1[Nlane];
+      for (l = 0; l < Nlane; ++l) {
+        t = b0 * v[l] + s1[l];
+        s1[l] = b1 * v[l] - a1 * t + s2[l];
+        s2[l] = b2 * v[l] - a2 * t;
+        v[l] = t;
+      }
+    }
+  }
+
+  return;
+}
+
+
+void
+FIdFreeCascIIR (struct FI_cascIIR *Filt)
+
+{
+  if (Filt != NULL) {
+    UTfree ((void *) Filt->h);
+    UTfree ((void *) Filt->s);
+    UTfree ((void *) Filt);
+  }
+
+  return;
+}
+
+/* Single lane: the intermediate value is kept in a local variable */
+
+
+static void
+FI_cascIIR1 (struct FI_cascIIR *Filt, const double x[], double y[],
+             int Nout)
+
+{
+  int i, n, Nsec;
+  const double *hp;
+  double *s;
+  double v, t;
+
+  Nsec = Filt->Nsec;
+  for (n = 0; n < Nout; ++n) {
+    v = x[n];
+    hp = Filt->h;
+    s = Filt->s;
+    for (i = 0; i < Nsec; ++i, hp += 5, s += 2) {
+      t = hp[0] * v + s[0];
+      s[0] = hp[1] * v - hp[3] * t + s[1];
+      s[1] = hp[2] * v - hp[4] * t;
+      v = t;
+    }
+    y[n] = v;
+  }
+
+  return;
+}
@@ -0,0 +1,276 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  struct FI_convFFT *FIdAllocConvFFT (const double h[], int Ncof, int Nblk)
+  void FIdConvFFT (struct FI_convFFT *Conv, const double x[], double y[],
+                   int Nout)
+  void FIdFreeConvFFT (struct FI_convFFT *Conv)
+
+Purpose:
+  Set up an FFT-based FIR filter
+  Filter a signal with an FFT-based FIR filter
+  Deallocate an FFT-based FIR filter
+
+Description:
+  These routines implement FIR filtering (convolution) using a uniformly
+  partitioned overlap-save method. For long filters, this is much faster than
+  direct convolution (FIdConvol). The filter response is split into partitions
+  of Nblk coefficients. The DFT (size 2*Nblk) of each partition is computed
+  once. The input data is processed in blocks of Nblk samples. For each block
+  of input, one forward and one inverse DFT are calculated, and the output is
+  formed by combining the DFT of the current input block with those of the
+  previous blocks (one for each filter partition).
+
+  FIdAllocConvFFT allocates the filter structure and calculates the DFT's of
+  the filter partitions. The filter memory is initialized to zero. The
+  structure should be deallocated using FIdFreeConvFFT.
+
+  FIdConvFFT filters Nout new input samples. The filter memory is kept in the
+  filter structure; each call continues from where the previous call left
+  off. The output y[m] is calculated as
+    y[m] = h[0]*x[m] + h[1]*x[m-1] + ... + h[Ncof-1]*x[m-Ncof+1],
+  where the values x[m-j] for m-j < 0 are the inputs from previous calls. The
+  output array can share storage with the input array.
+
+  Calls with Nout equal to a multiple of Nblk are the most efficient. When a
+  call ends partway through a block, the output for that partial block is
+  calculated with the available data, and the calculation for the block is
+  repeated on the next call.
+
+  The results differ from those of direct convolution only by round-off error.
+  For block sizes up to 4096, the difference in an output value is less than
+  1e-13 times the sum of the magnitudes of the products h[j]*x[m-j].
+
+Parameters:
+  <-  struct FI_convFFT *FIdAllocConvFFT
+      Pointer to the filter structure
+   -> const double h[]
+      Array of Ncof filter coefficients
+   -> int Ncof
+      Number of filter coefficients
+   -> int Nblk
+      Block size (a power of 2). The DFT size is 2*Nblk. A block size equal to
+      the filter length (rounded up to a power of 2) minimizes the number of
+      computations; a smaller block size reduces the storage.
+
+  <-  void FIdConvFFT
+  <-> struct FI_convFFT *Conv
+      Filter structure
+   -> const double x[]
+      Input array of Nout new samples
+  <-  double y[]
+      Output array of Nout samples. This array can share storage with x[].
+   -> int Nout
+      Number of samples to be filtered
+
+  <-  void FIdFreeConvFFT
+  <-> struct FI_convFFT *Conv
+      Filter structure to be deallocated
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/04 11:20:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp.h>
+
+#define MINV(a, b)  (((a) < (b)) ? (a) : (b))
+
+/* Filter structure
+  - The DFT's use the format of SPdRFFT (N values for a DFT of size N)
+  - H contains the DFT's of the Np filter partitions
+  - X contains the DFT's of the Np-1 most recent complete input windows,
+    stored in circular fashion, with X[iX] being the most recent
+  - Acc is the sum of the products of the DFT's of the filter partitions 1 to
+    Np-1 with the DFT's of the corresponding previous input windows
+  - xb is the input window: the previous block followed by the current block,
+    of which Nfill values are present
+*/
+struct FI_convFFT {
+  int Nblk;     /* Block size */
+  int N;        /* DFT size, 2*Nblk */
+  int Np;       /* Number of filter partitions */
+  int iX;       /* Index of the most recent input DFT in X */
+  int Nfill;    /* Number of values in the current block */
+  double *H;    /* Filter partition DFT's, Np*N */
+  double *X;    /* Input window DFT's, (Np-1)*N */
+  double *Acc;  /* Accumulated products for previous blocks, N */
+  double *xb;   /* Input window, 2*Nblk */
+  double *w;    /* Work space, N */
+};
+
+static void
+FI_accum (struct FI_convFFT *Conv);
+static void
+FI_cmac (double Y[], const double C[], const double A[], const double B[],
+         int N);
+
+
+struct FI_convFFT *
+FIdAllocConvFFT (const double h[], int Ncof, int Nblk)
+
+{
+  struct FI_convFFT *Conv;
+  int i, j, k, N;
+  double *Hp;
+
+  if (Nblk <= 0 || (Nblk & (Nblk-1)) != 0)
+    UThalt ("FIdAllocConvFFT: Block size must be a power of 2");
+
+  Conv = (struct FI_convFFT *) UTmalloc (sizeof (struct FI_convFFT));
+  N = 2 * Nblk;
+  Conv->Nblk = Nblk;
+  Conv->N = N;
+  Conv->Np = (Ncof > 0) ? (Ncof + Nblk - 1) / Nblk : 1;
+  Conv->iX = 0;
+  Conv->Nfill = 0;
+
+  Conv->H = (double *) UTmalloc (Conv->Np * N * sizeof (double));
+  Conv->X = (double *) UTmalloc ((Conv->Np - 1) * N * sizeof (double));
+  Conv->Acc = (double *) UTmalloc (N * sizeof (double));
+  Conv->xb = (double *) UTmalloc (N * sizeof (double));
+  Conv->w = (double *) UTmalloc (N * sizeof (double));
+
+/* DFT's of the filter partitions (zero padded to length N) */
+  for (i = 0; i < Conv->Np; ++i) {
+    Hp = &Conv->H[i*N];
+    for (j = 0, k = i*Nblk; j < Nblk; ++j, ++k)
+      Hp[j] = (k < Ncof) ? h[k] : 0.0;
+    VRdZero (&Hp[Nblk], Nblk);
+    SPdRFFT (Hp, N, 1);
+  }
+
+/* Clear the filter memory */
+  VRdZero (Conv->X, (Conv->Np - 1) * N);
+  VRdZero (Conv->Acc, N);
+  VRdZero (Conv->xb, N);
+
+  return Conv;
+}
+
+
+void
+FIdConvFFT (struct FI_convFFT *Conv, const double x[], double y[], int Nout)
+
+{
+  int i, m, n, N, Nblk, Nfill;
+  double *w, *xc;
+
+  N = Conv->N;
+  Nblk = Conv->Nblk;
+  w = Conv->w;
+  xc = &Conv->xb[Nblk];   /* Current block */
+
+  m = 0;
+  while (m < Nout) {
+
+/* Add new samples to the current block */
+    Nfill = Conv->Nfill;
+    n = MINV(Nblk - Nfill, Nout - m);
+    for (i = 0; i < n; ++i)
+      xc[Nfill+i] = x[m+i];
+
+/*
+  DFT of the input window
+  - Values in the current block beyond Nfill+n do not affect the outputs for
+    the first Nfill+n positions in the block
+*/
+    for (i = 0; i < N; ++i)
+      w[i] = Conv->xb[i];
+    SPdRFFT (w, N, 1);
+
+/* Save the DFT if the block is complete */
+    if (Nfill + n == Nblk && Conv->Np > 1) {
+      Conv->iX = (Conv->iX + 1) % (Conv->Np - 1);
+      for (i = 0; i < N; ++i)
+        Conv->X[Conv->iX * N + i] = w[i];
+    }
+
+/* Combine with the first filter partition and the previous blocks */
+    FI_cmac (w, Conv->Acc, Conv->H, w, N);
+    SPdRFFT (w, N, -1);
+
+/* The second half of the window holds the output for the current block */
+    for (i = 0; i < n; ++i)
+      y[m+i] = w[Nblk+Nfill+i];
+    m = m + n;
+
+/* Advance to the next block */
+    if (Nfill + n == Nblk) {
+      for (i = 0; i < Nblk; ++i)
+        Conv->xb[i] = xc[i];
+      Conv->Nfill = 0;
+      FI_accum (Conv);
+    }
+    else
+      Conv->Nfill = Nfill + n;
+  }
+
+  return;
+}
+
+
+void
+FIdFreeConvFFT (struct FI_convFFT *Conv)
+
+{
+  if (Conv != NULL) {
+    UTfree ((void *) Conv->H);
+    UTfree ((void *) Conv->X);
+    UTfree ((void *) Conv->Acc);
+    UTfree ((void *) Conv->xb);
+    UTfree ((void *) Conv->w);
+    UTfree ((void *) Conv);
+  }
+
+  return;
+}
+
+/* Form the sum of the products of filter partitions 1 to Np-1 with the DFT's
+   of the previous input windows (partition i with the i'th previous window)
+*/
+
+
+static void
+FI_accum (struct FI_convFFT *Conv)
+
+{
+  int i, j, N, Nx;
+
+  N = Conv->N;
+  Nx = Conv->Np - 1;
+  VRdZero (Conv->Acc, N);
+  for (i = 1; i <= Nx; ++i) {
+    j = (Conv->iX - (i-1) + Nx) % Nx;
+    FI_cmac (Conv->Acc, Conv->Acc, &Conv->H[i*N], &Conv->X[j*N], N);
+  }
+
+  return;
+}
+
+/* Multiply-add of DFT's (SPdRFFT format): Y <- C + A B
+   Y can share storage with C or B
+*/
+
+
+static void
+FI_cmac (double Y[], const double C[], const double A[], const double B[],
+         int N)
+
+{
+  int k, M;
+  double Yr;
+
+  M = N / 2;
+  Y[0] = C[0] + A[0] * B[0];
+  Y[M] = C[M] + A[M] * B[M];
+  for (k = 1; k < M; ++k) {
+    Yr = C[k] + (A[k] * B[k] - A[M+k] * B[M+k]);
+    Y[M+k] = C[M+k] + (A[k] * B[M+k] + A[M+k] * B[k]);
+    Y[k] = Yr;
+  }
+
+  return;
+}
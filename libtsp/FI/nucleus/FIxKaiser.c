@@ -42,6 +42,8 @@ Author / revision:
 
 -------------------------------------------------------------------------*/
 
+#include <libtsp/sysOS.h>
+
 #include <math.h>
 
 #include <libtsp.h>
@@ -52,8 +54,8 @@ double
 FIxKaiser (double x, double alpha)
 
 {
-  static double alpha_prev = 0.0;
-  static double Ia = 1.0;
+  static SY_THREAD_LOCAL double alpha_prev = 0.0;
+  static SY_THREAD_LOCAL double Ia = 1.0;
   double beta, win;
 
   /* Avoid recalculating the denominator Bessel function */
@@ -33,8 +33,8 @@ Description:
 Parameters:
   <-  char *FLfileDate
       Pointer to a character string for the date and time.  This is a pointer
-      to an internal static storage area; each call to this routine overlays
-      this storage.
+      to an internal static storage area; each call to this routine from the
+      same thread overlays this storage.
    -> FILE *fp
       File pointer for the file
    -> int format
@@ -67,7 +67,7 @@ FLfileDate (FILE *fp, int format)
 {
   struct stat Fstat;
   int status;
-  static char Datetime[MAXDATE+1];
+  static SY_THREAD_LOCAL char Datetime[MAXDATE+1];
 
   status = fstat (fileno (fp), &Fstat);
   if (status == 0)
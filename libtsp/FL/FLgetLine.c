@@ -19,19 +19,22 @@ Parameters:
       and the line is empty.  Otherwise, when end-of-file is encountered, the
       line is treated as if it were terminated with a newline.  The text string
       is in an internally allocated storage area; each call to this routine
-      overlays this storage.
+      from the same thread overlays this storage.
    -> FILE *fp
       File pointer to the text file
 
 Author / revision:
   P. Kabal  Copyright (C) 2017
-  $Revision: 1.18 $  $Date: 2017/05/24 16:21:53 $
+  $Revision: 1.19 $  $Date: 2020/12/25 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
+#include <libtsp/sysOS.h>
+
 #include <string.h>
 
 #include <libtsp.h>
+#include <libtsp/nucleus.h>
 #include <libtsp/FLmsg.h>
 
 #define DEF_BUF_SIZE  256     /* default buffer size */
@@ -44,14 +47,15 @@ FLgetLine (FILE *fp)
 {
   char *p;
   int nc;
-  static char *linebuf = NULL;
-  static int lenbuf = 0;
+  static SY_THREAD_LOCAL char *linebuf = NULL;
+  static SY_THREAD_LOCAL int lenbuf = 0;
 
 /* On each call, restore the buffer to the default size */
   if (lenbuf != DEF_BUF_SIZE) {
     UTfree ((void *) linebuf);
     linebuf = (char *) UTmalloc (DEF_BUF_SIZE);
     lenbuf = DEF_BUF_SIZE;
+    UTthreadFree ((void **) &linebuf);  /* Freed when the thread exits */
   }
 
 /* Read a line of input */
@@ -8,7 +8,11 @@ Purpose:
   Find the size of a file
 
 Description:
-  This routine finds the size of a binary file. The size of the file is
+  This routine finds the size of a binary file. For a regular file, the size
+  is taken from the file status (fstat). Data written to the stream but not
+  yet flushed is accounted for by taking the size to be at least the current
+  file position. This avoids repositioning the stream, which for an input
+  stream discards the buffered data. For other files, the size of the file is
   determined by positioning to end-of-file and returning the end-of-file
   position. On exit, the file position is restored to the original position.
 
@@ -20,16 +24,28 @@ Parameters:
 
 Author / revision:
   P. Kabal  Copyright (C) 2020
-  $Revision: 1.24 $  $Date: 2020/11/29 23:10:47 $
+  $Revision: 1.25 $  $Date: 2020/12/19 10:00:00 $
 
 -------------------------------------------------------------------------*/
 
+#include <libtsp/sysOS.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  define _CRT_NONSTDC_NO_DEPRECATE  /* Allow Posix names */
+#endif
+
 #include <errno.h>
+#include <stdio.h>  /* fileno (Section 8.2.1.1 of Posix) */
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include <libtsp.h>
 #include <libtsp/nucleus.h>
 #include <libtsp/FLmsg.h>
 
+#ifndef S_ISREG     /* Defined by POSIX */
+#  define S_ISREG(m)  (((m) & S_IFMT) == S_IFREG)
+#endif
+
 
 long int
 FLfileSize(FILE *fp)
@@ -37,18 +53,27 @@ FLfileSize(FILE *fp)
 {
   long int pos;
   long int endpos;
+  struct stat Fstat;
 
-/*
-   The ANSI C standard does not guarantee that this method of determining the
-   file size will work on all systems. It works on Unix systems and probably a
-   lot of other systems. The alternative is to use fstat, but that is probably
-   even less portable.
-*/
   errno = 0;
   pos = ftell(fp);
   if (pos == -1L && errno)
     UTerror("FLfileSize: %s", FLM_NoFilePos);
 
+/* Regular file: size from the file status */
+  if (fstat(fileno(fp), &Fstat) == 0 && S_ISREG(Fstat.st_mode)) {
+    endpos = (long int) Fstat.st_size;
+    if (pos > endpos)
+      endpos = pos;     /* Unflushed data */
+    return endpos;
+  }
+
+/*
+   The ANSI C standard does not guarantee that this method of determining the
+   file size will work on all systems. It works on Unix systems and probably a
+   lot of other systems.
+*/
+
   if (fseek(fp, 0L, SEEK_END) != 0)
     UThalt("FLfileSize: %s", FLM_FilePosErr);
 
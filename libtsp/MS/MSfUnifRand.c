@@ -17,7 +17,8 @@ Description:
   generated are shuffled to give better serial correlation properties.  The
   pseudo-random number generation routine is self initializing, but if a
   different sequence of pseudo-random values is desired, the routine MSrandSeed
-  can be used to supply a starting (seed) value.
+  can be used to supply a starting (seed) value. The generator state is kept
+  separately for each thread; each thread starts with the default sequence.
 
   Reference:
       W. H. Press, S. A. Teukolsky, W. T. Vetterling, B. P. Flannery,
@@ -41,6 +42,8 @@ Author / revision:
 
 -------------------------------------------------------------------------*/
 
+#include <libtsp/sysOS.h>
+
 #include <time.h>
 
 #include <libtsp.h>
@@ -55,9 +58,9 @@ Author / revision:
 #define RANMAX  (1.0 - EPS)
 #define DSEED 12345
 
-static long int y = 0;
-static long int is;
-static long int iv[NTAB];
+static SY_THREAD_LOCAL long int y = 0;
+static SY_THREAD_LOCAL long int is;
+static SY_THREAD_LOCAL long int iv[NTAB];
 
 
 double
@@ -110,7 +113,7 @@ MSrandSeed (int seed)
 {
   int j;
   long int t, k;
-  static long int timev = 0;
+  static SY_THREAD_LOCAL long int timev = 0;
 
 /*
   If seed == 0, the seed value is derived from the time.  However, if the time
@@ -0,0 +1,352 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  struct MS_randGen *MSallocRandGen (int seed, int Nstream)
+  void MSdRandGauss (struct MS_randGen *Gen, int j, double x[], int N,
+                     double rms)
+  void MSdRandUnif (struct MS_randGen *Gen, int j, double x[], int N)
+  void MSfreeRandGen (struct MS_randGen *Gen)
+
+Purpose:
+  Set up a pseudo-random number generator with independent streams
+  Generate an array of Gaussian pseudo-random values from a stream
+  Generate an array of uniformly distributed pseudo-random values from a stream
+  Deallocate a pseudo-random number generator
+
+Description:
+  These routines generate pseudo-random numbers from one or more independent
+  streams. The streams are intended to be used for different signals (e.g.
+  the channels of a multichannel signal). Each stream has its own generator
+  state. Calls for different streams can be made from different threads at the
+  same time. The values generated for a stream depend only on the seed and on
+  the stream number, not on the order in which the streams are used.
+
+  The uniform generator is xoshiro128** (Blackman and Vigna), which has a state
+  of 4 32-bit words and a period of 2^128-1. The state for the first stream is
+  derived from the seed by hashing. The state for stream j is obtained by
+  advancing the state of the first stream by j*2^64 steps (the jump function of
+  the generator), so that the streams do not overlap. Each double value is
+  formed from two 32-bit outputs.
+
+  The Gaussian values are generated with the Ziggurat method (Marsaglia and
+  Tsang), using 128 layers. The generated values have a Gaussian distribution
+  (exact, apart from the finite precision of the uniform values), unlike those
+  generated by MSfGaussRand (sum of uniform values). Most values need one pair
+  of 32-bit outputs, a multiplication and a comparison.
+
+  MSallocRandGen allocates the generator structure. The structure should be
+  deallocated using MSfreeRandGen.
+
+  References:
+      D. Blackman and S. Vigna, "Scrambled linear pseudorandom number
+      generators", arXiv:1805.01407, 2018.
+      G. Marsaglia and W. W. Tsang, "The Ziggurat method for generating random
+      variables", J. Statistical Software, vol. 5, no. 8, 2000.
+      J. A. Doornik, "An improved Ziggurat method to generate normal random
+      samples", Technical Report, University of Oxford, 2005.
+
+Parameters:
+  <-  struct MS_randGen *MSallocRandGen
+      Pointer to the generator structure
+   -> int seed
+      Seed value. A zero value sets the actual seed to a value based on the
+      current time.
+   -> int Nstream
+      Number of streams
+
+  <-  void MSdRandGauss
+  <-> struct MS_randGen *Gen
+      Generator structure
+   -> int j
+      Stream number, 0 <= j < Nstream
+  <-  double x[]
+      Output array of N Gaussian deviates, mean zero, standard deviation rms
+   -> int N
+      Number of values to be generated
+   -> double rms
+      Root-mean square value of the deviates (standard deviation)
+
+  <-  void MSdRandUnif
+  <-> struct MS_randGen *Gen
+      Generator structure
+   -> int j
+      Stream number, 0 <= j < Nstream
+  <-  double x[]
+      Output array of N uniform deviates with values between 0 and 1,
+      exclusive of the end points
+   -> int N
+      Number of values to be generated
+
+  <-  void MSfreeRandGen
+  <-> struct MS_randGen *Gen
+      Generator structure to be deallocated
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/24 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <math.h>
+#include <time.h>
+
+#include <libtsp/sysOS.h>
+#include <libtsp.h>
+#include <libtsp/UTtypes.h>
+
+#define NLAYER  128               /* Number of Ziggurat layers */
+#define ZIG_R   3.442619855899    /* Start of the tail */
+#define ZIG_V   9.91256303526217e-3   /* Area of each layer */
+#define DSEED   12345
+
+#define U32(x)      ((x) & 0xFFFFFFFFUL)
+#define ROTL(x, k)  U32 (((x) << (k)) | ((x) >> (32 - (k))))
+
+/* Generator structure
+  - s holds the generator state, 4 words per stream
+  - zx holds the Ziggurat layer edges x[0], ..., x[NLAYER] (x[NLAYER] = 0),
+    zr holds the ratios x[i+1]/x[i] and zf holds the values exp(-x[i]^2/2)
+*/
+struct MS_randGen {
+  int Nstream;      /* Number of streams */
+  UT_uint4_t *s;    /* Generator states, 4*Nstream */
+  double zx[NLAYER+1];
+  double zr[NLAYER];
+  double zf[NLAYER+1];
+};
+
+static UT_uint4_t
+MS_next (UT_uint4_t s[4]);
+static void
+MS_jump (UT_uint4_t s[4]);
+static UT_uint4_t
+MS_hash (UT_uint4_t x);
+
+
+struct MS_randGen *
+MSallocRandGen (int seed, int Nstream)
+
+{
+  struct MS_randGen *Gen;
+  UT_uint4_t *s;
+  UT_uint4_t sv;
+  int i, j;
+  long int t;
+  double x;
+  static SY_THREAD_LOCAL long int timev = 0;
+
+  assert (Nstream > 0);
+  Gen = (struct MS_randGen *) UTmalloc (sizeof (struct MS_randGen));
+  Gen->Nstream = Nstream;
+  Gen->s = (UT_uint4_t *) UTmalloc (4 * Nstream * sizeof (UT_uint4_t));
+
+/* Seed value (see MSrandSeed), then the state of the first stream */
+  if (seed == 0) {
+    t = (long int) time (NULL);
+    if (t <= timev)
+      t = timev + 1;
+    timev = t;
+    sv = (UT_uint4_t) U32 ((unsigned long int) t);
+  }
+  else
+    sv = (UT_uint4_t) U32 ((unsigned long int) seed);
+  if (sv == 0)
+    sv = DSEED;
+
+  s = Gen->s;
+  for (i = 0; i < 4; ++i) {
+    sv = (UT_uint4_t) U32 (sv + 0x9E3779B9UL);
+    s[i] = MS_hash (sv);
+  }
+  if (s[0] == 0 && s[1] == 0 && s[2] == 0 && s[3] == 0)
+    s[0] = DSEED;       /* All-zero state is not allowed */
+
+/* Other streams, separated by jumps */
+  for (j = 1; j < Nstream; ++j) {
+    s = &Gen->s[4*j];
+    for (i = 0; i < 4; ++i)
+      s[i] = s[i-4];
+    MS_jump (s);
+  }
+
+/* Ziggurat tables */
+  Gen->zf[0] = exp (-0.5 * ZIG_R * ZIG_R);
+  Gen->zx[0] = ZIG_V / Gen->zf[0];
+  Gen->zx[1] = ZIG_R;
+  Gen->zf[1] = Gen->zf[0];
+  for (i = 2; i < NLAYER; ++i) {
+    x = sqrt (-2.0 * log (ZIG_V / Gen->zx[i-1] + Gen->zf[i-1]));
+    Gen->zx[i] = x;
+    Gen->zf[i] = exp (-0.5 * x * x);
+  }
+  Gen->zf[0] = exp (-0.5 * Gen->zx[0] * Gen->zx[0]);
+  Gen->zx[NLAYER] = 0.0;
+  Gen->zf[NLAYER] = 1.0;
+  for (i = 0; i < NLAYER; ++i)
+    Gen->zr[i] = Gen->zx[i+1] / Gen->zx[i];
+
+  return Gen;
+}
+
+
+void
+MSdRandGauss (struct MS_randGen *Gen, int j, double x[], int N, double rms)
+
+{
+  UT_uint4_t *s;
+  UT_uint4_t a, b;
+  int i, k;
+  double u, v, t, xt;
+
+  assert (j >= 0 && j < Gen->Nstream);
+  s = &Gen->s[4*j];
+
+/*
+  - The 8 low-order bits of the first output give the layer (7 bits) and the
+    sign (1 bit). The remaining 24 bits and 29 bits of the second output form
+    a uniform value u in [0,1).
+  - Layer i (i >= 1) is a rectangle from 0 to x[i]. The value v = u*x[i] is
+    accepted immediately if it lies under the layer above (u < x[i+1]/x[i]).
+    Otherwise, a second test against the density is done.
+  - Layer 0 is the base rectangle together with the tail beyond R = x[1].
+*/
+  for (k = 0; k < N; ++k) {
+    while (1) {
+      a = MS_next (s);
+      b = MS_next (s);
+      i = (int) (a & (NLAYER - 1));
+      u = ((double) (a >> 8) * 536870912. + (double) (b >> 3))
+          * (1. / 9007199254740992.);     /* 2^29, 2^53 */
+      if (u < Gen->zr[i]) {
+        v = u * Gen->zx[i];
+        break;
+      }
+      if (i == 0) {
+        /* Tail, Marsaglia's method */
+        do {
+          MSdRandUnif (Gen, j, &t, 1);
+          xt = -log (t) / ZIG_R;
+          MSdRandUnif (Gen, j, &t, 1);
+        } while (-2.0 * log (t) < xt * xt);
+        v = ZIG_R + xt;
+        break;
+      }
+      v = u * Gen->zx[i];
+      MSdRandUnif (Gen, j, &t, 1);
+      if (Gen->zf[i] + t * (Gen->zf[i+1] - Gen->zf[i]) < exp (-0.5 * v * v))
+        break;
+    }
+    x[k] = (a & NLAYER) ? -rms * v : rms * v;
+  }
+
+  return;
+}
+
+
+void
+MSdRandUnif (struct MS_randGen *Gen, int j, double x[], int N)
+
+{
+  UT_uint4_t *s;
+  UT_uint4_t a, b;
+  int k;
+
+  assert (j >= 0 && j < Gen->Nstream);
+  s = &Gen->s[4*j];
+
+/* 53-bit value from the top bits of two outputs, plus one-half of the value
+   of the least significant bit, to give a value strictly between 0 and 1 */
+  for (k = 0; k < N; ++k) {
+    a = MS_next (s);
+    b = MS_next (s);
+    x[k] = ((double) (a >> 5) * 67108864. + (double) (b >> 6) + 0.5)
+           * (1. / 9007199254740992.);    /* 2^26, 2^53 */
+  }
+
+  return;
+}
+
+
+void
+MSfreeRandGen (struct MS_randGen *Gen)
+
+{
+  if (Gen != NULL) {
+    UTfree ((void *) Gen->s);
+    UTfree ((void *) Gen);
+  }
+
+  return;
+}
+
+/* xoshiro128** generator: returns the next 32-bit output, updates the state */
+
+
+static UT_uint4_t
+MS_next (UT_uint4_t s[4])
+
+{
+  UT_uint4_t r, t;
+
+  r = (UT_uint4_t) U32 (ROTL (U32 (s[1] * 5), 7) * 9);
+  t = (UT_uint4_t) U32 (s[1] << 9);
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = (UT_uint4_t) ROTL (s[3], 11);
+
+  return r;
+}
+
+/* Advance the state by 2^64 steps */
+
+
+static void
+MS_jump (UT_uint4_t s[4])
+
+{
+  static const UT_uint4_t Jump[4] = {
+    0x8764000BUL, 0xF542D2D3UL, 0x6FA035C3UL, 0x77F2DB5BUL };
+  UT_uint4_t t[4];
+  int i, b;
+
+  t[0] = t[1] = t[2] = t[3] = 0;
+  for (i = 0; i < 4; ++i) {
+    for (b = 0; b < 32; ++b) {
+      if (Jump[i] & ((UT_uint4_t) 1 << b)) {
+        t[0] ^= s[0];
+        t[1] ^= s[1];
+        t[2] ^= s[2];
+        t[3] ^= s[3];
+      }
+      MS_next (s);
+    }
+  }
+  s[0] = t[0];
+  s[1] = t[1];
+  s[2] = t[2];
+  s[3] = t[3];
+
+  return;
+}
+
+/* Mix the bits of a 32-bit value (integer hash) */
+
+
+static UT_uint4_t
+MS_hash (UT_uint4_t x)
+
+{
+  x = (UT_uint4_t) U32 (x ^ (x >> 16));
+  x = (UT_uint4_t) U32 (x * 0x7FEB352DUL);
+  x = (UT_uint4_t) U32 (x ^ (x >> 15));
+  x = (UT_uint4_t) U32 (x * 0x846CA68BUL);
+  x = (UT_uint4_t) U32 (x ^ (x >> 16));
+
+  return x;
+}
@@ -0,0 +1,116 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void SPdCFFT (double x[], double y[], int N, int Ifn)
+
+Purpose:
+  Calculate the DFT of a complex sequence (double precision)
+
+Description:
+  This routine calculates the discrete Fourier transform of a complex sequence
+  using a decimation-in-time radix-2 fast Fourier transform. The DFT is
+  defined as
+           N-1
+    X(k) = SUM x(n) exp(-j 2 pi n k / N),    0 <= k < N.
+           n=0
+  The inverse DFT is defined as
+               N-1
+    x(n) = 1/N SUM X(k) exp(j 2 pi n k / N),  0 <= n < N.
+               k=0
+  The real and imaginary parts of the sequence are stored in separate arrays.
+  The transform is computed in place; the output values overlay the input
+  values.
+
+Parameters:
+  <-  void SPdCFFT
+  <-> double x[]
+      Array of N values. On input, these are the real parts of the input
+      sequence. On output, these are the real parts of the transformed
+      sequence.
+  <-> double y[]
+      Array of N values. On input, these are the imaginary parts of the input
+      sequence. On output, these are the imaginary parts of the transformed
+      sequence.
+   -> int N
+      Number of values in the sequence. N must be a power of 2.
+   -> int Ifn
+      Function code, +1 for a forward transform, -1 for an inverse transform
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/04 11:20:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <math.h>
+
+#include <libtsp.h>
+
+#define PI      3.14159265358979323846
+
+
+void
+SPdCFFT (double x[], double y[], int N, int Ifn)
+
+{
+  int i, j, k, m, L, L2;
+  double t, tr, ti, wr, wi, ar, ai, s, sh;
+
+  if (N <= 0 || (N & (N-1)) != 0)
+    UThalt ("SPdCFFT: Number of values must be a power of 2");
+
+/* Bit-reversed reordering */
+  j = 0;
+  for (i = 0; i < N-1; ++i) {
+    if (i < j) {
+      t = x[i]; x[i] = x[j]; x[j] = t;
+      t = y[i]; y[i] = y[j]; y[j] = t;
+    }
+    k = N / 2;
+    while (k <= j) {
+      j = j - k;
+      k = k / 2;
+    }
+    j = j + k;
+  }
+
+/* Butterfly stages
+   The twiddle factors exp(-j pi m/L2) are generated using a recursion with
+   increment factor (1 + ar + j ai) = exp(-j pi/L2). The recursion uses
+   ar = -2 sin^2(pi/(2 L2)) to maintain accuracy.
+*/
+  for (L = 2; L <= N; L = 2 * L) {
+    L2 = L / 2;
+    sh = sin (0.5 * PI / L2);
+    ar = -2.0 * sh * sh;
+    ai = (Ifn >= 0) ? -sin (PI / L2) : sin (PI / L2);
+    wr = 1.0;
+    wi = 0.0;
+    for (m = 0; m < L2; ++m) {
+      for (i = m; i < N; i += L) {
+        j = i + L2;
+        tr = wr * x[j] - wi * y[j];
+        ti = wr * y[j] + wi * x[j];
+        x[j] = x[i] - tr;
+        y[j] = y[i] - ti;
+        x[i] = x[i] + tr;
+        y[i] = y[i] + ti;
+      }
+      t = wr;
+      wr = wr + (ar * wr - ai * wi);
+      wi = wi + (ar * wi + ai * t);
+    }
+  }
+
+/* Scaling for the inverse transform */
+  if (Ifn < 0) {
+    s = 1.0 / N;
+    for (i = 0; i < N; ++i) {
+      x[i] = s * x[i];
+      y[i] = s * y[i];
+    }
+  }
+
+  return;
+}
@@ -0,0 +1,247 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void SPdRFFT (double x[], int N, int Ifn)
+
+Purpose:
+  Calculate the DFT of a real sequence (double precision)
+
+Description:
+  This routine calculates the discrete Fourier transform of a real sequence.
+  The DFT is defined as
+           N-1
+    X(k) = SUM x(n) exp(-j 2 pi n k / N),    0 <= k < N.
+           n=0
+  For a real sequence, X(N-k) is the complex conjugate of X(k). Only the
+  values X(k) for 0 <= k <= N/2 are needed to represent the transform. The
+  imaginary parts of X(0) and X(N/2) are zero. The transformed values are
+  stored in the N element array x[] as follows.
+    x[k]     = Re[X(k)],    0 <= k <= N/2,
+    x[N/2+k] = Im[X(k)],    1 <= k < N/2.
+  The inverse transform takes the transformed values in this format and
+  returns the real sequence x(n). The inverse DFT is defined as
+               N-1
+    x(n) = 1/N SUM X(k) exp(j 2 pi n k / N),  0 <= n < N.
+               k=0
+
+  The DFT of the real sequence is calculated using a complex DFT of half the
+  length, followed by a separation step. The scratch storage used to reorder
+  the data is allocated on the first call and kept for later calls from the
+  same thread (it is freed when the thread exits).
+
+Parameters:
+  <-  void SPdRFFT
+  <-> double x[]
+      Array of N values. For a forward transform, the input is the real
+      sequence and the output is the DFT in the format described above. For an
+      inverse transform, the input is the DFT and the output is the real
+      sequence.
+   -> int N
+      Number of values in the sequence. N must be a power of 2.
+   -> int Ifn
+      Function code, +1 for a forward transform, -1 for an inverse transform
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.2 $  $Date: 2020/12/26 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+#include <math.h>
+
+#include <libtsp.h>
+#include <libtsp/nucleus.h>
+
+#define PI      3.14159265358979323846
+
+static void
+SP_split (double x[], int M, int Ifn);
+static void
+SP_deintl (double x[], int M);
+static void
+SP_intl (double x[], int M);
+static double *
+SP_work (int M);
+
+
+void
+SPdRFFT (double x[], int N, int Ifn)
+
+{
+  int M;
+  double t;
+
+  if (N <= 0 || (N & (N-1)) != 0)
+    UThalt ("SPdRFFT: Number of values must be a power of 2");
+
+  if (N == 1)
+    return;
+  if (N == 2) {
+    t = x[0];
+    x[0] = t + x[1];
+    x[1] = t - x[1];
+    if (Ifn < 0) {
+      x[0] = 0.5 * x[0];
+      x[1] = 0.5 * x[1];
+    }
+    return;
+  }
+
+/*
+  The even-numbered samples form the real part and the odd-numbered samples
+  form the imaginary part of a complex sequence of length M=N/2. The real
+  parts are stored in x[0], ..., x[M-1] and the imaginary parts in x[M], ...,
+  x[N-1].
+*/
+  M = N / 2;
+  if (Ifn >= 0) {
+    SP_deintl (x, M);
+    SPdCFFT (x, &x[M], M, 1);
+    SP_split (x, M, 1);
+  }
+  else {
+    SP_split (x, M, -1);
+    SPdCFFT (x, &x[M], M, -1);
+    SP_intl (x, M);
+  }
+
+  return;
+}
+
+/* Separate the DFT's of the even and odd samples, or combine them
+
+  Let Z(k) be the DFT of z(n) = x(2n) + j x(2n+1). With E(k) and O(k) being the
+  DFT's of the even and odd samples,
+    E(k) = (Z(k) + Z*(M-k)) / 2,  O(k) = (Z(k) - Z*(M-k)) / 2j,
+    X(k) = E(k) + W^k O(k),       W = exp(-j 2 pi / N).
+  The computations for k and M-k share the same storage locations.
+*/
+
+
+static void
+SP_split (double x[], int M, int Ifn)
+
+{
+  int k, M2;
+  double Er, Ei, Or, Oi, Tr, Ti, ar, ai, wr, wi, t, sh;
+  double *xr, *xi;
+
+  xr = x;
+  xi = &x[M];
+  M2 = M / 2;
+
+/* k = 0 and k = M/2 */
+  t = xr[0];
+  if (Ifn >= 0) {
+    xr[0] = t + xi[0];
+    xi[0] = t - xi[0];      /* Re[X(M)] is stored in x[M] */
+  }
+  else {
+    xr[0] = 0.5 * (t + xi[0]);
+    xi[0] = 0.5 * (t - xi[0]);
+  }
+  xi[M2] = -xi[M2];
+
+/* Twiddle factors W^k from a recursion, increment factor W */
+  sh = sin (0.5 * PI / M);
+  ar = -2.0 * sh * sh;
+  ai = -sin (PI / M);
+  wr = 1.0 + ar;
+  wi = ai;
+
+  for (k = 1; k < M2; ++k) {
+    if (Ifn >= 0) {
+      Er = 0.5 * (xr[k] + xr[M-k]);
+      Ei = 0.5 * (xi[k] - xi[M-k]);
+      Or = 0.5 * (xi[k] + xi[M-k]);
+      Oi = -0.5 * (xr[k] - xr[M-k]);
+      Tr = wr * Or - wi * Oi;       /* W^k O(k) */
+      Ti = wr * Oi + wi * Or;
+      xr[k] = Er + Tr;
+      xi[k] = Ei + Ti;
+      xr[M-k] = Er - Tr;            /* X(M-k) = conj(E(k) - W^k O(k)) */
+      xi[M-k] = -(Ei - Ti);
+    }
+    else {
+      Er = 0.5 * (xr[k] + xr[M-k]);
+      Ei = 0.5 * (xi[k] - xi[M-k]);
+      Tr = 0.5 * (xr[k] - xr[M-k]);
+      Ti = 0.5 * (xi[k] + xi[M-k]);
+      Or = wr * Tr + wi * Ti;       /* O(k) = conj(W^k) (X(k) - X*(M-k)) / 2 */
+      Oi = wr * Ti - wi * Tr;
+      xr[k] = Er - Oi;              /* Z(k) = E(k) + j O(k) */
+      xi[k] = Ei + Or;
+      xr[M-k] = Er + Oi;            /* Z(M-k) = E*(k) + j O*(k) */
+      xi[M-k] = -Ei + Or;
+    }
+    t = wr;
+    wr = wr + (ar * wr - ai * wi);
+    wi = wi + (ar * wi + ai * t);
+  }
+
+  return;
+}
+
+/* Move the even samples to x[0..M-1] and the odd samples to x[M..2M-1] */
+
+
+static void
+SP_deintl (double x[], int M)
+
+{
+  int n;
+  double *t;
+
+  t = SP_work (M);
+  for (n = 0; n < M; ++n)
+    t[n] = x[2*n+1];
+  for (n = 0; n < M; ++n)
+    x[n] = x[2*n];
+  for (n = 0; n < M; ++n)
+    x[M+n] = t[n];
+
+  return;
+}
+
+/* Interleave x[0..M-1] (even samples) and x[M..2M-1] (odd samples) */
+
+
+static void
+SP_intl (double x[], int M)
+
+{
+  int n;
+  double *t;
+
+  t = SP_work (M);
+  for (n = 0; n < M; ++n)
+    t[n] = x[M+n];
+  for (n = M-1; n >= 0; --n) {
+    x[2*n] = x[n];
+    x[2*n+1] = t[n];
+  }
+
+  return;
+}
+
+/* Scratch storage for M values, reused for later calls from the same thread */
+
+
+static double *
+SP_work (int M)
+
+{
+  static SY_THREAD_LOCAL double *t = NULL;
+  static SY_THREAD_LOCAL int Nt = 0;
+
+  if (M > Nt) {
+    UTfree ((void *) t);
+    t = (double *) UTmalloc (M * sizeof (double));
+    Nt = M;
+    UTthreadFree ((void **) &t);    /* Freed when the thread exits */
+  }
+
+  return t;
+}
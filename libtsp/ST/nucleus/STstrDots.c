@@ -102,7 +102,7 @@ STstrDots (const char Si[], int Maxchar)
   int i, k, N, M;
   int MultiLine;
   const char FillChar = '\xA4';   /* Generic currency symbol */
-  static char Line[MAXM+1];
+  static SY_THREAD_LOCAL char Line[MAXM+1];
 
   enum CharType {
     CT_NL,    /* Control character = > newline */
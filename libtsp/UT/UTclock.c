@@ -0,0 +1,57 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  double UTclock (void)
+
+Purpose:
+  Return a high resolution elapsed time value
+
+Description:
+  This routine returns the elapsed (wall clock) time in seconds from an
+  arbitrary starting point. Time intervals are measured as the difference
+  between two values. A monotonic clock is used where available (Posix
+  clock_gettime, Windows performance counter). Otherwise the processor time
+  from the C library routine clock() is used.
+
+Parameters:
+  <-  double UTclock
+      Time in seconds
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/16 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+
+#include <time.h>
+#if (SY_OS == SY_OS_WINDOWS)
+#  include <windows.h>
+#endif
+
+#include <libtsp.h>
+
+
+double
+UTclock (void)
+
+{
+#if (SY_POSIX && defined (CLOCK_MONOTONIC))
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+
+#elif (SY_OS == SY_OS_WINDOWS)
+  LARGE_INTEGER Count, Freq;
+
+  QueryPerformanceCounter (&Count);
+  QueryPerformanceFrequency (&Freq);
+  return (double) Count.QuadPart / (double) Freq.QuadPart;
+
+#else
+  return (double) clock () / CLOCKS_PER_SEC;
+#endif
+}
@@ -33,8 +33,8 @@ Description:
 Parameters:
   <-  char *UTdate
       Pointer to a character string for the date and time.  This is a pointer
-      to an internal static storage area; each call to this routine overlays
-      this storage.
+      to an internal static storage area; each call to this routine from the
+      same thread overlays this storage.
    -> int format
       Date / time format code, taking on values from 0 to 3
 
@@ -44,6 +44,8 @@ Author / revision:
 
 -------------------------------------------------------------------------*/
 
+#include <libtsp/sysOS.h>
+
 #include <time.h>
 
 #include <libtsp.h>
@@ -56,7 +58,7 @@ char *
 UTdate (int format)
 
 {
-  static char Datetime[MAXDATE+1];
+  static SY_THREAD_LOCAL char Datetime[MAXDATE+1];
   time_t tnow;
 
   tnow = time ((time_t *) NULL);
@@ -26,6 +26,8 @@ Author / revision:
 
 -------------------------------------------------------------------------*/
 
+#include <libtsp/sysOS.h>
+
 #include <assert.h>
 
 #include <libtsp/nucleus.h>
@@ -34,7 +36,6 @@ Author / revision:
 
 #define U4    ((int) sizeof (UT_uint4_t))
 
-static union { UT_uint4_t U; unsigned char C[U4]; } u;
 static const unsigned char C[4] = { 1, 2, 4, 8 };
 static const UT_uint4_t I4L = 0x08040201;
 static const UT_uint4_t I4B = 0x01020408;
@@ -44,7 +45,8 @@ enum UT_DS_T
 UTbyteOrder (void)
 
 {
-  static enum UT_DS_T Hbo = DS_UNDEF;
+  union { UT_uint4_t U; unsigned char C[U4]; } u;
+  static SY_THREAD_LOCAL enum UT_DS_T Hbo = DS_UNDEF;
 
   if (Hbo == DS_UNDEF) {  /* Cache the byte order */
     u.C[0] = C[0];
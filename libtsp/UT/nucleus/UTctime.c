@@ -33,8 +33,8 @@ Description:
 Parameters:
   <-  char UTctime[]
       Pointer to a character string for the date and time.  This is a pointer
-      to an internal static storage area; each call to this routine overlays
-      this storage.
+      to an internal static storage area; each call to this routine from the
+      same thread overlays this storage.
    -> time_t *Time
       Input time value
    -> int Format
@@ -59,6 +59,22 @@ Author / revision:
 #include <libtsp/nucleus.h>
 
 #define MAXDATE 64
+#define NASCTIME 26   /* Size of the asctime string (with newline and null) */
+
+/* Re-entrant versions of the time conversion routines */
+#if (SY_POSIX)
+#  define LOCALTIME_R(t, tm)  localtime_r (t, tm)
+#  define GMTIME_R(t, tm)     gmtime_r (t, tm)
+#  define ASCTIME_R(tm, s)    asctime_r (tm, s)
+#elif (SY_OS == SY_OS_WINDOWS)
+#  define LOCALTIME_R(t, tm)  (localtime_s (tm, t), tm)
+#  define GMTIME_R(t, tm)     (gmtime_s (tm, t), tm)
+#  define ASCTIME_R(tm, s)    (asctime_s (s, NASCTIME, tm), s)
+#else
+#  define LOCALTIME_R(t, tm)  (*(tm) = *localtime (t), tm)
+#  define GMTIME_R(t, tm)     (*(tm) = *gmtime (t), tm)
+#  define ASCTIME_R(tm, s)    ((void) (s), asctime (tm))
+#endif
 
 
 char *
@@ -67,7 +83,9 @@ UTctime (time_t *Time, int Format)
 {
   int nc;
   char *stdtime;
-  static char Datetime[MAXDATE+1];
+  char Atime[NASCTIME];
+  struct tm Tm;
+  static SY_THREAD_LOCAL char Datetime[MAXDATE+1];
 
 /* Time zone setting
  For Unix systems, use tzselect on the command line, then assign the value
@@ -83,24 +101,26 @@ UTctime (time_t *Time, int Format)
 */
   switch (Format) {
   case 1:
-    stdtime = asctime (localtime (Time));
+    stdtime = ASCTIME_R (LOCALTIME_R (Time, &Tm), Atime);
     nc = STcopyNMax (stdtime, Datetime, 20, MAXDATE);
-    strftime (&Datetime[nc], MAXDATE - nc, "%Z %Y", localtime (Time));
+    strftime (&Datetime[nc], MAXDATE - nc, "%Z %Y", &Tm);
     STtrim (&Datetime[nc], &Datetime[nc]); /* In case time zone is empty */
     break;
   case 2:
-    strftime (Datetime, MAXDATE, "%Y-%m-%d %H:%M:%S %Z", localtime (Time));
+    strftime (Datetime, MAXDATE, "%Y-%m-%d %H:%M:%S %Z",
+              LOCALTIME_R (Time, &Tm));
     STtrim (Datetime, Datetime);  /* In case time zone is empty */
     break;
   case 3:
-    strftime (Datetime, MAXDATE, "%Y-%m-%d %H:%M:%S UTC", gmtime (Time));
+    strftime (Datetime, MAXDATE, "%Y-%m-%d %H:%M:%S UTC",
+              GMTIME_R (Time, &Tm));
     break;
   case 4:
-    strftime (Datetime, MAXDATE, "%Y-%m-%d %H:%M:%S Z", gmtime (Time));
+    strftime (Datetime, MAXDATE, "%Y-%m-%d %H:%M:%S Z", GMTIME_R (Time, &Tm));
     break;
   case 0:
   default:
-    stdtime = asctime (localtime (Time));
+    stdtime = ASCTIME_R (LOCALTIME_R (Time, &Tm), Atime);
     STcopyNMax (stdtime, Datetime, 24, MAXDATE);
     break;
   }
@@ -32,6 +32,8 @@ Author / revision:
 
 -------------------------------------------------------------------------*/
 
+#include <libtsp/sysOS.h>
+
 #include <libtsp.h>
 #include <libtsp/nucleus.h>
 #include <libtsp/UTpar.h>
@@ -42,7 +44,7 @@ enum UT_DS_T
 UTswapCode (enum UT_DS_T Dbo)
 
 {
-  static enum UT_DS_T Hbo = DS_UNDEF;
+  static SY_THREAD_LOCAL enum UT_DS_T Hbo = DS_UNDEF;
 
   switch (Dbo) {
   case DS_EB:
@@ -0,0 +1,117 @@
+/*-------------- Telecommunications & Signal Processing Lab ---------------
+                             McGill University
+
+Routine:
+  void UTthreadFree (void **Ptr)
+
+Purpose:
+  Free the storage for a thread-local pointer when the thread exits
+
+Description:
+  Some routines keep allocated storage in a thread-local (SY_THREAD_LOCAL)
+  pointer variable so that the storage can be reused on later calls from the
+  same thread. This routine registers such a pointer variable for the calling
+  thread. When the thread exits, the storage pointed to by the variable is
+  freed (UTfree) and the variable is set to NULL. Registering a variable more
+  than once has no further effect. Up to 8 variables can be registered for a
+  thread.
+
+  The storage is freed only for threads which exit through pthread_exit or by
+  returning from the thread start routine. For the main thread of a program,
+  the storage is reclaimed when the program exits. On systems without POSIX
+  threads, this routine does nothing.
+
+Parameters:
+   -> void **Ptr
+      Address of a thread-local pointer variable
+
+Author / revision:
+  P. Kabal  Copyright (C) 2020
+  $Revision: 1.1 $  $Date: 2020/12/25 10:00:00 $
+
+-------------------------------------------------------------------------*/
+
+#include <libtsp/sysOS.h>
+
+#if (SY_POSIX)
+#  include <pthread.h>
+#endif
+
+#include <libtsp.h>
+#include <libtsp/nucleus.h>
+
+#define MAXPTR  8
+
+#if (SY_POSIX)
+/* Registered pointer variables for a thread */
+struct UT_ptrList {
+  int N;
+  void **Ptr[MAXPTR];
+};
+
+static pthread_once_t UT_once = PTHREAD_ONCE_INIT;
+static pthread_key_t UT_key;
+static SY_THREAD_LOCAL struct UT_ptrList UT_list = {0, {NULL}};
+
+static void
+UT_newKey (void);
+static void
+UT_freeList (void *List);
+#endif
+
+
+void
+UTthreadFree (void **Ptr)
+
+{
+#if (SY_POSIX)
+  int i;
+
+  for (i = 0; i < UT_list.N; ++i) {
+    if (UT_list.Ptr[i] == Ptr)
+      return;
+  }
+
+  /* The key value for the thread (non-NULL) enables the destructor */
+  if (UT_list.N == 0) {
+    pthread_once (&UT_once, UT_newKey);
+    pthread_setspecific (UT_key, &UT_list);
+  }
+  if (UT_list.N < MAXPTR) {
+    UT_list.Ptr[UT_list.N] = Ptr;
+    ++UT_list.N;
+  }
+#endif
+
+  return;
+}
+
+#if (SY_POSIX)
+/* Create the key (once for all threads) */
+
+
+static void
+UT_newKey (void)
+
+{
+  pthread_key_create (&UT_key, UT_freeList);
+}
+
+/* Destructor called at thread exit: free the storage */
+
+
+static void
+UT_freeList (void *List)
+
+{
+  struct UT_ptrList *L;
+  int i;
+
+  L = (struct UT_ptrList *) List;
+  for (i = 0; i < L->N; ++i) {
+    UTfree (*L->Ptr[i]);
+    *L->Ptr[i] = NULL;
+  }
+  L->N = 0;
+}
+#endif